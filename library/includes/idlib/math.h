@@ -22,13 +22,37 @@
 #if !defined(IDLIB_MATH_H_INCLUDED)
 #define IDLIB_MATH_H_INCLUDED
 
+#include "idlib/math/aabb.h"
+#include "idlib/math/animation.h"
+#include "idlib/math/arena.h"
+#include "idlib/math/broadphase.h"
 #include "idlib/math/color.h"
 #include "idlib/math/colors.h"
+#include "idlib/math/convex_hull.h"
+#include "idlib/math/curve.h"
+#include "idlib/math/delaunay_2.h"
+#include "idlib/math/encoding.h"
+#include "idlib/math/gjk.h"
+#include "idlib/math/integrator.h"
+#include "idlib/math/kd_tree.h"
+#include "idlib/math/matrix_3x3.h"
+#include "idlib/math/mesh.h"
+#include "idlib/math/noise.h"
+#include "idlib/math/obb.h"
+#include "idlib/math/projection.h"
+#include "idlib/math/random.h"
 #include "idlib/math/scalar.h"
 #include "idlib/math/matrix_4x4.h"
+#include "idlib/math/predicates.h"
+#include "idlib/math/shadow.h"
+#include "idlib/math/skinning.h"
+#include "idlib/math/spatial_grid.h"
+#include "idlib/math/transform.h"
 #include "idlib/math/vector_2.h"
 #include "idlib/math/vector_3.h"
 #include "idlib/math/vector_4.h"
 #include "idlib/math/version.h"
+#include "idlib/math/vertex_cache.h"
+#include "idlib/math/weld.h"
 
 #endif // IDLIB_MATH_H_INCLUDED
@@ -0,0 +1,83 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_AABB_H_INCLUDED)
+#define IDLIB_AABB_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+
+/// @since 1.5
+/// @brief An axis-aligned bounding box.
+/// @remarks The box is the set of points p with <code>minimum[k] <= p[k] <= maximum[k]</code>, k = 0, 1, 2.
+typedef struct idlib_aabb_3_f32 {
+  idlib_vector_3_f32 minimum;
+  idlib_vector_3_f32 maximum;
+} idlib_aabb_3_f32;
+
+/// @since 1.5
+/// @brief A stream of idlib_aabb_3_f32 objects in "structure of arrays" layout.
+typedef struct idlib_aabb_3_f32_soa {
+  idlib_vector_3_f32_soa minimum;
+  idlib_vector_3_f32_soa maximum;
+} idlib_aabb_3_f32_soa;
+
+/// @since 1.5
+/// @brief Get if two axis-aligned bounding boxes overlap.
+/// @param operand1, operand2 Pointers to the idlib_aabb_3_f32 objects.
+/// @return @a true if the boxes overlap (including touching boxes), @a false otherwise.
+static inline bool
+idlib_aabb_3_f32_overlap
+  (
+    idlib_aabb_3_f32 const* operand1,
+    idlib_aabb_3_f32 const* operand2
+  );
+
+/// @since 1.5
+/// @brief Compute the axis-aligned bounding box of a set of points.
+/// @param target Pointer to the idlib_aabb_3_f32 object receiving the box.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of points.
+/// @param count The number of points. If zero, the box is set to the point (0, 0, 0).
+/// @remarks Four points are processed at once on SIMD capable architectures.
+void
+idlib_aabb_3_f32_set_points
+  (
+    idlib_aabb_3_f32* target,
+    idlib_vector_3_f32_soa const* operand,
+    size_t count
+  );
+
+static inline bool
+idlib_aabb_3_f32_overlap
+  (
+    idlib_aabb_3_f32 const* operand1,
+    idlib_aabb_3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  return operand1->minimum.e[0] <= operand2->maximum.e[0] && operand2->minimum.e[0] <= operand1->maximum.e[0]
+      && operand1->minimum.e[1] <= operand2->maximum.e[1] && operand2->minimum.e[1] <= operand1->maximum.e[1]
+      && operand1->minimum.e[2] <= operand2->maximum.e[2] && operand2->minimum.e[2] <= operand1->maximum.e[2];
+}
+
+#endif // IDLIB_AABB_H_INCLUDED
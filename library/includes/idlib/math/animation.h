@@ -0,0 +1,201 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#if !defined(IDLIB_ANIMATION_H_INCLUDED)
+#define IDLIB_ANIMATION_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "vector_4.h"
+#include "matrix_4x4.h"
+#include "transform.h"
+#include "arena.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting keys stored as idlib_f32 values.
+#define IDLIB_ANIMATION_KEYS_F32 (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting keys quantized to idlib_u16 values.
+/// @remarks
+/// Translations and scalings are quantized to 16 bits per component relative to the range of the component over the keys of the track.
+/// Rotations are quantized to 48 bits by the "smallest three" encoding:
+/// The largest component (in magnitude) of the unit quaternion is omitted and reconstructed from the unit length,
+/// the other three components are quantized to 15 bits each and the index of the omitted component is stored in the two remaining bits.
+#define IDLIB_ANIMATION_KEYS_U16 (1)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the translation channel of a track.
+#define IDLIB_ANIMATION_CHANNEL_TRANSLATION (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the rotation channel of a track.
+#define IDLIB_ANIMATION_CHANNEL_ROTATION (1)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the scale channel of a track.
+#define IDLIB_ANIMATION_CHANNEL_SCALE (2)
+
+/// @since 1.5
+/// @brief The keys of a track of an animation as provided by the caller.
+/// @remarks
+/// A track animates one joint by three channels: translation, rotation, and scale.
+/// Each channel has its own keys. The times of the keys of a channel must be strictly increasing and each channel must have at least one key.
+/// Rotations are unit quaternions with their components stored in the order <code>(x, y, z, w)</code>.
+typedef struct idlib_animation_track_f32 {
+  idlib_f32 const* translation_times;
+  idlib_vector_3_f32 const* translations;
+  idlib_u32 number_of_translations;
+  idlib_f32 const* rotation_times;
+  idlib_vector_4_f32 const* rotations;
+  idlib_u32 number_of_rotations;
+  idlib_f32 const* scale_times;
+  idlib_vector_3_f32 const* scales;
+  idlib_u32 number_of_scales;
+} idlib_animation_track_f32;
+
+/// @since 1.5
+/// @brief The keys of one channel of all tracks of an animation clip.
+/// @remarks
+/// The keys of the i-th track are the keys <code>[offsets[i], offsets[i + 1])</code>.
+/// The time of a key is stored in @a times and its components are stored in separate arrays:
+/// - If the keys are stored as idlib_f32 values, the components are stored in @a values and the elements of @a quantized are null pointers.
+/// - If the keys are quantized, the components are stored in @a quantized and the elements of @a values are null pointers.
+///   The component c of a quantized translation or scaling q of the i-th track is <code>minimum[c][i] + q * step[c][i]</code>.
+///   @a minimum and @a step are not used for rotations.
+typedef struct idlib_animation_channel_f32 {
+  idlib_u32* offsets;
+  idlib_f32* times;
+  idlib_f32* values[4];
+  idlib_u16* quantized[3];
+  idlib_f32* minimum[3];
+  idlib_f32* step[3];
+} idlib_animation_channel_f32;
+
+/// @since 1.5
+/// @brief An animation clip.
+/// @remarks
+/// The keys are stored per channel in structure of arrays layout such that sampling a channel of consecutive tracks reads consecutive memory.
+/// The memory of a clip is allocated from an arena by idlib_animation_clip_f32_create.
+typedef struct idlib_animation_clip_f32 {
+  idlib_animation_channel_f32 channels[3];
+  idlib_u32 number_of_tracks;
+  idlib_u32 format;
+  idlib_f32 duration;
+} idlib_animation_clip_f32;
+
+/// @since 1.5
+/// @brief Create an animation clip.
+/// @param target Pointer to the idlib_animation_clip_f32 object.
+/// @param arena Pointer to the idlib_arena object to allocate the memory of the clip from.
+/// @param tracks Pointer to an array of @a number_of_tracks idlib_animation_track_f32 objects.
+/// @param number_of_tracks The number of tracks.
+/// @param format The format of the keys: IDLIB_ANIMATION_KEYS_F32 or IDLIB_ANIMATION_KEYS_U16.
+/// @param tolerance The maximum error of a component of a translation, rotation, or scaling introduced by removing keys. Must be non-negative.
+/// @return @a true on success, @a false if the arena is exhausted. In the latter case, the arena is unmodified.
+/// @remarks
+/// A key is removed if interpolating between the keys remaining before and after it reproduces all removed keys in between within @a tolerance.
+/// The keys are removed greedily, starting from the first key.
+/// A channel whose keys all equal its first key within @a tolerance is reduced to that key.
+/// With a tolerance of zero, only constant channels are reduced.
+///
+/// The error introduced by quantization comes in addition to @a tolerance.
+/// The duration of the clip is the time of the last key of all channels.
+bool
+idlib_animation_clip_f32_create
+  (
+    idlib_animation_clip_f32* target,
+    idlib_arena* arena,
+    idlib_animation_track_f32 const* tracks,
+    idlib_u32 number_of_tracks,
+    idlib_u32 format,
+    idlib_f32 tolerance
+  );
+
+/// @since 1.5
+/// @brief Get the number of keys of an animation clip.
+/// @param operand Pointer to the idlib_animation_clip_f32 object.
+/// @param channel The channel: IDLIB_ANIMATION_CHANNEL_TRANSLATION, IDLIB_ANIMATION_CHANNEL_ROTATION, or IDLIB_ANIMATION_CHANNEL_SCALE.
+/// @return The number of keys of the channel over all tracks.
+idlib_u32
+idlib_animation_clip_f32_get_number_of_keys
+  (
+    idlib_animation_clip_f32 const* operand,
+    idlib_u32 channel
+  );
+
+/// @since 1.5
+/// @brief Sample the tracks <code>[first, first + count)</code> of an animation clip.
+/// @param target Pointer to an array of @a count idlib_transform_f32 objects. The i-th object receives the transformation of the track <code>first + i</code>.
+/// @param cache Pointer to an array of <code>3 * number_of_tracks</code> idlib_u32 values or a null pointer.
+/// The array must be initialized to zero before the clip is sampled for the first time.
+/// @param operand Pointer to the idlib_animation_clip_f32 object.
+/// @param time The time. Times before the first key respectively after the last key of a channel evaluate to the first respectively the last key.
+/// @param first The index of the first track.
+/// @param count The number of tracks.
+/// @remarks
+/// Translations and scalings are interpolated linearly, rotations are interpolated by normalized linear interpolation along the shorter arc.
+///
+/// The index of the key preceding the time is found by binary search.
+/// If @a cache is not a null pointer, the key index of each channel of each track is remembered in @a cache.
+/// When the clip is sampled at the same or slightly later times (as in sequential playback), the key is then found in constant time.
+/// A separate cache is required for each instance of a playing clip.
+///
+/// The interpolation proceeds on four tracks at once on SIMD capable architectures.
+/// An invocation reads the keys of the tracks of the range from @a operand and writes @a count transformations to @a target.
+/// Of @a cache, it reads and writes only the entries <code>3 * track</code> to <code>3 * track + 2</code> of the tracks of the range.
+/// Invocations on disjoint ranges can hence share a cache if their targets do not overlap (see the section on ranges in idlib-math.md).
+void
+idlib_animation_clip_f32_sample_n
+  (
+    idlib_transform_f32* target,
+    idlib_u32* cache,
+    idlib_animation_clip_f32 const* operand,
+    idlib_f32 time,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+/// @since 1.5
+/// @brief Sample the tracks <code>[first, first + count)</code> of an animation clip into a matrix palette.
+/// @param target Pointer to an array of @a count idlib_matrix_4x4_f32 objects. The i-th object receives the matrix of the transformation of the track <code>first + i</code>.
+/// @param cache See idlib_animation_clip_f32_sample_n.
+/// @param operand Pointer to the idlib_animation_clip_f32 object.
+/// @param time The time.
+/// @param first The index of the first track.
+/// @param count The number of tracks.
+/// @remarks
+/// The result is the same as that of idlib_animation_clip_f32_sample_n followed by idlib_matrix_4x4_f32_set_transform_n.
+/// The tracks are processed in blocks such that the transformations do not leave the cache before they are converted.
+void
+idlib_animation_clip_f32_sample_matrices_n
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_u32* cache,
+    idlib_animation_clip_f32 const* operand,
+    idlib_f32 time,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+#endif // IDLIB_ANIMATION_H_INCLUDED
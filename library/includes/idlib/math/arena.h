@@ -0,0 +1,154 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_ARENA_H_INCLUDED)
+#define IDLIB_ARENA_H_INCLUDED
+
+#include "scalar.h"
+
+/// @since 1.5
+/// @brief The alignment, in Bytes, of the memory blocks returned by idlib_arena_allocate.
+/// @remarks The size of a cache line on the supported architectures.
+#define IDLIB_ARENA_ALIGNMENT (64)
+
+/// @since 1.5
+/// @brief A linear allocator handing out memory blocks from a memory region provided by the caller.
+/// @remarks
+/// Memory blocks are allocated by advancing an offset into the region and are never freed individually.
+/// Instead, the offset is saved by idlib_arena_push and restored by idlib_arena_pop, freeing all blocks allocated in between,
+/// or is reset to zero by idlib_arena_reset, freeing all blocks.
+/// The arena does not allocate or free the memory region itself.
+typedef struct idlib_arena {
+  /// @brief Pointer to the memory region.
+  idlib_u8* memory;
+  /// @brief The size, in Bytes, of the memory region.
+  size_t size;
+  /// @brief The number of Bytes in use, including padding.
+  size_t used;
+  /// @brief The maximum of @a used since the arena was initialized.
+  size_t peak;
+} idlib_arena;
+
+/// @since 1.5
+/// @brief A marker saving the state of an idlib_arena object.
+typedef size_t idlib_arena_marker;
+
+/// @since 1.5
+/// @brief Initialize an idlib_arena object.
+/// @param target Pointer to the idlib_arena object.
+/// @param memory Pointer to the memory region. May be a null pointer if @a size is zero.
+/// @param size The size, in Bytes, of the memory region.
+/// @remarks The memory region need not be aligned.
+/// However, the padding required to align the first memory block is not available to allocations.
+void
+idlib_arena_initialize
+  (
+    idlib_arena* target,
+    void* memory,
+    size_t size
+  );
+
+/// @since 1.5
+/// @brief Allocate a memory block aligned to IDLIB_ARENA_ALIGNMENT Bytes.
+/// @param target Pointer to the idlib_arena object.
+/// @param size The size, in Bytes, of the memory block. May be zero.
+/// @return Pointer to the memory block on success, a null pointer if the arena is exhausted.
+/// The contents of the memory block are unspecified.
+void*
+idlib_arena_allocate
+  (
+    idlib_arena* target,
+    size_t size
+  );
+
+/// @since 1.5
+/// @brief Allocate a memory block aligned to the specified number of Bytes.
+/// @param target Pointer to the idlib_arena object.
+/// @param size The size, in Bytes, of the memory block. May be zero.
+/// @param alignment The alignment, in Bytes. Must be a power of two.
+/// @return Pointer to the memory block on success, a null pointer if the arena is exhausted.
+/// The contents of the memory block are unspecified.
+void*
+idlib_arena_allocate_aligned
+  (
+    idlib_arena* target,
+    size_t size,
+    size_t alignment
+  );
+
+/// @since 1.5
+/// @brief Get a marker saving the state of an arena.
+/// @param operand Pointer to the idlib_arena object.
+/// @return The marker.
+idlib_arena_marker
+idlib_arena_push
+  (
+    idlib_arena const* operand
+  );
+
+/// @since 1.5
+/// @brief Restore the state of an arena saved in a marker.
+/// @param target Pointer to the idlib_arena object.
+/// @param marker The marker as returned by idlib_arena_push for @a target.
+/// @remarks All memory blocks allocated after the marker was obtained are freed.
+/// Markers must be restored in the reverse order they were obtained in.
+void
+idlib_arena_pop
+  (
+    idlib_arena* target,
+    idlib_arena_marker marker
+  );
+
+/// @since 1.5
+/// @brief Free all memory blocks of an arena.
+/// @param target Pointer to the idlib_arena object.
+void
+idlib_arena_reset
+  (
+    idlib_arena* target
+  );
+
+/// @since 1.5
+/// @brief Allocate a memory block with the specified alignment from the heap.
+/// @param size The size, in Bytes, of the memory block. Must not be zero.
+/// @param alignment The alignment, in Bytes. Must be a power of two.
+/// @return Pointer to the memory block on success, a null pointer on failure.
+/// @remarks
+/// This is intended to allocate the memory regions of idlib_arena objects and arrays of aligned types like idlib_vector_3a_f32 or idlib_matrix_4x4a_f32.
+/// The memory block must be deallocated by idlib_deallocate_aligned.
+void*
+idlib_allocate_aligned
+  (
+    size_t size,
+    size_t alignment
+  );
+
+/// @since 1.5
+/// @brief Deallocate a memory block allocated by idlib_allocate_aligned.
+/// @param pointer Pointer to the memory block or a null pointer.
+void
+idlib_deallocate_aligned
+  (
+    void* pointer
+  );
+
+#endif // IDLIB_ARENA_H_INCLUDED
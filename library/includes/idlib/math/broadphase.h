@@ -0,0 +1,148 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_BROADPHASE_H_INCLUDED)
+#define IDLIB_BROADPHASE_H_INCLUDED
+
+#include "scalar.h"
+#include "aabb.h"
+#include "arena.h"
+
+/// @since 1.5
+/// @brief A sweep-and-prune broadphase over a stream of axis-aligned bounding boxes.
+/// @remarks
+/// The broadphase maintains the bodies (that is, the indices of the boxes in the stream) sorted by the minimum of their boxes along the sweep axis
+/// together with copies of the coordinates of the boxes in that order.
+/// The arrays are located in a workspace provided by the caller.
+typedef struct idlib_broadphase {
+  /// @brief The bodies in ascending order of the minimum of their boxes along the sweep axis.
+  idlib_u32* order;
+  /// @brief <code>minimum[k][i]</code> and <code>maximum[k][i]</code> are the coordinates of the box of the body <code>order[i]</code>.
+  idlib_f32* minimum[3];
+  idlib_f32* maximum[3];
+  /// @brief The number of bodies.
+  idlib_u32 number_of_bodies;
+  /// @brief The maximum number of bodies.
+  idlib_u32 capacity;
+  /// @brief The sweep axis (0, 1, or 2).
+  idlib_u32 axis;
+  /// @brief If the order must be rebuilt by the next update.
+  bool rebuild;
+} idlib_broadphase;
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by an idlib_broadphase object.
+/// @param capacity The maximum number of bodies.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 16 Bytes.
+size_t
+idlib_broadphase_get_workspace_size
+  (
+    idlib_u32 capacity
+  );
+
+/// @since 1.5
+/// @brief Initialize an idlib_broadphase object.
+/// @param target Pointer to the idlib_broadphase object.
+/// @param capacity The maximum number of bodies.
+/// @param workspace Pointer to a workspace of idlib_broadphase_get_workspace_size(capacity) Bytes.
+/// The workspace must remain valid as long as @a target is used.
+/// @remarks The broadphase contains no bodies.
+void
+idlib_broadphase_initialize
+  (
+    idlib_broadphase* target,
+    idlib_u32 capacity,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Update a broadphase with the current boxes of the bodies.
+/// @param target Pointer to the idlib_broadphase object.
+/// @param operand Pointer to the idlib_aabb_3_f32_soa object describing the stream of boxes. The i-th box is the box of the i-th body.
+/// @param number_of_bodies The number of bodies. Must not exceed the capacity of @a target. The coordinates of the boxes must not be NaN.
+/// @remarks
+/// If the number of bodies increased, then the new bodies are appended to the order.
+/// If it decreased, then the bodies with indices greater than or equal to @a number_of_bodies are removed from the order.
+///
+/// The sweep axis is the axis along which the centers of the boxes have the largest variance.
+/// To retain the order, the sweep axis is changed only if the variance along the new axis is larger than twice the variance along the current axis.
+///
+/// As the boxes of the bodies usually move little from one update to the next, the order of the previous update is almost sorted
+/// and is sorted by insertion sort in almost linear time.
+/// If the order was just initialized, if the sweep axis changed, or if many bodies were appended, then it is sorted from scratch by Shell sort.
+void
+idlib_broadphase_update
+  (
+    idlib_broadphase* target,
+    idlib_aabb_3_f32_soa const* operand,
+    idlib_u32 number_of_bodies
+  );
+
+/// @since 1.5
+/// @brief Find the pairs of bodies with overlapping boxes.
+/// @param target Pointer to an array of <code>2 * capacity</code> elements receiving the pairs.
+/// The k-th pair is <code>(target[2 * k], target[2 * k + 1])</code> where the first body is less than the second body.
+/// @param capacity The maximum number of pairs to store.
+/// @param operand Pointer to the idlib_broadphase object.
+/// @param first, count The range <code>[first, first + count)</code> of positions in the order of @a operand to sweep.
+/// @return The number of pairs found. If this is greater than @a capacity, then only the first @a capacity pairs were stored.
+/// @remarks
+/// The boxes are the boxes of the last update. Boxes touching at a face, an edge, or a corner overlap (see idlib_aabb_3_f32_overlap).
+///
+/// A pair is found by the sweep of the position of that body of the pair which comes first in the order.
+/// Hence sweeping the positions <code>[0, number_of_bodies)</code> finds each pair exactly once.
+/// The positions can be partitioned into ranges swept concurrently (e.g., by different threads) into different arrays.
+///
+/// For each position, the subsequent positions are swept until the minimum along the sweep axis exceeds the maximum of the box at the position.
+/// The other two axes are tested for four positions at once on SIMD capable architectures.
+size_t
+idlib_broadphase_find_pairs
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_broadphase const* operand,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+/// @since 1.5
+/// @brief Find the pairs of bodies with overlapping boxes and store them in an arena.
+/// @param target Pointer to a variable receiving a pointer to the pairs (see idlib_broadphase_find_pairs).
+/// @param number_of_pairs Pointer to a variable receiving the number of pairs.
+/// @param arena Pointer to the idlib_arena object the pairs are allocated from.
+/// @param operand Pointer to the idlib_broadphase object.
+/// @param first, count The range <code>[first, first + count)</code> of positions in the order of @a operand to sweep.
+/// @return @a true on success, @a false if the arena is exhausted. In the latter case, the arena is unmodified.
+/// @remarks The pairs are written into the remaining memory of the arena and the block is then shrunk to the number of pairs found.
+bool
+idlib_broadphase_find_pairs_arena
+  (
+    idlib_u32** target,
+    size_t* number_of_pairs,
+    idlib_arena* arena,
+    idlib_broadphase const* operand,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+#endif // IDLIB_BROADPHASE_H_INCLUDED
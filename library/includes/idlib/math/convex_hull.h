@@ -0,0 +1,93 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#if !defined(IDLIB_CONVEX_HULL_H_INCLUDED)
+#define IDLIB_CONVEX_HULL_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+#include "vector_3.h"
+#include "arena.h"
+
+/// @since 1.5
+/// @brief Compute the convex hull of a set of points in the plane.
+/// @param target Pointer to a variable receiving a pointer to the array of the indices of the vertices of the hull.
+/// @param number_of_vertices Pointer to a variable receiving the number of vertices of the hull.
+/// @param arena Pointer to the idlib_arena object the array of vertices and temporary arrays are allocated from.
+/// @param points Pointer to an array of @a number_of_points idlib_vector_2_f32 objects.
+/// @param number_of_points The number of points.
+/// @return @a true on success, @a false if the arena is exhausted. In the latter case, the arena is unmodified.
+/// @remarks
+/// The vertices are in counterclockwise order, starting with the vertex with the smallest x coordinate (and the smallest y coordinate among these).
+/// Points in the interior of the edges of the hull are not vertices. Of coinciding points, only one is a vertex.
+/// If all points are collinear, then the hull consists of the two endpoints (or of one point if all points coincide).
+///
+/// The points are first filtered: The extreme points along eight directions are found in a single pass
+/// and the points inside their convex hull (by a margin exceeding the arithmetic errors) are discarded (Akl-Toussaint heuristic).
+/// The remaining points are sorted by a radix sort and Andrew's monotone chain algorithm computes the hull.
+/// All decisions of the algorithm are made by the robust predicate idlib_orient_2_f32.
+///
+/// Only the array of vertices remains allocated from the arena.
+bool
+idlib_convex_hull_2_f32
+  (
+    idlib_u32** target,
+    idlib_u32* number_of_vertices,
+    idlib_arena* arena,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 number_of_points
+  );
+
+/// @since 1.5
+/// @brief Compute the convex hull of a set of points in space.
+/// @param target Pointer to a variable receiving a pointer to the array of the triangles of the hull.
+/// The i-th triangle consists of the points with the indices <code>(*target)[3 * i + k]</code>, k = 0, 1, 2,
+/// in counterclockwise order when viewed from outside of the hull.
+/// @param number_of_triangles Pointer to a variable receiving the number of triangles of the hull.
+/// @param arena Pointer to the idlib_arena object the array of triangles and temporary arrays are allocated from.
+/// @param points Pointer to an array of @a number_of_points idlib_vector_3_f32 objects.
+/// @param number_of_points The number of points.
+/// @return @a true on success, @a false if the arena is exhausted. In the latter case, the arena is unmodified.
+/// @remarks
+/// If the points are coplanar (in particular, if fewer than four points are given), then the hull has no triangles.
+/// Points in the interior of the faces or edges of the hull are not vertices. Of coinciding points, only one is a vertex.
+/// Faces of the hull which are polygons with more than three vertices are triangulated arbitrarily.
+///
+/// The points are first filtered: The extreme points along fourteen directions are found in a single pass
+/// and the points inside their convex hull (by a margin exceeding the arithmetic errors) are discarded (Akl-Toussaint heuristic).
+/// The hull of the remaining points is computed by the Quickhull algorithm (Barber, Dobkin, Huhdanpaa).
+/// All decisions of the algorithm are made by the robust predicate idlib_orient_3_f32 such that the hull is convex.
+///
+/// The size of the temporary arrays is about 270 Bytes per point remaining after the filtering plus 4 Bytes per point.
+/// Only the array of triangles remains allocated from the arena.
+bool
+idlib_convex_hull_3_f32
+  (
+    idlib_u32** target,
+    idlib_u32* number_of_triangles,
+    idlib_arena* arena,
+    idlib_vector_3_f32 const* points,
+    idlib_u32 number_of_points
+  );
+
+#endif // IDLIB_CONVEX_HULL_H_INCLUDED
@@ -0,0 +1,449 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_CURVE_H_INCLUDED)
+#define IDLIB_CURVE_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+#include "vector_3.h"
+#include "vector_4.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a piecewise cubic Hermite curve.
+#define IDLIB_CURVE_HERMITE (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a uniform Catmull-Rom spline.
+#define IDLIB_CURVE_CATMULL_ROM (1)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a piecewise cubic Bezier curve.
+#define IDLIB_CURVE_BEZIER (2)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a uniform cubic B-spline.
+#define IDLIB_CURVE_B_SPLINE (3)
+
+/// @since 1.5
+/// @brief A piecewise cubic curve given by its control points.
+/// @remarks
+/// The i-th segment of the curve is defined by the four control points starting at the control point with index <code>stride * i</code>,
+/// where the stride depends on the kind of the curve:
+/// - IDLIB_CURVE_HERMITE: The control points are positions and tangents in alternating order <code>p0, m0, p1, m1, ...</code>.
+///   The i-th segment is the Hermite curve from the position p(i) with tangent m(i) to the position p(i + 1) with tangent m(i + 1). The stride is 2.
+/// - IDLIB_CURVE_CATMULL_ROM: The i-th segment is the (uniform) Catmull-Rom curve from the control point i + 1 to the control point i + 2. The stride is 1.
+/// - IDLIB_CURVE_BEZIER: The i-th segment is the cubic Bezier curve from the control point 3 i to the control point 3 i + 3. The stride is 3.
+/// - IDLIB_CURVE_B_SPLINE: The i-th segment is the uniform cubic B-spline segment of the control points i to i + 3. The stride is 1.
+///
+/// The curve is parameterized over <code>[0, n]</code> where n is the number of segments: The parameter u denotes the point with the parameter <code>u - i</code>
+/// on the i-th segment where <code>i = floor(u)</code> (and <code>i = n - 1</code> if <code>u = n</code>). Parameters outside of <code>[0, n]</code> are clamped.
+/// The control points are not copied.
+typedef struct idlib_curve_3_f32 {
+  idlib_u32 kind;
+  idlib_vector_3_f32 const* control_points;
+  idlib_u32 number_of_control_points;
+} idlib_curve_3_f32;
+
+/// @since 1.5
+/// @brief Assign an idlib_curve_3_f32 object a curve.
+/// @param target Pointer to the idlib_curve_3_f32 object.
+/// @param kind The kind of the curve: IDLIB_CURVE_HERMITE, IDLIB_CURVE_CATMULL_ROM, IDLIB_CURVE_BEZIER, or IDLIB_CURVE_B_SPLINE.
+/// @param control_points Pointer to an array of @a number_of_control_points idlib_vector_3_f32 objects. The array must remain valid as long as @a target is used.
+/// @param number_of_control_points The number of control points. The curve must have at least one segment.
+void
+idlib_curve_3_f32_set
+  (
+    idlib_curve_3_f32* target,
+    idlib_u32 kind,
+    idlib_vector_3_f32 const* control_points,
+    idlib_u32 number_of_control_points
+  );
+
+/// @since 1.5
+/// @brief Get the number of segments of a curve.
+/// @param operand Pointer to the idlib_curve_3_f32 object.
+/// @return The number of segments.
+/// @remarks Four control points define one segment. Each additional segment requires 2 (Hermite curves), 3 (Bezier curves), or 1 (Catmull-Rom curves and B-splines) additional control points.
+idlib_u32
+idlib_curve_3_f32_get_number_of_segments
+  (
+    idlib_curve_3_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Evaluate a curve.
+/// @param target Pointer to the idlib_vector_3_f32 object receiving the point.
+/// @param operand Pointer to the idlib_curve_3_f32 object.
+/// @param parameter The parameter.
+void
+idlib_curve_3_f32_evaluate
+  (
+    idlib_vector_3_f32* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 parameter
+  );
+
+/// @since 1.5
+/// @brief Evaluate a curve at many parameters.
+/// @param target Pointer to the idlib_vector_3_f32_soa object. The i-th vector of the stream receives the point at the parameter <code>parameters[i]</code>.
+/// @param operand Pointer to the idlib_curve_3_f32 object.
+/// @param parameters Pointer to an array of @a count parameters.
+/// @param count The number of parameters.
+/// @remarks
+/// The curve is evaluated for four parameters at once on SIMD capable architectures: The basis functions are evaluated for the four parameters
+/// and the control points of the segments are combined per component. The results are the same as those of idlib_curve_3_f32_evaluate.
+void
+idlib_curve_3_f32_evaluate_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate the derivative of a curve at many parameters.
+/// @param target Pointer to the idlib_vector_3_f32_soa object. The i-th vector of the stream receives the derivative at the parameter <code>parameters[i]</code>.
+/// @param operand Pointer to the idlib_curve_3_f32 object.
+/// @param parameters Pointer to an array of @a count parameters.
+/// @param count The number of parameters.
+/// @remarks The derivative is with respect to the parameter of the curve (which is the parameter of the segments) and is the tangent of the curve.
+void
+idlib_curve_3_f32_evaluate_derivative_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate many curves, each at its own parameter.
+/// @param target Pointer to the idlib_vector_3_f32_soa object. The i-th vector of the stream receives the point of the i-th curve at the parameter <code>parameters[i]</code>.
+/// @param operand Pointer to an array of @a count idlib_curve_3_f32 objects. The curves may be of different kinds.
+/// @param parameters Pointer to an array of @a count parameters.
+/// @param count The number of curves.
+/// @remarks Four curves are evaluated at once on SIMD capable architectures. The results are the same as those of idlib_curve_3_f32_evaluate.
+void
+idlib_curve_3_f32_evaluate_curves_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Get the Bezier control points of a segment of a curve.
+/// @param target Pointer to an array of four idlib_vector_3_f32 objects receiving the control points.
+/// @param operand Pointer to the idlib_curve_3_f32 object.
+/// @param segment The index of the segment.
+/// @remarks All segments are cubic polynomials and hence cubic Bezier curves. Their Bezier control points are used for subdivision (see idlib_bezier_3_f32_split) and for bounding boxes (as the segment is within the convex hull of its Bezier control points).
+void
+idlib_curve_3_f32_get_bezier
+  (
+    idlib_vector_3_f32 target[4],
+    idlib_curve_3_f32 const* operand,
+    idlib_u32 segment
+  );
+
+/// @since 1.5
+/// @brief Compute the arc lengths of a curve at uniformly spaced parameters.
+/// @param target Pointer to an array of <code>n * samples_per_segment + 1</code> idlib_f32 values, where n is the number of segments. Receives the arc lengths.
+/// @param operand Pointer to the idlib_curve_3_f32 object.
+/// @param samples_per_segment The number of intervals per segment. Must be positive.
+/// @remarks
+/// <code>target[j]</code> is the arc length of the curve from the parameter 0 to the parameter <code>j / samples_per_segment</code>.
+/// The length of each interval is computed by five point Gauss-Legendre quadrature of the length of the derivative.
+/// Four intervals of a segment are processed at once on SIMD capable architectures.
+/// The table maps arc lengths to parameters by idlib_arc_lengths_f32_get_parameters_n.
+void
+idlib_curve_3_f32_get_arc_lengths
+  (
+    idlib_f32* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_u32 samples_per_segment
+  );
+
+/// @since 1.5
+/// @brief Split a cubic Bezier curve by the de Casteljau algorithm.
+/// @param target1 Pointer to an array of four idlib_vector_3_f32 objects receiving the control points of the part of the curve from the parameter 0 to the parameter @a parameter.
+/// @param target2 Pointer to an array of four idlib_vector_3_f32 objects receiving the control points of the part of the curve from the parameter @a parameter to the parameter 1.
+/// @param operand Pointer to an array of four idlib_vector_3_f32 objects, the control points of the curve.
+/// @param parameter The parameter at which the curve is split. Should be within [0, 1].
+/// @remarks @a target1 and @a target2 must not overlap. Either may be @a operand.
+void
+idlib_bezier_3_f32_split
+  (
+    idlib_vector_3_f32 target1[4],
+    idlib_vector_3_f32 target2[4],
+    idlib_vector_3_f32 const operand[4],
+    idlib_f32 parameter
+  );
+
+/// @since 1.5
+/// @brief A piecewise cubic curve with control points of type idlib_vector_2_f32.
+/// @remarks See idlib_curve_3_f32.
+typedef struct idlib_curve_2_f32 {
+  idlib_u32 kind;
+  idlib_vector_2_f32 const* control_points;
+  idlib_u32 number_of_control_points;
+} idlib_curve_2_f32;
+
+/// @since 1.5
+/// @brief Assign an idlib_curve_2_f32 object a curve.
+/// @remarks See idlib_curve_3_f32_set.
+void
+idlib_curve_2_f32_set
+  (
+    idlib_curve_2_f32* target,
+    idlib_u32 kind,
+    idlib_vector_2_f32 const* control_points,
+    idlib_u32 number_of_control_points
+  );
+
+/// @since 1.5
+/// @brief Get the number of segments of a curve.
+/// @remarks See idlib_curve_3_f32_get_number_of_segments.
+idlib_u32
+idlib_curve_2_f32_get_number_of_segments
+  (
+    idlib_curve_2_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Evaluate a curve.
+/// @remarks See idlib_curve_3_f32_evaluate.
+void
+idlib_curve_2_f32_evaluate
+  (
+    idlib_vector_2_f32* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 parameter
+  );
+
+/// @since 1.5
+/// @brief Evaluate a curve at many parameters.
+/// @remarks See idlib_curve_3_f32_evaluate_n.
+void
+idlib_curve_2_f32_evaluate_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate the derivative of a curve at many parameters.
+/// @remarks See idlib_curve_3_f32_evaluate_derivative_n.
+void
+idlib_curve_2_f32_evaluate_derivative_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate many curves, each at its own parameter.
+/// @remarks See idlib_curve_3_f32_evaluate_curves_n.
+void
+idlib_curve_2_f32_evaluate_curves_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Get the Bezier control points of a segment of a curve.
+/// @remarks See idlib_curve_3_f32_get_bezier.
+void
+idlib_curve_2_f32_get_bezier
+  (
+    idlib_vector_2_f32 target[4],
+    idlib_curve_2_f32 const* operand,
+    idlib_u32 segment
+  );
+
+/// @since 1.5
+/// @brief Compute the arc lengths of a curve at uniformly spaced parameters.
+/// @remarks See idlib_curve_3_f32_get_arc_lengths.
+void
+idlib_curve_2_f32_get_arc_lengths
+  (
+    idlib_f32* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_u32 samples_per_segment
+  );
+
+/// @since 1.5
+/// @brief Split a cubic Bezier curve by the de Casteljau algorithm.
+/// @remarks See idlib_bezier_3_f32_split.
+void
+idlib_bezier_2_f32_split
+  (
+    idlib_vector_2_f32 target1[4],
+    idlib_vector_2_f32 target2[4],
+    idlib_vector_2_f32 const operand[4],
+    idlib_f32 parameter
+  );
+
+/// @since 1.5
+/// @brief A piecewise cubic curve with control points of type idlib_vector_4_f32.
+/// @remarks See idlib_curve_3_f32.
+typedef struct idlib_curve_4_f32 {
+  idlib_u32 kind;
+  idlib_vector_4_f32 const* control_points;
+  idlib_u32 number_of_control_points;
+} idlib_curve_4_f32;
+
+/// @since 1.5
+/// @brief Assign an idlib_curve_4_f32 object a curve.
+/// @remarks See idlib_curve_3_f32_set.
+void
+idlib_curve_4_f32_set
+  (
+    idlib_curve_4_f32* target,
+    idlib_u32 kind,
+    idlib_vector_4_f32 const* control_points,
+    idlib_u32 number_of_control_points
+  );
+
+/// @since 1.5
+/// @brief Get the number of segments of a curve.
+/// @remarks See idlib_curve_3_f32_get_number_of_segments.
+idlib_u32
+idlib_curve_4_f32_get_number_of_segments
+  (
+    idlib_curve_4_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Evaluate a curve.
+/// @remarks See idlib_curve_3_f32_evaluate.
+void
+idlib_curve_4_f32_evaluate
+  (
+    idlib_vector_4_f32* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 parameter
+  );
+
+/// @since 1.5
+/// @brief Evaluate a curve at many parameters.
+/// @remarks See idlib_curve_3_f32_evaluate_n.
+void
+idlib_curve_4_f32_evaluate_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate the derivative of a curve at many parameters.
+/// @remarks See idlib_curve_3_f32_evaluate_derivative_n.
+void
+idlib_curve_4_f32_evaluate_derivative_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate many curves, each at its own parameter.
+/// @remarks See idlib_curve_3_f32_evaluate_curves_n.
+void
+idlib_curve_4_f32_evaluate_curves_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Get the Bezier control points of a segment of a curve.
+/// @remarks See idlib_curve_3_f32_get_bezier.
+void
+idlib_curve_4_f32_get_bezier
+  (
+    idlib_vector_4_f32 target[4],
+    idlib_curve_4_f32 const* operand,
+    idlib_u32 segment
+  );
+
+/// @since 1.5
+/// @brief Compute the arc lengths of a curve at uniformly spaced parameters.
+/// @remarks See idlib_curve_3_f32_get_arc_lengths.
+void
+idlib_curve_4_f32_get_arc_lengths
+  (
+    idlib_f32* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_u32 samples_per_segment
+  );
+
+/// @since 1.5
+/// @brief Split a cubic Bezier curve by the de Casteljau algorithm.
+/// @remarks See idlib_bezier_3_f32_split.
+void
+idlib_bezier_4_f32_split
+  (
+    idlib_vector_4_f32 target1[4],
+    idlib_vector_4_f32 target2[4],
+    idlib_vector_4_f32 const operand[4],
+    idlib_f32 parameter
+  );
+
+/// @since 1.5
+/// @brief Map arc lengths to parameters of a curve.
+/// @param target Pointer to an array of @a count idlib_f32 values receiving the parameters.
+/// @param arc_lengths Pointer to the array of @a number_of_arc_lengths arc lengths computed by idlib_curve_3_f32_get_arc_lengths (or its 2 and 4 component variants).
+/// @param number_of_arc_lengths The number of arc lengths. Must be at least two.
+/// @param samples_per_segment The number of intervals per segment the arc lengths were computed with.
+/// @param operand Pointer to an array of @a count arc lengths. Arc lengths outside of [0, l], where l is the length of the curve, are clamped.
+/// @param count The number of arc lengths.
+/// @remarks
+/// The interval containing an arc length is found by binary search and the parameter is interpolated linearly within the interval.
+/// Evaluating a curve at parameters of equally spaced arc lengths yields equally spaced points along the curve (constant speed).
+/// Four arc lengths are mapped at once on SIMD capable architectures.
+void
+idlib_arc_lengths_f32_get_parameters_n
+  (
+    idlib_f32* target,
+    idlib_f32 const* arc_lengths,
+    idlib_u32 number_of_arc_lengths,
+    idlib_u32 samples_per_segment,
+    idlib_f32 const* operand,
+    size_t count
+  );
+
+#endif // IDLIB_CURVE_H_INCLUDED
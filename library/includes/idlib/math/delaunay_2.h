@@ -0,0 +1,129 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(IDLIB_DELAUNAY_2_H_INCLUDED)
+#define IDLIB_DELAUNAY_2_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting "no triangle" resp. "no vertex".
+#define IDLIB_TRIANGULATION_2_NONE (0xFFFFFFFFu)
+
+/// @since 1.5
+/// @brief A triangulation of a set of points in the plane in "triangle adjacency" representation.
+/// @remarks
+/// The i-th triangle consists of the vertices <code>vertices[3 * i + k]</code>, k = 0, 1, 2, in counterclockwise order.
+/// The vertices are indices into the array of points the triangulation was computed from.
+///
+/// <code>neighbors[3 * i + k]</code> is the index of the triangle sharing the edge opposite to vertex k of the i-th triangle,
+/// that is the edge from <code>vertices[3 * i + (k + 1) % 3]</code> to <code>vertices[3 * i + (k + 2) % 3]</code>.
+/// It is IDLIB_TRIANGULATION_2_NONE if that edge is on the convex hull.
+///
+/// Bit k of <code>constraints[i]</code> is set if the edge opposite to vertex k of the i-th triangle is a constrained edge.
+///
+/// The arrays are provided by the caller and must provide space for @a capacity triangles.
+/// The capacity required to triangulate n points is returned by idlib_delaunay_2_f32_get_capacity.
+/// A larger capacity is permitted; the triangulation does not use the additional space and the size of the workspace does not depend on it.
+typedef struct idlib_triangulation_2 {
+  idlib_u32* vertices;
+  idlib_u32* neighbors;
+  idlib_u8* constraints;
+  idlib_u32 number_of_triangles;
+  idlib_u32 capacity;
+} idlib_triangulation_2;
+
+/// @since 1.5
+/// @brief Get the number of triangles an idlib_triangulation_2 object must provide space for.
+/// @param number_of_points The number of points.
+/// @return The capacity, in triangles.
+idlib_u32
+idlib_delaunay_2_f32_get_capacity
+  (
+    idlib_u32 number_of_points
+  );
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by idlib_delaunay_2_f32_triangulate and idlib_delaunay_2_f32_insert_constraints.
+/// @param number_of_points The number of points.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 8 Bytes.
+size_t
+idlib_delaunay_2_f32_get_workspace_size
+  (
+    idlib_u32 number_of_points
+  );
+
+/// @since 1.5
+/// @brief Compute the Delaunay triangulation of a set of points.
+/// @param target Pointer to the idlib_triangulation_2 object receiving the triangulation.
+/// @param points Pointer to an array of @a number_of_points idlib_vector_2_f32 objects.
+/// @param number_of_points The number of points.
+/// @param workspace Pointer to a workspace of idlib_delaunay_2_f32_get_workspace_size(number_of_points) Bytes.
+/// @return @a true on success.
+/// @a false if the points are all collinear (or fewer than three distinct points are given) or the capacity of @a target is insufficient.
+/// @remarks
+/// The points are inserted in "biased randomized insertion order" (BRIO):
+/// They are distributed into rounds of geometrically increasing size, and within each round ordered along a Hilbert curve.
+/// Each point is located by walking from the previously inserted point and inserted by the Bowyer-Watson algorithm.
+/// The hull is represented by "ghost triangles" sharing a vertex at infinity such that no bounding triangle is required.
+/// All decisions are made by the robust predicates idlib_orient_2_f32 and idlib_in_circle_2_f32.
+///
+/// Duplicate points are not part of the triangulation; only one of the coinciding points is referenced.
+///
+/// Cocircular points are triangulated arbitrarily but consistently.
+bool
+idlib_delaunay_2_f32_triangulate
+  (
+    idlib_triangulation_2* target,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 number_of_points,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Insert constrained edges into a triangulation computed by idlib_delaunay_2_f32_triangulate.
+/// @param target Pointer to the idlib_triangulation_2 object.
+/// @param points Pointer to the array of @a number_of_points idlib_vector_2_f32 objects @a target was computed from.
+/// @param number_of_points The number of points.
+/// @param edges Pointer to an array of <code>2 * number_of_edges</code> vertex indices. The i-th edge is <code>(edges[2 * i], edges[2 * i + 1])</code>.
+/// @param number_of_edges The number of edges.
+/// @param workspace Pointer to a workspace of idlib_delaunay_2_f32_get_workspace_size(number_of_points) Bytes.
+/// @return @a true on success.
+/// @a false if an edge references a vertex which is not part of the triangulation or if an edge crosses a previously inserted constrained edge.
+/// In that case the edges preceding the offending edge have been inserted.
+/// @remarks
+/// The result is the constrained Delaunay triangulation.
+/// Edges intersecting a constrained edge are removed by flipping (Sloan's algorithm) and the Delaunay property is then restored by flipping the new edges.
+/// An edge passing through a vertex is split at that vertex.
+bool
+idlib_delaunay_2_f32_insert_constraints
+  (
+    idlib_triangulation_2* target,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 number_of_points,
+    idlib_u32 const* edges,
+    idlib_u32 number_of_edges,
+    void* workspace
+  );
+
+#endif // IDLIB_DELAUNAY_2_H_INCLUDED
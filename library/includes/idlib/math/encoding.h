@@ -0,0 +1,415 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_ENCODING_H_INCLUDED)
+#define IDLIB_ENCODING_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "vector_4.h"
+
+/// @since 1.5
+/// @brief Encode a unit vector in octahedral representation.
+/// @param operand Pointer to the idlib_vector_3_f32 object, a unit vector.
+/// @param bits The number of bits per component of the encoding: 8, 12, or 16 (for encodings of 16, 24, or 32 bits).
+/// @return The encoding. The first component is stored in the lower @a bits bits, the second component in the following @a bits bits.
+/// @remarks
+/// The unit sphere is projected onto the octahedron |x| + |y| + |z| = 1, the lower half of the octahedron is folded over the upper half,
+/// and the resulting square [-1,+1]^2 is quantized with @a bits bits per component (as signed normalized integers).
+/// The maximum angular errors of an encoded and decoded unit vector are approximately
+/// 0.96 degrees for 8 bits, 0.059 degrees for 12 bits, and 0.0037 degrees for 16 bits.
+idlib_u32
+idlib_octahedral_encode_f32
+  (
+    idlib_vector_3_f32 const* operand,
+    idlib_u32 bits
+  );
+
+/// @since 1.5
+/// @brief Decode a unit vector in octahedral representation.
+/// @param target Pointer to the idlib_vector_3_f32 object receiving the unit vector.
+/// @param operand The encoding as computed by idlib_octahedral_encode_f32.
+/// @param bits The number of bits per component of the encoding.
+void
+idlib_octahedral_decode_f32
+  (
+    idlib_vector_3_f32* target,
+    idlib_u32 operand,
+    idlib_u32 bits
+  );
+
+/// @since 1.5
+/// @brief Encode the unit vectors <code>[first, first + count)</code> of a stream in octahedral representation.
+/// @param target Pointer to an array receiving, at index i, the encoding of the i-th vector.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of unit vectors.
+/// @param bits The number of bits per component of the encoding.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// The result is the same as that of idlib_octahedral_encode_f32.
+/// Four vectors are encoded at once on SIMD capable architectures.
+void
+idlib_octahedral_encode_f32_n
+  (
+    idlib_u32* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 bits,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Decode the unit vectors <code>[first, first + count)</code> of a stream in octahedral representation.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the unit vectors.
+/// @param operand Pointer to an array of encodings as computed by idlib_octahedral_encode_f32.
+/// @param bits The number of bits per component of the encoding.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// The result is the same as that of idlib_octahedral_decode_f32.
+/// Four vectors are decoded at once on SIMD capable architectures.
+void
+idlib_octahedral_decode_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u32 const* operand,
+    idlib_u32 bits,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Encode a vector as unsigned normalized 16 bit integers relative to an axis-aligned bounding box.
+/// @param target Pointer to an array of three elements receiving the encoding.
+/// @param operand Pointer to the idlib_vector_3_f32 object.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_encode_unorm16_n.
+void
+idlib_vector_3_f32_encode_unorm16
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Decode a vector encoded by idlib_vector_3_f32_encode_unorm16.
+/// @param target Pointer to the idlib_vector_3_f32 object receiving the vector.
+/// @param operand Pointer to an array of three elements, the encoding.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_decode_unorm16_n.
+void
+idlib_vector_3_f32_decode_unorm16
+  (
+    idlib_vector_3_f32* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Encode a vector as unsigned normalized 8 bit integers relative to an axis-aligned bounding box.
+/// @param target Pointer to an array of three elements receiving the encoding.
+/// @param operand Pointer to the idlib_vector_3_f32 object.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_encode_unorm8_n.
+void
+idlib_vector_3_f32_encode_unorm8
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Decode a vector encoded by idlib_vector_3_f32_encode_unorm8.
+/// @param target Pointer to the idlib_vector_3_f32 object receiving the vector.
+/// @param operand Pointer to an array of three elements, the encoding.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_decode_unorm8_n.
+void
+idlib_vector_3_f32_decode_unorm8
+  (
+    idlib_vector_3_f32* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Encode a vector as signed normalized 16 bit integers relative to an axis-aligned bounding box.
+/// @param target Pointer to an array of three elements receiving the encoding.
+/// @param operand Pointer to the idlib_vector_3_f32 object.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_encode_snorm16_n.
+void
+idlib_vector_3_f32_encode_snorm16
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Decode a vector encoded by idlib_vector_3_f32_encode_snorm16.
+/// @param target Pointer to the idlib_vector_3_f32 object receiving the vector.
+/// @param operand Pointer to an array of three elements, the encoding.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_decode_snorm16_n.
+void
+idlib_vector_3_f32_decode_snorm16
+  (
+    idlib_vector_3_f32* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Encode a vector as signed normalized 8 bit integers relative to an axis-aligned bounding box.
+/// @param target Pointer to an array of three elements receiving the encoding.
+/// @param operand Pointer to the idlib_vector_3_f32 object.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_encode_snorm8_n.
+void
+idlib_vector_3_f32_encode_snorm8
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Decode a vector encoded by idlib_vector_3_f32_encode_snorm8.
+/// @param target Pointer to the idlib_vector_3_f32 object receiving the vector.
+/// @param operand Pointer to an array of three elements, the encoding.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @remarks The result is the same as that of idlib_vector_3_f32_decode_snorm8_n.
+void
+idlib_vector_3_f32_decode_snorm8
+  (
+    idlib_vector_3_f32* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  );
+
+/// @since 1.5
+/// @brief Encode the vectors <code>[first, first + count)</code> of a stream as unsigned normalized 16 bit integers relative to an axis-aligned bounding box.
+/// @param target Pointer to an array receiving, at indices 3 * i + k, k = 0, 1, 2, the encoding of the i-th vector.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of vectors.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// The k-th component x is mapped to <code>round((x - minimum[k]) / (maximum[k] - minimum[k]) * 65535)</code>, clamped to [0, 65535].
+/// The maximum error of an encoded and decoded component is half a quantization step, that is <code>(maximum[k] - minimum[k]) / 131070</code>,
+/// up to the rounding error of idlib_f32 arithmetic.
+/// Components outside of the box are clamped to the box.
+/// Four vectors are encoded at once on SIMD capable architectures.
+void
+idlib_vector_3_f32_encode_unorm16_n
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Decode vectors encoded by idlib_vector_3_f32_encode_unorm16_n.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the vectors <code>[first, first + count)</code>.
+/// @param operand Pointer to the array of encodings.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks Four vectors are decoded at once on SIMD capable architectures.
+void
+idlib_vector_3_f32_decode_unorm16_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Encode the vectors <code>[first, first + count)</code> of a stream as unsigned normalized 8 bit integers relative to an axis-aligned bounding box.
+/// @remarks
+/// See idlib_vector_3_f32_encode_unorm16_n.
+/// The maximum error of an encoded and decoded component is <code>(maximum[k] - minimum[k]) / 510</code>.
+void
+idlib_vector_3_f32_encode_unorm8_n
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Decode vectors encoded by idlib_vector_3_f32_encode_unorm8_n.
+/// @remarks See idlib_vector_3_f32_decode_unorm16_n.
+void
+idlib_vector_3_f32_decode_unorm8_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Encode the vectors <code>[first, first + count)</code> of a stream as signed normalized 16 bit integers relative to an axis-aligned bounding box.
+/// @param target Pointer to an array receiving, at indices 3 * i + k, k = 0, 1, 2, the encoding of the i-th vector.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of vectors.
+/// @param minimum, maximum Pointers to the idlib_vector_3_f32 objects, the minimum and the maximum of the box.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// The k-th component x is mapped to <code>round((x - c[k]) / e[k] * 32767)</code>, clamped to [-32767, +32767],
+/// where c is the center and e is the half extent of the box. The center of the box is represented exactly.
+/// The maximum error of an encoded and decoded component is half a quantization step, that is <code>(maximum[k] - minimum[k]) / 131068</code>.
+/// Four vectors are encoded at once on SIMD capable architectures.
+void
+idlib_vector_3_f32_encode_snorm16_n
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Decode vectors encoded by idlib_vector_3_f32_encode_snorm16_n.
+/// @remarks See idlib_vector_3_f32_decode_unorm16_n.
+void
+idlib_vector_3_f32_decode_snorm16_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Encode the vectors <code>[first, first + count)</code> of a stream as signed normalized 8 bit integers relative to an axis-aligned bounding box.
+/// @remarks
+/// See idlib_vector_3_f32_encode_snorm16_n.
+/// The maximum error of an encoded and decoded component is <code>(maximum[k] - minimum[k]) / 508</code>.
+void
+idlib_vector_3_f32_encode_snorm8_n
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Decode vectors encoded by idlib_vector_3_f32_encode_snorm8_n.
+/// @remarks See idlib_vector_3_f32_decode_unorm16_n.
+void
+idlib_vector_3_f32_decode_snorm8_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Pack a four component vector into 32 bits with 10 bits for each of the first three components and 2 bits for the fourth component.
+/// @param operand Pointer to the idlib_vector_4_f32 object. Its components are expected to be in [0,1] and are clamped to [0,1], NaN is mapped to 0.
+/// @return The packed vector. The first component is stored in the lowest 10 bits, the fourth component in the highest 2 bits.
+/// @remarks
+/// The maximum error of a packed and unpacked component is 1/2046 for the first three components and 1/6 for the fourth component.
+/// To pack a unit vector, pack <code>(n + 1) / 2</code>; the maximum angular error is then approximately 0.1 degrees.
+idlib_u32
+idlib_vector_4_f32_pack_rgb10a2
+  (
+    idlib_vector_4_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Unpack a four component vector packed by idlib_vector_4_f32_pack_rgb10a2.
+/// @param target Pointer to the idlib_vector_4_f32 object receiving the vector.
+/// @param operand The packed vector.
+void
+idlib_vector_4_f32_unpack_rgb10a2
+  (
+    idlib_vector_4_f32* target,
+    idlib_u32 operand
+  );
+
+/// @since 1.5
+/// @brief Pack the vectors <code>[first, first + count)</code> of a stream by idlib_vector_4_f32_pack_rgb10a2.
+/// @param target Pointer to an array receiving, at index i, the packed i-th vector.
+/// @param operand Pointer to the idlib_vector_4_f32_soa object describing the stream of vectors.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks Four vectors are packed at once on SIMD capable architectures.
+void
+idlib_vector_4_f32_pack_rgb10a2_n
+  (
+    idlib_u32* target,
+    idlib_vector_4_f32_soa const* operand,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Unpack the vectors <code>[first, first + count)</code> of a stream by idlib_vector_4_f32_unpack_rgb10a2.
+/// @param target Pointer to the idlib_vector_4_f32_soa object describing the stream receiving the vectors.
+/// @param operand Pointer to an array of packed vectors.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+void
+idlib_vector_4_f32_unpack_rgb10a2_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_u32 const* operand,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_ENCODING_H_INCLUDED
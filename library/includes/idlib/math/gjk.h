@@ -0,0 +1,230 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_GJK_H_INCLUDED)
+#define IDLIB_GJK_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "matrix_3x3.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a sphere.
+#define IDLIB_CONVEX_SHAPE_SPHERE (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a box.
+#define IDLIB_CONVEX_SHAPE_BOX (1)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a capsule.
+#define IDLIB_CONVEX_SHAPE_CAPSULE (2)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the convex hull of a set of points.
+#define IDLIB_CONVEX_SHAPE_HULL (3)
+
+/// @since 1.5
+/// @brief A convex shape given by its support function.
+/// @remarks
+/// A shape is a "core" shape in its local coordinate system, transformed by @a rotation and translated by @a center,
+/// and extended by @a radius (that is, the set of points at a distance of at most @a radius from the core shape):
+/// - A sphere is a point extended by its radius.
+/// - A box is the box with the half extents @a extents.
+/// - A capsule is the segment from <code>(0, -extents[1], 0)</code> to <code>(0, extents[1], 0)</code> extended by its radius.
+/// - A hull is the convex hull of the @a number_of_points points @a points. The points are not copied.
+///
+/// Use the idlib_convex_shape_3_f32_set_* functions to assign the shapes.
+typedef struct idlib_convex_shape_3_f32 {
+  idlib_u32 kind;
+  idlib_vector_3_f32 center;
+  idlib_matrix_3x3_f32 rotation;
+  idlib_vector_3_f32 extents;
+  idlib_f32 radius;
+  idlib_vector_3_f32 const* points;
+  idlib_u32 number_of_points;
+} idlib_convex_shape_3_f32;
+
+/// @since 1.5
+/// @brief The simplex of a GJK query retained for warm starting the next query on the same pair of shapes.
+/// @remarks
+/// The vertices of the simplex are stored as pairs of points on the core shapes in their local coordinate systems.
+/// As these points remain points of the shapes if the shapes move, the next query starts with the simplex of the previous query
+/// and terminates after few iterations if the shapes moved little.
+/// A cache must be initialized by idlib_gjk_cache_3_f32_initialize before its first use.
+typedef struct idlib_gjk_cache_3_f32 {
+  idlib_vector_3_f32 points1[4];
+  idlib_vector_3_f32 points2[4];
+  idlib_u32 count;
+} idlib_gjk_cache_3_f32;
+
+/// @since 1.5
+/// @brief The result of idlib_gjk_3_f32_distance.
+typedef struct idlib_gjk_result_3_f32 {
+  /// @brief The distance of the shapes if they are separated, the negated penetration depth if they intersect.
+  idlib_f32 distance;
+  /// @brief The unit normal from the first shape to the second shape.
+  /// If the shapes are separated, it is the direction from @a point1 to @a point2.
+  /// If they intersect, the second shape must be translated by <code>-distance * normal</code> to separate the shapes.
+  idlib_vector_3_f32 normal;
+  /// @brief The witness points on the first and second shape.
+  /// If the shapes are separated, then these are the closest points.
+  /// If they intersect, then these are the points of the shapes deepest inside the other shape.
+  idlib_vector_3_f32 point1;
+  idlib_vector_3_f32 point2;
+  /// @brief The number of iterations of the GJK and EPA algorithms.
+  idlib_u32 iterations;
+} idlib_gjk_result_3_f32;
+
+/// @since 1.5
+/// @brief Assign an idlib_convex_shape_3_f32 object a sphere.
+/// @param target Pointer to the idlib_convex_shape_3_f32 object.
+/// @param center Pointer to the idlib_vector_3_f32 object denoting the center.
+/// @param radius The radius. Must not be negative.
+void
+idlib_convex_shape_3_f32_set_sphere
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_f32 radius
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_convex_shape_3_f32 object a box.
+/// @param target Pointer to the idlib_convex_shape_3_f32 object.
+/// @param center Pointer to the idlib_vector_3_f32 object denoting the center.
+/// @param rotation Pointer to the idlib_matrix_3x3_f32 object denoting the rotation. Its columns are the axes of the box.
+/// @param extents Pointer to the idlib_vector_3_f32 object denoting the half extents. Must not be negative.
+void
+idlib_convex_shape_3_f32_set_box
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_matrix_3x3_f32 const* rotation,
+    idlib_vector_3_f32 const* extents
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_convex_shape_3_f32 object a capsule.
+/// @param target Pointer to the idlib_convex_shape_3_f32 object.
+/// @param center Pointer to the idlib_vector_3_f32 object denoting the center.
+/// @param rotation Pointer to the idlib_matrix_3x3_f32 object denoting the rotation. Its second column is the axis of the capsule.
+/// @param half_height Half the length of the segment of the capsule. Must not be negative.
+/// @param radius The radius. Must not be negative.
+void
+idlib_convex_shape_3_f32_set_capsule
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_matrix_3x3_f32 const* rotation,
+    idlib_f32 half_height,
+    idlib_f32 radius
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_convex_shape_3_f32 object the convex hull of a set of points.
+/// @param target Pointer to the idlib_convex_shape_3_f32 object.
+/// @param center Pointer to the idlib_vector_3_f32 object denoting the translation.
+/// @param rotation Pointer to the idlib_matrix_3x3_f32 object denoting the rotation.
+/// @param points Pointer to an array of @a number_of_points idlib_vector_3_f32 objects denoting the points in the local coordinate system.
+/// The array must remain valid as long as @a target is used. The points need not be the vertices of their convex hull (but queries are faster if they are).
+/// @param number_of_points The number of points. Must be positive.
+void
+idlib_convex_shape_3_f32_set_hull
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_matrix_3x3_f32 const* rotation,
+    idlib_vector_3_f32 const* points,
+    idlib_u32 number_of_points
+  );
+
+/// @since 1.5
+/// @brief Evaluate the support function of a shape.
+/// @param target Pointer to the idlib_vector_3_f32 object receiving the point of the shape farthest in the direction.
+/// @param operand Pointer to the idlib_convex_shape_3_f32 object.
+/// @param direction Pointer to the idlib_vector_3_f32 object denoting the direction. Need not be normalized.
+/// If it is the zero vector, then a point of the core shape is returned.
+void
+idlib_convex_shape_3_f32_support
+  (
+    idlib_vector_3_f32* target,
+    idlib_convex_shape_3_f32 const* operand,
+    idlib_vector_3_f32 const* direction
+  );
+
+/// @since 1.5
+/// @brief Initialize an idlib_gjk_cache_3_f32 object.
+/// @param target Pointer to the idlib_gjk_cache_3_f32 object.
+/// @remarks The cache is empty: The next query using it starts from scratch.
+void
+idlib_gjk_cache_3_f32_initialize
+  (
+    idlib_gjk_cache_3_f32* target
+  );
+
+/// @since 1.5
+/// @brief Get if two convex shapes intersect.
+/// @param cache Pointer to the idlib_gjk_cache_3_f32 object of the pair of shapes or a null pointer.
+/// @param operand1, operand2 Pointers to the idlib_convex_shape_3_f32 objects.
+/// @return @a true if the shapes intersect or touch, @a false otherwise.
+/// @remarks
+/// The GJK algorithm is run on the core shapes.
+/// It terminates as soon as a direction is found along which the core shapes are separated by more than the sum of the radii,
+/// or as soon as the core shapes are known to be no farther apart than the sum of the radii.
+/// See idlib_gjk_3_f32_distance for the use of the cache.
+bool
+idlib_gjk_3_f32_intersect
+  (
+    idlib_gjk_cache_3_f32* cache,
+    idlib_convex_shape_3_f32 const* operand1,
+    idlib_convex_shape_3_f32 const* operand2
+  );
+
+/// @since 1.5
+/// @brief Compute the distance or the penetration depth of two convex shapes.
+/// @param target Pointer to the idlib_gjk_result_3_f32 object receiving the result.
+/// @param cache Pointer to the idlib_gjk_cache_3_f32 object of the pair of shapes or a null pointer.
+/// @param operand1, operand2 Pointers to the idlib_convex_shape_3_f32 objects.
+/// @remarks
+/// The GJK algorithm computes the distance of the core shapes.
+/// If the core shapes are separated, the distance of the shapes is the distance of the core shapes minus the sum of the radii.
+/// Otherwise the EPA algorithm computes the penetration depth of the core shapes and the sum of the radii is added.
+/// The penetration depth of core shapes with no volume (like two segments) is zero along the normal of their plane.
+///
+/// The functions use no memory but a few kilobytes of stack.
+///
+/// If @a cache is not a null pointer, then GJK starts with the simplex of the previous query using this cache
+/// and the final simplex is stored in the cache.
+/// If the shapes moved little since the previous query, then the query terminates after one or two iterations.
+/// A cache must only be used for the same pair of shapes (in the same order).
+/// The shapes may move and rotate, however, their kinds, extents, and points must not change.
+void
+idlib_gjk_3_f32_distance
+  (
+    idlib_gjk_result_3_f32* target,
+    idlib_gjk_cache_3_f32* cache,
+    idlib_convex_shape_3_f32 const* operand1,
+    idlib_convex_shape_3_f32 const* operand2
+  );
+
+#endif // IDLIB_GJK_H_INCLUDED
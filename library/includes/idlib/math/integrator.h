@@ -0,0 +1,193 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#if !defined(IDLIB_INTEGRATOR_H_INCLUDED)
+#define IDLIB_INTEGRATOR_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "aabb.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the explicit Euler method.
+/// @remarks The position is advanced by the velocity, then the velocity is advanced by the acceleration, both at the beginning of the step.
+#define IDLIB_INTEGRATOR_EXPLICIT_EULER (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the symplectic (semi-implicit) Euler method.
+/// @remarks The velocity is advanced by the acceleration, then the position is advanced by the new velocity.
+/// Unlike the explicit Euler method, it does not gain energy over time.
+#define IDLIB_INTEGRATOR_SYMPLECTIC_EULER (1)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the (position) Verlet method.
+/// @remarks The new position is computed from the current and the previous position and the acceleration.
+/// The velocity is not integrated but derived from the positions.
+#define IDLIB_INTEGRATOR_VERLET (2)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the classical fourth order Runge-Kutta method.
+/// @remarks
+/// The method evaluates the accelerations at four intermediate states (stages) of a step.
+/// It is hence not supported by idlib_integrator_f32_step_n, which takes the accelerations at the beginning of the step.
+/// Instead, a step consists of IDLIB_INTEGRATOR_RUNGE_KUTTA_4_STAGES calls of idlib_integrator_f32_runge_kutta_4_stage_n
+/// between which the caller evaluates the accelerations at the positions and velocities of the stages.
+#define IDLIB_INTEGRATOR_RUNGE_KUTTA_4 (3)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the number of stages of a step of IDLIB_INTEGRATOR_RUNGE_KUTTA_4.
+#define IDLIB_INTEGRATOR_RUNGE_KUTTA_4_STAGES (4)
+
+/// @since 1.5
+/// @brief The streams of a particle system.
+/// @remarks
+/// The i-th particle has the position <code>(positions.x[i], positions.y[i], positions.z[i])</code> and so on.
+///
+/// The streams @a accelerations and @a previous_positions are optional.
+/// A stream is absent if its member @a x is a null pointer.
+typedef struct idlib_particles_3_f32 {
+  /// @brief The positions.
+  idlib_vector_3_f32_soa positions;
+  /// @brief The velocities.
+  /// For IDLIB_INTEGRATOR_VERLET, the velocities are only written and may be absent.
+  idlib_vector_3_f32_soa velocities;
+  /// @brief The previous positions. Required for and only used by IDLIB_INTEGRATOR_VERLET.
+  idlib_vector_3_f32_soa previous_positions;
+  /// @brief The accelerations, in addition to the gravity, constant over the step respectively the stage.
+  idlib_vector_3_f32_soa accelerations;
+} idlib_particles_3_f32;
+
+/// @since 1.5
+/// @brief An integrator of particle systems.
+/// @remarks
+/// The acceleration of the i-th particle is <code>a + g - damping * v</code>
+/// where a is its acceleration, g is the gravity, and v is its velocity.
+/// The explicit methods are stable if <code>damping * time_step</code> is smaller than one.
+///
+/// If @a clamp is true, the positions are clamped to @a bounds after each step.
+/// The components of the velocities of the particles clamped in these components are set to zero.
+typedef struct idlib_integrator_f32 {
+  /// @brief The method: IDLIB_INTEGRATOR_EXPLICIT_EULER, IDLIB_INTEGRATOR_SYMPLECTIC_EULER, IDLIB_INTEGRATOR_VERLET, or IDLIB_INTEGRATOR_RUNGE_KUTTA_4.
+  idlib_u32 method;
+  /// @brief The coefficient of the linear damping, per second. Must be non-negative.
+  idlib_f32 damping;
+  /// @brief The gravity.
+  idlib_vector_3_f32 gravity;
+  /// @brief If the positions are clamped to @a bounds.
+  bool clamp;
+  /// @brief The bounds.
+  idlib_aabb_3_f32 bounds;
+} idlib_integrator_f32;
+
+/// @since 1.5
+/// @brief Assign an idlib_integrator_f32 object a method without damping, gravity, and clamping.
+/// @param target Pointer to the idlib_integrator_f32 object.
+/// @param method The method: IDLIB_INTEGRATOR_EXPLICIT_EULER, IDLIB_INTEGRATOR_SYMPLECTIC_EULER, IDLIB_INTEGRATOR_VERLET, or IDLIB_INTEGRATOR_RUNGE_KUTTA_4.
+/// @remarks To obtain damping, gravity, or clamping, assign the respective members afterwards.
+void
+idlib_integrator_f32_set
+  (
+    idlib_integrator_f32* target,
+    idlib_u32 method
+  );
+
+/// @since 1.5
+/// @brief Advance the particles <code>[first, first + count)</code> of a particle system by one step.
+/// @param target Pointer to the idlib_particles_3_f32 object describing the streams of the particle system.
+/// @param integrator Pointer to the idlib_integrator_f32 object.
+/// @param time_step The time step, in seconds. Must be positive.
+/// @param first The index of the first particle.
+/// @param count The number of particles.
+/// @remarks
+/// The method of @a integrator must not be IDLIB_INTEGRATOR_RUNGE_KUTTA_4 (see idlib_integrator_f32_runge_kutta_4_stage_n).
+///
+/// The streams are read and written in a single pass, four particles at once on SIMD capable architectures.
+/// The particles are independent of each other such that ranges of particles can be advanced by different threads.
+///
+/// For IDLIB_INTEGRATOR_VERLET, the previous positions receive the current positions
+/// and the velocities (if present) receive the displacements divided by the time step.
+/// To start a Verlet integration from positions p and velocities v, initialize the previous positions to <code>p - time_step * v</code>.
+void
+idlib_integrator_f32_step_n
+  (
+    idlib_particles_3_f32 const* target,
+    idlib_integrator_f32 const* integrator,
+    idlib_f32 time_step,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief The scratch streams of a particle system integrated by IDLIB_INTEGRATOR_RUNGE_KUTTA_4.
+/// @remarks The i-th element of each stream belongs to the i-th particle.
+typedef struct idlib_runge_kutta_4_stages_3_f32 {
+  /// @brief The positions of the next stage, at which the caller evaluates the accelerations.
+  idlib_vector_3_f32_soa positions;
+  /// @brief The velocities of the next stage, at which the caller evaluates velocity-dependent accelerations.
+  idlib_vector_3_f32_soa velocities;
+  /// @brief The weighted sums of the derivatives of the positions of the previous stages.
+  idlib_vector_3_f32_soa position_derivatives;
+  /// @brief The weighted sums of the derivatives of the velocities of the previous stages.
+  idlib_vector_3_f32_soa velocity_derivatives;
+} idlib_runge_kutta_4_stages_3_f32;
+
+/// @since 1.5
+/// @brief Compute a stage of a step of the particles <code>[first, first + count)</code> of a particle system by the classical fourth order Runge-Kutta method.
+/// @param target Pointer to the idlib_particles_3_f32 object describing the streams of the particle system.
+/// The accelerations are those at the positions and velocities of the stage.
+/// @param stages Pointer to the idlib_runge_kutta_4_stages_3_f32 object describing the scratch streams.
+/// @param integrator Pointer to the idlib_integrator_f32 object. Its method must be IDLIB_INTEGRATOR_RUNGE_KUTTA_4.
+/// @param time_step The time step, in seconds. Must be positive and the same for all stages of a step.
+/// @param stage The index of the stage. Must be smaller than IDLIB_INTEGRATOR_RUNGE_KUTTA_4_STAGES.
+/// @param first The index of the first particle.
+/// @param count The number of particles.
+/// @remarks
+/// A step of size h from the positions x and velocities v consists of the stages 0, 1, 2, and 3.
+/// Before each stage, the caller assigns the accelerations of @a target:
+/// For the stage 0, the accelerations at the positions and velocities of @a target,
+/// for the other stages, the accelerations at the positions and velocities of @a stages.
+/// The i-th stage computes the derivatives ki of the positions and ki' of the velocities from these accelerations.
+/// The stages 0 and 1 assign @a stages the positions <code>x + h/2 ki</code> and velocities <code>v + h/2 ki'</code>,
+/// the stage 2 the positions <code>x + h k2</code> and velocities <code>v + h k2'</code>.
+/// The stage 3 assigns @a target the positions <code>x + h/6 (k0 + 2 k1 + 2 k2 + k3)</code> and likewise the velocities.
+/// The positions and velocities of @a target are not modified before the last stage.
+/// The damping and the gravity of @a integrator are applied at every stage, the clamping only to the result of the last stage.
+/// The method is of fourth order for accelerations depending on the positions and velocities, e.g., of springs, force fields, or drag.
+///
+/// An invocation reads and writes the elements of the range of the streams of @a target and @a stages,
+/// four particles at once on SIMD capable architectures (see the section on ranges in idlib-math.md).
+/// If the acceleration of a particle depends on the stages of other particles (e.g., springs between particles),
+/// all ranges must have completed a stage before the accelerations of the next stage are evaluated.
+void
+idlib_integrator_f32_runge_kutta_4_stage_n
+  (
+    idlib_particles_3_f32 const* target,
+    idlib_runge_kutta_4_stages_3_f32 const* stages,
+    idlib_integrator_f32 const* integrator,
+    idlib_f32 time_step,
+    idlib_u32 stage,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_INTEGRATOR_H_INCLUDED
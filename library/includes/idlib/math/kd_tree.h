@@ -0,0 +1,360 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_KD_TREE_H_INCLUDED)
+#define IDLIB_KD_TREE_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+#include "vector_3.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting "no point".
+#define IDLIB_KD_TREE_NONE (0xFFFFFFFFu)
+
+/// @since 1.5
+/// @brief The maximum number of points of a leaf of an idlib_kd_tree object.
+#define IDLIB_KD_TREE_LEAF_SIZE (8)
+
+/// @since 1.5
+/// @brief A static k-d tree over a set of points in two or three dimensions in implicit layout.
+/// @remarks
+/// The tree has no pointers. Its nodes are ranges of positions: The root is the range <code>[0, number_of_points)</code>.
+/// A range <code>[first, last)</code> with more than IDLIB_KD_TREE_LEAF_SIZE points is split at its median position
+/// <code>m = first + (last - first) / 2</code> into the ranges <code>[first, m)</code> and <code>[m + 1, last)</code>.
+/// The point at the position m is the splitting point and <code>dimensions[m]</code> is the splitting dimension:
+/// The points of the first range are not greater than the splitting point and those of the second range are not less than the splitting point in that dimension.
+/// Ranges with at most IDLIB_KD_TREE_LEAF_SIZE points are leaves.
+///
+/// The arrays are located in a workspace provided by the caller.
+typedef struct idlib_kd_tree {
+  /// @brief <code>indices[j]</code> is the index of the point at the j-th position.
+  idlib_u32* indices;
+  /// @brief <code>coordinates[k][j]</code> is the k-th coordinate of the point at the j-th position.
+  /// <code>coordinates[2]</code> is not used by trees in two dimensions.
+  idlib_f32* coordinates[3];
+  /// @brief <code>dimensions[j]</code> is the splitting dimension of the range split at the j-th position.
+  idlib_u8* dimensions;
+  /// @brief The number of points.
+  idlib_u32 number_of_points;
+  /// @brief The maximum number of points.
+  idlib_u32 capacity;
+  /// @brief The number of dimensions (2 or 3).
+  idlib_u32 number_of_dimensions;
+  /// @brief The number of levels built by the last call to idlib_kd_tree_2_f32_build_top respectively idlib_kd_tree_3_f32_build_top.
+  idlib_u32 number_of_levels;
+} idlib_kd_tree;
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by an idlib_kd_tree object.
+/// @param capacity The maximum number of points.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 16 Bytes.
+size_t
+idlib_kd_tree_get_workspace_size
+  (
+    idlib_u32 capacity
+  );
+
+/// @since 1.5
+/// @brief Initialize an idlib_kd_tree object.
+/// @param target Pointer to the idlib_kd_tree object.
+/// @param capacity The maximum number of points.
+/// @param workspace Pointer to a workspace of idlib_kd_tree_get_workspace_size(capacity) Bytes.
+/// The workspace must remain valid as long as @a target is used.
+/// @remarks The tree contains no points.
+void
+idlib_kd_tree_initialize
+  (
+    idlib_kd_tree* target,
+    idlib_u32 capacity,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Build a subtree of a k-d tree.
+/// @param target Pointer to the idlib_kd_tree object the top levels of which were built by idlib_kd_tree_2_f32_build_top or idlib_kd_tree_3_f32_build_top.
+/// @param subtree The index of the subtree. Must be less than <code>2^number_of_levels</code>.
+/// @remarks
+/// The i-th subtree is the range reached from the root by descending into the first or second range at the d-th level if bit <code>number_of_levels - 1 - d</code> of i is zero respectively one.
+/// If a leaf is reached before the depth @a number_of_levels, then it belongs to the subtree with the remaining bits zero and the other subtrees are empty.
+void
+idlib_kd_tree_build_subtree
+  (
+    idlib_kd_tree* target,
+    idlib_u32 subtree
+  );
+
+/// @since 1.5
+/// @brief Build a k-d tree over a set of points in three dimensions.
+/// @param target Pointer to the idlib_kd_tree object.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of points.
+/// @param number_of_points The number of points. Must not exceed the capacity of @a target. The coordinates of the points must not be NaN.
+/// @remarks
+/// The coordinates of the points are copied into the tree and the points are reordered in place.
+/// Each range is split in the dimension in which the points of the range have the largest extent.
+/// The median is selected by quickselect in expected linear time such that the tree is built in expected O(n log n) time.
+/// Equivalent to idlib_kd_tree_3_f32_build_top with zero levels followed by idlib_kd_tree_build_subtree for the only subtree.
+void
+idlib_kd_tree_3_f32_build
+  (
+    idlib_kd_tree* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points
+  );
+
+/// @since 1.5
+/// @brief Build the top levels of a k-d tree over a set of points in three dimensions.
+/// @param target Pointer to the idlib_kd_tree object.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of points.
+/// @param number_of_points The number of points. Must not exceed the capacity of @a target.
+/// @param number_of_levels The number of levels to build. Must be less than 32.
+/// @remarks
+/// The ranges of the tree down to the depth @a number_of_levels are split.
+/// The <code>2^number_of_levels</code> ranges at that depth are the roots of the subtrees which are built by idlib_kd_tree_build_subtree.
+/// The subtrees are disjoint and can be built concurrently (e.g., by different threads).
+void
+idlib_kd_tree_3_f32_build_top
+  (
+    idlib_kd_tree* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_u32 number_of_levels
+  );
+
+/// @since 1.5
+/// @brief Find the k nearest points of a query point in three dimensions.
+/// @param target Pointer to an array of @a k elements receiving the indices of the points in ascending order of their distances.
+/// @param distances Pointer to an array of @a k elements receiving the squared distances of the points.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param point Pointer to the idlib_vector_3_f32 object denoting the query point.
+/// @param k The number of points to find.
+/// @param epsilon The approximation parameter. Must not be negative.
+/// If zero, then the k nearest points are found.
+/// Otherwise, the distance of the i-th point found is at most <code>1 + epsilon</code> times the distance of the true i-th nearest point.
+/// @return The number of points found. This is the minimum of @a k and the number of points of the tree.
+/// The remaining elements of @a target are set to IDLIB_KD_TREE_NONE and those of @a distances to infinity.
+/// @remarks
+/// The tree is descended to the leaf containing the query point first.
+/// A range on the other side of a splitting point is skipped if its distance to the query point times <code>1 + epsilon</code>
+/// is not less than the distance of the k-th nearest point found so far.
+/// The points of leaves are tested four at once on SIMD capable architectures.
+idlib_u32
+idlib_kd_tree_3_f32_query_nearest
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_u32 k,
+    idlib_f32 epsilon
+  );
+
+/// @since 1.5
+/// @brief Find the k nearest points of the query points <code>[first, first + count)</code> of a stream in three dimensions.
+/// @param target Pointer to an array of <code>count * k</code> elements.
+/// The indices of the points found for the i-th query point are stored at the positions <code>[(i - first) * k, (i - first + 1) * k)</code>.
+/// @param distances Pointer to an array of <code>count * k</code> elements receiving the squared distances.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param points Pointer to the idlib_vector_3_f32_soa object describing the stream of query points.
+/// @param k The number of points to find for each query point.
+/// @param epsilon The approximation parameter.
+/// @param first, count The range of query points.
+/// @remarks See idlib_kd_tree_3_f32_query_nearest.
+/// The ranges of query points can be processed concurrently (e.g., by different threads) into different arrays.
+void
+idlib_kd_tree_3_f32_query_nearest_n
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_u32 k,
+    idlib_f32 epsilon,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Find the points within a radius of a query point in three dimensions.
+/// @param target Pointer to an array of @a capacity elements receiving the indices of the points.
+/// @param capacity The maximum number of indices to store.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param point Pointer to the idlib_vector_3_f32 object denoting the query point.
+/// @param radius The radius. Must not be negative.
+/// @return The number of points found. If this is greater than @a capacity, then only the first @a capacity indices were stored.
+/// @remarks
+/// A point is found if its squared distance to the query point (computed in idlib_f32 arithmetic) is less than or equal to the square of the radius.
+/// The order of the indices is unspecified.
+size_t
+idlib_kd_tree_3_f32_query_radius
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_f32 radius
+  );
+
+/// @since 1.5
+/// @brief Find the points within a radius of the query points <code>[first, first + count)</code> of a stream in three dimensions.
+/// @param offsets Pointer to an array of <code>count + 1</code> elements.
+/// The indices of the points found for the i-th query point are stored at the positions <code>[offsets[i - first], offsets[i - first + 1])</code> of @a target.
+/// @param target Pointer to an array of @a capacity elements receiving the indices of the points.
+/// @param capacity The maximum number of indices to store.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param points Pointer to the idlib_vector_3_f32_soa object describing the stream of query points.
+/// @param radius The radius. Must not be negative.
+/// @param first, count The range of query points.
+/// @return The total number of points found. If this is greater than @a capacity, then only the first @a capacity indices were stored.
+/// @remarks The ranges of query points can be processed concurrently (e.g., by different threads) into different arrays.
+size_t
+idlib_kd_tree_3_f32_query_radius_n
+  (
+    size_t* offsets,
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_f32 radius,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Build a k-d tree over a set of points in two dimensions.
+/// @param target Pointer to the idlib_kd_tree object.
+/// @param operand Pointer to the idlib_vector_2_f32_soa object describing the stream of points.
+/// @param number_of_points The number of points.
+/// @remarks See idlib_kd_tree_3_f32_build.
+void
+idlib_kd_tree_2_f32_build
+  (
+    idlib_kd_tree* target,
+    idlib_vector_2_f32_soa const* operand,
+    idlib_u32 number_of_points
+  );
+
+/// @since 1.5
+/// @brief Build the top levels of a k-d tree over a set of points in two dimensions.
+/// @param target Pointer to the idlib_kd_tree object.
+/// @param operand Pointer to the idlib_vector_2_f32_soa object describing the stream of points.
+/// @param number_of_points The number of points.
+/// @param number_of_levels The number of levels to build.
+/// @remarks See idlib_kd_tree_3_f32_build_top.
+void
+idlib_kd_tree_2_f32_build_top
+  (
+    idlib_kd_tree* target,
+    idlib_vector_2_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_u32 number_of_levels
+  );
+
+/// @since 1.5
+/// @brief Find the k nearest points of a query point in two dimensions.
+/// @param target Pointer to an array of @a k elements receiving the indices of the points.
+/// @param distances Pointer to an array of @a k elements receiving the squared distances of the points.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param point Pointer to the idlib_vector_2_f32 object denoting the query point.
+/// @param k The number of points to find.
+/// @param epsilon The approximation parameter.
+/// @return The number of points found.
+/// @remarks See idlib_kd_tree_3_f32_query_nearest.
+idlib_u32
+idlib_kd_tree_2_f32_query_nearest
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32 const* point,
+    idlib_u32 k,
+    idlib_f32 epsilon
+  );
+
+/// @since 1.5
+/// @brief Find the k nearest points of the query points <code>[first, first + count)</code> of a stream in two dimensions.
+/// @param target Pointer to an array of <code>count * k</code> elements receiving the indices of the points.
+/// @param distances Pointer to an array of <code>count * k</code> elements receiving the squared distances.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param points Pointer to the idlib_vector_2_f32_soa object describing the stream of query points.
+/// @param k The number of points to find for each query point.
+/// @param epsilon The approximation parameter.
+/// @param first, count The range of query points.
+/// @remarks See idlib_kd_tree_3_f32_query_nearest_n.
+void
+idlib_kd_tree_2_f32_query_nearest_n
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32_soa const* points,
+    idlib_u32 k,
+    idlib_f32 epsilon,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Find the points within a radius of a query point in two dimensions.
+/// @param target Pointer to an array of @a capacity elements receiving the indices of the points.
+/// @param capacity The maximum number of indices to store.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param point Pointer to the idlib_vector_2_f32 object denoting the query point.
+/// @param radius The radius.
+/// @return The number of points found.
+/// @remarks See idlib_kd_tree_3_f32_query_radius.
+size_t
+idlib_kd_tree_2_f32_query_radius
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32 const* point,
+    idlib_f32 radius
+  );
+
+/// @since 1.5
+/// @brief Find the points within a radius of the query points <code>[first, first + count)</code> of a stream in two dimensions.
+/// @param offsets Pointer to an array of <code>count + 1</code> elements.
+/// @param target Pointer to an array of @a capacity elements receiving the indices of the points.
+/// @param capacity The maximum number of indices to store.
+/// @param operand Pointer to the idlib_kd_tree object.
+/// @param points Pointer to the idlib_vector_2_f32_soa object describing the stream of query points.
+/// @param radius The radius.
+/// @param first, count The range of query points.
+/// @return The total number of points found.
+/// @remarks See idlib_kd_tree_3_f32_query_radius_n.
+size_t
+idlib_kd_tree_2_f32_query_radius_n
+  (
+    size_t* offsets,
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32_soa const* points,
+    idlib_f32 radius,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_KD_TREE_H_INCLUDED
@@ -0,0 +1,312 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_MATRIX_3X3_H_INCLUDED)
+#define IDLIB_MATRIX_3X3_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "matrix_4x4.h"
+
+/// @since 1.5
+/// @brief A row-major matrix with elements of type idlib_f32.
+/// Row major means: The first index denotes the row, the second index denotes the column.
+typedef struct idlib_matrix_3x3_f32 {
+  idlib_f32 e[3][3];
+} idlib_matrix_3x3_f32;
+
+/// @since 1.5
+/// @brief A stream of idlib_matrix_3x3_f32 objects in "structure of arrays" layout.
+/// @remarks The element (r, c) of the i-th matrix is <code>e[r][c][i]</code>.
+typedef struct idlib_matrix_3x3_f32_soa {
+  idlib_f32* e[3][3];
+} idlib_matrix_3x3_f32_soa;
+
+/// @since 1.5
+/// @brief Assign an idlib_matrix_3x3_f32 object the values of the zero matrix.
+/// @param target Pointer to the idlib_matrix_3x3_f32 object to which the result is assigned.
+static inline void
+idlib_matrix_3x3_f32_set_zero
+  (
+    idlib_matrix_3x3_f32* target
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_matrix_3x3_f32 object the values of the identity matrix.
+/// @param target Pointer to the idlib_matrix_3x3_f32 object to which the result is assigned.
+static inline void
+idlib_matrix_3x3_f32_set_identity
+  (
+    idlib_matrix_3x3_f32* target
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_matrix_3x3_f32 object the values of the upper left 3x3 submatrix of an idlib_matrix_4x4_f32 object.
+/// @param target Pointer to the idlib_matrix_3x3_f32 object to which the result is assigned.
+/// @param operand Pointer to the idlib_matrix_4x4_f32 object.
+static inline void
+idlib_matrix_3x3_f32_set_matrix_4x4
+  (
+    idlib_matrix_3x3_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Compute the product of two matrices.
+/// @param target Pointer to a idlib_matrix_3x3_f32 object to assign the result to.
+/// @param operand1 Pointer to a idlib_matrix_3x3_f32 object, the multiplier (first operand).
+/// @param operand2 Pointer to a idlib_matrix_3x3_f32 object, the multiplicand (second operand).
+/// @remarks @a target, @a operand1, and @a operand2 all may refer to the same object.
+static inline void
+idlib_matrix_3x3_f32_multiply
+  (
+    idlib_matrix_3x3_f32* target,
+    idlib_matrix_3x3_f32 const* operand1,
+    idlib_matrix_3x3_f32 const* operand2
+  );
+
+/// @since 1.5
+/// @brief Transpose a matrix.
+/// @param target A pointer to the idlib_matrix_3x3_f32 object to assign the result to.
+/// @param operand Pointer to the idlib_matrix_3x3_f32 object to transpose.
+/// @remarks @a target and @a operand may refer to the same idlib_matrix_3x3_f32 object.
+static inline void
+idlib_matrix_3x3_f32_transpose
+  (
+    idlib_matrix_3x3_f32* target,
+    idlib_matrix_3x3_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Transform a vector.
+/// @param target Pointer to an idlib_vector_3_f32 object receiving the result.
+/// @param operand1 Pointer to an idlib_matrix_3x3_f32 object, the multiplier (first operand).
+/// @param operand2 Pointer to an idlib_vector_3_f32 object, the multiplicand (second operand).
+/// @remarks @a target and @a operand2 may refer to the same idlib_vector_3_f32 object.
+static inline void
+idlib_matrix_3x3_3f_transform
+  (
+    idlib_vector_3_f32* target,
+    idlib_matrix_3x3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2
+  );
+
+/// @since 1.5
+/// @brief Compute the eigenvalues and eigenvectors of a symmetric matrix.
+/// @param target_vectors Pointer to the idlib_matrix_3x3_f32 object receiving the eigenvectors.
+/// The k-th column is the unit eigenvector of the k-th eigenvalue.
+/// The matrix is a rotation matrix (its determinant is +1).
+/// @param target_values Pointer to the idlib_vector_3_f32 object receiving the eigenvalues in descending order.
+/// @param operand Pointer to the idlib_matrix_3x3_f32 object, a symmetric matrix. Only its upper triangle is read.
+/// @remarks
+/// The matrix is scaled by the reciprocal of its element of greatest magnitude and diagonalized by a fixed number of cyclic Jacobi sweeps.
+/// The rotations are computed without trigonometric functions and without branches.
+/// The eigenvalues are accurate to about 1e-6 times the element of greatest magnitude.
+void
+idlib_matrix_3x3_f32_eigen_symmetric
+  (
+    idlib_matrix_3x3_f32* target_vectors,
+    idlib_vector_3_f32* target_values,
+    idlib_matrix_3x3_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Compute the eigenvalues and eigenvectors of the symmetric matrices <code>[first, first + count)</code> of a stream.
+/// @param target_vectors Pointer to the idlib_matrix_3x3_f32_soa object describing the stream receiving the eigenvectors.
+/// @param target_values Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the eigenvalues.
+/// @param operand Pointer to the idlib_matrix_3x3_f32_soa object describing the stream of symmetric matrices.
+/// @param first The index of the first matrix.
+/// @param count The number of matrices.
+/// @remarks
+/// The result is the same as that of idlib_matrix_3x3_f32_eigen_symmetric.
+/// Eight matrices are decomposed at once on SIMD capable architectures.
+/// The streams of @a target_vectors and @a operand may be the same.
+void
+idlib_matrix_3x3_f32_eigen_symmetric_n
+  (
+    idlib_matrix_3x3_f32_soa const* target_vectors,
+    idlib_vector_3_f32_soa const* target_values,
+    idlib_matrix_3x3_f32_soa const* operand,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Compute the singular value decomposition of a matrix.
+/// @param target_u Pointer to the idlib_matrix_3x3_f32 object receiving U, a rotation matrix.
+/// @param target_sigma Pointer to the idlib_vector_3_f32 object receiving the singular values s.
+/// @param target_v Pointer to the idlib_matrix_3x3_f32 object receiving V, a rotation matrix.
+/// @param operand Pointer to the idlib_matrix_3x3_f32 object, the matrix A.
+/// @remarks
+/// The decomposition satisfies A = U diag(s) V^T with <code>s[0] >= s[1] >= |s[2]|</code>.
+/// As both U and V are rotations, s[2] is negative if the determinant of A is negative.
+/// Consequently, U V^T is the rotation of the polar decomposition of A.
+///
+/// This is the branch-free algorithm of McAdams et al., "Computing the Singular Value Decomposition of 3x3 matrices with minimal branching and elementary floating point operations", 2011:
+/// A^T A is diagonalized by Jacobi sweeps with approximate Givens rotations yielding V,
+/// the columns of A V are sorted by decreasing norm, and A V is factored into U R by a QR decomposition with Givens rotations.
+/// Like idlib_matrix_3x3_f32_eigen_symmetric, the matrix is scaled by the reciprocal of its element of greatest magnitude first.
+/// Six sweeps are performed rather than the four of the paper, which leave errors of up to 1e-2 for some ill-conditioned matrices.
+/// The elements of U diag(s) V^T differ from those of A by about 1e-5 times the element of greatest magnitude.
+void
+idlib_matrix_3x3_f32_svd
+  (
+    idlib_matrix_3x3_f32* target_u,
+    idlib_vector_3_f32* target_sigma,
+    idlib_matrix_3x3_f32* target_v,
+    idlib_matrix_3x3_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Compute the singular value decompositions of the matrices <code>[first, first + count)</code> of a stream.
+/// @param target_u Pointer to the idlib_matrix_3x3_f32_soa object describing the stream receiving the matrices U.
+/// @param target_sigma Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the singular values.
+/// @param target_v Pointer to the idlib_matrix_3x3_f32_soa object describing the stream receiving the matrices V.
+/// @param operand Pointer to the idlib_matrix_3x3_f32_soa object describing the stream of matrices.
+/// @param first The index of the first matrix.
+/// @param count The number of matrices.
+/// @remarks
+/// The result is the same as that of idlib_matrix_3x3_f32_svd.
+/// Eight matrices are decomposed at once on SIMD capable architectures.
+/// The stream of @a operand may be the same as the stream of @a target_u or @a target_v.
+void
+idlib_matrix_3x3_f32_svd_n
+  (
+    idlib_matrix_3x3_f32_soa const* target_u,
+    idlib_vector_3_f32_soa const* target_sigma,
+    idlib_matrix_3x3_f32_soa const* target_v,
+    idlib_matrix_3x3_f32_soa const* operand,
+    size_t first,
+    size_t count
+  );
+
+static inline void
+idlib_matrix_3x3_f32_set_zero
+  (
+    idlib_matrix_3x3_f32* target
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      target->e[i][j] = 0.f;
+    }
+  }
+}
+
+static inline void
+idlib_matrix_3x3_f32_set_identity
+  (
+    idlib_matrix_3x3_f32* target
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      target->e[i][j] = i == j ? 1.f : 0.f;
+    }
+  }
+}
+
+static inline void
+idlib_matrix_3x3_f32_set_matrix_4x4
+  (
+    idlib_matrix_3x3_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      target->e[i][j] = operand->e[i][j];
+    }
+  }
+}
+
+static inline void
+idlib_matrix_3x3_f32_multiply
+  (
+    idlib_matrix_3x3_f32* target,
+    idlib_matrix_3x3_f32 const* operand1,
+    idlib_matrix_3x3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+
+  idlib_f32 t[3][3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      t[i][j] = 0.f;
+      for (size_t k = 0; k < 3; ++k) {
+        t[i][j] += operand1->e[i][k] * operand2->e[k][j];
+      }
+    }
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      target->e[i][j] = t[i][j];
+    }
+  }
+}
+
+static inline void
+idlib_matrix_3x3_f32_transpose
+  (
+    idlib_matrix_3x3_f32* target,
+    idlib_matrix_3x3_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+
+  for (size_t i = 0; i < 3; ++i) {
+    target->e[i][i] = operand->e[i][i];
+    for (size_t j = i + 1; j < 3; ++j) {
+      idlib_f32 t = operand->e[i][j];
+      target->e[i][j] = operand->e[j][i];
+      target->e[j][i] = t;
+    }
+  }
+}
+
+static inline void
+idlib_matrix_3x3_3f_transform
+  (
+    idlib_vector_3_f32* target,
+    idlib_matrix_3x3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+
+  idlib_f32 x = operand2->e[0], y = operand2->e[1], z = operand2->e[2];
+  for (size_t i = 0; i < 3; ++i) {
+    target->e[i] = operand1->e[i][0] * x + operand1->e[i][1] * y + operand1->e[i][2] * z;
+  }
+}
+
+#endif // IDLIB_MATRIX_3X3_H_INCLUDED
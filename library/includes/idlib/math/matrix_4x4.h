@@ -24,6 +24,7 @@
 
 #include "scalar.h"
 #include "vector_3.h"
+#include "vector_4.h"
 
 // 'Windows.h', which is frequently included in Windows
 // programs, defines the macros 'near' and 'far' causing
@@ -43,6 +44,19 @@ typedef struct idlib_matrix_4x4_f32 {
   idlib_f32 e[4][4];
 } idlib_matrix_4x4_f32;
 
+/// @since 1.5
+/// @brief A row-major matrix with elements of type idlib_f32 aligned to 64 Bytes.
+/// @remarks
+/// The elements are stored at the same offsets as in idlib_matrix_4x4_f32.
+/// The alignment places an idlib_matrix_4x4a_f32 object in a single cache line and allows for loading each row into a SIMD register with a single aligned load.
+typedef struct IDLIB_ALIGNAS(64) idlib_matrix_4x4a_f32 {
+  idlib_f32 e[4][4];
+} idlib_matrix_4x4a_f32;
+
+IDLIB_STATIC_ASSERT(sizeof(idlib_matrix_4x4_f32) == 64, "idlib_matrix_4x4_f32 must be 64 Bytes");
+IDLIB_STATIC_ASSERT(sizeof(idlib_matrix_4x4a_f32) == 64, "idlib_matrix_4x4a_f32 must be 64 Bytes");
+IDLIB_STATIC_ASSERT(IDLIB_ALIGNOF(idlib_matrix_4x4a_f32) == 64, "idlib_matrix_4x4a_f32 must be aligned to 64 Bytes");
+
 /// @since 1.4
 /// @brief Add an idlib_matrix_4x4_f32 object to another idlib_matrix_4x4_f32 object. Assign the result to a idlib_matrix_4x4_f32 object.
 /// @param target Pointer to the idlib_matrix_4x4_f32 object to which the result is assigned.
@@ -410,6 +424,65 @@ idlib_matrix_4x4_3f_transform_direction
     idlib_vector_3_f32 const* operand2
   );
 
+/// @since 1.5
+/// @brief Assign an idlib_matrix_4x4a_f32 object the values of an idlib_matrix_4x4_f32 object.
+/// @param target Pointer to the idlib_matrix_4x4a_f32 object to assign the values to.
+/// @param operand Pointer to the idlib_matrix_4x4_f32 object.
+static inline void
+idlib_matrix_4x4a_f32_set_matrix_4x4
+  (
+    idlib_matrix_4x4a_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_matrix_4x4_f32 object the values of an idlib_matrix_4x4a_f32 object.
+/// @param target Pointer to the idlib_matrix_4x4_f32 object to assign the values to.
+/// @param operand Pointer to the idlib_matrix_4x4a_f32 object.
+static inline void
+idlib_matrix_4x4_f32_set_matrix_4x4a
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_matrix_4x4a_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Transform an array of position vectors.
+/// @param target Pointer to an array of @a count idlib_vector_4a_f32 objects receiving the results.
+/// The i-th result is <code>operand1 * (operand2[i].e[0], operand2[i].e[1], operand2[i].e[2], 1)</code>.
+/// @param operand1 Pointer to the idlib_matrix_4x4a_f32 object, the multiplier.
+/// @param operand2 Pointer to an array of @a count idlib_vector_3a_f32 objects, the multiplicands.
+/// @param count The number of vectors.
+/// @remarks
+/// The results are written with non-temporal ("streaming") stores bypassing the cache
+/// as large arrays of results are usually consumed later or by another unit (e.g., uploaded to the GPU).
+/// @a target and @a operand2 must not overlap.
+void
+idlib_matrix_4x4a_f32_transform_points_n
+  (
+    idlib_vector_4a_f32* target,
+    idlib_matrix_4x4a_f32 const* operand1,
+    idlib_vector_3a_f32 const* operand2,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Transform an array of direction vectors.
+/// @param target Pointer to an array of @a count idlib_vector_4a_f32 objects receiving the results.
+/// The i-th result is <code>operand1 * (operand2[i].e[0], operand2[i].e[1], operand2[i].e[2], 0)</code>.
+/// @param operand1 Pointer to the idlib_matrix_4x4a_f32 object, the multiplier.
+/// @param operand2 Pointer to an array of @a count idlib_vector_3a_f32 objects, the multiplicands.
+/// @param count The number of vectors.
+/// @remarks See idlib_matrix_4x4a_f32_transform_points_n.
+void
+idlib_matrix_4x4a_f32_transform_directions_n
+  (
+    idlib_vector_4a_f32* target,
+    idlib_matrix_4x4a_f32 const* operand1,
+    idlib_vector_3a_f32 const* operand2,
+    size_t count
+  );
+
 static inline void
 idlib_matrix_4x4_f32_add
   (
@@ -1089,4 +1162,36 @@ idlib_matrix_4x4_3f_transform_direction
   target->e[2] = e[2];
 }
 
+static inline void
+idlib_matrix_4x4a_f32_set_matrix_4x4
+  (
+    idlib_matrix_4x4a_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t i = 0; i < 4; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      target->e[i][j] = operand->e[i][j];
+    }
+  }
+}
+
+static inline void
+idlib_matrix_4x4_f32_set_matrix_4x4a
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_matrix_4x4a_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t i = 0; i < 4; ++i) {
+    for (size_t j = 0; j < 4; ++j) {
+      target->e[i][j] = operand->e[i][j];
+    }
+  }
+}
+
 #endif // IDLIB_MATRIX_4X4_H_INCLUDED
@@ -0,0 +1,150 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_MESH_H_INCLUDED)
+#define IDLIB_MESH_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+#include "vector_3.h"
+#include "vector_4.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the weighting of the contribution of a triangle to its vertices by the area of the triangle.
+#define IDLIB_MESH_WEIGHTING_AREA (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the weighting of the contribution of a triangle to its vertices by the angles of the triangle at the vertices.
+#define IDLIB_MESH_WEIGHTING_ANGLE (1)
+
+/// @since 1.5
+/// @brief Describes the streams of an indexed triangle mesh for the computation of vertex normals and tangents.
+/// @remarks
+/// The i-th triangle consists of the vertices <code>indices[3 * i + k]</code>, k = 0, 1, 2, in counterclockwise order.
+///
+/// If @a texture_coordinates.x is a null pointer, then tangents are not computed and @a tangents is not written.
+typedef struct idlib_mesh_f32_job {
+  /// The positions of the vertices.
+  idlib_vector_3_f32_soa positions;
+  /// The texture coordinates of the vertices.
+  idlib_vector_2_f32_soa texture_coordinates;
+  /// The indices of the vertices of the triangles.
+  idlib_u32 const* indices;
+  /// The number of vertices.
+  idlib_u32 number_of_vertices;
+  /// The number of triangles.
+  idlib_u32 number_of_triangles;
+  /// IDLIB_MESH_WEIGHTING_AREA or IDLIB_MESH_WEIGHTING_ANGLE.
+  idlib_u8 weighting;
+  /// The normals of the vertices.
+  idlib_vector_3_f32_soa normals;
+  /// The tangents of the vertices.
+  /// The w component is the handedness of the tangent frame (+1 or -1): The bitangent is <code>w * cross(normal, tangent)</code>.
+  idlib_vector_4_f32_soa tangents;
+} idlib_mesh_f32_job;
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by the idlib_mesh_f32_* functions.
+/// @param number_of_vertices The number of vertices.
+/// @param number_of_triangles The number of triangles.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 16 Bytes.
+size_t
+idlib_mesh_f32_get_workspace_size
+  (
+    idlib_u32 number_of_vertices,
+    idlib_u32 number_of_triangles
+  );
+
+/// @since 1.5
+/// @brief Compute the vertex normals and vertex tangents of a mesh.
+/// @param job Pointer to the mesh job.
+/// @param workspace Pointer to a workspace of idlib_mesh_f32_get_workspace_size Bytes.
+/// @remarks
+/// This invokes idlib_mesh_f32_prepare, idlib_mesh_f32_compute_triangle_frames for all triangles,
+/// and idlib_mesh_f32_compute_vertex_frames for all vertices.
+void
+idlib_mesh_f32_compute_normals_and_tangents
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief First phase: Compute the list of triangle corners of each vertex.
+/// @param job Pointer to the mesh job.
+/// @param workspace Pointer to a workspace of idlib_mesh_f32_get_workspace_size Bytes.
+/// @remarks The lists are computed by a counting sort of the indices in linear time.
+void
+idlib_mesh_f32_prepare
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Second phase: Compute the normals, tangents, and bitangents of the triangles <code>[first, first + count)</code>.
+/// @param job Pointer to the mesh job.
+/// @param workspace Pointer to the workspace.
+/// @param first The index of the first triangle.
+/// @param count The number of triangles.
+/// @remarks
+/// The normal of a triangle is the normalized cross product of two of its edges.
+/// Its tangent and bitangent are the normalized directions of increasing u and v texture coordinates.
+/// The weight of the triangle at each of its corners is its area or the angle at that corner.
+/// An invocation reads the indices of the triangles of the range and the positions and texture coordinates of their vertices.
+/// It writes the frames and the corner weights of these triangles to the workspace and nothing else.
+void
+idlib_mesh_f32_compute_triangle_frames
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+/// @since 1.5
+/// @brief Third phase: Compute the normals and tangents of the vertices <code>[first, first + count)</code>.
+/// @param job Pointer to the mesh job.
+/// @param workspace Pointer to the workspace.
+/// @param first The index of the first vertex.
+/// @param count The number of vertices.
+/// @remarks
+/// The weighted frames of the triangles incident to a vertex are summed up (as 4-component SIMD vectors) and normalized.
+/// The tangent is orthogonalized with respect to the normal (Gram-Schmidt) and its handedness is determined from the summed up bitangents.
+///
+/// Each vertex gathers the contributions of its triangles, rather than each triangle scattering its contribution to its vertices.
+/// Hence, an invocation writes only the normals and tangents of the vertices of the range and needs no atomic operations or locks.
+/// It reads the frames and corner weights of the triangles incident to these vertices, which the second phase must have computed.
+///
+/// A vertex not referenced by a non-degenerate triangle is assigned the zero normal.
+/// A vertex without a well-defined tangent is assigned an arbitrary unit tangent orthogonal to its normal.
+void
+idlib_mesh_f32_compute_vertex_frames
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+#endif // IDLIB_MESH_H_INCLUDED
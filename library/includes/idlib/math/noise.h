@@ -0,0 +1,240 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#if !defined(IDLIB_NOISE_H_INCLUDED)
+#define IDLIB_NOISE_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+#include "vector_3.h"
+#include "vector_4.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting (improved) Perlin noise.
+/// @remarks Gradient noise on the square/cubic lattice, interpolated by the quintic fade function <code>6 t^5 - 15 t^4 + 10 t^3</code>.
+#define IDLIB_NOISE_PERLIN (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting simplex noise.
+/// @remarks Gradient noise on the simplex lattice. It is cheaper than Perlin noise in higher dimensions and has fewer directional artifacts.
+#define IDLIB_NOISE_SIMPLEX (1)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting value noise.
+/// @remarks Random values at the points of the square/cubic lattice, interpolated by the quintic fade function.
+#define IDLIB_NOISE_VALUE (2)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting a single octave of noise.
+#define IDLIB_NOISE_FRACTAL_NONE (0)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting fractional Brownian motion.
+/// @remarks The octaves are summed with their amplitudes. The result is in the range of the noise.
+#define IDLIB_NOISE_FRACTAL_FBM (1)
+
+/// @since 1.5
+/// @brief Symbolic constant denoting ridged multifractal noise.
+/// @remarks The values <code>(1 - |n|)^2</code> of the octaves n are summed with their amplitudes. The result is in the range [0, 1].
+#define IDLIB_NOISE_FRACTAL_RIDGED (2)
+
+/// @since 1.5
+/// @brief A noise function.
+/// @remarks
+/// The noise at a point p is the sum over the octaves i = 0, ..., @a octaves - 1 of
+/// <code>gain^i * n(frequency * lacunarity^i * p)</code> divided by the sum of the amplitudes <code>gain^i</code>,
+/// where n is noise of the kind @a kind with a seed derived from @a seed and i.
+/// The noise is in the range [-1, 1] (approximately for Perlin noise and simplex noise).
+///
+/// The noise is deterministic: It only depends on the point and the parameters, and it is the same on all architectures and for all functions evaluating it.
+/// This requires IEEE 754 single precision arithmetic without contraction of multiplications and additions (in particular, no "fast math").
+typedef struct idlib_noise_f32 {
+  /// @brief The kind of noise: IDLIB_NOISE_PERLIN, IDLIB_NOISE_SIMPLEX, or IDLIB_NOISE_VALUE.
+  idlib_u32 kind;
+  /// @brief The fractal: IDLIB_NOISE_FRACTAL_NONE, IDLIB_NOISE_FRACTAL_FBM, or IDLIB_NOISE_FRACTAL_RIDGED.
+  idlib_u32 fractal;
+  /// @brief The seed.
+  idlib_u32 seed;
+  /// @brief The number of octaves. Ignored for IDLIB_NOISE_FRACTAL_NONE.
+  idlib_u32 octaves;
+  /// @brief The frequency of the first octave.
+  idlib_f32 frequency;
+  /// @brief The factor by which the frequency increases from one octave to the next.
+  idlib_f32 lacunarity;
+  /// @brief The factor by which the amplitude decreases from one octave to the next.
+  idlib_f32 gain;
+} idlib_noise_f32;
+
+/// @since 1.5
+/// @brief Assign an idlib_noise_f32 object a single octave of noise.
+/// @param target Pointer to the idlib_noise_f32 object.
+/// @param kind The kind of noise: IDLIB_NOISE_PERLIN, IDLIB_NOISE_SIMPLEX, or IDLIB_NOISE_VALUE.
+/// @param seed The seed.
+/// @remarks
+/// The fractal is IDLIB_NOISE_FRACTAL_NONE, the frequency is 1, the lacunarity is 2, and the gain is 1/2.
+/// To obtain fractal noise, assign the members @a fractal and @a octaves afterwards.
+void
+idlib_noise_f32_set
+  (
+    idlib_noise_f32* target,
+    idlib_u32 kind,
+    idlib_u32 seed
+  );
+
+/// @since 1.5
+/// @brief Evaluate two-dimensional noise at a point.
+/// @param operand Pointer to the idlib_noise_f32 object.
+/// @param point Pointer to the idlib_vector_2_f32 object, the point.
+/// @return The noise at the point.
+idlib_f32
+idlib_noise_2_f32_evaluate
+  (
+    idlib_noise_f32 const* operand,
+    idlib_vector_2_f32 const* point
+  );
+
+/// @since 1.5
+/// @brief Evaluate two-dimensional noise at the points <code>[first, first + count)</code> of a stream.
+/// @param target Pointer to an array of idlib_f32 values. <code>target[i]</code> receives the noise at the i-th point.
+/// @param operand Pointer to the idlib_noise_f32 object.
+/// @param points Pointer to the idlib_vector_2_f32_soa object describing the stream of points.
+/// @param first The index of the first point.
+/// @param count The number of points.
+/// @remarks
+/// Four points are processed at once on SIMD capable architectures.
+/// An invocation reads the points of the range and writes <code>target[first]</code> to <code>target[first + count - 1]</code>.
+/// @a operand is only read, the lattice is hashed from the seed rather than looked up in a table (see the section on ranges in idlib-math.md).
+void
+idlib_noise_2_f32_evaluate_n
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_2_f32_soa const* points,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate two-dimensional noise at the rows <code>[first, first + count)</code> of a regular grid.
+/// @param target Pointer to an array of <code>size_x * size_y</code> idlib_f32 values, where size_y is the number of rows of the grid.
+/// <code>target[x + size_x * y]</code> receives the noise at the point <code>origin + (x * spacing.x, y * spacing.y)</code>.
+/// @param operand Pointer to the idlib_noise_f32 object.
+/// @param origin Pointer to the idlib_vector_2_f32 object, the point of the grid with the indices (0, 0).
+/// @param spacing Pointer to the idlib_vector_2_f32 object, the distances between adjacent points of the grid along the axes.
+/// @param size_x The number of points of a row.
+/// @param first The index of the first row.
+/// @param count The number of rows.
+/// @remarks
+/// The result is the same as evaluating the noise at the points of the grid by idlib_noise_2_f32_evaluate.
+/// An invocation writes <code>target[size_x * first]</code> to <code>target[size_x * (first + count) - 1]</code>, that is, the rows of the range.
+void
+idlib_noise_2_f32_evaluate_grid
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_2_f32 const* origin,
+    idlib_vector_2_f32 const* spacing,
+    idlib_u32 size_x,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+/// @since 1.5
+/// @brief Evaluate three-dimensional noise at a point.
+/// @param operand Pointer to the idlib_noise_f32 object.
+/// @param point Pointer to the idlib_vector_3_f32 object, the point.
+/// @return The noise at the point.
+idlib_f32
+idlib_noise_3_f32_evaluate
+  (
+    idlib_noise_f32 const* operand,
+    idlib_vector_3_f32 const* point
+  );
+
+/// @since 1.5
+/// @brief Evaluate three-dimensional noise at the points <code>[first, first + count)</code> of a stream.
+/// @remarks See idlib_noise_2_f32_evaluate_n.
+void
+idlib_noise_3_f32_evaluate_n
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_3_f32_soa const* points,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate three-dimensional noise at the rows <code>[first, first + count)</code> of a regular grid.
+/// @param target Pointer to an array of <code>size_x * size_y * size_z</code> idlib_f32 values, where size_z is the number of slices of the grid.
+/// <code>target[x + size_x * (y + size_y * z)]</code> receives the noise at the point <code>origin + (x * spacing.x, y * spacing.y, z * spacing.z)</code>.
+/// @param operand Pointer to the idlib_noise_f32 object.
+/// @param origin Pointer to the idlib_vector_3_f32 object, the point of the grid with the indices (0, 0, 0).
+/// @param spacing Pointer to the idlib_vector_3_f32 object, the distances between adjacent points of the grid along the axes.
+/// @param size_x The number of points of a row.
+/// @param size_y The number of rows of a slice.
+/// @param first The index of the first row. The row with the index <code>y + size_y * z</code> is the y-th row of the z-th slice.
+/// @param count The number of rows.
+/// @remarks See idlib_noise_2_f32_evaluate_grid.
+void
+idlib_noise_3_f32_evaluate_grid
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_3_f32 const* origin,
+    idlib_vector_3_f32 const* spacing,
+    idlib_u32 size_x,
+    idlib_u32 size_y,
+    idlib_u32 first,
+    idlib_u32 count
+  );
+
+/// @since 1.5
+/// @brief Evaluate four-dimensional noise at a point.
+/// @param operand Pointer to the idlib_noise_f32 object.
+/// @param point Pointer to the idlib_vector_4_f32 object, the point.
+/// @return The noise at the point.
+/// @remarks
+/// Four-dimensional noise is commonly used to animate three-dimensional noise over time
+/// or to create two-dimensional noise which is periodic in both directions (by evaluating it on a torus).
+idlib_f32
+idlib_noise_4_f32_evaluate
+  (
+    idlib_noise_f32 const* operand,
+    idlib_vector_4_f32 const* point
+  );
+
+/// @since 1.5
+/// @brief Evaluate four-dimensional noise at the points <code>[first, first + count)</code> of a stream.
+/// @remarks See idlib_noise_2_f32_evaluate_n.
+void
+idlib_noise_4_f32_evaluate_n
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_4_f32_soa const* points,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_NOISE_H_INCLUDED
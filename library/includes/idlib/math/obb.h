@@ -0,0 +1,169 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_OBB_H_INCLUDED)
+#define IDLIB_OBB_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "matrix_3x3.h"
+#include "aabb.h"
+
+/// @since 1.5
+/// @brief An oriented bounding box.
+/// @remarks
+/// The box is the set of points <code>center + rotation * u</code> with <code>|u[k]| <= extents[k]</code>, k = 0, 1, 2.
+/// That is, the columns of @a rotation are the unit axes of the box and @a extents are the half extents along these axes.
+/// @a rotation is a rotation matrix.
+typedef struct idlib_obb_3_f32 {
+  idlib_vector_3_f32 center;
+  idlib_matrix_3x3_f32 rotation;
+  idlib_vector_3_f32 extents;
+} idlib_obb_3_f32;
+
+/// @since 1.5
+/// @brief A stream of idlib_obb_3_f32 objects in "structure of arrays" layout.
+typedef struct idlib_obb_3_f32_soa {
+  idlib_vector_3_f32_soa center;
+  idlib_matrix_3x3_f32_soa rotation;
+  idlib_vector_3_f32_soa extents;
+} idlib_obb_3_f32_soa;
+
+/// @since 1.5
+/// @brief Assign an idlib_obb_3_f32 object the values of an axis-aligned bounding box.
+/// @param target Pointer to the idlib_obb_3_f32 object.
+/// @param operand Pointer to the idlib_aabb_3_f32 object.
+void
+idlib_obb_3_f32_set_aabb
+  (
+    idlib_obb_3_f32* target,
+    idlib_aabb_3_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Fit an oriented bounding box to a set of points by principal component analysis.
+/// @param target Pointer to the idlib_obb_3_f32 object receiving the box.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of points.
+/// @param count The number of points. If zero, the box is set to the point (0, 0, 0).
+/// @remarks
+/// The axes of the box are the eigenvectors of the covariance matrix of the points (see idlib_matrix_3x3_f32_eigen_symmetric).
+/// The box is tight along these axes. The points are read three times.
+/// The fit is sensitive to the distribution of the points: Clusters of points in the interior pull the axes towards them.
+void
+idlib_obb_3_f32_fit_covariance
+  (
+    idlib_obb_3_f32* target,
+    idlib_vector_3_f32_soa const* operand,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Fit an oriented bounding box to a set of points by the DiTO-14 algorithm.
+/// @param target Pointer to the idlib_obb_3_f32 object receiving the box.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of points.
+/// @param count The number of points. If zero, the box is set to the point (0, 0, 0).
+/// @remarks
+/// Larsson and Kallberg, "Fast Computation of Tight-Fitting Oriented Bounding Boxes", 2011:
+/// The extremal points along 7 fixed directions are selected in a first pass.
+/// Candidate axes are derived from the edges and normals of a large triangle and a "ditetrahedron" built from these 14 points
+/// and the candidate of least surface area with respect to the 14 points is selected.
+/// The box is made tight along the selected axes in a second pass and replaced by the axis-aligned box if that has less surface area.
+/// The points are read twice, four points are processed at once on SIMD capable architectures.
+/// The fit is usually tighter than idlib_obb_3_f32_fit_covariance and does not depend on the distribution of the interior points.
+void
+idlib_obb_3_f32_fit_dito
+  (
+    idlib_obb_3_f32* target,
+    idlib_vector_3_f32_soa const* operand,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Get if two oriented bounding boxes overlap.
+/// @param operand1, operand2 Pointers to the idlib_obb_3_f32 objects.
+/// @return @a true if the boxes overlap, @a false otherwise.
+/// @remarks
+/// The boxes are tested for separation along the 15 potentially separating axes
+/// (the 3 axes of each box and the 9 cross products of an axis of the first and an axis of the second box).
+/// A small epsilon is added to the absolute values of the rotation from one box to the other
+/// such that the test remains robust if the boxes have (almost) parallel axes.
+bool
+idlib_obb_3_f32_overlap
+  (
+    idlib_obb_3_f32 const* operand1,
+    idlib_obb_3_f32 const* operand2
+  );
+
+/// @since 1.5
+/// @brief Get if an oriented bounding box and an axis-aligned bounding box overlap.
+/// @param operand1 Pointer to the idlib_obb_3_f32 object.
+/// @param operand2 Pointer to the idlib_aabb_3_f32 object.
+/// @return @a true if the boxes overlap, @a false otherwise.
+/// @remarks See idlib_obb_3_f32_overlap.
+bool
+idlib_obb_3_f32_overlap_aabb
+  (
+    idlib_obb_3_f32 const* operand1,
+    idlib_aabb_3_f32 const* operand2
+  );
+
+/// @since 1.5
+/// @brief Test one oriented bounding box against the oriented bounding boxes <code>[first, first + count)</code> of a stream.
+/// @param target Pointer to an array receiving, at index i, 1 if the box overlaps the i-th box of the stream and 0 otherwise.
+/// @param operand1 Pointer to the idlib_obb_3_f32 object.
+/// @param operand2 Pointer to the idlib_obb_3_f32_soa object describing the stream of boxes.
+/// @param first The index of the first box.
+/// @param count The number of boxes.
+/// @remarks
+/// The result is the same as that of idlib_obb_3_f32_overlap.
+/// Four boxes are tested at once on SIMD capable architectures.
+void
+idlib_obb_3_f32_overlap_n
+  (
+    idlib_u8* target,
+    idlib_obb_3_f32 const* operand1,
+    idlib_obb_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Test one oriented bounding box against the axis-aligned bounding boxes <code>[first, first + count)</code> of a stream.
+/// @param target Pointer to an array receiving, at index i, 1 if the box overlaps the i-th box of the stream and 0 otherwise.
+/// @param operand1 Pointer to the idlib_obb_3_f32 object.
+/// @param operand2 Pointer to the idlib_aabb_3_f32_soa object describing the stream of boxes.
+/// @param first The index of the first box.
+/// @param count The number of boxes.
+/// @remarks
+/// The result is the same as that of idlib_obb_3_f32_overlap_aabb.
+/// Four boxes are tested at once on SIMD capable architectures.
+void
+idlib_obb_3_f32_overlap_aabb_n
+  (
+    idlib_u8* target,
+    idlib_obb_3_f32 const* operand1,
+    idlib_aabb_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_OBB_H_INCLUDED
@@ -0,0 +1,140 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(IDLIB_PREDICATES_H_INCLUDED)
+#define IDLIB_PREDICATES_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+#include "vector_3.h"
+
+/// @since 1.5
+/// @brief Determine the orientation of three points in the plane.
+/// @param operand1, operand2, operand3 Pointers to the idlib_vector_2_f32 objects a, b, and c.
+/// @return
+/// A positive value if a, b, and c occur in counterclockwise order,
+/// a negative value if they occur in clockwise order,
+/// and zero if they are collinear.
+/// The returned value approximates twice the signed area of the triangle abc; its sign is exact.
+/// @remarks
+/// The determinant is first evaluated in idlib_f64 arithmetic.
+/// Only if its magnitude is below a forward error bound, it is re-evaluated exactly using floating-point expansions.
+/// The predicates require IEEE 754 double precision arithmetic with round-to-nearest (in particular, no x87 extended precision and no "fast math").
+idlib_f64
+idlib_orient_2_f32
+  (
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3
+  );
+
+/// @since 1.5
+/// @brief Determine the orientation of a point relative to the plane through three other points.
+/// @param operand1, operand2, operand3, operand4 Pointers to the idlib_vector_3_f32 objects a, b, c, and d.
+/// @return
+/// A positive value if d lies below the plane through a, b, and c, where "below" is defined such that a, b, and c
+/// appear in counterclockwise order when viewed from above the plane,
+/// a negative value if d lies above the plane,
+/// and zero if the points are coplanar.
+/// The returned value approximates six times the signed volume of the tetrahedron abcd; its sign is exact.
+/// @remarks See idlib_orient_2_f32 for the evaluation strategy.
+idlib_f64
+idlib_orient_3_f32
+  (
+    idlib_vector_3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2,
+    idlib_vector_3_f32 const* operand3,
+    idlib_vector_3_f32 const* operand4
+  );
+
+/// @since 1.5
+/// @brief Determine if a point lies inside the circle through three other points.
+/// @param operand1, operand2, operand3, operand4 Pointers to the idlib_vector_2_f32 objects a, b, c, and d.
+/// @return
+/// Provided that a, b, and c occur in counterclockwise order:
+/// A positive value if d lies inside the circle through a, b, and c,
+/// a negative value if d lies outside the circle,
+/// and zero if the four points are cocircular.
+/// The sign is reversed if a, b, and c occur in clockwise order.
+/// @remarks See idlib_orient_2_f32 for the evaluation strategy.
+idlib_f64
+idlib_in_circle_2_f32
+  (
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3,
+    idlib_vector_2_f32 const* operand4
+  );
+
+/// @since 1.5
+/// @brief Evaluate idlib_orient_2_f32 for @a count tuples of points.
+/// @param target Pointer to an array of @a count idlib_f64 values receiving the results.
+/// @param operand1, operand2, operand3 Pointers to arrays of @a count idlib_vector_2_f32 objects.
+/// The i-th tuple is <code>(operand1[i], operand2[i], operand3[i])</code>.
+/// @param count The number of tuples.
+/// @remarks
+/// The filtered determinants of all tuples are evaluated in a first pass free of branches.
+/// Only the tuples for which the filter is inconclusive are re-evaluated exactly in a second pass.
+void
+idlib_orient_2_f32_n
+  (
+    idlib_f64* target,
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate idlib_orient_3_f32 for @a count tuples of points.
+/// @param target Pointer to an array of @a count idlib_f64 values receiving the results.
+/// @param operand1, operand2, operand3, operand4 Pointers to arrays of @a count idlib_vector_3_f32 objects.
+/// @param count The number of tuples.
+/// @remarks See idlib_orient_2_f32_n.
+void
+idlib_orient_3_f32_n
+  (
+    idlib_f64* target,
+    idlib_vector_3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2,
+    idlib_vector_3_f32 const* operand3,
+    idlib_vector_3_f32 const* operand4,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Evaluate idlib_in_circle_2_f32 for @a count tuples of points.
+/// @param target Pointer to an array of @a count idlib_f64 values receiving the results.
+/// @param operand1, operand2, operand3, operand4 Pointers to arrays of @a count idlib_vector_2_f32 objects.
+/// @param count The number of tuples.
+/// @remarks See idlib_orient_2_f32_n.
+void
+idlib_in_circle_2_f32_n
+  (
+    idlib_f64* target,
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3,
+    idlib_vector_2_f32 const* operand4,
+    size_t count
+  );
+
+#endif // IDLIB_PREDICATES_H_INCLUDED
@@ -0,0 +1,140 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_PROJECTION_H_INCLUDED)
+#define IDLIB_PROJECTION_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "vector_4.h"
+#include "matrix_4x4.h"
+
+/// @since 1.5
+/// @brief A viewport, that is, a rectangle on the screen.
+/// @remarks
+/// The origin of the screen is its top left corner, the positive x-axis points to the right and the positive y-axis points to the bottom.
+typedef struct idlib_viewport_f32 {
+  /// The position of the left side of the viewport.
+  idlib_f32 left;
+  /// The position of the top side of the viewport.
+  idlib_f32 top;
+  /// The width of the viewport.
+  idlib_f32 width;
+  /// The height of the viewport.
+  idlib_f32 height;
+} idlib_viewport_f32;
+
+/// @since 1.5
+/// @brief Transform a position vector by a projective transformation and perform the perspective divide.
+/// @param target Pointer to an idlib_vector_3_f32 object receiving the normalized device coordinates.
+/// @param operand1 Pointer to an idlib_matrix_4x4_f32 object, the transformation (e.g., a product of a projection and a view matrix).
+/// @param operand2 Pointer to an idlib_vector_3_f32 object, the position vector.
+/// @return @a true if the point is in front of the camera, that is, if its clip space w component is positive.
+/// @a false otherwise. In that case, @a target is assigned the zero vector.
+/// @remarks
+/// Unlike idlib_matrix_4x4_3f_transform_point, this function takes the fourth row of the matrix into account.
+/// For matrices created by idlib_matrix_4x4_f32_set_perspective and idlib_matrix_4x4_f32_set_orthographic,
+/// points inside of the view volume are mapped to the cube [-1,+1] x [-1,+1] x [-1,+1].
+bool
+idlib_matrix_4x4_3f_project_point
+  (
+    idlib_vector_3_f32* target,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2
+  );
+
+/// @since 1.5
+/// @brief Transform the position vectors <code>[first, first + count)</code> of a stream into clip space.
+/// @param target Pointer to the idlib_vector_4_f32_soa object describing the stream receiving the clip space coordinates.
+/// @param operand1 Pointer to an idlib_matrix_4x4_f32 object, the transformation.
+/// @param operand2 Pointer to the idlib_vector_3_f32_soa object describing the stream of position vectors.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// The i-th clip space vector is <code>operand1 * (x[i], y[i], z[i], 1)</code>.
+/// Four vectors are transformed at once on SIMD capable architectures.
+/// An invocation reads the elements of the range of @a operand2 and writes the elements of the range of @a target (see the section on ranges in idlib-math.md).
+void
+idlib_matrix_4x4_f32_project_to_clip_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_vector_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Transform the position vectors <code>[first, first + count)</code> of a stream into normalized device coordinates.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the normalized device coordinates.
+/// @param visible Pointer to an array receiving, at index i, @a 1 if the i-th point is in front of the camera and @a 0 otherwise.
+/// @param operand1 Pointer to an idlib_matrix_4x4_f32 object, the transformation.
+/// @param operand2 Pointer to the idlib_vector_3_f32_soa object describing the stream of position vectors.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// See idlib_matrix_4x4_3f_project_point for the computation of a single vector.
+/// Points behind the camera are assigned the zero vector.
+/// See idlib_matrix_4x4_f32_project_to_clip_n for remarks on vectorization and threading.
+/// Like @a target, @a visible is written only at the indices of the range.
+void
+idlib_matrix_4x4_f32_project_to_ndc_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8* visible,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_vector_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Transform the position vectors <code>[first, first + count)</code> of a stream into screen coordinates.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the screen coordinates.
+/// @param visible Pointer to an array receiving, at index i, @a 1 if the i-th point is in front of the camera and @a 0 otherwise.
+/// @param operand1 Pointer to an idlib_matrix_4x4_f32 object, the transformation.
+/// @param viewport Pointer to the idlib_viewport_f32 object.
+/// @param operand2 Pointer to the idlib_vector_3_f32_soa object describing the stream of position vectors.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// The normalized device coordinates (x, y, z) of a point are mapped to
+/// @code
+/// (left + (x + 1) / 2 * width, top + (1 - y) / 2 * height, (z + 1) / 2)
+/// @endcode
+/// that is, the z component is the depth in [0,1].
+/// Points behind the camera are assigned the zero vector.
+/// See idlib_matrix_4x4_f32_project_to_clip_n for remarks on vectorization and threading.
+/// Like @a target, @a visible is written only at the indices of the range.
+void
+idlib_matrix_4x4_f32_project_to_screen_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8* visible,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_viewport_f32 const* viewport,
+    idlib_vector_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_PROJECTION_H_INCLUDED
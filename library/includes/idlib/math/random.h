@@ -0,0 +1,202 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#if !defined(IDLIB_RANDOM_H_INCLUDED)
+#define IDLIB_RANDOM_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_2.h"
+#include "vector_3.h"
+#include "aabb.h"
+
+/// @since 1.5
+/// @brief The number of lanes of an idlib_random object.
+#define IDLIB_RANDOM_LANES (4)
+
+/// @since 1.5
+/// @brief A pseudo-random number generator.
+/// @remarks
+/// The generator consists of IDLIB_RANDOM_LANES independent xoshiro128** generators ("lanes") which are advanced at once.
+/// <code>state[k][l]</code> is the k-th word of the state of the l-th lane.
+/// The lanes of a generator are initialized such that their sequences do not overlap for the first 2^64 numbers of each lane.
+///
+/// The numbers are produced in groups of IDLIB_RANDOM_LANES numbers, one number per lane.
+/// The sequence of numbers is the same on all architectures and does not depend on SIMD support.
+/// It only depends on the seed, the stream, and the counts of the numbers requested by the calls.
+/// If a count is not a multiple of IDLIB_RANDOM_LANES, then the remaining numbers of the last group are discarded.
+typedef struct idlib_random {
+  idlib_u32 state[4][IDLIB_RANDOM_LANES];
+} idlib_random;
+
+/// @since 1.5
+/// @brief Initialize an idlib_random object.
+/// @param target Pointer to the idlib_random object.
+/// @param seed The seed.
+/// @param stream The index of the stream.
+/// @remarks
+/// Generators initialized with the same seed and different streams produce different sequences of numbers.
+/// This allows for distributing sampling over threads, each with its own generator:
+/// The result of the computation does not depend on the schedule of the threads if the i-th part of the computation uses the stream i.
+/// The state of the first lane is derived from the seed and the stream by the SplitMix64 generator,
+/// the state of the l-th lane is that of the first lane advanced by <code>l * 2^64</code> numbers.
+void
+idlib_random_initialize
+  (
+    idlib_random* target,
+    idlib_u64 seed,
+    idlib_u64 stream
+  );
+
+/// @since 1.5
+/// @brief Generate uniformly distributed unsigned 32 bit integers.
+/// @param target Pointer to an array of @a count idlib_u32 values receiving the numbers.
+/// @param generator Pointer to the idlib_random object.
+/// @param count The number of numbers.
+void
+idlib_random_u32_n
+  (
+    idlib_u32* target,
+    idlib_random* generator,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Generate uniformly distributed numbers in [0, 1).
+/// @param target Pointer to an array of @a count idlib_f32 values receiving the numbers.
+/// @param generator Pointer to the idlib_random object.
+/// @param count The number of numbers.
+/// @remarks The numbers are multiples of 2^-24 computed from the upper 24 bits of 32 bit integers.
+void
+idlib_random_f32_n
+  (
+    idlib_f32* target,
+    idlib_random* generator,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Sample points <code>[first, first + count)</code> of a stream uniformly from an axis-aligned bounding box.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the points.
+/// @param generator Pointer to the idlib_random object.
+/// @param box Pointer to the idlib_aabb_3_f32 object.
+/// @param first The index of the first point.
+/// @param count The number of points.
+/// @remarks
+/// Each point consumes three numbers per lane.
+/// Four points are computed at once on SIMD capable architectures. The results are the same on all architectures.
+void
+idlib_random_sample_box_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    idlib_aabb_3_f32 const* box,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Sample points <code>[first, first + count)</code> of a stream uniformly from the unit sphere.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the points.
+/// @param generator Pointer to the idlib_random object.
+/// @param first The index of the first point.
+/// @param count The number of points.
+/// @remarks
+/// The z coordinate is uniform in [-1, 1] and the azimuth is uniform in [0, 2 pi) (Archimedes' hat-box theorem).
+/// The sine and cosine of the azimuth are evaluated by polynomials such that no rejection sampling is required
+/// and the results are the same on all architectures.
+/// Each point consumes two numbers per lane.
+void
+idlib_random_sample_sphere_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Sample points <code>[first, first + count)</code> of a stream uniformly from the unit hemisphere around the positive z axis.
+/// @remarks See idlib_random_sample_sphere_3_f32_n. The z coordinate is uniform in [0, 1].
+void
+idlib_random_sample_hemisphere_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Sample directions <code>[first, first + count)</code> of a stream from the unit hemisphere around the positive z axis with a density proportional to the cosine of their angle with the z axis.
+/// @remarks
+/// See idlib_random_sample_sphere_3_f32_n.
+/// A point sampled uniformly from the unit disk is projected up onto the hemisphere (Malley's method).
+/// The directions are the importance sampling distribution of diffuse (Lambertian) reflection.
+void
+idlib_random_sample_cosine_hemisphere_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Sample points <code>[first, first + count)</code> of a stream uniformly from the unit disk.
+/// @param target Pointer to the idlib_vector_2_f32_soa object describing the stream receiving the points.
+/// @param generator Pointer to the idlib_random object.
+/// @param first The index of the first point.
+/// @param count The number of points.
+/// @remarks See idlib_random_sample_sphere_3_f32_n. The radius is the square root of a uniformly distributed number.
+void
+idlib_random_sample_disk_2_f32_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Sample points <code>[first, first + count)</code> of a stream uniformly from a triangle.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the points.
+/// @param generator Pointer to the idlib_random object.
+/// @param operand1, operand2, operand3 Pointers to the idlib_vector_3_f32 objects, the vertices of the triangle.
+/// @param first The index of the first point.
+/// @param count The number of points.
+/// @remarks
+/// For uniformly distributed numbers u and v, the barycentric coordinates <code>(1 - sqrt(u), sqrt(u) (1 - v), sqrt(u) v)</code> are uniformly distributed over the triangle.
+/// Each point consumes two numbers per lane.
+void
+idlib_random_sample_triangle_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    idlib_vector_3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2,
+    idlib_vector_3_f32 const* operand3,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_RANDOM_H_INCLUDED
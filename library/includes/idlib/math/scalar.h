@@ -30,7 +30,7 @@
 // NULL
 #include <stddef.h>
 
-// uint8_t
+// uint8_t, uint16_t, uint32_t, uint64_t
 #include <inttypes.h>
 
 
@@ -38,6 +38,22 @@
 /// Alias for uint8_t.
 typedef uint8_t idlib_u8;
 
+/// @since 1.5
+/// Alias for uint16_t.
+typedef uint16_t idlib_u16;
+
+/// @since 1.5
+/// Alias for uint32_t.
+typedef uint32_t idlib_u32;
+
+/// @since 1.5
+/// Alias for uint64_t.
+typedef uint64_t idlib_u64;
+
+/// @since 1.5
+/// Alias for int32_t.
+typedef int32_t idlib_i32;
+
 /// @since 1.0
 /// Alias for float.
 typedef float idlib_f32;
@@ -47,6 +63,40 @@ typedef float idlib_f32;
 typedef double idlib_f64;
 
 
+/// @since 1.5
+/// @brief Specify the alignment, in Bytes, of a structure type.
+/// @param alignment The alignment. Must be a power of two.
+/// @remarks Place between the "struct" keyword and the name of the structure type, for example
+/// <code>typedef struct IDLIB_ALIGNAS(16) idlib_foo { ... } idlib_foo;</code>.
+#if IDLIB_COMPILER_C == IDLIB_COMPILER_C_MSVC
+  #define IDLIB_ALIGNAS(alignment) __declspec(align(alignment))
+#else
+  #define IDLIB_ALIGNAS(alignment) __attribute__((aligned(alignment)))
+#endif
+
+/// @since 1.5
+/// @brief Get the alignment, in Bytes, of a type.
+/// @param type The type.
+#if IDLIB_COMPILER_C == IDLIB_COMPILER_C_MSVC
+  #define IDLIB_ALIGNOF(type) __alignof(type)
+#else
+  #define IDLIB_ALIGNOF(type) __alignof__(type)
+#endif
+
+#define IDLIB_STATIC_ASSERT_CONCATENATE_IMPL(a, b) a##b
+#define IDLIB_STATIC_ASSERT_CONCATENATE(a, b) IDLIB_STATIC_ASSERT_CONCATENATE_IMPL(a, b)
+
+/// @since 1.5
+/// @brief Assert a constant expression at compile time.
+/// @param expression The constant expression.
+/// @param message A string literal describing the assertion.
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+  #define IDLIB_STATIC_ASSERT(expression, message) _Static_assert(expression, message)
+#else
+  #define IDLIB_STATIC_ASSERT(expression, message) \
+    typedef char IDLIB_STATIC_ASSERT_CONCATENATE(idlib_static_assert_, __COUNTER__)[(expression) ? 1 : -1]
+#endif
+
 #if _DEBUG
 
   void
@@ -0,0 +1,128 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#if !defined(IDLIB_SHADOW_H_INCLUDED)
+#define IDLIB_SHADOW_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "matrix_4x4.h"
+
+/// @since 1.5
+/// @brief Compute the split distances of cascaded shadow maps.
+/// @param target Pointer to an array of <code>number_of_cascades + 1</code> idlib_f32 values receiving the split distances.
+/// The i-th cascade covers the distances <code>[target[i], target[i + 1]]</code> from the camera.
+/// @param near_distance, far_distance The distances of the near and the far clip plane of the camera.
+/// @param weight The weight of the logarithmic split scheme. Must be in [0, 1].
+/// @param number_of_cascades The number of cascades. Must be positive.
+/// @remarks
+/// The "practical split scheme" is used: The i-th split distance is
+/// @code
+/// weight * n * (f / n)^(i / c) + (1 - weight) * (n + (f - n) * i / c)
+/// @endcode
+/// where n is the near distance, f is the far distance, and c is the number of cascades.
+/// That is, the distances interpolate between the logarithmic split scheme (distributing the texels evenly in screen space)
+/// and the uniform split scheme. A weight of about 0.75 is a good start.
+/// The first split distance is the near distance and the last split distance is the far distance.
+void
+idlib_shadow_cascades_f32_get_splits
+  (
+    idlib_f32* target,
+    idlib_f32 near_distance,
+    idlib_f32 far_distance,
+    idlib_f32 weight,
+    idlib_u32 number_of_cascades
+  );
+
+/// @since 1.5
+/// @brief Compute the view projection matrices of cascaded shadow maps of a directional light.
+/// @param target Pointer to an array of @a number_of_cascades idlib_matrix_4x4_f32 objects receiving the view projection matrices.
+/// @param view Pointer to the idlib_matrix_4x4_f32 object, the view matrix of the camera (e.g., created by idlib_matrix_4x4_f32_set_look_at).
+/// Must be an affine transformation.
+/// @param field_of_view_y, aspect_ratio The field of view along the y-axis, in degrees, and the aspect ratio of the camera
+/// as passed to idlib_matrix_4x4_f32_set_perspective.
+/// @param splits Pointer to an array of <code>number_of_cascades + 1</code> split distances (e.g., computed by idlib_shadow_cascades_f32_get_splits).
+/// @param number_of_cascades The number of cascades.
+/// @param direction Pointer to the idlib_vector_3_f32 object, the direction of the light. Must not be the zero vector.
+/// @param resolution The width and height of the shadow maps, in texels. Must be greater than one.
+/// @param extension The distance by which the view volumes are extended towards the light.
+/// @remarks
+/// The i-th matrix maps the part of the view frustum of the camera between the distances <code>splits[i]</code> and <code>splits[i + 1]</code>
+/// into the cube [-1,+1] x [-1,+1] x [-1,+1]. The view volume of the light is an axis-aligned box in the light space
+/// (which only depends on the direction of the light) tightly fitted to the eight corners of that part of the frustum.
+/// It is extended towards the light by @a extension such that objects between the light and the frustum cast shadows.
+///
+/// The bounds of the box in the x-y plane of the light space are snapped to multiples of the size of a texel.
+/// The size of a texel does not change if the camera moves without rotating,
+/// hence the texels of the shadow maps then do not move relative to the world and the shadows do not shimmer.
+void
+idlib_shadow_cascades_f32_set_view_projections
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_matrix_4x4_f32 const* view,
+    idlib_f32 field_of_view_y,
+    idlib_f32 aspect_ratio,
+    idlib_f32 const* splits,
+    idlib_u32 number_of_cascades,
+    idlib_vector_3_f32 const* direction,
+    idlib_u32 resolution,
+    idlib_f32 extension
+  );
+
+/// @since 1.5
+/// @brief Symbolic constant denoting the number of faces of a cube map.
+#define IDLIB_SHADOW_CUBE_FACES (6)
+
+/// @since 1.5
+/// @brief Compute the view projection matrices of the six faces of the cube shadow maps of the point lights <code>[first, first + count)</code>.
+/// @param target Pointer to an array of idlib_matrix_4x4_f32 objects.
+/// <code>target[IDLIB_SHADOW_CUBE_FACES * i + j]</code> receives the view projection matrix of the j-th face of the i-th light.
+/// @param positions Pointer to the idlib_vector_3_f32_soa object describing the stream of the positions of the lights.
+/// @param near_distance The distance of the near clip plane.
+/// @param far_distances Pointer to an array of idlib_f32 values. <code>far_distances[i]</code> is the distance of the far clip plane of the i-th light (e.g., its range).
+/// @param first The index of the first light.
+/// @param count The number of lights.
+/// @remarks
+/// The faces are ordered +x, -x, +y, -y, +z, -z and oriented as the faces of an OpenGL cube map texture:
+/// The j-th matrix is bit-identical to the product of
+/// <code>idlib_matrix_4x4_f32_set_perspective(90, 1, near_distance, far_distances[i])</code> and
+/// <code>idlib_matrix_4x4_f32_set_look_at(p, p + d, u)</code>
+/// where p is the position of the i-th light and the direction d and the up vector u of the faces are
+/// (+x, -y), (-x, -y), (+y, +z), (-y, -z), (+z, -y), and (-z, -y).
+///
+/// As the axes of the faces are the coordinate axes, the look-at transformations reduce to permutations and negations of the coordinates of the positions.
+/// They are computed for four lights at once on SIMD capable architectures.
+/// An invocation reads the positions and far distances of the lights of the range and writes the
+/// <code>IDLIB_SHADOW_CUBE_FACES * count</code> matrices starting at <code>target[IDLIB_SHADOW_CUBE_FACES * first]</code> (see the section on ranges in idlib-math.md).
+void
+idlib_shadow_cube_f32_set_view_projections_n
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_vector_3_f32_soa const* positions,
+    idlib_f32 near_distance,
+    idlib_f32 const* far_distances,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_SHADOW_H_INCLUDED
@@ -0,0 +1,136 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#if !defined(IDLIB_SKINNING_H_INCLUDED)
+#define IDLIB_SKINNING_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "matrix_4x4.h"
+
+/// @since 1.5
+/// @brief The number of bone influences per vertex.
+#define IDLIB_SKINNING_NUMBER_OF_INFLUENCES (4)
+
+/// @since 1.5
+/// @brief A unit dual quaternion representing a rigid transformation.
+/// @remarks
+/// The components are stored in the order <code>(x, y, z, w)</code>.
+/// @a real is the rotation part, @a dual is the translation part.
+typedef struct idlib_dual_quaternion_f32 {
+  idlib_f32 real[4];
+  idlib_f32 dual[4];
+} idlib_dual_quaternion_f32;
+
+/// @since 1.5
+/// @brief Describes the vertex streams of a skinning job.
+/// @remarks
+/// The bone indices and the bone weights of the i-th vertex are stored at
+/// <code>[i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES, (i + 1) * IDLIB_SKINNING_NUMBER_OF_INFLUENCES)</code>.
+/// The weights of a vertex are expected to sum up to one. Unused influences must have a weight of zero.
+///
+/// If @a source_normals.x is a null pointer, then normals are neither read nor written.
+typedef struct idlib_skinning_f32_job {
+  /// The bind pose positions.
+  idlib_vector_3_f32_soa source_positions;
+  /// The bind pose normals.
+  idlib_vector_3_f32_soa source_normals;
+  /// The skinned positions.
+  idlib_vector_3_f32_soa target_positions;
+  /// The skinned normals.
+  idlib_vector_3_f32_soa target_normals;
+  /// The indices of the bones influencing the vertices.
+  idlib_u16 const* bone_indices;
+  /// The weights of the bones influencing the vertices.
+  idlib_f32 const* bone_weights;
+} idlib_skinning_f32_job;
+
+/// @since 1.5
+/// @brief Assign an idlib_dual_quaternion_f32 object the rigid transformation represented by an idlib_matrix_4x4_f32 object.
+/// @param target Pointer to the idlib_dual_quaternion_f32 object to assign the result to.
+/// @param operand Pointer to the idlib_matrix_4x4_f32 object.
+/// @remarks
+/// The upper left 3x3 matrix of @a operand is expected to be a rotation matrix.
+/// The fourth column of @a operand is the translation.
+void
+idlib_dual_quaternion_f32_set_matrix_4x4
+  (
+    idlib_dual_quaternion_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Convert a palette of bone matrices into a palette of dual quaternions.
+/// @param target Pointer to an array of @a count idlib_dual_quaternion_f32 objects.
+/// @param operand Pointer to an array of @a count idlib_matrix_4x4_f32 objects.
+/// @param count The number of bones.
+void
+idlib_dual_quaternion_f32_set_matrix_4x4_n
+  (
+    idlib_dual_quaternion_f32* target,
+    idlib_matrix_4x4_f32 const* operand,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Deform the vertices <code>[first, first + count)</code> of a skinning job by linear blend skinning.
+/// @param job Pointer to the skinning job.
+/// @param palette Pointer to the array of bone matrices.
+/// @param first The index of the first vertex.
+/// @param count The number of vertices.
+/// @remarks
+/// For each vertex the bone matrices are blended by their weights and the blended matrix is applied
+/// to the position and the normal. Skinned normals are re-normalized.
+///
+/// Invocations on disjoint vertex ranges of the same job do not interfere.
+/// Deforming a large mesh or a crowd of characters can hence be distributed over threads by assigning each thread a range of vertices or a set of jobs.
+void
+idlib_skinning_f32_linear_blend
+  (
+    idlib_skinning_f32_job const* job,
+    idlib_matrix_4x4_f32 const* palette,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Deform the vertices <code>[first, first + count)</code> of a skinning job by dual quaternion skinning.
+/// @param job Pointer to the skinning job.
+/// @param palette Pointer to the array of bone dual quaternions.
+/// @param first The index of the first vertex.
+/// @param count The number of vertices.
+/// @remarks
+/// For each vertex the bone dual quaternions are blended by their weights (antipodality is resolved relative to the first influence),
+/// normalized, and applied to the position and the normal.
+/// Unlike linear blend skinning, this preserves volume at twisting joints but supports rigid bone transformations only.
+/// On SIMD capable architectures, the real and the dual part of the blended dual quaternion of a vertex are held in one SIMD register each,
+/// and the normalization and the transformation of the vertex are computed with SIMD operations.
+/// See idlib_skinning_f32_linear_blend for remarks on threading.
+void
+idlib_skinning_f32_dual_quaternion_blend
+  (
+    idlib_skinning_f32_job const* job,
+    idlib_dual_quaternion_f32 const* palette,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_SKINNING_H_INCLUDED
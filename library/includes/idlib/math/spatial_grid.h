@@ -0,0 +1,316 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_SPATIAL_GRID_H_INCLUDED)
+#define IDLIB_SPATIAL_GRID_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+
+/// @since 1.5
+/// @brief Symbolic constant denoting "no point".
+#define IDLIB_SPATIAL_GRID_NONE (0xFFFFFFFFu)
+
+/// @since 1.5
+/// @brief A uniform grid of cubic cells over a set of points for neighbor queries.
+/// @remarks
+/// The cell of a point p is the cell with the integer coordinates <code>floor(p[k] / cell_size)</code>, k = 0, 1, 2.
+/// The cells are hashed into a table of buckets. The points are sorted by their buckets (by counting sort)
+/// such that the points of a bucket are consecutive: The points of the i-th bucket are the points at the positions
+/// <code>[cell_start[i], cell_start[i] + cell_count[i])</code>.
+/// A bucket may contain the points of several cells.
+///
+/// The arrays are located in a workspace provided by the caller.
+typedef struct idlib_spatial_grid {
+  /// @brief <code>cell_start[i]</code> is the position of the first point of the i-th bucket.
+  idlib_u32* cell_start;
+  /// @brief <code>cell_count[i]</code> is the number of points of the i-th bucket.
+  idlib_u32* cell_count;
+  /// @brief <code>indices[j]</code> is the index of the point at the j-th position.
+  idlib_u32* indices;
+  /// @brief <code>(x[j], y[j], z[j])</code> is the point at the j-th position.
+  idlib_f32* x;
+  idlib_f32* y;
+  idlib_f32* z;
+  /// @brief The number of points.
+  idlib_u32 number_of_points;
+  /// @brief The maximum number of points.
+  idlib_u32 capacity;
+  /// @brief The number of buckets. A power of two.
+  idlib_u32 number_of_buckets;
+  /// @brief The size of the cells.
+  idlib_f32 cell_size;
+  /// @brief The minimum and maximum coordinates of the cells containing points.
+  idlib_i32 minimum[3];
+  idlib_i32 maximum[3];
+} idlib_spatial_grid;
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by an idlib_spatial_grid object.
+/// @param capacity The maximum number of points.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 16 Bytes.
+size_t
+idlib_spatial_grid_get_workspace_size
+  (
+    idlib_u32 capacity
+  );
+
+/// @since 1.5
+/// @brief Initialize an idlib_spatial_grid object.
+/// @param target Pointer to the idlib_spatial_grid object.
+/// @param capacity The maximum number of points.
+/// @param workspace Pointer to a workspace of idlib_spatial_grid_get_workspace_size(capacity) Bytes.
+/// The workspace must remain valid as long as @a target is used.
+/// @remarks The grid contains no points.
+void
+idlib_spatial_grid_initialize
+  (
+    idlib_spatial_grid* target,
+    idlib_u32 capacity,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Build a grid over a set of points.
+/// @param target Pointer to the idlib_spatial_grid object.
+/// @param operand Pointer to the idlib_vector_3_f32_soa object describing the stream of points.
+/// @param number_of_points The number of points. Must not exceed the capacity of @a target.
+/// @param cell_size The size of the cells. Must be positive.
+/// Queries are most efficient if the cell size is about the query radius.
+/// @remarks
+/// The coordinates of the points divided by @a cell_size must be less than 2^31 in magnitude.
+/// The number of buckets is the smallest power of two not less than the number of points.
+/// The points are sorted by counting sort: The points of each bucket are counted,
+/// the start positions of the buckets are computed by a prefix sum over the counts (four buckets at once on SIMD capable architectures),
+/// and the points are scattered to their positions. The points of a bucket are in the order of their indices.
+/// See idlib_spatial_grid_build_job for a build distributed over threads.
+void
+idlib_spatial_grid_build
+  (
+    idlib_spatial_grid* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_f32 cell_size
+  );
+
+/// @since 1.5
+/// @brief The state of a build of an idlib_spatial_grid object in phases which can be distributed over threads.
+/// @remarks
+/// The points are split into @a number_of_ranges ranges of consecutive points and the buckets into at most @a number_of_ranges blocks of consecutive buckets.
+/// Each phase is a function invoked for each i in <code>[0, number_of_ranges)</code>:
+/// - idlib_spatial_grid_build_job_count counts the points of the i-th range per bucket.
+/// - idlib_spatial_grid_build_job_scan sums the counts of the buckets of the i-th block over the ranges
+///   and computes the start positions of the buckets relative to the block and of the ranges relative to the buckets.
+/// - idlib_spatial_grid_build_job_scatter computes the start positions of the blocks by an exclusive prefix sum over the totals of the blocks
+///   and scatters the points of the i-th range to their positions.
+///
+/// The invocations of a phase do not write to shared data and can run concurrently.
+/// All invocations of a phase must have returned before an invocation of the next phase begins.
+/// The grid is the same as the grid built by idlib_spatial_grid_build. The members are private.
+typedef struct idlib_spatial_grid_build_job {
+  idlib_spatial_grid* target;
+  idlib_vector_3_f32_soa operand;
+  idlib_u32 number_of_points;
+  idlib_f32 inverse_cell_size;
+  idlib_u32 number_of_ranges;
+  idlib_u32 block_shift;
+  idlib_u32* counts;
+  idlib_u32* bases;
+  idlib_u32* totals;
+  idlib_i32* bounds;
+} idlib_spatial_grid_build_job;
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by an idlib_spatial_grid_build_job object.
+/// @param capacity The capacity of the grid.
+/// @param number_of_ranges The number of ranges.
+/// @return The size of the workspace, in Bytes.
+/// @remarks
+/// The workspace must be aligned to 4 Bytes.
+/// Each range requires a count for each bucket, that is, about <code>4 * number_of_ranges * capacity</code> Bytes.
+size_t
+idlib_spatial_grid_build_job_get_workspace_size
+  (
+    idlib_u32 capacity,
+    idlib_u32 number_of_ranges
+  );
+
+/// @since 1.5
+/// @brief Initialize an idlib_spatial_grid_build_job object.
+/// @param job Pointer to the idlib_spatial_grid_build_job object.
+/// @param target, operand, number_of_points, cell_size See idlib_spatial_grid_build.
+/// @param number_of_ranges The number of ranges. Must be positive. Usually the number of threads.
+/// @param workspace Pointer to a workspace of idlib_spatial_grid_build_job_get_workspace_size(target->capacity, number_of_ranges) Bytes.
+/// @remarks
+/// The object pointed to by @a operand is copied, the stream it describes is not.
+/// The grid must not be used until the last phase has completed.
+void
+idlib_spatial_grid_build_job_initialize
+  (
+    idlib_spatial_grid_build_job* job,
+    idlib_spatial_grid* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_f32 cell_size,
+    idlib_u32 number_of_ranges,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief The first phase of a build job: Count the points of the i-th range per bucket.
+/// @param job Pointer to the idlib_spatial_grid_build_job object.
+/// @param i The index of the range.
+/// @remarks Reads the points of the i-th range and writes the i-th row of the counts and the bounds of the cells of the range.
+void
+idlib_spatial_grid_build_job_count
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief The second phase of a build job: Scan the counts of the buckets of the i-th block.
+/// @param job Pointer to the idlib_spatial_grid_build_job object.
+/// @param i The index of the block.
+/// @remarks
+/// Reads and writes the counts of the buckets of the i-th block in all ranges and writes their counts and (relative) start positions in the grid.
+/// The 0-th invocation also writes the bounds of the cells of the grid.
+void
+idlib_spatial_grid_build_job_scan
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief The third phase of a build job: Scatter the points of the i-th range.
+/// @param job Pointer to the idlib_spatial_grid_build_job object.
+/// @param i The index of the range.
+/// @remarks
+/// Reads the points of the i-th range and writes them to their positions in the grid.
+/// Adds the start position of the i-th block to the start positions of its buckets.
+void
+idlib_spatial_grid_build_job_scatter
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief Find the points within a radius of a query point.
+/// @param target Pointer to an array of @a capacity elements receiving the indices of the points.
+/// @param capacity The maximum number of indices to store.
+/// @param operand Pointer to the idlib_spatial_grid object.
+/// @param point Pointer to the idlib_vector_3_f32 object denoting the query point.
+/// @param radius The radius. Must not be negative.
+/// @return The number of points found. If this is greater than @a capacity, then only the first @a capacity indices were stored.
+/// @remarks
+/// A point is found if its squared distance to the query point (computed in idlib_f32 arithmetic) is less than or equal to the square of the radius.
+/// The order of the indices is unspecified.
+/// The cells overlapping the cube of side length <code>2 * radius</code> centered at the query point are visited
+/// and the points of their buckets are tested four at once on SIMD capable architectures.
+size_t
+idlib_spatial_grid_query_radius
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_f32 radius
+  );
+
+/// @since 1.5
+/// @brief Find the points within a radius of the query points <code>[first, first + count)</code> of a stream.
+/// @param offsets Pointer to an array of <code>count + 1</code> elements.
+/// The indices of the points found for the i-th query point are stored at the positions <code>[offsets[i - first], offsets[i - first + 1])</code> of @a target.
+/// @param target Pointer to an array of @a capacity elements receiving the indices of the points.
+/// @param capacity The maximum number of indices to store.
+/// @param operand Pointer to the idlib_spatial_grid object.
+/// @param points Pointer to the idlib_vector_3_f32_soa object describing the stream of query points.
+/// @param radius The radius. Must not be negative.
+/// @param first, count The range of query points.
+/// @return The total number of points found. If this is greater than @a capacity, then only the first @a capacity indices were stored
+/// (and @a offsets may exceed @a capacity).
+/// @remarks
+/// The ranges of query points can be processed concurrently (e.g., by different threads) into different arrays.
+size_t
+idlib_spatial_grid_query_radius_n
+  (
+    size_t* offsets,
+    idlib_u32* target,
+    size_t capacity,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_f32 radius,
+    size_t first,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Find the k nearest points of a query point.
+/// @param target Pointer to an array of @a k elements receiving the indices of the points in ascending order of their distances.
+/// @param distances Pointer to an array of @a k elements receiving the squared distances of the points.
+/// @param operand Pointer to the idlib_spatial_grid object.
+/// @param point Pointer to the idlib_vector_3_f32 object denoting the query point.
+/// @param k The number of points to find.
+/// @return The number of points found. This is the minimum of @a k and the number of points of the grid.
+/// The remaining elements of @a target are set to IDLIB_SPATIAL_GRID_NONE and those of @a distances to infinity.
+/// @remarks
+/// The cells are visited in shells of increasing distance from the cell of the query point.
+/// The search terminates if k points were found and no point in the next shell can be nearer than the k-th nearest point found.
+/// Cells farther away than the k-th nearest point found are skipped.
+/// The search is efficient if the k nearest points are within a few cells of the query point.
+idlib_u32
+idlib_spatial_grid_query_nearest
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_u32 k
+  );
+
+/// @since 1.5
+/// @brief Find the k nearest points of the query points <code>[first, first + count)</code> of a stream.
+/// @param target Pointer to an array of <code>count * k</code> elements.
+/// The indices of the points found for the i-th query point are stored at the positions <code>[(i - first) * k, (i - first + 1) * k)</code>.
+/// @param distances Pointer to an array of <code>count * k</code> elements receiving the squared distances.
+/// @param operand Pointer to the idlib_spatial_grid object.
+/// @param points Pointer to the idlib_vector_3_f32_soa object describing the stream of query points.
+/// @param k The number of points to find for each query point.
+/// @param first, count The range of query points.
+/// @remarks See idlib_spatial_grid_query_nearest.
+/// The ranges of query points can be processed concurrently (e.g., by different threads) into different arrays.
+void
+idlib_spatial_grid_query_nearest_n
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_u32 k,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_SPATIAL_GRID_H_INCLUDED
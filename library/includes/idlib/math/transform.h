@@ -0,0 +1,163 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_TRANSFORM_H_INCLUDED)
+#define IDLIB_TRANSFORM_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+#include "vector_4.h"
+#include "matrix_4x4.h"
+
+/// @since 1.5
+/// @brief A transformation composed of a scaling, a rotation, and a translation (in that order).
+/// @remarks
+/// The transformation is represented by the matrix <code>T * R * S</code>
+/// where T is the translation matrix of @a translation, R is the rotation matrix of @a rotation, and S is the scaling matrix of @a scale.
+/// @a rotation is a unit quaternion with its components stored in the order <code>(x, y, z, w)</code>.
+typedef struct idlib_transform_f32 {
+  idlib_vector_3_f32 translation;
+  idlib_vector_4_f32 rotation;
+  idlib_vector_3_f32 scale;
+} idlib_transform_f32;
+
+/// @since 1.5
+/// @brief Assign an idlib_matrix_4x4_f32 object the matrix of an idlib_transform_f32 object.
+/// @param target Pointer to the idlib_matrix_4x4_f32 object to assign the result to.
+/// @param operand Pointer to the idlib_transform_f32 object.
+/// @remarks
+/// The matrix <code>T * R * S</code> is written in one pass:
+/// The i-th column of the upper left 3x3 matrix is the i-th column of R scaled by the i-th component of the scale,
+/// the fourth column is the translation.
+/// This is equivalent to but considerably cheaper than composing the matrices created by idlib_matrix_4x4_f32_set_translate,
+/// idlib_matrix_4x4_f32_set_rotation_*, and idlib_matrix_4x4_f32_set_scale by idlib_matrix_4x4_f32_multiply.
+void
+idlib_matrix_4x4_f32_set_transform
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_transform_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Assign idlib_matrix_4x4_f32 objects the matrices of idlib_transform_f32 objects.
+/// @param target Pointer to an array of @a count idlib_matrix_4x4_f32 objects.
+/// @param operand Pointer to an array of @a count idlib_transform_f32 objects.
+/// @param count The number of transformations.
+void
+idlib_matrix_4x4_f32_set_transform_n
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_transform_f32 const* operand,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Decompose an affine transformation matrix into a translation, a rotation, and a scaling.
+/// @param target Pointer to the idlib_transform_f32 object to assign the result to.
+/// @param operand Pointer to the idlib_matrix_4x4_f32 object.
+/// The fourth row is expected to be <code>(0, 0, 0, 1)</code>.
+/// @return @a true on success.
+/// @a false if the upper left 3x3 matrix of @a operand is singular.
+/// In that case, the rotation is the identity and the scale consists of the lengths of the columns of the upper left 3x3 matrix.
+/// @remarks
+/// The translation is the fourth column of @a operand.
+/// The upper left 3x3 matrix A is factored into <code>A = Q * P</code> by the polar decomposition
+/// where Q is orthogonal and P is symmetric positive definite.
+/// Q is computed by the scaled Newton iteration <code>Q := (g * Q + Q^-T / g) / 2</code>.
+/// The rotation is Q and the scale is the diagonal of P.
+/// If A contains a shear, then the off-diagonal elements of P are non-zero and are discarded;
+/// the result is the closest transformation without shear in the sense of the polar decomposition.
+/// If A contains a reflection (its determinant is negative), then the x component of the scale is negative.
+bool
+idlib_transform_f32_set_matrix_4x4
+  (
+    idlib_transform_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Decompose affine transformation matrices into translations, rotations, and scalings.
+/// @param target Pointer to an array of @a count idlib_transform_f32 objects.
+/// @param operand Pointer to an array of @a count idlib_matrix_4x4_f32 objects.
+/// @param count The number of matrices.
+/// @return @a true if all matrices were decomposed successfully, @a false otherwise.
+/// @remarks See idlib_transform_f32_set_matrix_4x4.
+bool
+idlib_transform_f32_set_matrix_4x4_n
+  (
+    idlib_transform_f32* target,
+    idlib_matrix_4x4_f32 const* operand,
+    size_t count
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_matrix_4x4_f32 object the "normal matrix" of an idlib_matrix_4x4_f32 object.
+/// @param target Pointer to the idlib_matrix_4x4_f32 object to assign the result to.
+/// @param operand Pointer to the idlib_matrix_4x4_f32 object, the transformation of positions.
+/// @remarks
+/// Normals must be transformed by the inverse transpose of the upper left 3x3 matrix A of the transformation of the positions
+/// rather than by A itself (as idlib_matrix_4x4_3f_transform_direction does) unless A is a rotation times a uniform scaling.
+/// Since normals are renormalized after the transformation, the cofactor matrix <code>cof(A) = det(A) * A^-T</code> is used instead.
+/// It is multiplied by the sign of det(A) such that normals are not flipped by reflections.
+/// This requires neither a division nor a full inverse and is well-defined even if A is singular.
+///
+/// The upper left 3x3 matrix of @a target is assigned the result, the fourth row and the fourth column are assigned <code>(0, 0, 0, 1)</code>.
+/// Hence, @a target can be used with idlib_matrix_4x4_3f_transform_direction.
+/// @a target and @a operand may refer to the same object.
+void
+idlib_matrix_4x4_f32_set_normal_matrix
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Transform and renormalize the normals and tangents <code>[first, first + count)</code> of streams.
+/// @param target_normals Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the normals.
+/// @param target_tangents Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the tangents.
+/// @param operand Pointer to the idlib_matrix_4x4_f32 object, the transformation of positions.
+/// @param source_normals Pointer to the idlib_vector_3_f32_soa object describing the stream of normals.
+/// @param source_tangents Pointer to the idlib_vector_3_f32_soa object describing the stream of tangents.
+/// If @a source_tangents->x is a null pointer, then tangents are neither read nor written.
+/// @param first The index of the first vector.
+/// @param count The number of vectors.
+/// @remarks
+/// The normals are transformed by the normal matrix (see idlib_matrix_4x4_f32_set_normal_matrix),
+/// the tangents are transformed by the upper left 3x3 matrix of @a operand, as they lie in the surface.
+/// Both are then normalized. Vectors of length zero remain zero vectors.
+/// Four normals and tangents are processed at once on SIMD capable architectures.
+/// If the determinant of the transformation is negative, the handedness of tangent frames is reversed and the caller must negate bitangent signs.
+/// An invocation computes the normal matrix of @a operand locally, reads the vectors of the range of the source streams,
+/// and writes the vectors of the range of the target streams (see the section on ranges in idlib-math.md).
+void
+idlib_matrix_4x4_f32_transform_normals_n
+  (
+    idlib_vector_3_f32_soa const* target_normals,
+    idlib_vector_3_f32_soa const* target_tangents,
+    idlib_matrix_4x4_f32 const* operand,
+    idlib_vector_3_f32_soa const* source_normals,
+    idlib_vector_3_f32_soa const* source_tangents,
+    size_t first,
+    size_t count
+  );
+
+#endif // IDLIB_TRANSFORM_H_INCLUDED
@@ -30,6 +30,15 @@ typedef struct idlib_vector_2_f23 {
   idlib_f32 e[2];
 } idlib_vector_2_f32;
 
+/// @since 1.5
+/// @brief A stream of two component vectors with elements of type idlib_f32 in "structure of arrays" layout.
+/// The i-th vector of the stream is <code>(x[i], y[i])</code>.
+/// @remarks See idlib_vector_3_f32_soa.
+typedef struct idlib_vector_2_f32_soa {
+  idlib_f32* x;
+  idlib_f32* y;
+} idlib_vector_2_f32_soa;
+
 /// @since 1.0
 /// @brief Get the squared length of a idlib_vector_2_f32 object.
 /// @param operand A pointer to the idlib_vector_2_f32 object of which the squared length is computed.
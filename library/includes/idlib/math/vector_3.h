@@ -30,6 +30,34 @@ typedef struct idlib_vector_3_f32 {
   idlib_f32 e[3];
 } idlib_vector_3_f32;
 
+/// @since 1.5
+/// @brief A stream of three component vectors with elements of type idlib_f32 in "structure of arrays" layout.
+/// The i-th vector of the stream is <code>(x[i], y[i], z[i])</code>.
+/// @remarks
+/// Batch functions operate on streams rather than on arrays of idlib_vector_3_f32 objects
+/// such that consecutive x, y, and z components can be loaded into SIMD registers directly.
+typedef struct idlib_vector_3_f32_soa {
+  idlib_f32* x;
+  idlib_f32* y;
+  idlib_f32* z;
+} idlib_vector_3_f32_soa;
+
+/// @since 1.5
+/// @brief A three component vector with elements of type idlib_f32 aligned to and padded to 16 Bytes.
+/// @remarks
+/// The elements are stored at the same offsets as in idlib_vector_3_f32.
+/// The padding allows for loading an idlib_vector_3a_f32 object into a SIMD register with a single aligned load,
+/// arrays of idlib_vector_3a_f32 objects do not straddle cache lines.
+/// The value of the padding is unspecified.
+typedef struct IDLIB_ALIGNAS(16) idlib_vector_3a_f32 {
+  idlib_f32 e[3];
+  idlib_f32 padding;
+} idlib_vector_3a_f32;
+
+IDLIB_STATIC_ASSERT(sizeof(idlib_vector_3_f32) == 12, "idlib_vector_3_f32 must be 12 Bytes");
+IDLIB_STATIC_ASSERT(sizeof(idlib_vector_3a_f32) == 16, "idlib_vector_3a_f32 must be 16 Bytes");
+IDLIB_STATIC_ASSERT(IDLIB_ALIGNOF(idlib_vector_3a_f32) == 16, "idlib_vector_3a_f32 must be aligned to 16 Bytes");
+
 /// @since 1.0
 /// @brief Get the squared length of a idlib_vector_3_f32 object.
 /// @param operand A pointer to the idlib_vector_3_f32 object of which the squared length is computed.
@@ -179,6 +207,29 @@ idlib_vector_3_f32_get_data
     idlib_vector_3_f32* operand
   );
 
+/// @since 1.5
+/// @brief Assign an idlib_vector_3_f32 object the values of an idlib_vector_3a_f32 object.
+/// @param target Pointer to the idlib_vector_3_f32 object to assign the values to.
+/// @param operand Pointer to the idlib_vector_3a_f32 object.
+static inline void
+idlib_vector_3_f32_set_vector_3a
+  (
+    idlib_vector_3_f32* target,
+    idlib_vector_3a_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_vector_3a_f32 object the values of an idlib_vector_3_f32 object.
+/// @param target Pointer to the idlib_vector_3a_f32 object to assign the values to.
+/// @param operand Pointer to the idlib_vector_3_f32 object.
+/// @remarks The padding of @a target is assigned zero.
+static inline void
+idlib_vector_3a_f32_set_vector_3
+  (
+    idlib_vector_3a_f32* target,
+    idlib_vector_3_f32 const* operand
+  );
+
 static inline idlib_f32
 idlib_vector_3_f32_squared_length
   (
@@ -351,4 +402,33 @@ idlib_vector_3_f32_get_data
   )
 { return &(operand->e[0]); }
 
+static inline void
+idlib_vector_3_f32_set_vector_3a
+  (
+    idlib_vector_3_f32* target,
+    idlib_vector_3a_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  target->e[0] = operand->e[0];
+  target->e[1] = operand->e[1];
+  target->e[2] = operand->e[2];
+}
+
+static inline void
+idlib_vector_3a_f32_set_vector_3
+  (
+    idlib_vector_3a_f32* target,
+    idlib_vector_3_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  target->e[0] = operand->e[0];
+  target->e[1] = operand->e[1];
+  target->e[2] = operand->e[2];
+  target->padding = 0.f;
+}
+
 #endif // IDLIB_VECTOR_3_H_INCLUDED
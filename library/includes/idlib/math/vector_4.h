@@ -30,6 +30,30 @@ typedef struct idlib_vector_4_f32 {
   idlib_f32 e[4];
 } idlib_vector_4_f32;
 
+/// @since 1.5
+/// @brief A stream of four component vectors with elements of type idlib_f32 in "structure of arrays" layout.
+/// The i-th vector of the stream is <code>(x[i], y[i], z[i], w[i])</code>.
+/// @remarks See idlib_vector_3_f32_soa.
+typedef struct idlib_vector_4_f32_soa {
+  idlib_f32* x;
+  idlib_f32* y;
+  idlib_f32* z;
+  idlib_f32* w;
+} idlib_vector_4_f32_soa;
+
+/// @since 1.5
+/// @brief A four component vector with elements of type idlib_f32 aligned to 16 Bytes.
+/// @remarks
+/// The elements are stored at the same offsets as in idlib_vector_4_f32.
+/// The alignment allows for loading an idlib_vector_4a_f32 object into a SIMD register with a single aligned load.
+typedef struct IDLIB_ALIGNAS(16) idlib_vector_4a_f32 {
+  idlib_f32 e[4];
+} idlib_vector_4a_f32;
+
+IDLIB_STATIC_ASSERT(sizeof(idlib_vector_4_f32) == 16, "idlib_vector_4_f32 must be 16 Bytes");
+IDLIB_STATIC_ASSERT(sizeof(idlib_vector_4a_f32) == 16, "idlib_vector_4a_f32 must be 16 Bytes");
+IDLIB_STATIC_ASSERT(IDLIB_ALIGNOF(idlib_vector_4a_f32) == 16, "idlib_vector_4a_f32 must be aligned to 16 Bytes");
+
 /// @since 1.0
 /// @brief Get the squared length of a idlib_vector_4_f32 object.
 /// @param operand A pointer to the idlib_vector_4_f32 object of which the squared length is computed.
@@ -166,6 +190,28 @@ idlib_vector_4_f32_get_data
     idlib_vector_4_f32* operand
   );
 
+/// @since 1.5
+/// @brief Assign an idlib_vector_4_f32 object the values of an idlib_vector_4a_f32 object.
+/// @param target Pointer to the idlib_vector_4_f32 object to assign the values to.
+/// @param operand Pointer to the idlib_vector_4a_f32 object.
+static inline void
+idlib_vector_4_f32_set_vector_4a
+  (
+    idlib_vector_4_f32* target,
+    idlib_vector_4a_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Assign an idlib_vector_4a_f32 object the values of an idlib_vector_4_f32 object.
+/// @param target Pointer to the idlib_vector_4a_f32 object to assign the values to.
+/// @param operand Pointer to the idlib_vector_4_f32 object.
+static inline void
+idlib_vector_4a_f32_set_vector_4
+  (
+    idlib_vector_4a_f32* target,
+    idlib_vector_4_f32 const* operand
+  );
+
 static inline idlib_f32
 idlib_vector_4_f32_squared_length
   (
@@ -330,4 +376,34 @@ idlib_vector_4_f32_get_data
   )
 { return &(operand->e[0]); }
 
+static inline void
+idlib_vector_4_f32_set_vector_4a
+  (
+    idlib_vector_4_f32* target,
+    idlib_vector_4a_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  target->e[0] = operand->e[0];
+  target->e[1] = operand->e[1];
+  target->e[2] = operand->e[2];
+  target->e[3] = operand->e[3];
+}
+
+static inline void
+idlib_vector_4a_f32_set_vector_4
+  (
+    idlib_vector_4a_f32* target,
+    idlib_vector_4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  target->e[0] = operand->e[0];
+  target->e[1] = operand->e[1];
+  target->e[2] = operand->e[2];
+  target->e[3] = operand->e[3];
+}
+
 #endif // IDLIB_VECTOR_3_H_INCLUDED
@@ -0,0 +1,178 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_VERTEX_CACHE_H_INCLUDED)
+#define IDLIB_VERTEX_CACHE_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+
+/// @since 1.5
+/// @brief The size of the vertex cache modelled by idlib_vertex_cache_optimize.
+#define IDLIB_VERTEX_CACHE_SIZE (32)
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by idlib_vertex_cache_optimize.
+/// @param number_of_indices The number of indices, three times the number of triangles.
+/// @param number_of_vertices The number of vertices.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 4 Bytes.
+size_t
+idlib_vertex_cache_get_workspace_size
+  (
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices
+  );
+
+/// @since 1.5
+/// @brief Reorder the triangles of an indexed triangle list for the post-transform vertex cache.
+/// @param target Pointer to an array of @a number_of_indices elements receiving the reordered indices.
+/// Must not overlap with @a indices.
+/// @param indices Pointer to an array of @a number_of_indices indices. The i-th triangle is <code>(indices[3 * i], indices[3 * i + 1], indices[3 * i + 2])</code>.
+/// @param number_of_indices The number of indices. Must be a multiple of three.
+/// @param number_of_vertices The number of vertices. All indices must be less than this.
+/// @param workspace Pointer to a workspace of idlib_vertex_cache_get_workspace_size Bytes.
+/// @remarks
+/// This is Tom Forsyth's "Linear-Speed Vertex Cache Optimisation":
+/// A least recently used cache of IDLIB_VERTEX_CACHE_SIZE vertices is simulated.
+/// Each vertex is scored by its position in the cache and by the number of its triangles not yet emitted,
+/// each triangle is scored by the sum of the scores of its vertices.
+/// The triangle with the highest score among the triangles of the vertices in the cache is emitted next.
+/// Only the scores of the vertices in the cache and of their triangles change when a triangle is emitted, hence the time is linear in the number of triangles.
+/// The winding order of the triangles is preserved.
+/// Apply idlib_overdraw_optimize to the result to reduce overdraw as well.
+void
+idlib_vertex_cache_optimize
+  (
+    idlib_u32* target,
+    idlib_u32 const* indices,
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Compute the average cache miss ratio (ACMR) of an indexed triangle list.
+/// @param indices Pointer to an array of @a number_of_indices indices.
+/// @param number_of_indices The number of indices. Must be a multiple of three.
+/// @param number_of_vertices The number of vertices.
+/// @param cache_size The size of the simulated first-in first-out cache.
+/// @param workspace Pointer to a workspace of <code>number_of_vertices * sizeof(idlib_u32)</code> Bytes.
+/// @return The number of cache misses per triangle, a value between 0.5 (for large regular meshes) and 3.
+idlib_f32
+idlib_vertex_cache_get_acmr
+  (
+    idlib_u32 const* indices,
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices,
+    idlib_u32 cache_size,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by idlib_overdraw_optimize.
+/// @param number_of_indices The number of indices, three times the number of triangles.
+/// @param number_of_vertices The number of vertices.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 4 Bytes.
+size_t
+idlib_overdraw_get_workspace_size
+  (
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices
+  );
+
+/// @since 1.5
+/// @brief Reorder clusters of the triangles of an indexed triangle list to reduce overdraw.
+/// @param target Pointer to an array of @a number_of_indices elements receiving the reordered indices.
+/// Must not overlap with @a indices.
+/// @param indices Pointer to an array of @a number_of_indices indices, usually the result of idlib_vertex_cache_optimize.
+/// @param number_of_indices The number of indices. Must be a multiple of three.
+/// @param positions Pointer to the idlib_vector_3_f32_soa object describing the stream of the vertex positions.
+/// @param number_of_vertices The number of vertices. All indices must be less than this.
+/// @param threshold The factor, at least 1, by which the cache miss ratio of a cluster may exceed that of the run of triangles it is split from.
+/// Larger values yield smaller clusters and less overdraw at the expense of more cache misses. Typical values are 1.05 to 1.2.
+/// @param workspace Pointer to a workspace of idlib_overdraw_get_workspace_size Bytes.
+/// @remarks
+/// This is the view-independent cluster sorting of Sander, Nehab, and Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw":
+/// The triangles are split where a first-in first-out cache of IDLIB_VERTEX_CACHE_SIZE vertices misses all vertices of a triangle,
+/// that is, where the order of @a indices restarted.
+/// These runs are split further where the cache miss ratio of the triangles since the last split does not exceed the cache miss ratio of the run times @a threshold.
+/// The clusters are then sorted, stable and in descending order, by the dot product of their area-weighted normal
+/// and the vector from the centroid of the mesh to their centroid:
+/// Clusters on the outside of the mesh facing away from its center likely occlude other clusters and are drawn first.
+/// The normal of a triangle <code>(a, b, c)</code> is <code>(b - a) x (c - a)</code>, that is, front faces are expected to be counter-clockwise.
+/// The triangles within a cluster keep their order. The time is linear in the number of triangles and vertices.
+void
+idlib_overdraw_optimize
+  (
+    idlib_u32* target,
+    idlib_u32 const* indices,
+    size_t number_of_indices,
+    idlib_vector_3_f32_soa const* positions,
+    idlib_u32 number_of_vertices,
+    idlib_f32 threshold,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief Compute a vertex order for the vertex fetch and rewrite the indices accordingly.
+/// @param remap Pointer to an array of @a number_of_vertices elements receiving, at index i, the new index of the i-th vertex.
+/// @param indices Pointer to an array of @a number_of_indices indices. Each index i is replaced by <code>remap[i]</code>.
+/// @param number_of_indices The number of indices.
+/// @param number_of_vertices The number of vertices.
+/// @return The number of vertices referenced by @a indices.
+/// @remarks
+/// The vertices are numbered in the order of their first occurrence in @a indices
+/// such that the vertex data is fetched sequentially when the triangles are rendered.
+/// Vertices not referenced are numbered last, hence @a remap is a permutation.
+/// Invoke this after idlib_vertex_cache_optimize and apply @a remap to the vertex data by idlib_vertex_remap_f32.
+idlib_u32
+idlib_vertex_fetch_optimize
+  (
+    idlib_u32* remap,
+    idlib_u32* indices,
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices
+  );
+
+/// @since 1.5
+/// @brief Reorder vertex data.
+/// @param target Pointer to an array of <code>number_of_vertices * number_of_components</code> elements receiving the reordered vertex data.
+/// Must not overlap with @a source.
+/// @param source Pointer to an array of <code>number_of_vertices * number_of_components</code> elements, the vertex data.
+/// The data of the i-th vertex are the @a number_of_components elements starting at index <code>i * number_of_components</code>.
+/// @param remap Pointer to the permutation as computed by idlib_vertex_fetch_optimize.
+/// @param number_of_vertices The number of vertices.
+/// @param number_of_components The number of elements per vertex, for example 1 for each array of an idlib_vector_3_f32_soa stream
+/// or 3 for an array of idlib_vector_3_f32 objects.
+void
+idlib_vertex_remap_f32
+  (
+    idlib_f32* target,
+    idlib_f32 const* source,
+    idlib_u32 const* remap,
+    idlib_u32 number_of_vertices,
+    idlib_u32 number_of_components
+  );
+
+#endif // IDLIB_VERTEX_CACHE_H_INCLUDED
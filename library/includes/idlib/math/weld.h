@@ -0,0 +1,255 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#if !defined(IDLIB_WELD_H_INCLUDED)
+#define IDLIB_WELD_H_INCLUDED
+
+#include "scalar.h"
+#include "vector_3.h"
+
+/// @since 1.5
+/// @brief Compute a hash value of an idlib_vector_3_f32 object.
+/// @param operand Pointer to the idlib_vector_3_f32 object.
+/// @return The hash value.
+/// @remarks
+/// Vectors with bitwise equal components have equal hash values.
+/// Positive and negative zero are considered equal.
+idlib_u32
+idlib_vector_3_f32_hash
+  (
+    idlib_vector_3_f32 const* operand
+  );
+
+/// @since 1.5
+/// @brief Compute a hash value of an idlib_vector_3_f32 object quantized to a grid.
+/// @param operand Pointer to the idlib_vector_3_f32 object.
+/// @param cell_size The size of the cells of the grid. Must be positive.
+/// @return The hash value.
+/// @remarks
+/// Each component x is quantized to <code>floor(x / cell_size + 1/2)</code>,
+/// that is, to the index of the grid point nearest to x.
+/// The index is computed in double precision and is not converted to an integer:
+/// Components of any magnitude, including infinities, are quantized to distinct grid points, all NaN components to the same grid point.
+/// Vectors quantized to the same grid point have equal hash values.
+idlib_u32
+idlib_vector_3_f32_hash_quantized
+  (
+    idlib_vector_3_f32 const* operand,
+    idlib_f32 cell_size
+  );
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by idlib_weld_f32.
+/// @param number_of_vertices The number of vertices.
+/// @return The size of the workspace, in Bytes.
+/// @remarks The workspace must be aligned to 4 Bytes.
+size_t
+idlib_weld_f32_get_workspace_size
+  (
+    size_t number_of_vertices
+  );
+
+/// @since 1.5
+/// @brief Weld duplicate vertices.
+/// @param remap Pointer to an array of @a number_of_vertices elements receiving, at index i, the index of the i-th vertex in @a target.
+/// @param target Pointer to the idlib_vector_3_f32_soa object describing the stream receiving the distinct vertices.
+/// It must provide space for @a number_of_vertices vectors and must not overlap with @a source.
+/// @param source Pointer to the idlib_vector_3_f32_soa object describing the stream of vertices.
+/// @param number_of_vertices The number of vertices.
+/// @param cell_size If zero, then vertices are welded if their components are bitwise equal (up to the sign of zero).
+/// Otherwise, vertices are welded if they are quantized to the same grid point (see idlib_vector_3_f32_hash_quantized).
+/// @param workspace Pointer to a workspace of idlib_weld_f32_get_workspace_size(number_of_vertices) Bytes.
+/// @return The number of distinct vertices.
+/// @remarks
+/// @a number_of_vertices must be less than 2^32 - 1.
+/// The distinct vertices are stored in the order of their first occurrence in @a source, the first occurrence is stored.
+/// The vertices are inserted into an open-addressing hash table with linear probing and a load factor of at most 1/2
+/// such that the expected time is linear in the number of vertices. Each slot of the table requires 4 Bytes.
+///
+/// Vertices close to the boundary between two cells might be quantized to different grid points and are not welded in that case.
+size_t
+idlib_weld_f32
+  (
+    idlib_u32* remap,
+    idlib_vector_3_f32_soa const* target,
+    idlib_vector_3_f32_soa const* source,
+    size_t number_of_vertices,
+    idlib_f32 cell_size,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief The state of a weld job.
+/// @remarks
+/// A weld job computes the same result as idlib_weld_f32 in phases which can be distributed over threads.
+/// The vertices are split into @a number_of_partitions chunks of consecutive vertices
+/// and, by their hash values, into @a number_of_partitions partitions such that equal vertices are in the same partition.
+/// Each phase is a function invoked for each i in <code>[0, number_of_partitions)</code>:
+/// - idlib_weld_f32_job_partition hashes the vertices of the i-th chunk and counts them per partition.
+/// - idlib_weld_f32_job_scatter stores the indices of the vertices of the i-th chunk into the partitions.
+/// - idlib_weld_f32_job_weld welds the vertices of the i-th partition in a hash table of its own.
+/// - idlib_weld_f32_job_compact stores the distinct vertices of the i-th chunk into the target.
+/// - idlib_weld_f32_job_remap stores the remap table entries of the i-th chunk.
+///
+/// The invocations of a phase do not write to shared data and can run concurrently.
+/// All invocations of a phase must have returned before an invocation of the next phase begins.
+/// The members are private.
+typedef struct idlib_weld_f32_job {
+  idlib_u32* remap;
+  idlib_vector_3_f32_soa target;
+  idlib_vector_3_f32_soa source;
+  size_t number_of_vertices;
+  idlib_f32 cell_size;
+  idlib_u32 number_of_partitions;
+  idlib_u32* hashes;
+  idlib_u32* order;
+  idlib_u32* representatives;
+  idlib_u32* counts;
+  idlib_u32* unique_counts;
+  idlib_u32* tables;
+} idlib_weld_f32_job;
+
+/// @since 1.5
+/// @brief Get the size, in Bytes, of the workspace required by a weld job.
+/// @param number_of_vertices The number of vertices.
+/// @param number_of_partitions The number of partitions.
+/// @return The size of the workspace, in Bytes.
+/// @remarks
+/// The workspace must be aligned to 4 Bytes.
+/// It requires <code>7 * number_of_vertices + 2 * number_of_partitions^2 + 16 * number_of_partitions</code> elements of 4 Bytes.
+size_t
+idlib_weld_f32_job_get_workspace_size
+  (
+    size_t number_of_vertices,
+    idlib_u32 number_of_partitions
+  );
+
+/// @since 1.5
+/// @brief Initialize a weld job.
+/// @param job Pointer to the idlib_weld_f32_job object.
+/// @param remap, target, source, number_of_vertices, cell_size See idlib_weld_f32.
+/// @param number_of_partitions The number of chunks and partitions. Must be positive. Usually the number of threads.
+/// @param workspace Pointer to a workspace of idlib_weld_f32_job_get_workspace_size(number_of_vertices, number_of_partitions) Bytes.
+/// @remarks
+/// The objects pointed to by @a target and @a source are copied, the streams they describe are not.
+void
+idlib_weld_f32_job_initialize
+  (
+    idlib_weld_f32_job* job,
+    idlib_u32* remap,
+    idlib_vector_3_f32_soa const* target,
+    idlib_vector_3_f32_soa const* source,
+    size_t number_of_vertices,
+    idlib_f32 cell_size,
+    idlib_u32 number_of_partitions,
+    void* workspace
+  );
+
+/// @since 1.5
+/// @brief The first phase of a weld job: Hash the vertices of the i-th chunk.
+/// @param job Pointer to the idlib_weld_f32_job object.
+/// @param i The index of the chunk.
+/// @remarks Reads the vertices of the i-th chunk, writes their hash values and the i-th row of the counts.
+void
+idlib_weld_f32_job_partition
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief The second phase of a weld job: Store the vertices of the i-th chunk into the partitions.
+/// @param job Pointer to the idlib_weld_f32_job object.
+/// @param i The index of the chunk.
+/// @remarks
+/// Reads all counts, the offsets of the chunk in the partitions are the exclusive prefix sums of the counts.
+/// Writes the indices of the vertices of the i-th chunk at these offsets.
+void
+idlib_weld_f32_job_scatter
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief The third phase of a weld job: Weld the vertices of the i-th partition.
+/// @param job Pointer to the idlib_weld_f32_job object.
+/// @param i The index of the partition.
+/// @remarks
+/// Reads the vertices of the i-th partition and writes, for each of them, the index of its first occurrence in the source.
+/// The hash table of the partition is stored in a region of the workspace of its own.
+void
+idlib_weld_f32_job_weld
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief The fourth phase of a weld job: Store the distinct vertices of the i-th chunk.
+/// @param job Pointer to the idlib_weld_f32_job object.
+/// @param i The index of the chunk.
+/// @remarks
+/// The index of the first distinct vertex of the chunk in the target is the number of distinct vertices in the preceding chunks.
+void
+idlib_weld_f32_job_compact
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief The fifth phase of a weld job: Store the remap table entries of the i-th chunk.
+/// @param job Pointer to the idlib_weld_f32_job object.
+/// @param i The index of the chunk.
+void
+idlib_weld_f32_job_remap
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  );
+
+/// @since 1.5
+/// @brief Get the number of distinct vertices found by a weld job.
+/// @param job Pointer to the idlib_weld_f32_job object.
+/// @return The number of distinct vertices.
+/// @remarks Must be invoked after the third phase has completed.
+size_t
+idlib_weld_f32_job_get_number_of_vertices
+  (
+    idlib_weld_f32_job const* job
+  );
+
+/// @since 1.5
+/// @brief Remap an array of vertex indices.
+/// @param target Pointer to an array of @a count vertex indices. Each index i is replaced by <code>remap[i]</code>.
+/// @param count The number of vertex indices.
+/// @param remap Pointer to the remap table as computed by idlib_weld_f32.
+void
+idlib_weld_remap_indices
+  (
+    idlib_u32* target,
+    size_t count,
+    idlib_u32 const* remap
+  );
+
+#endif // IDLIB_WELD_H_INCLUDED
@@ -0,0 +1,74 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/aabb.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+void
+idlib_aabb_3_f32_set_points
+  (
+    idlib_aabb_3_f32* target,
+    idlib_vector_3_f32_soa const* operand,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  if (!count) {
+    idlib_vector_3_f32_set_zero(&target->minimum);
+    idlib_vector_3_f32_set_zero(&target->maximum);
+    return;
+  }
+  idlib_f32 const* components[3] = { operand->x, operand->y, operand->z };
+  for (size_t k = 0; k < 3; ++k) {
+    idlib_f32 const* c = components[k];
+    idlib_f32 minimum = c[0], maximum = c[0];
+    size_t i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+    if (count >= 4) {
+      __m128 minimum4 = _mm_loadu_ps(c), maximum4 = minimum4;
+      for (i = 4; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(c + i);
+        minimum4 = _mm_min_ps(minimum4, x);
+        maximum4 = _mm_max_ps(maximum4, x);
+      }
+      IDLIB_ALIGNAS(16) idlib_f32 t[2][4];
+      _mm_store_ps(t[0], minimum4);
+      _mm_store_ps(t[1], maximum4);
+      for (size_t j = 0; j < 4; ++j) {
+        minimum = t[0][j] < minimum ? t[0][j] : minimum;
+        maximum = t[1][j] > maximum ? t[1][j] : maximum;
+      }
+    }
+#endif
+    for (; i < count; ++i) {
+      minimum = c[i] < minimum ? c[i] : minimum;
+      maximum = c[i] > maximum ? c[i] : maximum;
+    }
+    target->minimum.e[k] = minimum;
+    target->maximum.e[k] = maximum;
+  }
+}
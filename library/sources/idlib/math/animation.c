@@ -0,0 +1,681 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#include "idlib/math/animation.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// fabsf, sqrtf
+#include <math.h>
+
+// The scalar paths below perform the same sequence of operations as the SIMD paths
+// such that the results do not depend on the position of a track in the range.
+
+// The number of transformations sampled into a block by idlib_animation_clip_f32_sample_matrices_n.
+#define BLOCK_SIZE (64)
+
+// The number of keys a cached key index is advanced linearly before resorting to binary search.
+#define MAXIMUM_LINEAR_STEPS (2)
+
+// The range of the three smallest components of a unit quaternion is [-1/sqrt(2), 1/sqrt(2)].
+#define SQRT_2 (1.41421356237f)
+
+static idlib_u32
+get_number_of_components
+  (
+    idlib_u32 channel
+  )
+{ return IDLIB_ANIMATION_CHANNEL_ROTATION == channel ? 4 : 3; }
+
+// Get the keys of a channel of a track provided by the caller.
+static void
+get_source
+  (
+    idlib_animation_track_f32 const* track,
+    idlib_u32 channel,
+    idlib_f32 const** times,
+    idlib_f32 const** values,
+    idlib_u32* number_of_keys
+  )
+{
+  switch (channel) {
+    case IDLIB_ANIMATION_CHANNEL_TRANSLATION: {
+      *times = track->translation_times;
+      *values = track->translations->e;
+      *number_of_keys = track->number_of_translations;
+    } break;
+    case IDLIB_ANIMATION_CHANNEL_ROTATION: {
+      *times = track->rotation_times;
+      *values = track->rotations->e;
+      *number_of_keys = track->number_of_rotations;
+    } break;
+    default: {
+      *times = track->scale_times;
+      *values = track->scales->e;
+      *number_of_keys = track->number_of_scales;
+    } break;
+  }
+  IDLIB_DEBUG_ASSERT(0 < *number_of_keys);
+}
+
+// Interpolate between two keys.
+// Rotations are normalized, the caller must have negated b if it is not in the same hemisphere as a.
+static void
+interpolate
+  (
+    idlib_f32* target,
+    idlib_f32 const* a,
+    idlib_f32 const* b,
+    idlib_f32 alpha,
+    idlib_u32 number_of_components
+  )
+{
+  for (size_t c = 0; c < number_of_components; ++c) {
+    target[c] = a[c] + (b[c] - a[c]) * alpha;
+  }
+  if (4 == number_of_components) {
+    idlib_f32 l = sqrtf(target[0] * target[0] + target[1] * target[1] + target[2] * target[2] + target[3] * target[3]);
+    for (size_t c = 0; c < 4; ++c) {
+      target[c] = target[c] / l;
+    }
+  }
+}
+
+// Negate b if it is not in the same hemisphere as the rotation a.
+static void
+align
+  (
+    idlib_f32* b,
+    idlib_f32 const* a,
+    idlib_u32 number_of_components
+  )
+{
+  if (4 == number_of_components && a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3] < 0.f) {
+    for (size_t c = 0; c < 4; ++c) {
+      b[c] = -b[c];
+    }
+  }
+}
+
+// Determine if the value v is within tolerance of the value r.
+static bool
+is_within_tolerance
+  (
+    idlib_f32 const* r,
+    idlib_f32 const* v,
+    idlib_u32 number_of_components,
+    idlib_f32 tolerance
+  )
+{
+  idlib_f32 w[4];
+  for (size_t c = 0; c < number_of_components; ++c) {
+    w[c] = v[c];
+  }
+  align(w, r, number_of_components);
+  for (size_t c = 0; c < number_of_components; ++c) {
+    if (!(fabsf(w[c] - r[c]) <= tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Determine if all keys of a channel are within tolerance of its first key.
+static bool
+is_constant
+  (
+    idlib_f32 const* values,
+    idlib_u32 number_of_keys,
+    idlib_u32 number_of_components,
+    idlib_f32 tolerance
+  )
+{
+  for (idlib_u32 i = 1; i < number_of_keys; ++i) {
+    if (!is_within_tolerance(values, values + (size_t)i * number_of_components, number_of_components, tolerance)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Get the index of the key following the retained key anchor which must be retained.
+// The keys between them are reproduced within tolerance by interpolating between the anchor and the returned key.
+static idlib_u32
+get_next_key
+  (
+    idlib_f32 const* times,
+    idlib_f32 const* values,
+    idlib_u32 number_of_keys,
+    idlib_u32 number_of_components,
+    idlib_u32 anchor,
+    idlib_f32 tolerance
+  )
+{
+  size_t n = number_of_components;
+  idlib_f32 const* a = values + anchor * n;
+  idlib_u32 j = anchor + 1;
+  // The keys are only checked at their times. Interpolating rotations is not linear, hence keys are only removed if an error is tolerated.
+  while (tolerance > 0.f && j + 1 < number_of_keys) {
+    idlib_u32 candidate = j + 1;
+    idlib_f32 b[4];
+    for (size_t c = 0; c < n; ++c) {
+      b[c] = values[candidate * n + c];
+    }
+    align(b, a, number_of_components);
+    for (idlib_u32 k = anchor + 1; k < candidate; ++k) {
+      idlib_f32 r[4];
+      interpolate(r, a, b, (times[k] - times[anchor]) / (times[candidate] - times[anchor]), number_of_components);
+      if (!is_within_tolerance(r, values + k * n, number_of_components, tolerance)) {
+        return j;
+      }
+    }
+    j = candidate;
+  }
+  return j;
+}
+
+// Get the number of retained keys of a channel of a track.
+static idlib_u32
+get_number_of_retained_keys
+  (
+    idlib_f32 const* times,
+    idlib_f32 const* values,
+    idlib_u32 number_of_keys,
+    idlib_u32 number_of_components,
+    idlib_f32 tolerance
+  )
+{
+  if (is_constant(values, number_of_keys, number_of_components, tolerance)) {
+    return 1;
+  }
+  idlib_u32 count = 1;
+  for (idlib_u32 i = 0; i + 1 < number_of_keys; i = get_next_key(times, values, number_of_keys, number_of_components, i, tolerance)) {
+    count++;
+  }
+  return count;
+}
+
+// Quantize a unit quaternion by the "smallest three" encoding.
+static void
+encode_rotation
+  (
+    idlib_u16 target[3],
+    idlib_f32 const operand[4]
+  )
+{
+  idlib_f32 q[4];
+  idlib_f32 l = sqrtf(operand[0] * operand[0] + operand[1] * operand[1] + operand[2] * operand[2] + operand[3] * operand[3]);
+  idlib_u32 m = 0;
+  for (idlib_u32 c = 0; c < 4; ++c) {
+    q[c] = operand[c] / l;
+    if (fabsf(q[c]) > fabsf(q[m])) {
+      m = c;
+    }
+  }
+  // q and -q denote the same rotation. Choose the one with a positive largest component such that its sign need not be stored.
+  idlib_f32 s = q[m] < 0.f ? -1.f : 1.f;
+  for (idlib_u32 c = 0, k = 0; c < 4; ++c) {
+    if (c != m) {
+      idlib_f32 v = (s * q[c] * SQRT_2 * 0.5f + 0.5f) * 32767.f + 0.5f;
+      v = v < 0.f ? 0.f : (v > 32767.f ? 32767.f : v);
+      target[k++] = (idlib_u16)v;
+    }
+  }
+  target[0] |= (idlib_u16)((m & 1) << 15);
+  target[1] |= (idlib_u16)((m >> 1) << 15);
+}
+
+static void
+decode_rotation
+  (
+    idlib_f32 target[4],
+    idlib_u16 const operand[3]
+  )
+{
+  idlib_u32 m = (idlib_u32)(operand[0] >> 15) | ((idlib_u32)(operand[1] >> 15) << 1);
+  idlib_f32 v[3], s = 0.f;
+  for (size_t k = 0; k < 3; ++k) {
+    v[k] = ((idlib_f32)(operand[k] & 0x7fff) * (2.f / 32767.f) - 1.f) * (1.f / SQRT_2);
+    s += v[k] * v[k];
+  }
+  for (idlib_u32 c = 0, k = 0; c < 4; ++c) {
+    target[c] = c == m ? sqrtf(s < 1.f ? 1.f - s : 0.f) : v[k++];
+  }
+}
+
+// Store the retained keys of a channel of a track.
+static void
+store_keys
+  (
+    idlib_animation_channel_f32* target,
+    idlib_u32 channel,
+    idlib_u32 format,
+    idlib_u32 track,
+    idlib_f32 const* times,
+    idlib_f32 const* values,
+    idlib_u32 number_of_keys,
+    idlib_f32 tolerance
+  )
+{
+  idlib_u32 n = get_number_of_components(channel);
+  idlib_u32 first = target->offsets[track], count = target->offsets[track + 1] - first;
+  idlib_u32 j = first;
+  for (idlib_u32 i = 0; j < first + count; i = get_next_key(times, values, number_of_keys, n, i, tolerance)) {
+    target->times[j] = times[i];
+    if (IDLIB_ANIMATION_KEYS_F32 == format) {
+      for (size_t c = 0; c < n; ++c) {
+        target->values[c][j] = values[(size_t)i * n + c];
+      }
+    } else if (4 == n) {
+      idlib_u16 q[3];
+      encode_rotation(q, values + (size_t)i * n);
+      for (size_t c = 0; c < 3; ++c) {
+        target->quantized[c][j] = q[c];
+      }
+    }
+    j++;
+  }
+  if (IDLIB_ANIMATION_KEYS_U16 == format && 3 == n) {
+    // Translations and scalings are quantized relative to the range of the retained keys.
+    j = first;
+    idlib_f32 minimum[3], maximum[3];
+    for (size_t c = 0; c < 3; ++c) {
+      minimum[c] = maximum[c] = values[c];
+    }
+    for (idlib_u32 i = 0; j < first + count; i = get_next_key(times, values, number_of_keys, n, i, tolerance)) {
+      for (size_t c = 0; c < 3; ++c) {
+        idlib_f32 v = values[(size_t)i * 3 + c];
+        minimum[c] = v < minimum[c] ? v : minimum[c];
+        maximum[c] = v > maximum[c] ? v : maximum[c];
+      }
+      j++;
+    }
+    for (size_t c = 0; c < 3; ++c) {
+      target->minimum[c][track] = minimum[c];
+      target->step[c][track] = (maximum[c] - minimum[c]) / 65535.f;
+    }
+    j = first;
+    for (idlib_u32 i = 0; j < first + count; i = get_next_key(times, values, number_of_keys, n, i, tolerance)) {
+      for (size_t c = 0; c < 3; ++c) {
+        idlib_f32 step = target->step[c][track];
+        idlib_f32 v = step > 0.f ? (values[(size_t)i * 3 + c] - minimum[c]) / step + 0.5f : 0.f;
+        target->quantized[c][j] = (idlib_u16)(v < 65535.f ? v : 65535.f);
+      }
+      j++;
+    }
+  }
+}
+
+bool
+idlib_animation_clip_f32_create
+  (
+    idlib_animation_clip_f32* target,
+    idlib_arena* arena,
+    idlib_animation_track_f32 const* tracks,
+    idlib_u32 number_of_tracks,
+    idlib_u32 format,
+    idlib_f32 tolerance
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != arena);
+  IDLIB_DEBUG_ASSERT(NULL != tracks || 0 == number_of_tracks);
+  IDLIB_DEBUG_ASSERT(IDLIB_ANIMATION_KEYS_F32 == format || IDLIB_ANIMATION_KEYS_U16 == format);
+  IDLIB_DEBUG_ASSERT(tolerance >= 0.f);
+  idlib_arena_marker marker = idlib_arena_push(arena);
+  // The peak is restored on failure such that the arena is unmodified.
+  size_t peak = arena->peak;
+  target->number_of_tracks = number_of_tracks;
+  target->format = format;
+  target->duration = 0.f;
+  for (idlib_u32 channel = 0; channel < 3; ++channel) {
+    idlib_animation_channel_f32* ch = &target->channels[channel];
+    idlib_u32 n = get_number_of_components(channel);
+    ch->offsets = (idlib_u32*)idlib_arena_allocate(arena, ((size_t)number_of_tracks + 1) * sizeof(idlib_u32));
+    if (!ch->offsets) {
+      idlib_arena_pop(arena, marker);
+      arena->peak = peak;
+      return false;
+    }
+    ch->offsets[0] = 0;
+    for (idlib_u32 i = 0; i < number_of_tracks; ++i) {
+      idlib_f32 const* times, * values;
+      idlib_u32 number_of_keys;
+      get_source(&tracks[i], channel, &times, &values, &number_of_keys);
+      ch->offsets[i + 1] = ch->offsets[i] + get_number_of_retained_keys(times, values, number_of_keys, n, tolerance);
+      target->duration = times[number_of_keys - 1] > target->duration ? times[number_of_keys - 1] : target->duration;
+    }
+    size_t number_of_keys = ch->offsets[number_of_tracks];
+    bool exhausted = false;
+    ch->times = (idlib_f32*)idlib_arena_allocate(arena, number_of_keys * sizeof(idlib_f32));
+    exhausted |= !ch->times;
+    for (size_t c = 0; c < 4; ++c) {
+      ch->values[c] = NULL;
+      if (IDLIB_ANIMATION_KEYS_F32 == format && c < n) {
+        ch->values[c] = (idlib_f32*)idlib_arena_allocate(arena, number_of_keys * sizeof(idlib_f32));
+        exhausted |= !ch->values[c];
+      }
+    }
+    for (size_t c = 0; c < 3; ++c) {
+      ch->quantized[c] = NULL;
+      ch->minimum[c] = NULL;
+      ch->step[c] = NULL;
+      if (IDLIB_ANIMATION_KEYS_U16 == format) {
+        ch->quantized[c] = (idlib_u16*)idlib_arena_allocate(arena, number_of_keys * sizeof(idlib_u16));
+        exhausted |= !ch->quantized[c];
+        if (3 == n) {
+          ch->minimum[c] = (idlib_f32*)idlib_arena_allocate(arena, number_of_tracks * sizeof(idlib_f32));
+          ch->step[c] = (idlib_f32*)idlib_arena_allocate(arena, number_of_tracks * sizeof(idlib_f32));
+          exhausted |= !ch->minimum[c] || !ch->step[c];
+        }
+      }
+    }
+    if (exhausted) {
+      idlib_arena_pop(arena, marker);
+      arena->peak = peak;
+      return false;
+    }
+    for (idlib_u32 i = 0; i < number_of_tracks; ++i) {
+      idlib_f32 const* times, * values;
+      idlib_u32 number_of_keys;
+      get_source(&tracks[i], channel, &times, &values, &number_of_keys);
+      if (1 == ch->offsets[i + 1] - ch->offsets[i]) {
+        // A constant channel retains its first key.
+        number_of_keys = 1;
+      }
+      store_keys(ch, channel, format, i, times, values, number_of_keys, tolerance);
+    }
+  }
+  return true;
+}
+
+idlib_u32
+idlib_animation_clip_f32_get_number_of_keys
+  (
+    idlib_animation_clip_f32 const* operand,
+    idlib_u32 channel
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(channel <= IDLIB_ANIMATION_CHANNEL_SCALE);
+  return operand->channels[channel].offsets[operand->number_of_tracks];
+}
+
+// Get the index of the last key in [lower, upper] whose time is not greater than the specified time.
+// Return lower if there is no such key.
+static idlib_u32
+search
+  (
+    idlib_f32 const* times,
+    idlib_u32 lower,
+    idlib_u32 upper,
+    idlib_f32 time
+  )
+{
+  idlib_u32 base = lower;
+  for (idlib_u32 n = upper - lower + 1; n > 1; ) {
+    idlib_u32 half = n / 2;
+    base = times[base + half] <= time ? base + half : base;
+    n -= half;
+  }
+  return base;
+}
+
+// Find the keys surrounding a time in a channel of a track and the interpolation parameter between them.
+// If cache is not a null pointer, the search starts at the cached key and the key found is stored in the cache.
+static void
+find_keys
+  (
+    idlib_u32* key0,
+    idlib_u32* key1,
+    idlib_f32* alpha,
+    idlib_u32* cache,
+    idlib_animation_channel_f32 const* channel,
+    idlib_u32 track,
+    idlib_f32 time
+  )
+{
+  idlib_u32 first = channel->offsets[track], n = channel->offsets[track + 1] - first;
+  if (1 == n) {
+    *key0 = *key1 = first;
+    *alpha = 0.f;
+    return;
+  }
+  idlib_f32 const* times = channel->times + first;
+  idlib_u32 k = cache ? *cache : 0;
+  k = k < n - 2 ? k : n - 2;
+  if (time < times[k]) {
+    k = search(times, 0, k, time);
+  } else {
+    for (idlib_u32 i = 0; i < MAXIMUM_LINEAR_STEPS && k + 2 < n && times[k + 1] <= time; ++i) {
+      k++;
+    }
+    if (k + 2 < n && times[k + 1] <= time) {
+      k = search(times, k, n - 2, time);
+    }
+  }
+  if (cache) {
+    *cache = k;
+  }
+  idlib_f32 a = (time - times[k]) / (times[k + 1] - times[k]);
+  *alpha = a > 0.f ? (a < 1.f ? a : 1.f) : 0.f;
+  *key0 = first + k;
+  *key1 = first + k + 1;
+}
+
+// Decode a key of a channel of a track.
+static void
+decode
+  (
+    idlib_f32* target,
+    idlib_animation_channel_f32 const* channel,
+    idlib_u32 number_of_components,
+    idlib_u32 format,
+    idlib_u32 track,
+    idlib_u32 key
+  )
+{
+  if (IDLIB_ANIMATION_KEYS_F32 == format) {
+    for (size_t c = 0; c < number_of_components; ++c) {
+      target[c] = channel->values[c][key];
+    }
+  } else if (4 == number_of_components) {
+    idlib_u16 q[3] = { channel->quantized[0][key], channel->quantized[1][key], channel->quantized[2][key] };
+    decode_rotation(target, q);
+  } else {
+    for (size_t c = 0; c < 3; ++c) {
+      target[c] = channel->minimum[c][track] + (idlib_f32)channel->quantized[c][key] * channel->step[c][track];
+    }
+  }
+}
+
+// Get the component of a transformation for a channel.
+static idlib_f32*
+get_target
+  (
+    idlib_transform_f32* target,
+    idlib_u32 channel
+  )
+{
+  switch (channel) {
+    case IDLIB_ANIMATION_CHANNEL_TRANSLATION: {
+      return target->translation.e;
+    } break;
+    case IDLIB_ANIMATION_CHANNEL_ROTATION: {
+      return target->rotation.e;
+    } break;
+    default: {
+      return target->scale.e;
+    } break;
+  }
+}
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+// Decode the keys of four tracks (one key per lane).
+static void
+decode_4
+  (
+    __m128* target,
+    idlib_animation_channel_f32 const* channel,
+    idlib_u32 number_of_components,
+    idlib_u32 format,
+    idlib_u32 track,
+    idlib_u32 const key[4]
+  )
+{
+  if (IDLIB_ANIMATION_KEYS_F32 == format) {
+    for (size_t c = 0; c < number_of_components; ++c) {
+      idlib_f32 const* v = channel->values[c];
+      target[c] = _mm_setr_ps(v[key[0]], v[key[1]], v[key[2]], v[key[3]]);
+    }
+  } else if (4 == number_of_components) {
+    __m128 v[3], s = _mm_setzero_ps();
+    IDLIB_ALIGNAS(16) idlib_f32 m[4];
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_u16 const* q = channel->quantized[k];
+      v[k] = _mm_setr_ps((idlib_f32)(q[key[0]] & 0x7fff), (idlib_f32)(q[key[1]] & 0x7fff), (idlib_f32)(q[key[2]] & 0x7fff), (idlib_f32)(q[key[3]] & 0x7fff));
+      v[k] = _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(v[k], _mm_set1_ps(2.f / 32767.f)), _mm_set1_ps(1.f)), _mm_set1_ps(1.f / SQRT_2));
+      s = _mm_add_ps(s, _mm_mul_ps(v[k], v[k]));
+    }
+    for (size_t l = 0; l < 4; ++l) {
+      m[l] = (idlib_f32)((idlib_u32)(channel->quantized[0][key[l]] >> 15) | ((idlib_u32)(channel->quantized[1][key[l]] >> 15) << 1));
+    }
+    __m128 mm = _mm_load_ps(m);
+    __m128 missing = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.f), s), _mm_setzero_ps()));
+    // The component c is the omitted component if c = m, the component v[c] if c < m, and the component v[c - 1] otherwise.
+    for (size_t c = 0; c < 4; ++c) {
+      __m128 cc = _mm_set1_ps((idlib_f32)c);
+      __m128 is_missing = _mm_cmpeq_ps(cc, mm), is_before = _mm_cmplt_ps(cc, mm);
+      __m128 x = c < 3 ? _mm_and_ps(is_before, v[c]) : _mm_setzero_ps();
+      if (c > 0) {
+        x = _mm_or_ps(x, _mm_andnot_ps(_mm_or_ps(is_before, is_missing), v[c - 1]));
+      }
+      target[c] = _mm_or_ps(_mm_andnot_ps(is_missing, x), _mm_and_ps(is_missing, missing));
+    }
+  } else {
+    for (size_t c = 0; c < 3; ++c) {
+      idlib_u16 const* q = channel->quantized[c];
+      __m128 v = _mm_setr_ps((idlib_f32)q[key[0]], (idlib_f32)q[key[1]], (idlib_f32)q[key[2]], (idlib_f32)q[key[3]]);
+      target[c] = _mm_add_ps(_mm_loadu_ps(channel->minimum[c] + track), _mm_mul_ps(v, _mm_loadu_ps(channel->step[c] + track)));
+    }
+  }
+}
+
+#endif
+
+void
+idlib_animation_clip_f32_sample_n
+  (
+    idlib_transform_f32* target,
+    idlib_u32* cache,
+    idlib_animation_clip_f32 const* operand,
+    idlib_f32 time,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(first + count <= operand->number_of_tracks);
+  for (idlib_u32 channel = 0; channel < 3; ++channel) {
+    idlib_animation_channel_f32 const* ch = &operand->channels[channel];
+    idlib_u32 n = get_number_of_components(channel);
+    idlib_u32 i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+    for (; i + 4 <= count; i += 4) {
+      idlib_u32 track = first + i;
+      idlib_u32 key0[4], key1[4];
+      IDLIB_ALIGNAS(16) idlib_f32 alpha[4];
+      for (size_t k = 0; k < 4; ++k) {
+        find_keys(&key0[k], &key1[k], &alpha[k], cache ? cache + 3 * (size_t)(track + k) + channel : NULL, ch, track + (idlib_u32)k, time);
+      }
+      __m128 a[4], b[4];
+      decode_4(a, ch, n, operand->format, track, key0);
+      decode_4(b, ch, n, operand->format, track, key1);
+      if (4 == n) {
+        // Negate b in the lanes in which it is not in the same hemisphere as a.
+        __m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2])), _mm_mul_ps(a[3], b[3]));
+        __m128 sign = _mm_and_ps(_mm_cmplt_ps(d, _mm_setzero_ps()), _mm_set1_ps(-0.f));
+        for (size_t c = 0; c < 4; ++c) {
+          b[c] = _mm_xor_ps(b[c], sign);
+        }
+      }
+      __m128 t = _mm_load_ps(alpha);
+      for (size_t c = 0; c < n; ++c) {
+        a[c] = _mm_add_ps(a[c], _mm_mul_ps(_mm_sub_ps(b[c], a[c]), t));
+      }
+      if (4 == n) {
+        __m128 l = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], a[0]), _mm_mul_ps(a[1], a[1])), _mm_mul_ps(a[2], a[2])), _mm_mul_ps(a[3], a[3])));
+        for (size_t c = 0; c < 4; ++c) {
+          a[c] = _mm_div_ps(a[c], l);
+        }
+      }
+      IDLIB_ALIGNAS(16) idlib_f32 r[4][4];
+      for (size_t c = 0; c < n; ++c) {
+        _mm_store_ps(r[c], a[c]);
+      }
+      for (size_t k = 0; k < 4; ++k) {
+        idlib_f32* p = get_target(target + i + k, channel);
+        for (size_t c = 0; c < n; ++c) {
+          p[c] = r[c][k];
+        }
+      }
+    }
+#endif
+    for (; i < count; ++i) {
+      idlib_u32 track = first + i, key0, key1;
+      idlib_f32 a[4], b[4], alpha;
+      find_keys(&key0, &key1, &alpha, cache ? cache + 3 * (size_t)track + channel : NULL, ch, track, time);
+      decode(a, ch, n, operand->format, track, key0);
+      decode(b, ch, n, operand->format, track, key1);
+      align(b, a, n);
+      interpolate(get_target(target + i, channel), a, b, alpha, n);
+    }
+  }
+}
+
+void
+idlib_animation_clip_f32_sample_matrices_n
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_u32* cache,
+    idlib_animation_clip_f32 const* operand,
+    idlib_f32 time,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(first + count <= operand->number_of_tracks);
+  idlib_transform_f32 block[BLOCK_SIZE];
+  for (idlib_u32 i = 0; i < count; i += BLOCK_SIZE) {
+    idlib_u32 n = count - i < BLOCK_SIZE ? count - i : BLOCK_SIZE;
+    idlib_animation_clip_f32_sample_n(block, cache, operand, time, first + i, n);
+    idlib_matrix_4x4_f32_set_transform_n(target + i, block, n);
+  }
+}
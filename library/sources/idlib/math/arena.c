@@ -0,0 +1,160 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+// posix_memalign is a POSIX function: Request its declaration before any header is included.
+#if !defined(_POSIX_C_SOURCE)
+  #define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "idlib/math/arena.h"
+
+// uintptr_t
+#include <stdint.h>
+
+#if IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS || IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MINGW
+  // _aligned_malloc, _aligned_free
+  #include <malloc.h>
+#else
+  // posix_memalign, free
+  #include <stdlib.h>
+#endif
+
+void
+idlib_arena_initialize
+  (
+    idlib_arena* target,
+    void* memory,
+    size_t size
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != memory || 0 == size);
+  target->memory = (idlib_u8*)memory;
+  target->size = size;
+  target->used = 0;
+  target->peak = 0;
+}
+
+void*
+idlib_arena_allocate
+  (
+    idlib_arena* target,
+    size_t size
+  )
+{ return idlib_arena_allocate_aligned(target, size, IDLIB_ARENA_ALIGNMENT); }
+
+void*
+idlib_arena_allocate_aligned
+  (
+    idlib_arena* target,
+    size_t size,
+    size_t alignment
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(0 != alignment && 0 == (alignment & (alignment - 1)));
+  if (!target->memory) {
+    return NULL;
+  }
+  // Align the address rather than the offset as the memory region itself need not be aligned.
+  uintptr_t address = (uintptr_t)(target->memory + target->used);
+  size_t padding = (size_t)((alignment - (address & (alignment - 1))) & (alignment - 1));
+  size_t available = target->size - target->used;
+  if (padding > available || size > available - padding) {
+    return NULL;
+  }
+  void* block = target->memory + target->used + padding;
+  target->used += padding + size;
+  if (target->peak < target->used) {
+    target->peak = target->used;
+  }
+  return block;
+}
+
+idlib_arena_marker
+idlib_arena_push
+  (
+    idlib_arena const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  return operand->used;
+}
+
+void
+idlib_arena_pop
+  (
+    idlib_arena* target,
+    idlib_arena_marker marker
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(marker <= target->used);
+  target->used = marker;
+}
+
+void
+idlib_arena_reset
+  (
+    idlib_arena* target
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  target->used = 0;
+}
+
+void*
+idlib_allocate_aligned
+  (
+    size_t size,
+    size_t alignment
+  )
+{
+  IDLIB_DEBUG_ASSERT(0 != size);
+  IDLIB_DEBUG_ASSERT(0 != alignment && 0 == (alignment & (alignment - 1)));
+#if IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS || IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MINGW
+  return _aligned_malloc(size, alignment);
+#else
+  // posix_memalign requires the alignment to be a multiple of sizeof(void*).
+  if (alignment < sizeof(void*)) {
+    alignment = sizeof(void*);
+  }
+  void* pointer = NULL;
+  if (posix_memalign(&pointer, alignment, size)) {
+    return NULL;
+  }
+  return pointer;
+#endif
+}
+
+void
+idlib_deallocate_aligned
+  (
+    void* pointer
+  )
+{
+#if IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_WINDOWS || IDLIB_OPERATING_SYSTEM == IDLIB_OPERATING_SYSTEM_MINGW
+  _aligned_free(pointer);
+#else
+  free(pointer);
+#endif
+}
@@ -0,0 +1,330 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/broadphase.h"
+
+// NAN
+#include <math.h>
+// uintptr_t
+#include <stdint.h>
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// The coordinate arrays have four elements beyond the last body such that the four positions following any position can be loaded at once.
+// The minima along the sweep axis of these elements are NaN such that the comparison with any maximum is false.
+#define PADDING (4)
+
+// The number of elements of a coordinate array.
+static size_t
+get_stride
+  (
+    idlib_u32 capacity
+  )
+{ return ((size_t)capacity + PADDING + 3) & ~(size_t)3; }
+
+size_t
+idlib_broadphase_get_workspace_size
+  (
+    idlib_u32 capacity
+  )
+{ return 6 * get_stride(capacity) * sizeof(idlib_f32) + (size_t)capacity * sizeof(idlib_u32); }
+
+void
+idlib_broadphase_initialize
+  (
+    idlib_broadphase* target,
+    idlib_u32 capacity,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  IDLIB_DEBUG_ASSERT(0 == ((uintptr_t)workspace & 15));
+  size_t stride = get_stride(capacity);
+  idlib_f32* p = (idlib_f32*)workspace;
+  for (size_t k = 0; k < 3; ++k) {
+    target->minimum[k] = p; p += stride;
+    target->maximum[k] = p; p += stride;
+  }
+  target->order = (idlib_u32*)p;
+  target->number_of_bodies = 0;
+  target->capacity = capacity;
+  target->axis = 0;
+  target->rebuild = true;
+}
+
+// Select the sweep axis.
+static idlib_u32
+select_axis
+  (
+    idlib_aabb_3_f32_soa const* operand,
+    idlib_u32 number_of_bodies,
+    idlib_u32 axis
+  )
+{
+  if (number_of_bodies < 2) {
+    return axis;
+  }
+  idlib_f32 const* minimum[3] = { operand->minimum.x, operand->minimum.y, operand->minimum.z };
+  idlib_f32 const* maximum[3] = { operand->maximum.x, operand->maximum.y, operand->maximum.z };
+  // The variances of twice the centers (the factor does not matter for the comparison).
+  idlib_f64 variance[3];
+  for (size_t k = 0; k < 3; ++k) {
+    idlib_f64 sum = 0.0, sum_of_squares = 0.0;
+    for (idlib_u32 i = 0; i < number_of_bodies; ++i) {
+      idlib_f64 c = (idlib_f64)minimum[k][i] + (idlib_f64)maximum[k][i];
+      sum += c;
+      sum_of_squares += c * c;
+    }
+    variance[k] = sum_of_squares - sum * sum / (idlib_f64)number_of_bodies;
+  }
+  idlib_u32 best = axis;
+  for (idlib_u32 k = 0; k < 3; ++k) {
+    if (variance[k] > variance[best]) {
+      best = k;
+    }
+  }
+  return variance[best] > 2.0 * variance[axis] ? best : axis;
+}
+
+// Sort the positions [0, n) of the order by their keys by Shell sort with the specified gaps in ascending order.
+// The first gap must be 1 such that the sort is an insertion sort if only that gap is specified.
+static void
+sort
+  (
+    idlib_f32* keys,
+    idlib_u32* order,
+    idlib_u32 n,
+    size_t const* gaps,
+    size_t number_of_gaps
+  )
+{
+  for (size_t g = number_of_gaps; g > 0; --g) {
+    size_t gap = gaps[g - 1];
+    for (size_t i = gap; i < n; ++i) {
+      idlib_f32 key = keys[i];
+      idlib_u32 body = order[i];
+      size_t j = i;
+      while (j >= gap && keys[j - gap] > key) {
+        keys[j] = keys[j - gap];
+        order[j] = order[j - gap];
+        j -= gap;
+      }
+      keys[j] = key;
+      order[j] = body;
+    }
+  }
+}
+
+void
+idlib_broadphase_update
+  (
+    idlib_broadphase* target,
+    idlib_aabb_3_f32_soa const* operand,
+    idlib_u32 number_of_bodies
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(number_of_bodies <= target->capacity);
+  idlib_u32* order = target->order;
+  idlib_u32 n = target->number_of_bodies;
+  // Remove the bodies which no longer exist, retaining the order of the others.
+  if (number_of_bodies < n) {
+    idlib_u32 m = 0;
+    for (idlib_u32 i = 0; i < n; ++i) {
+      if (order[i] < number_of_bodies) {
+        order[m++] = order[i];
+      }
+    }
+    n = m;
+  }
+  // Append the new bodies. Many new bodies are better sorted from scratch.
+  if (number_of_bodies - n > number_of_bodies / 8 + 16) {
+    target->rebuild = true;
+  }
+  for (; n < number_of_bodies; ++n) {
+    order[n] = n;
+  }
+  target->number_of_bodies = n;
+  idlib_u32 axis = select_axis(operand, n, target->axis);
+  if (axis != target->axis) {
+    target->axis = axis;
+    target->rebuild = true;
+  }
+  idlib_f32 const* minimum[3] = { operand->minimum.x, operand->minimum.y, operand->minimum.z };
+  idlib_f32 const* maximum[3] = { operand->maximum.x, operand->maximum.y, operand->maximum.z };
+  // Sort the order by the minima along the sweep axis.
+  idlib_f32* keys = target->minimum[axis];
+  for (idlib_u32 i = 0; i < n; ++i) {
+    keys[i] = minimum[axis][order[i]];
+  }
+  if (target->rebuild) {
+    // The gaps of Ciura, extended by a factor of 9/4, in ascending order.
+    size_t gaps[32] = { 1, 4, 10, 23, 57, 132, 301, 701 };
+    size_t number_of_gaps = 8;
+    while (number_of_gaps < 32 && gaps[number_of_gaps - 1] * 9 / 4 < n) {
+      gaps[number_of_gaps] = gaps[number_of_gaps - 1] * 9 / 4;
+      number_of_gaps++;
+    }
+    sort(keys, order, n, gaps, number_of_gaps);
+    target->rebuild = false;
+  } else {
+    static size_t const gaps[] = { 1 };
+    sort(keys, order, n, gaps, 1);
+  }
+  // Gather the other coordinates in that order.
+  for (size_t k = 0; k < 3; ++k) {
+    idlib_f32* mi = target->minimum[k];
+    idlib_f32* ma = target->maximum[k];
+    if (k != axis) {
+      for (idlib_u32 i = 0; i < n; ++i) {
+        mi[i] = minimum[k][order[i]];
+      }
+    }
+    for (idlib_u32 i = 0; i < n; ++i) {
+      ma[i] = maximum[k][order[i]];
+    }
+    for (idlib_u32 i = n; i < n + PADDING; ++i) {
+      mi[i] = k == axis ? NAN : 0.f;
+      ma[i] = 0.f;
+    }
+  }
+}
+
+// Store a pair if the capacity permits.
+static inline void
+store_pair
+  (
+    idlib_u32* target,
+    size_t capacity,
+    size_t number_of_pairs,
+    idlib_u32 body1,
+    idlib_u32 body2
+  )
+{
+  if (number_of_pairs < capacity) {
+    target[2 * number_of_pairs + 0] = body1 < body2 ? body1 : body2;
+    target[2 * number_of_pairs + 1] = body1 < body2 ? body2 : body1;
+  }
+}
+
+size_t
+idlib_broadphase_find_pairs
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_broadphase const* operand,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == capacity);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(first <= operand->number_of_bodies && count <= operand->number_of_bodies - first);
+  idlib_u32 a = operand->axis, b = (a + 1) % 3, c = (a + 2) % 3;
+  idlib_f32 const* minimum_a = operand->minimum[a], * maximum_a = operand->maximum[a];
+  idlib_f32 const* minimum_b = operand->minimum[b], * maximum_b = operand->maximum[b];
+  idlib_f32 const* minimum_c = operand->minimum[c], * maximum_c = operand->maximum[c];
+  idlib_u32 const* order = operand->order;
+  size_t number_of_pairs = 0;
+  for (idlib_u32 i = first; i < first + count; ++i) {
+    idlib_u32 j = i + 1;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+    __m128 maximum_a_i = _mm_set1_ps(maximum_a[i]);
+    __m128 minimum_b_i = _mm_set1_ps(minimum_b[i]), maximum_b_i = _mm_set1_ps(maximum_b[i]);
+    __m128 minimum_c_i = _mm_set1_ps(minimum_c[i]), maximum_c_i = _mm_set1_ps(maximum_c[i]);
+    for (;; j += 4) {
+      // The positions for which the sweep continues. As the minima are sorted (and the padding is NaN), this is a prefix of the four positions.
+      __m128 sweep = _mm_cmple_ps(_mm_loadu_ps(minimum_a + j), maximum_a_i);
+      int continues = _mm_movemask_ps(sweep);
+      if (!continues) {
+        break;
+      }
+      __m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minimum_b + j), maximum_b_i), _mm_cmple_ps(minimum_b_i, _mm_loadu_ps(maximum_b + j)));
+      overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minimum_c + j), maximum_c_i), _mm_cmple_ps(minimum_c_i, _mm_loadu_ps(maximum_c + j))));
+      int mask = _mm_movemask_ps(_mm_and_ps(overlap, sweep));
+      for (idlib_u32 k = 0; k < 4; ++k) {
+        if (mask & (1 << k)) {
+          store_pair(target, capacity, number_of_pairs++, order[i], order[j + k]);
+        }
+      }
+      if (continues != 15) {
+        break;
+      }
+    }
+#else
+    for (; minimum_a[j] <= maximum_a[i]; ++j) {
+      if (minimum_b[j] <= maximum_b[i] && minimum_b[i] <= maximum_b[j] && minimum_c[j] <= maximum_c[i] && minimum_c[i] <= maximum_c[j]) {
+        store_pair(target, capacity, number_of_pairs++, order[i], order[j]);
+      }
+    }
+#endif
+  }
+  return number_of_pairs;
+}
+
+bool
+idlib_broadphase_find_pairs_arena
+  (
+    idlib_u32** target,
+    size_t* number_of_pairs,
+    idlib_arena* arena,
+    idlib_broadphase const* operand,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != number_of_pairs);
+  IDLIB_DEBUG_ASSERT(NULL != arena);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  idlib_arena_marker marker = idlib_arena_push(arena);
+  size_t peak = arena->peak;
+  // Allocate the remaining memory of the arena.
+  size_t available = 0;
+  if (arena->memory) {
+    uintptr_t address = (uintptr_t)(arena->memory + arena->used);
+    size_t padding = (size_t)((sizeof(idlib_u32) - (address & (sizeof(idlib_u32) - 1))) & (sizeof(idlib_u32) - 1));
+    size_t remaining = arena->size - arena->used;
+    available = padding < remaining ? (remaining - padding) / (2 * sizeof(idlib_u32)) : 0;
+  }
+  idlib_u32* pairs = (idlib_u32*)idlib_arena_allocate_aligned(arena, available * 2 * sizeof(idlib_u32), sizeof(idlib_u32));
+  if (!pairs) {
+    return false;
+  }
+  size_t n = idlib_broadphase_find_pairs(pairs, available, operand, first, count);
+  // Shrink the block to the pairs found. The block is allocated at the same address again.
+  idlib_arena_pop(arena, marker);
+  arena->peak = peak;
+  if (n > available) {
+    return false;
+  }
+  pairs = (idlib_u32*)idlib_arena_allocate_aligned(arena, n * 2 * sizeof(idlib_u32), sizeof(idlib_u32));
+  IDLIB_DEBUG_ASSERT(NULL != pairs);
+  *target = pairs;
+  *number_of_pairs = n;
+  return true;
+}
@@ -0,0 +1,1047 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+// memmove
+#include <string.h>
+// fabs, fabsf
+#include <math.h>
+
+#include "idlib/math/convex_hull.h"
+#include "idlib/math/predicates.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+  // __m128i, _mm_*_epi32
+  #include <emmintrin.h>
+#endif
+
+// Symbolic constant denoting "no point" resp. "no face".
+#define NONE (0xFFFFFFFFu)
+
+// The unit roundoff of idlib_f32.
+#define EPSILON (5.9604645e-8f)
+
+// The relative error bound of the evaluation of the height of a point above a face in idlib_f64 arithmetic.
+// Shewchuk's bound for orient3d is (7 + 56 u) u with the unit roundoff u = 2^-53 of idlib_f64.
+#define HEIGHT_ERROR_BOUND (8. * 1.1102230246251565e-16)
+
+// The number of directions along which the extreme points are searched for in the plane: x, y, x + y, x - y.
+#define DIRECTIONS_2 (4)
+
+// The number of directions along which the extreme points are searched for in space: x, y, z, x + y + z, x + y - z, x - y + z, -x + y + z.
+#define DIRECTIONS_3 (7)
+
+// A line in the plane resp. a plane in space.
+// A point p is inside (by a margin exceeding the arithmetic errors of evaluating the f32 expression) if dot(normal, p) - distance < -margin.
+typedef struct plane {
+  idlib_f32 normal[3];
+  idlib_f32 distance;
+  idlib_f32 margin;
+} plane;
+
+// Compute a plane from its normal and a point on it.
+// magnitude is an upper bound of the absolute values of the coordinates of the points tested against the plane.
+static void
+plane_set
+  (
+    plane* target,
+    idlib_f64 const normal[3],
+    idlib_f64 const point[3],
+    idlib_f32 magnitude
+  )
+{
+  idlib_f64 d = 0., l = 0.;
+  for (size_t k = 0; k < 3; ++k) {
+    target->normal[k] = (idlib_f32)normal[k];
+    d += (idlib_f64)target->normal[k] * point[k];
+    l += fabs((idlib_f64)target->normal[k]);
+  }
+  target->distance = (idlib_f32)d;
+  // Bounds the errors of rounding the normal and the distance and of the evaluation with generous slack.
+  target->margin = (idlib_f32)(16. * EPSILON * (l * magnitude + fabs(d)));
+}
+
+// Map an idlib_f32 value to an idlib_u32 value such that the order of the values is preserved.
+// -0 and +0 are mapped to the same value.
+static inline idlib_u32
+sortable
+  (
+    idlib_f32 x
+  )
+{
+  union {
+    idlib_f32 f;
+    idlib_u32 u;
+  } v;
+  v.f = x + 0.f;
+  return v.u ^ ((v.u >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Find the indices of the points with the minimum and the maximum projections onto the directions x, y, x + y, and x - y.
+// Of points with equal projections, the point with the smallest index is selected.
+static void
+extremes_2
+  (
+    idlib_u32 minimum[DIRECTIONS_2],
+    idlib_u32 maximum[DIRECTIONS_2],
+    idlib_vector_2_f32 const* points,
+    idlib_u32 n
+  )
+{
+  idlib_f32 lo[DIRECTIONS_2], hi[DIRECTIONS_2];
+  {
+    idlib_f32 x = points[0].e[0], y = points[0].e[1];
+    idlib_f32 p[DIRECTIONS_2] = { x, y, x + y, x - y };
+    for (size_t k = 0; k < DIRECTIONS_2; ++k) {
+      lo[k] = hi[k] = p[k];
+      minimum[k] = maximum[k] = 0;
+    }
+  }
+  idlib_u32 i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 lo4[DIRECTIONS_2], hi4[DIRECTIONS_2];
+  __m128i lo_i[DIRECTIONS_2], hi_i[DIRECTIONS_2];
+  for (size_t k = 0; k < DIRECTIONS_2; ++k) {
+    lo4[k] = _mm_set1_ps(lo[k]);
+    hi4[k] = _mm_set1_ps(hi[k]);
+    lo_i[k] = hi_i[k] = _mm_setzero_si128();
+  }
+  __m128i index = _mm_setr_epi32(0, 1, 2, 3), four = _mm_set1_epi32(4);
+  for (; i + 4 <= n; i += 4) {
+    __m128 a = _mm_loadu_ps(points[i].e), b = _mm_loadu_ps(points[i + 2].e);
+    __m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    __m128 p[DIRECTIONS_2] = { x, y, _mm_add_ps(x, y), _mm_sub_ps(x, y) };
+    for (size_t k = 0; k < DIRECTIONS_2; ++k) {
+      __m128 m = _mm_cmplt_ps(p[k], lo4[k]);
+      lo4[k] = _mm_or_ps(_mm_and_ps(m, p[k]), _mm_andnot_ps(m, lo4[k]));
+      lo_i[k] = _mm_or_si128(_mm_and_si128(_mm_castps_si128(m), index), _mm_andnot_si128(_mm_castps_si128(m), lo_i[k]));
+      m = _mm_cmpgt_ps(p[k], hi4[k]);
+      hi4[k] = _mm_or_ps(_mm_and_ps(m, p[k]), _mm_andnot_ps(m, hi4[k]));
+      hi_i[k] = _mm_or_si128(_mm_and_si128(_mm_castps_si128(m), index), _mm_andnot_si128(_mm_castps_si128(m), hi_i[k]));
+    }
+    index = _mm_add_epi32(index, four);
+  }
+  for (size_t k = 0; k < DIRECTIONS_2; ++k) {
+    IDLIB_ALIGNAS(16) idlib_f32 v[2][4];
+    IDLIB_ALIGNAS(16) idlib_u32 j[2][4];
+    _mm_store_ps(v[0], lo4[k]);
+    _mm_store_ps(v[1], hi4[k]);
+    _mm_store_si128((__m128i*)j[0], lo_i[k]);
+    _mm_store_si128((__m128i*)j[1], hi_i[k]);
+    for (size_t l = 0; l < 4; ++l) {
+      if (v[0][l] < lo[k] || (v[0][l] == lo[k] && j[0][l] < minimum[k])) {
+        lo[k] = v[0][l];
+        minimum[k] = j[0][l];
+      }
+      if (v[1][l] > hi[k] || (v[1][l] == hi[k] && j[1][l] < maximum[k])) {
+        hi[k] = v[1][l];
+        maximum[k] = j[1][l];
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    idlib_f32 x = points[i].e[0], y = points[i].e[1];
+    idlib_f32 p[DIRECTIONS_2] = { x, y, x + y, x - y };
+    for (size_t k = 0; k < DIRECTIONS_2; ++k) {
+      if (p[k] < lo[k]) {
+        lo[k] = p[k];
+        minimum[k] = i;
+      }
+      if (p[k] > hi[k]) {
+        hi[k] = p[k];
+        maximum[k] = i;
+      }
+    }
+  }
+}
+
+// Store the indices of the points which are not inside all lines. Return the number of these points.
+static idlib_u32
+filter_2
+  (
+    idlib_u32* target,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 n,
+    plane const* planes,
+    idlib_u32 number_of_planes
+  )
+{
+  idlib_u32 count = 0, i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // Without planes, no point is inside.
+  __m128 all = number_of_planes > 0 ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+  for (; i + 4 <= n; i += 4) {
+    __m128 a = _mm_loadu_ps(points[i].e), b = _mm_loadu_ps(points[i + 2].e);
+    __m128 x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    __m128 inside = all;
+    for (idlib_u32 j = 0; j < number_of_planes; ++j) {
+      plane const* p = &planes[j];
+      __m128 v = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p->normal[0]), x), _mm_mul_ps(_mm_set1_ps(p->normal[1]), y)), _mm_set1_ps(p->distance));
+      inside = _mm_and_ps(inside, _mm_cmplt_ps(v, _mm_set1_ps(-p->margin)));
+      if (0 == _mm_movemask_ps(inside)) {
+        break;
+      }
+    }
+    int mask = _mm_movemask_ps(inside);
+    for (idlib_u32 l = 0; l < 4; ++l) {
+      if (!(mask & (1 << l))) {
+        target[count++] = i + l;
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    idlib_f32 x = points[i].e[0], y = points[i].e[1];
+    bool inside = number_of_planes > 0;
+    for (idlib_u32 j = 0; j < number_of_planes && inside; ++j) {
+      plane const* p = &planes[j];
+      idlib_f32 v = (p->normal[0] * x + p->normal[1] * y) - p->distance;
+      inside = v < -p->margin;
+    }
+    if (!inside) {
+      target[count++] = i;
+    }
+  }
+  return count;
+}
+
+// Compute the convex hull of the points with the specified indices by Andrew's monotone chain algorithm.
+// target must provide space for count + 1 indices, keys and order for 2 * count elements each.
+// Return the number of vertices of the hull.
+static idlib_u32
+monotone_chain
+  (
+    idlib_u32* target,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 const* indices,
+    idlib_u32 count,
+    idlib_u64* keys,
+    idlib_u32* order
+  )
+{
+  // Sort the points by their x and then by their y coordinates by a least significant digit radix sort.
+  idlib_u64* k[2] = { keys, keys + count };
+  idlib_u32* o[2] = { order, order + count };
+  for (idlib_u32 i = 0; i < count; ++i) {
+    idlib_vector_2_f32 const* p = &points[indices[i]];
+    k[0][i] = ((idlib_u64)sortable(p->e[0]) << 32) | sortable(p->e[1]);
+    o[0][i] = indices[i];
+  }
+  idlib_u32 source = 0;
+  for (idlib_u32 pass = 0; pass < 8; ++pass) {
+    idlib_u32 shift = pass * 8;
+    size_t counts[256] = { 0 };
+    for (idlib_u32 i = 0; i < count; ++i) {
+      counts[(k[source][i] >> shift) & 0xFF]++;
+    }
+    if (counts[(k[source][0] >> shift) & 0xFF] == count) {
+      // All keys have the same digit.
+      continue;
+    }
+    size_t sum = 0;
+    for (idlib_u32 j = 0; j < 256; ++j) {
+      size_t c = counts[j];
+      counts[j] = sum;
+      sum += c;
+    }
+    for (idlib_u32 i = 0; i < count; ++i) {
+      size_t j = counts[(k[source][i] >> shift) & 0xFF]++;
+      k[1 - source][j] = k[source][i];
+      o[1 - source][j] = o[source][i];
+    }
+    source = 1 - source;
+  }
+  // Remove coinciding points.
+  idlib_u32* sorted = o[1 - source];
+  idlib_u32 m = 0;
+  for (idlib_u32 i = 0; i < count; ++i) {
+    if (0 == i || k[source][i] != k[source][i - 1]) {
+      sorted[m++] = o[source][i];
+    }
+  }
+  if (m < 3) {
+    for (idlib_u32 i = 0; i < m; ++i) {
+      target[i] = sorted[i];
+    }
+    return m;
+  }
+  // Compute the lower hull from left to right and the upper hull from right to left.
+  idlib_u32 h = 0;
+  for (idlib_u32 i = 0; i < m; ++i) {
+    while (h >= 2 && idlib_orient_2_f32(&points[target[h - 2]], &points[target[h - 1]], &points[sorted[i]]) <= 0.) {
+      h--;
+    }
+    target[h++] = sorted[i];
+  }
+  for (idlib_u32 i = m - 1, t = h + 1; i > 0; --i) {
+    while (h >= t && idlib_orient_2_f32(&points[target[h - 2]], &points[target[h - 1]], &points[sorted[i - 1]]) <= 0.) {
+      h--;
+    }
+    target[h++] = sorted[i - 1];
+  }
+  // The first vertex was added again.
+  return h - 1;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+// Load four points and transpose them into their x, y, and z coordinates.
+static inline void
+load_3
+  (
+    __m128* x,
+    __m128* y,
+    __m128* z,
+    idlib_vector_3_f32 const* points
+  )
+{
+  __m128 a = _mm_loadu_ps(points[0].e), b = _mm_loadu_ps(points[0].e + 4), c = _mm_loadu_ps(points[0].e + 8);
+  __m128 u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+  *x = _mm_shuffle_ps(a, u, _MM_SHUFFLE(2, 0, 3, 0));
+  __m128 v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), w = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+  *y = _mm_shuffle_ps(v, w, _MM_SHUFFLE(2, 0, 2, 0));
+  v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+  w = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+  *z = _mm_shuffle_ps(v, w, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+#endif
+
+// Find the indices of the points with the minimum and the maximum projections onto the directions
+// x, y, z, x + y + z, x + y - z, x - y + z, and -x + y + z.
+// Of points with equal projections, the point with the smallest index is selected.
+static void
+extremes_3
+  (
+    idlib_u32 minimum[DIRECTIONS_3],
+    idlib_u32 maximum[DIRECTIONS_3],
+    idlib_vector_3_f32 const* points,
+    idlib_u32 n
+  )
+{
+  idlib_f32 lo[DIRECTIONS_3], hi[DIRECTIONS_3];
+  {
+    idlib_f32 x = points[0].e[0], y = points[0].e[1], z = points[0].e[2];
+    idlib_f32 p[DIRECTIONS_3] = { x, y, z, (x + y) + z, (x + y) - z, (x - y) + z, (y - x) + z };
+    for (size_t k = 0; k < DIRECTIONS_3; ++k) {
+      lo[k] = hi[k] = p[k];
+      minimum[k] = maximum[k] = 0;
+    }
+  }
+  idlib_u32 i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 lo4[DIRECTIONS_3], hi4[DIRECTIONS_3];
+  __m128i lo_i[DIRECTIONS_3], hi_i[DIRECTIONS_3];
+  for (size_t k = 0; k < DIRECTIONS_3; ++k) {
+    lo4[k] = _mm_set1_ps(lo[k]);
+    hi4[k] = _mm_set1_ps(hi[k]);
+    lo_i[k] = hi_i[k] = _mm_setzero_si128();
+  }
+  __m128i index = _mm_setr_epi32(0, 1, 2, 3), four = _mm_set1_epi32(4);
+  for (; i + 4 <= n; i += 4) {
+    __m128 x, y, z;
+    load_3(&x, &y, &z, points + i);
+    __m128 p[DIRECTIONS_3] = { x, y, z,
+                               _mm_add_ps(_mm_add_ps(x, y), z), _mm_sub_ps(_mm_add_ps(x, y), z),
+                               _mm_add_ps(_mm_sub_ps(x, y), z), _mm_add_ps(_mm_sub_ps(y, x), z) };
+    for (size_t k = 0; k < DIRECTIONS_3; ++k) {
+      __m128 m = _mm_cmplt_ps(p[k], lo4[k]);
+      lo4[k] = _mm_or_ps(_mm_and_ps(m, p[k]), _mm_andnot_ps(m, lo4[k]));
+      lo_i[k] = _mm_or_si128(_mm_and_si128(_mm_castps_si128(m), index), _mm_andnot_si128(_mm_castps_si128(m), lo_i[k]));
+      m = _mm_cmpgt_ps(p[k], hi4[k]);
+      hi4[k] = _mm_or_ps(_mm_and_ps(m, p[k]), _mm_andnot_ps(m, hi4[k]));
+      hi_i[k] = _mm_or_si128(_mm_and_si128(_mm_castps_si128(m), index), _mm_andnot_si128(_mm_castps_si128(m), hi_i[k]));
+    }
+    index = _mm_add_epi32(index, four);
+  }
+  for (size_t k = 0; k < DIRECTIONS_3; ++k) {
+    IDLIB_ALIGNAS(16) idlib_f32 v[2][4];
+    IDLIB_ALIGNAS(16) idlib_u32 j[2][4];
+    _mm_store_ps(v[0], lo4[k]);
+    _mm_store_ps(v[1], hi4[k]);
+    _mm_store_si128((__m128i*)j[0], lo_i[k]);
+    _mm_store_si128((__m128i*)j[1], hi_i[k]);
+    for (size_t l = 0; l < 4; ++l) {
+      if (v[0][l] < lo[k] || (v[0][l] == lo[k] && j[0][l] < minimum[k])) {
+        lo[k] = v[0][l];
+        minimum[k] = j[0][l];
+      }
+      if (v[1][l] > hi[k] || (v[1][l] == hi[k] && j[1][l] < maximum[k])) {
+        hi[k] = v[1][l];
+        maximum[k] = j[1][l];
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    idlib_f32 x = points[i].e[0], y = points[i].e[1], z = points[i].e[2];
+    idlib_f32 p[DIRECTIONS_3] = { x, y, z, (x + y) + z, (x + y) - z, (x - y) + z, (y - x) + z };
+    for (size_t k = 0; k < DIRECTIONS_3; ++k) {
+      if (p[k] < lo[k]) {
+        lo[k] = p[k];
+        minimum[k] = i;
+      }
+      if (p[k] > hi[k]) {
+        hi[k] = p[k];
+        maximum[k] = i;
+      }
+    }
+  }
+}
+
+// Store the indices of the points which are not inside all planes. Return the number of these points.
+static idlib_u32
+filter_3
+  (
+    idlib_u32* target,
+    idlib_vector_3_f32 const* points,
+    idlib_u32 n,
+    plane const* planes,
+    idlib_u32 number_of_planes
+  )
+{
+  idlib_u32 count = 0, i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // Without planes, no point is inside.
+  __m128 all = number_of_planes > 0 ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : _mm_setzero_ps();
+  for (; i + 4 <= n; i += 4) {
+    __m128 x, y, z;
+    load_3(&x, &y, &z, points + i);
+    __m128 inside = all;
+    for (idlib_u32 j = 0; j < number_of_planes; ++j) {
+      plane const* p = &planes[j];
+      __m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p->normal[0]), x), _mm_mul_ps(_mm_set1_ps(p->normal[1]), y)), _mm_mul_ps(_mm_set1_ps(p->normal[2]), z));
+      v = _mm_sub_ps(v, _mm_set1_ps(p->distance));
+      inside = _mm_and_ps(inside, _mm_cmplt_ps(v, _mm_set1_ps(-p->margin)));
+      if (0 == _mm_movemask_ps(inside)) {
+        break;
+      }
+    }
+    int mask = _mm_movemask_ps(inside);
+    for (idlib_u32 l = 0; l < 4; ++l) {
+      if (!(mask & (1 << l))) {
+        target[count++] = i + l;
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    idlib_f32 x = points[i].e[0], y = points[i].e[1], z = points[i].e[2];
+    bool inside = number_of_planes > 0;
+    for (idlib_u32 j = 0; j < number_of_planes && inside; ++j) {
+      plane const* p = &planes[j];
+      idlib_f32 v = ((p->normal[0] * x + p->normal[1] * y) + p->normal[2] * z) - p->distance;
+      inside = v < -p->margin;
+    }
+    if (!inside) {
+      target[count++] = i;
+    }
+  }
+  return count;
+}
+
+// A face of the hull. The vertices are in counterclockwise order when viewed from outside.
+// neighbors[k] is the face sharing the edge from vertices[k] to vertices[(k + 1) % 3].
+typedef struct hull_face {
+  idlib_u32 vertices[3];
+  idlib_u32 neighbors[3];
+  // The normal (b - a) x (c - a) of the face abc and the absolute values of the products it is computed from.
+  idlib_f64 normal[3];
+  idlib_f64 permanent[3];
+  // The first point of the outside set, the list of points above the face assigned to it.
+  idlib_u32 outside;
+  // The point of the outside set farthest from the face and its height above the face.
+  idlib_u32 farthest;
+  idlib_f64 distance;
+  // The previous and the next face in the list of faces with outside points resp. the next face in the list of free faces.
+  idlib_u32 previous;
+  idlib_u32 next;
+  // The number of the iteration in which the face was found to be visible.
+  idlib_u32 visited;
+  bool alive;
+} hull_face;
+
+typedef struct quickhull {
+  idlib_vector_3_f32 const* points;
+  idlib_u32 number_of_points;
+  hull_face* faces;
+  idlib_u32 capacity;
+  // The number of used face slots, the number of faces alive.
+  idlib_u32 number_of_slots;
+  idlib_u32 number_of_faces;
+  // The list of free face slots.
+  idlib_u32 free;
+  // The list of faces with outside points.
+  idlib_u32 pending;
+  idlib_u32 iteration;
+  // For each point, the next point in the outside set.
+  idlib_u32* next;
+  // For each point, the new face whose horizon edge starts at the point.
+  idlib_u32* link;
+  // The visible faces resp. the new faces.
+  idlib_u32* visible;
+  // The horizon edges (start vertex, end vertex, face beyond the horizon).
+  idlib_u32* horizon;
+  // The outside points of the visible faces.
+  idlib_u32* unassigned;
+} quickhull;
+
+// Compute the height of a point above a face (scaled by twice the area of the face).
+// The height is evaluated in idlib_f64 arithmetic with the error bound of Shewchuk's orient3d.
+// Only if its sign is uncertain, it is re-evaluated by idlib_orient_3_f32.
+static inline idlib_f64
+height
+  (
+    quickhull const* qh,
+    hull_face const* f,
+    idlib_u32 p
+  )
+{
+  idlib_vector_3_f32 const* a = &qh->points[f->vertices[0]];
+  idlib_f64 w[3];
+  for (size_t k = 0; k < 3; ++k) {
+    w[k] = (idlib_f64)qh->points[p].e[k] - (idlib_f64)a->e[k];
+  }
+  idlib_f64 d = w[0] * f->normal[0] + w[1] * f->normal[1] + w[2] * f->normal[2];
+  idlib_f64 e = fabs(w[0]) * f->permanent[0] + fabs(w[1]) * f->permanent[1] + fabs(w[2]) * f->permanent[2];
+  if (fabs(d) > HEIGHT_ERROR_BOUND * e) {
+    return d;
+  }
+  return -idlib_orient_3_f32(a, &qh->points[f->vertices[1]], &qh->points[f->vertices[2]], &qh->points[p]);
+}
+
+static idlib_u32
+face_create
+  (
+    quickhull* qh,
+    idlib_u32 a,
+    idlib_u32 b,
+    idlib_u32 c
+  )
+{
+  idlib_u32 i;
+  if (NONE != qh->free) {
+    i = qh->free;
+    qh->free = qh->faces[i].next;
+  } else {
+    IDLIB_DEBUG_ASSERT(qh->number_of_slots < qh->capacity);
+    i = qh->number_of_slots++;
+  }
+  hull_face* f = &qh->faces[i];
+  f->vertices[0] = a;
+  f->vertices[1] = b;
+  f->vertices[2] = c;
+  f->neighbors[0] = f->neighbors[1] = f->neighbors[2] = NONE;
+  idlib_f64 u[3], v[3];
+  for (size_t k = 0; k < 3; ++k) {
+    u[k] = (idlib_f64)qh->points[b].e[k] - (idlib_f64)qh->points[a].e[k];
+    v[k] = (idlib_f64)qh->points[c].e[k] - (idlib_f64)qh->points[a].e[k];
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    size_t i = (k + 1) % 3, j = (k + 2) % 3;
+    f->normal[k] = u[i] * v[j] - u[j] * v[i];
+    f->permanent[k] = fabs(u[i] * v[j]) + fabs(u[j] * v[i]);
+  }
+  f->outside = f->farthest = NONE;
+  f->distance = 0.;
+  f->previous = f->next = NONE;
+  f->visited = 0;
+  f->alive = true;
+  qh->number_of_faces++;
+  return i;
+}
+
+static void
+face_destroy
+  (
+    quickhull* qh,
+    idlib_u32 i
+  )
+{
+  hull_face* f = &qh->faces[i];
+  if (NONE != f->outside) {
+    // Remove the face from the list of faces with outside points.
+    if (NONE != f->previous) {
+      qh->faces[f->previous].next = f->next;
+    } else {
+      qh->pending = f->next;
+    }
+    if (NONE != f->next) {
+      qh->faces[f->next].previous = f->previous;
+    }
+  }
+  f->alive = false;
+  f->next = qh->free;
+  qh->free = i;
+  qh->number_of_faces--;
+}
+
+// Assign a point to the outside set of the first of the faces it is above.
+static void
+assign
+  (
+    quickhull* qh,
+    idlib_u32 p,
+    idlib_u32 const* faces,
+    idlib_u32 number_of_faces
+  )
+{
+  for (idlib_u32 j = 0; j < number_of_faces; ++j) {
+    idlib_u32 i = faces[j];
+    hull_face* f = &qh->faces[i];
+    idlib_f64 d = height(qh, f, p);
+    if (d > 0.) {
+      if (NONE == f->outside) {
+        f->previous = NONE;
+        f->next = qh->pending;
+        if (NONE != qh->pending) {
+          qh->faces[qh->pending].previous = i;
+        }
+        qh->pending = i;
+      }
+      qh->next[p] = f->outside;
+      f->outside = p;
+      if (d > f->distance) {
+        f->distance = d;
+        f->farthest = p;
+      }
+      return;
+    }
+  }
+}
+
+// Create the initial tetrahedron. Return false if the points are coplanar.
+static bool
+quickhull_start
+  (
+    quickhull* qh
+  )
+{
+  idlib_vector_3_f32 const* p = qh->points;
+  idlib_u32 n = qh->number_of_points;
+  // The extreme points along the axes.
+  idlib_u32 e[6] = { 0, 0, 0, 0, 0, 0 };
+  for (idlib_u32 i = 1; i < n; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      if (p[i].e[k] < p[e[2 * k]].e[k]) e[2 * k] = i;
+      if (p[i].e[k] > p[e[2 * k + 1]].e[k]) e[2 * k + 1] = i;
+    }
+  }
+  // The two extreme points farthest apart.
+  idlib_u32 v[4] = { 0, 0, 0, 0 };
+  idlib_f64 best = 0.;
+  for (size_t i = 0; i < 6; ++i) {
+    for (size_t j = i + 1; j < 6; ++j) {
+      idlib_f64 l = 0.;
+      for (size_t k = 0; k < 3; ++k) {
+        idlib_f64 d = (idlib_f64)p[e[i]].e[k] - (idlib_f64)p[e[j]].e[k];
+        l += d * d;
+      }
+      if (l > best) {
+        best = l;
+        v[0] = e[i];
+        v[1] = e[j];
+      }
+    }
+  }
+  if (!(best > 0.)) {
+    return false;
+  }
+  // The point farthest from the line through these points.
+  idlib_f64 a[3], u[3], normal[3] = { 0., 0., 0. };
+  for (size_t k = 0; k < 3; ++k) {
+    a[k] = p[v[0]].e[k];
+    u[k] = (idlib_f64)p[v[1]].e[k] - a[k];
+  }
+  best = 0.;
+  for (idlib_u32 i = 0; i < n; ++i) {
+    idlib_f64 w[3] = { p[i].e[0] - a[0], p[i].e[1] - a[1], p[i].e[2] - a[2] };
+    idlib_f64 c[3] = { u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0] };
+    idlib_f64 l = c[0] * c[0] + c[1] * c[1] + c[2] * c[2];
+    if (l > best) {
+      best = l;
+      v[2] = i;
+      normal[0] = c[0];
+      normal[1] = c[1];
+      normal[2] = c[2];
+    }
+  }
+  if (!(best > 0.)) {
+    return false;
+  }
+  // The point farthest from the plane through these points.
+  best = 0.;
+  for (idlib_u32 i = 0; i < n; ++i) {
+    idlib_f64 l = fabs(normal[0] * (p[i].e[0] - a[0]) + normal[1] * (p[i].e[1] - a[1]) + normal[2] * (p[i].e[2] - a[2]));
+    if (l > best) {
+      best = l;
+      v[3] = i;
+    }
+  }
+  idlib_f64 o = idlib_orient_3_f32(&p[v[0]], &p[v[1]], &p[v[2]], &p[v[3]]);
+  for (idlib_u32 i = 0; i < n && 0. == o; ++i) {
+    // The approximations failed: Search for any point not coplanar.
+    o = idlib_orient_3_f32(&p[v[0]], &p[v[1]], &p[v[2]], &p[i]);
+    v[3] = i;
+  }
+  if (0. == o) {
+    return false;
+  }
+  if (o < 0.) {
+    idlib_u32 t = v[1];
+    v[1] = v[2];
+    v[2] = t;
+  }
+  // The fourth point is below the plane of the first three points.
+  static idlib_u32 const faces[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+  idlib_u32 f[4];
+  for (size_t i = 0; i < 4; ++i) {
+    f[i] = face_create(qh, v[faces[i][0]], v[faces[i][1]], v[faces[i][2]]);
+  }
+  for (size_t i = 0; i < 4; ++i) {
+    hull_face* g = &qh->faces[f[i]];
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_u32 s = g->vertices[k], t = g->vertices[(k + 1) % 3];
+      for (size_t j = 0; j < 4; ++j) {
+        hull_face const* h = &qh->faces[f[j]];
+        for (size_t l = 0; l < 3; ++l) {
+          if (h->vertices[l] == t && h->vertices[(l + 1) % 3] == s) {
+            g->neighbors[k] = f[j];
+          }
+        }
+      }
+    }
+  }
+  for (idlib_u32 i = 0; i < n; ++i) {
+    assign(qh, i, f, 4);
+  }
+  return true;
+}
+
+// Add the farthest point of a face with outside points to the hull.
+static void
+quickhull_step
+  (
+    quickhull* qh
+  )
+{
+  idlib_u32 i = qh->pending;
+  idlib_u32 eye = qh->faces[i].farthest;
+  idlib_u32 iteration = ++qh->iteration;
+  // Find the faces visible from the point and the horizon by a breadth first search.
+  idlib_u32 number_of_visible = 0, number_of_horizon = 0;
+  qh->visible[number_of_visible++] = i;
+  qh->faces[i].visited = iteration;
+  for (idlib_u32 j = 0; j < number_of_visible; ++j) {
+    hull_face const* f = &qh->faces[qh->visible[j]];
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_u32 g = f->neighbors[k];
+      if (qh->faces[g].visited == iteration) {
+        continue;
+      }
+      if (height(qh, &qh->faces[g], eye) > 0.) {
+        qh->faces[g].visited = iteration;
+        qh->visible[number_of_visible++] = g;
+      } else {
+        idlib_u32* h = &qh->horizon[3 * number_of_horizon++];
+        h[0] = f->vertices[k];
+        h[1] = f->vertices[(k + 1) % 3];
+        h[2] = g;
+      }
+    }
+  }
+  // Collect the outside points of the visible faces and remove the visible faces.
+  idlib_u32 number_of_unassigned = 0;
+  for (idlib_u32 j = 0; j < number_of_visible; ++j) {
+    for (idlib_u32 p = qh->faces[qh->visible[j]].outside; NONE != p; p = qh->next[p]) {
+      if (p != eye) {
+        qh->unassigned[number_of_unassigned++] = p;
+      }
+    }
+    face_destroy(qh, qh->visible[j]);
+  }
+  // Connect the horizon to the point.
+  idlib_u32* new_faces = qh->visible;
+  for (idlib_u32 j = 0; j < number_of_horizon; ++j) {
+    idlib_u32 const* h = &qh->horizon[3 * j];
+    idlib_u32 f = face_create(qh, h[0], h[1], eye);
+    hull_face* g = &qh->faces[h[2]];
+    qh->faces[f].neighbors[0] = h[2];
+    for (size_t k = 0; k < 3; ++k) {
+      if (g->vertices[k] == h[1] && g->vertices[(k + 1) % 3] == h[0]) {
+        g->neighbors[k] = f;
+      }
+    }
+    qh->link[h[0]] = f;
+    new_faces[j] = f;
+  }
+  for (idlib_u32 j = 0; j < number_of_horizon; ++j) {
+    hull_face* f = &qh->faces[new_faces[j]];
+    idlib_u32 g = qh->link[f->vertices[1]];
+    f->neighbors[1] = g;
+    qh->faces[g].neighbors[2] = new_faces[j];
+  }
+  for (idlib_u32 j = 0; j < number_of_unassigned; ++j) {
+    assign(qh, qh->unassigned[j], new_faces, number_of_horizon);
+  }
+}
+
+// Compute the convex hull of a set of points by the Quickhull algorithm.
+// Return false if the arena is exhausted. If the points are coplanar, then the hull has no faces.
+static bool
+quickhull_run
+  (
+    quickhull* qh,
+    idlib_arena* arena,
+    idlib_vector_3_f32 const* points,
+    idlib_u32 n
+  )
+{
+  qh->points = points;
+  qh->number_of_points = n;
+  // A hull of v vertices has 2 v - 4 faces. The visible faces are removed before new faces are created.
+  qh->capacity = 2 * n + 4;
+  qh->number_of_slots = 0;
+  qh->number_of_faces = 0;
+  qh->free = NONE;
+  qh->pending = NONE;
+  qh->iteration = 0;
+  qh->faces = (hull_face*)idlib_arena_allocate(arena, qh->capacity * sizeof(hull_face));
+  qh->next = (idlib_u32*)idlib_arena_allocate(arena, n * sizeof(idlib_u32));
+  qh->link = (idlib_u32*)idlib_arena_allocate(arena, n * sizeof(idlib_u32));
+  qh->visible = (idlib_u32*)idlib_arena_allocate(arena, qh->capacity * sizeof(idlib_u32));
+  qh->horizon = (idlib_u32*)idlib_arena_allocate(arena, 3 * qh->capacity * sizeof(idlib_u32));
+  qh->unassigned = (idlib_u32*)idlib_arena_allocate(arena, n * sizeof(idlib_u32));
+  if (!qh->faces || !qh->next || !qh->link || !qh->visible || !qh->horizon || !qh->unassigned) {
+    return false;
+  }
+  if (n < 4 || !quickhull_start(qh)) {
+    qh->number_of_slots = 0;
+    qh->number_of_faces = 0;
+    return true;
+  }
+  while (NONE != qh->pending) {
+    quickhull_step(qh);
+  }
+  return true;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+bool
+idlib_convex_hull_2_f32
+  (
+    idlib_u32** target,
+    idlib_u32* number_of_vertices,
+    idlib_arena* arena,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 number_of_points
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != number_of_vertices);
+  IDLIB_DEBUG_ASSERT(NULL != arena);
+  IDLIB_DEBUG_ASSERT(NULL != points || 0 == number_of_points);
+  *target = NULL;
+  *number_of_vertices = 0;
+  if (0 == number_of_points) {
+    return true;
+  }
+  idlib_arena_marker marker = idlib_arena_push(arena);
+  // The peak is restored on failure such that the arena is unmodified.
+  size_t peak = arena->peak;
+  // Compute the hull of the extreme points and the lines through its edges.
+  idlib_u32 minimum[DIRECTIONS_2], maximum[DIRECTIONS_2];
+  extremes_2(minimum, maximum, points, number_of_points);
+  idlib_u32 e[2 * DIRECTIONS_2], number_of_extremes = 0;
+  for (size_t k = 0; k < 2 * DIRECTIONS_2; ++k) {
+    idlib_u32 i = k < DIRECTIONS_2 ? minimum[k] : maximum[k - DIRECTIONS_2];
+    bool found = false;
+    for (idlib_u32 j = 0; j < number_of_extremes; ++j) {
+      found |= e[j] == i;
+    }
+    if (!found) {
+      e[number_of_extremes++] = i;
+    }
+  }
+  idlib_f32 magnitude = 0.f;
+  for (size_t k = 0; k < 2; ++k) {
+    idlib_f32 a = fabsf(points[minimum[k]].e[k]), b = fabsf(points[maximum[k]].e[k]);
+    magnitude = a > magnitude ? a : magnitude;
+    magnitude = b > magnitude ? b : magnitude;
+  }
+  idlib_u64 keys[4 * DIRECTIONS_2];
+  idlib_u32 order[4 * DIRECTIONS_2], polygon[2 * DIRECTIONS_2 + 1];
+  idlib_u32 number_of_planes = monotone_chain(polygon, points, e, number_of_extremes, keys, order);
+  plane planes[2 * DIRECTIONS_2];
+  if (number_of_planes < 3) {
+    number_of_planes = 0;
+  }
+  for (idlib_u32 j = 0; j < number_of_planes; ++j) {
+    idlib_vector_2_f32 const* a = &points[polygon[j]];
+    idlib_vector_2_f32 const* b = &points[polygon[(j + 1) % number_of_planes]];
+    // The outward normal of the counterclockwise edge from a to b.
+    idlib_f64 normal[3] = { (idlib_f64)b->e[1] - a->e[1], (idlib_f64)a->e[0] - b->e[0], 0. };
+    idlib_f64 point[3] = { a->e[0], a->e[1], 0. };
+    plane_set(&planes[j], normal, point, magnitude);
+  }
+  // Discard the points inside the hull of the extreme points.
+  idlib_u32* indices = (idlib_u32*)idlib_arena_allocate(arena, number_of_points * sizeof(idlib_u32));
+  if (!indices) {
+    idlib_arena_pop(arena, marker);
+    arena->peak = peak;
+    return false;
+  }
+  idlib_u32 m = filter_2(indices, points, number_of_points, planes, number_of_planes);
+  idlib_u64* k = (idlib_u64*)idlib_arena_allocate(arena, 2 * (size_t)m * sizeof(idlib_u64));
+  idlib_u32* o = (idlib_u32*)idlib_arena_allocate(arena, 2 * (size_t)m * sizeof(idlib_u32));
+  idlib_u32* hull = (idlib_u32*)idlib_arena_allocate(arena, ((size_t)m + 1) * sizeof(idlib_u32));
+  if (!k || !o || !hull) {
+    idlib_arena_pop(arena, marker);
+    arena->peak = peak;
+    return false;
+  }
+  idlib_u32 h = monotone_chain(hull, points, indices, m, k, o);
+  // Free the temporary arrays and move the vertices to the beginning of the freed memory.
+  idlib_arena_pop(arena, marker);
+  idlib_u32* vertices = (idlib_u32*)idlib_arena_allocate(arena, h * sizeof(idlib_u32));
+  IDLIB_DEBUG_ASSERT(NULL != vertices);
+  memmove(vertices, hull, h * sizeof(idlib_u32));
+  *target = vertices;
+  *number_of_vertices = h;
+  return true;
+}
+
+bool
+idlib_convex_hull_3_f32
+  (
+    idlib_u32** target,
+    idlib_u32* number_of_triangles,
+    idlib_arena* arena,
+    idlib_vector_3_f32 const* points,
+    idlib_u32 number_of_points
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != number_of_triangles);
+  IDLIB_DEBUG_ASSERT(NULL != arena);
+  IDLIB_DEBUG_ASSERT(NULL != points || 0 == number_of_points);
+  *target = NULL;
+  *number_of_triangles = 0;
+  if (number_of_points < 4) {
+    return true;
+  }
+  idlib_arena_marker marker = idlib_arena_push(arena);
+  // The peak is restored on failure such that the arena is unmodified.
+  size_t peak = arena->peak;
+  // Compute the hull of the extreme points and the planes through its faces.
+  idlib_u32 minimum[DIRECTIONS_3], maximum[DIRECTIONS_3];
+  extremes_3(minimum, maximum, points, number_of_points);
+  idlib_vector_3_f32 e[2 * DIRECTIONS_3];
+  idlib_u32 number_of_extremes = 0;
+  for (size_t k = 0; k < 2 * DIRECTIONS_3; ++k) {
+    idlib_vector_3_f32 const* p = &points[k < DIRECTIONS_3 ? minimum[k] : maximum[k - DIRECTIONS_3]];
+    bool found = false;
+    for (idlib_u32 j = 0; j < number_of_extremes; ++j) {
+      found |= e[j].e[0] == p->e[0] && e[j].e[1] == p->e[1] && e[j].e[2] == p->e[2];
+    }
+    if (!found) {
+      e[number_of_extremes++] = *p;
+    }
+  }
+  idlib_f32 magnitude = 0.f;
+  for (size_t k = 0; k < 3; ++k) {
+    idlib_f32 a = fabsf(points[minimum[k]].e[k]), b = fabsf(points[maximum[k]].e[k]);
+    magnitude = a > magnitude ? a : magnitude;
+    magnitude = b > magnitude ? b : magnitude;
+  }
+  quickhull qh;
+  if (!quickhull_run(&qh, arena, e, number_of_extremes)) {
+    idlib_arena_pop(arena, marker);
+    arena->peak = peak;
+    return false;
+  }
+  plane planes[4 * DIRECTIONS_3];
+  idlib_u32 number_of_planes = 0;
+  for (idlib_u32 i = 0; i < qh.number_of_slots; ++i) {
+    hull_face const* f = &qh.faces[i];
+    if (!f->alive) {
+      continue;
+    }
+    idlib_f64 a[3], u[3], v[3];
+    for (size_t k = 0; k < 3; ++k) {
+      a[k] = e[f->vertices[0]].e[k];
+      u[k] = (idlib_f64)e[f->vertices[1]].e[k] - a[k];
+      v[k] = (idlib_f64)e[f->vertices[2]].e[k] - a[k];
+    }
+    idlib_f64 normal[3] = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+    plane_set(&planes[number_of_planes++], normal, a, magnitude);
+  }
+  // Discard the points inside the hull of the extreme points.
+  idlib_u32* indices = (idlib_u32*)idlib_arena_allocate(arena, number_of_points * sizeof(idlib_u32));
+  if (!indices) {
+    idlib_arena_pop(arena, marker);
+    arena->peak = peak;
+    return false;
+  }
+  idlib_u32 m = filter_3(indices, points, number_of_points, planes, number_of_planes);
+  idlib_vector_3_f32* p = (idlib_vector_3_f32*)idlib_arena_allocate(arena, (size_t)m * sizeof(idlib_vector_3_f32));
+  if (!p) {
+    idlib_arena_pop(arena, marker);
+    arena->peak = peak;
+    return false;
+  }
+  for (idlib_u32 i = 0; i < m; ++i) {
+    p[i] = points[indices[i]];
+  }
+  if (!quickhull_run(&qh, arena, p, m)) {
+    idlib_arena_pop(arena, marker);
+    arena->peak = peak;
+    return false;
+  }
+  // Store the triangles in the array of the horizon edges (which holds 3 (2 m + 4) indices) and map the vertices to the indices of the points.
+  idlib_u32 t = qh.number_of_faces;
+  idlib_u32* triangles = qh.horizon;
+  for (idlib_u32 i = 0, j = 0; i < qh.number_of_slots; ++i) {
+    hull_face const* f = &qh.faces[i];
+    if (f->alive) {
+      for (size_t k = 0; k < 3; ++k) {
+        triangles[j++] = indices[f->vertices[k]];
+      }
+    }
+  }
+  // Free the temporary arrays and move the triangles to the beginning of the freed memory.
+  idlib_arena_pop(arena, marker);
+  idlib_u32* result = (idlib_u32*)idlib_arena_allocate(arena, 3 * (size_t)t * sizeof(idlib_u32));
+  IDLIB_DEBUG_ASSERT(NULL != result);
+  memmove(result, triangles, 3 * (size_t)t * sizeof(idlib_u32));
+  *target = t > 0 ? result : NULL;
+  *number_of_triangles = t;
+  return true;
+}
@@ -0,0 +1,885 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/curve.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// The scalar paths below perform the same sequence of operations as the SIMD paths
+// such that the results do not depend on the position of a parameter in the stream.
+
+// The basis matrices of the kinds of curves.
+// The point with the parameter t on a segment with the control points p[0], ..., p[3] is
+// sum_j w[j] p[j] where w[j] = BASIS[kind][0][j] t^3 + BASIS[kind][1][j] t^2 + BASIS[kind][2][j] t + BASIS[kind][3][j].
+static idlib_f32 const BASIS[4][4][4] = {
+  // IDLIB_CURVE_HERMITE (p0, m0, p1, m1)
+  {
+    {  2.f,  1.f, -2.f,  1.f },
+    { -3.f, -2.f,  3.f, -1.f },
+    {  0.f,  1.f,  0.f,  0.f },
+    {  1.f,  0.f,  0.f,  0.f },
+  },
+  // IDLIB_CURVE_CATMULL_ROM
+  {
+    { -0.5f,  1.5f, -1.5f,  0.5f },
+    {  1.0f, -2.5f,  2.0f, -0.5f },
+    { -0.5f,  0.0f,  0.5f,  0.0f },
+    {  0.0f,  1.0f,  0.0f,  0.0f },
+  },
+  // IDLIB_CURVE_BEZIER
+  {
+    { -1.f,  3.f, -3.f, 1.f },
+    {  3.f, -6.f,  3.f, 0.f },
+    { -3.f,  3.f,  0.f, 0.f },
+    {  1.f,  0.f,  0.f, 0.f },
+  },
+  // IDLIB_CURVE_B_SPLINE
+  {
+    { -1.f / 6.f,  3.f / 6.f, -3.f / 6.f, 1.f / 6.f },
+    {  3.f / 6.f, -6.f / 6.f,  3.f / 6.f, 0.f       },
+    { -3.f / 6.f,  0.f,        3.f / 6.f, 0.f       },
+    {  1.f / 6.f,  4.f / 6.f,  1.f / 6.f, 0.f       },
+  },
+};
+
+// The number of control points between the first control points of two consecutive segments.
+static idlib_u32 const STRIDE[4] = { 2, 1, 3, 1 };
+
+// The nodes of the five point Gauss-Legendre quadrature mapped from [-1, 1] to [0, 1] and the weights halved accordingly.
+static idlib_f32 const GAUSS_NODES[5] = {
+  0.5f - 0.5f * 0.9061798459386640f,
+  0.5f - 0.5f * 0.5384693101056831f,
+  0.5f,
+  0.5f + 0.5f * 0.5384693101056831f,
+  0.5f + 0.5f * 0.9061798459386640f,
+};
+
+static idlib_f32 const GAUSS_WEIGHTS[5] = {
+  0.5f * 0.2369268850561891f,
+  0.5f * 0.4786286704993665f,
+  0.5f * 0.5688888888888889f,
+  0.5f * 0.4786286704993665f,
+  0.5f * 0.2369268850561891f,
+};
+
+// A curve independent of the number of components of its control points.
+typedef struct curve {
+  idlib_u32 kind;
+  idlib_f32 const* points;
+  idlib_u32 number_of_points;
+} curve;
+
+// Gets the i-th curve of an array of curves.
+typedef curve (get_curve_callback)(void const* curves, size_t i);
+
+static idlib_u32
+get_number_of_segments
+  (
+    idlib_u32 kind,
+    idlib_u32 number_of_points
+  )
+{ return number_of_points < 4 ? 0 : (number_of_points - 4) / STRIDE[kind] + 1; }
+
+// Maps a curve parameter to the index of the first control point of the segment and the segment parameter.
+static void
+locate
+  (
+    curve const* operand,
+    idlib_f32 parameter,
+    idlib_u32* first,
+    idlib_f32* t
+  )
+{
+  idlib_u32 n = get_number_of_segments(operand->kind, operand->number_of_points);
+  IDLIB_DEBUG_ASSERT(0 < n);
+  idlib_f32 u = parameter > 0.f ? parameter : 0.f;
+  u = u < (idlib_f32)n ? u : (idlib_f32)n;
+  idlib_u32 s = (idlib_u32)u;
+  s = s < n - 1 ? s : n - 1;
+  *first = s * STRIDE[operand->kind];
+  *t = u - (idlib_f32)s;
+}
+
+// Computes the weights of the control points of a segment (or of the derivative if derivative is true).
+static void
+get_weights
+  (
+    idlib_f32 target[4],
+    idlib_u32 kind,
+    idlib_f32 t,
+    bool derivative
+  )
+{
+  idlib_f32 const (*m)[4] = BASIS[kind];
+  for (size_t j = 0; j < 4; ++j) {
+    if (derivative) {
+      target[j] = ((3.f * m[0][j]) * t + (2.f * m[1][j])) * t + m[2][j];
+    } else {
+      target[j] = ((m[0][j] * t + m[1][j]) * t + m[2][j]) * t + m[3][j];
+    }
+  }
+}
+
+// Computes the point (or the derivative) of a curve at a parameter.
+static void
+evaluate
+  (
+    idlib_f32* target,
+    curve const* operand,
+    idlib_u32 number_of_components,
+    idlib_f32 parameter,
+    bool derivative
+  )
+{
+  idlib_u32 first;
+  idlib_f32 t, w[4];
+  locate(operand, parameter, &first, &t);
+  get_weights(w, operand->kind, t, derivative);
+  idlib_f32 const* p = operand->points + (size_t)first * number_of_components;
+  for (size_t c = 0; c < number_of_components; ++c) {
+    target[c] = w[0] * p[c]
+              + w[1] * p[number_of_components + c]
+              + w[2] * p[2 * number_of_components + c]
+              + w[3] * p[3 * number_of_components + c];
+  }
+}
+
+// Computes the points (or the derivatives) of curves at parameters.
+// If curves is NULL, the curve operand is evaluated at all parameters.
+// Otherwise the i-th curve of curves is evaluated at the i-th parameter.
+static void
+evaluate_n
+  (
+    idlib_f32* const* target,
+    curve const* operand,
+    void const* curves,
+    get_curve_callback* get_curve,
+    idlib_u32 number_of_components,
+    idlib_f32 const* parameters,
+    size_t count,
+    bool derivative
+  )
+{
+  size_t i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 three = _mm_set1_ps(3.f), two = _mm_set1_ps(2.f);
+  for (; i + 4 <= count; i += 4) {
+    curve c[4];
+    idlib_f32 const* p[4];
+    idlib_u32 first[4];
+    idlib_f32 t[4];
+    for (size_t k = 0; k < 4; ++k) {
+      c[k] = curves ? get_curve(curves, i + k) : *operand;
+      locate(&c[k], parameters[i + k], &first[k], &t[k]);
+      p[k] = c[k].points + (size_t)first[k] * number_of_components;
+    }
+    __m128 tt = _mm_setr_ps(t[0], t[1], t[2], t[3]);
+    __m128 w[4];
+    for (size_t j = 0; j < 4; ++j) {
+      __m128 m[4];
+      if (curves) {
+        for (size_t r = 0; r < 4; ++r) {
+          m[r] = _mm_setr_ps(BASIS[c[0].kind][r][j], BASIS[c[1].kind][r][j], BASIS[c[2].kind][r][j], BASIS[c[3].kind][r][j]);
+        }
+      } else {
+        for (size_t r = 0; r < 4; ++r) {
+          m[r] = _mm_set1_ps(BASIS[operand->kind][r][j]);
+        }
+      }
+      if (derivative) {
+        w[j] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(three, m[0]), tt), _mm_mul_ps(two, m[1])), tt), m[2]);
+      } else {
+        w[j] = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(m[0], tt), m[1]), tt), m[2]), tt), m[3]);
+      }
+    }
+    for (size_t d = 0; d < number_of_components; ++d) {
+      __m128 v = _mm_mul_ps(w[0], _mm_setr_ps(p[0][d], p[1][d], p[2][d], p[3][d]));
+      for (size_t j = 1; j < 4; ++j) {
+        size_t o = j * number_of_components + d;
+        v = _mm_add_ps(v, _mm_mul_ps(w[j], _mm_setr_ps(p[0][o], p[1][o], p[2][o], p[3][o])));
+      }
+      _mm_storeu_ps(target[d] + i, v);
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    curve c = curves ? get_curve(curves, i) : *operand;
+    idlib_f32 v[4];
+    evaluate(v, &c, number_of_components, parameters[i], derivative);
+    for (size_t d = 0; d < number_of_components; ++d) {
+      target[d][i] = v[d];
+    }
+  }
+}
+
+// Computes the power basis coefficients a, b, c, d of a segment such that the segment is a t^3 + b t^2 + c t + d.
+static void
+get_power_coefficients
+  (
+    idlib_f32 target[4][4],
+    curve const* operand,
+    idlib_u32 number_of_components,
+    idlib_u32 segment
+  )
+{
+  idlib_f32 const (*m)[4] = BASIS[operand->kind];
+  idlib_f32 const* p = operand->points + (size_t)segment * STRIDE[operand->kind] * number_of_components;
+  for (size_t r = 0; r < 4; ++r) {
+    for (size_t c = 0; c < number_of_components; ++c) {
+      target[r][c] = m[r][0] * p[c]
+                   + m[r][1] * p[number_of_components + c]
+                   + m[r][2] * p[2 * number_of_components + c]
+                   + m[r][3] * p[3 * number_of_components + c];
+    }
+  }
+}
+
+static void
+get_bezier
+  (
+    idlib_f32* target,
+    curve const* operand,
+    idlib_u32 number_of_components,
+    idlib_u32 segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(segment < get_number_of_segments(operand->kind, operand->number_of_points));
+  if (IDLIB_CURVE_BEZIER == operand->kind) {
+    idlib_f32 const* p = operand->points + (size_t)segment * 3 * number_of_components;
+    for (size_t c = 0; c < 4 * number_of_components; ++c) {
+      target[c] = p[c];
+    }
+    return;
+  }
+  idlib_f32 k[4][4];
+  get_power_coefficients(k, operand, number_of_components, segment);
+  for (size_t c = 0; c < number_of_components; ++c) {
+    idlib_f32 a = k[0][c], b = k[1][c], d1 = k[2][c], d0 = k[3][c];
+    idlib_f32 b1 = d0 + d1 / 3.f;
+    target[c] = d0;
+    target[number_of_components + c] = b1;
+    target[2 * number_of_components + c] = b1 + (d1 + b) / 3.f;
+    target[3 * number_of_components + c] = a + b + d1 + d0;
+  }
+}
+
+static void
+bezier_split
+  (
+    idlib_f32* target1,
+    idlib_f32* target2,
+    idlib_f32 const* operand,
+    idlib_u32 number_of_components,
+    idlib_f32 parameter
+  )
+{
+  size_t n = number_of_components;
+  for (size_t c = 0; c < n; ++c) {
+    idlib_f32 p0 = operand[c], p1 = operand[n + c], p2 = operand[2 * n + c], p3 = operand[3 * n + c];
+    idlib_f32 p01 = p0 + (p1 - p0) * parameter,
+              p12 = p1 + (p2 - p1) * parameter,
+              p23 = p2 + (p3 - p2) * parameter;
+    idlib_f32 p012 = p01 + (p12 - p01) * parameter,
+              p123 = p12 + (p23 - p12) * parameter;
+    idlib_f32 p0123 = p012 + (p123 - p012) * parameter;
+    target1[c] = p0; target1[n + c] = p01; target1[2 * n + c] = p012; target1[3 * n + c] = p0123;
+    target2[c] = p0123; target2[n + c] = p123; target2[2 * n + c] = p23; target2[3 * n + c] = p3;
+  }
+}
+
+static void
+get_arc_lengths
+  (
+    idlib_f32* target,
+    curve const* operand,
+    idlib_u32 number_of_components,
+    idlib_u32 samples_per_segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(0 < samples_per_segment);
+  idlib_u32 n = get_number_of_segments(operand->kind, operand->number_of_points);
+  idlib_f32 h = 1.f / (idlib_f32)samples_per_segment;
+  idlib_f32 length = 0.f;
+  size_t j = 0;
+  target[j++] = length;
+  for (idlib_u32 s = 0; s < n; ++s) {
+    // The derivative of the segment is (3 a t + 2 b) t + c.
+    idlib_f32 k[4][4];
+    get_power_coefficients(k, operand, number_of_components, s);
+    for (size_t c = 0; c < number_of_components; ++c) {
+      k[0][c] = 3.f * k[0][c];
+      k[1][c] = 2.f * k[1][c];
+    }
+    idlib_u32 i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+    __m128 hh = _mm_set1_ps(h);
+    for (; i + 4 <= samples_per_segment; i += 4) {
+      __m128 base = _mm_setr_ps((idlib_f32)i, (idlib_f32)(i + 1), (idlib_f32)(i + 2), (idlib_f32)(i + 3));
+      __m128 sum = _mm_setzero_ps();
+      for (size_t g = 0; g < 5; ++g) {
+        __m128 t = _mm_mul_ps(_mm_add_ps(base, _mm_set1_ps(GAUSS_NODES[g])), hh);
+        __m128 squared = _mm_setzero_ps();
+        for (size_t c = 0; c < number_of_components; ++c) {
+          __m128 v = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(k[0][c]), t), _mm_set1_ps(k[1][c])), t), _mm_set1_ps(k[2][c]));
+          squared = _mm_add_ps(squared, _mm_mul_ps(v, v));
+        }
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(GAUSS_WEIGHTS[g]), _mm_sqrt_ps(squared)));
+      }
+      IDLIB_ALIGNAS(16) idlib_f32 l[4];
+      _mm_store_ps(l, _mm_mul_ps(sum, hh));
+      for (size_t q = 0; q < 4; ++q) {
+        length += l[q];
+        target[j++] = length;
+      }
+    }
+#endif
+    for (; i < samples_per_segment; ++i) {
+      idlib_f32 sum = 0.f;
+      for (size_t g = 0; g < 5; ++g) {
+        idlib_f32 t = ((idlib_f32)i + GAUSS_NODES[g]) * h;
+        idlib_f32 squared = 0.f;
+        for (size_t c = 0; c < number_of_components; ++c) {
+          idlib_f32 v = (k[0][c] * t + k[1][c]) * t + k[2][c];
+          squared = squared + v * v;
+        }
+        sum = sum + GAUSS_WEIGHTS[g] * idlib_sqrt_f32(squared);
+      }
+      length += sum * h;
+      target[j++] = length;
+    }
+  }
+}
+
+static curve
+get_curve_2
+  (
+    void const* curves,
+    size_t i
+  )
+{
+  idlib_curve_2_f32 const* c = (idlib_curve_2_f32 const*)curves + i;
+  return (curve) { .kind = c->kind, .points = c->control_points->e, .number_of_points = c->number_of_control_points };
+}
+
+void
+idlib_curve_2_f32_set
+  (
+    idlib_curve_2_f32* target,
+    idlib_u32 kind,
+    idlib_vector_2_f32 const* control_points,
+    idlib_u32 number_of_control_points
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(kind <= IDLIB_CURVE_B_SPLINE);
+  IDLIB_DEBUG_ASSERT(NULL != control_points);
+  IDLIB_DEBUG_ASSERT(0 < get_number_of_segments(kind, number_of_control_points));
+  target->kind = kind;
+  target->control_points = control_points;
+  target->number_of_control_points = number_of_control_points;
+}
+
+idlib_u32
+idlib_curve_2_f32_get_number_of_segments
+  (
+    idlib_curve_2_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  return get_number_of_segments(operand->kind, operand->number_of_control_points);
+}
+
+void
+idlib_curve_2_f32_evaluate
+  (
+    idlib_vector_2_f32* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 parameter
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_2(operand, 0);
+  evaluate(target->e, &c, 2, parameter, false);
+}
+
+void
+idlib_curve_2_f32_evaluate_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  curve c = get_curve_2(operand, 0);
+  idlib_f32* t[2] = { target->x, target->y };
+  evaluate_n(t, &c, NULL, NULL, 2, parameters, count, false);
+}
+
+void
+idlib_curve_2_f32_evaluate_derivative_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  curve c = get_curve_2(operand, 0);
+  idlib_f32* t[2] = { target->x, target->y };
+  evaluate_n(t, &c, NULL, NULL, 2, parameters, count, true);
+}
+
+void
+idlib_curve_2_f32_evaluate_curves_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  idlib_f32* t[2] = { target->x, target->y };
+  evaluate_n(t, NULL, operand, &get_curve_2, 2, parameters, count, false);
+}
+
+void
+idlib_curve_2_f32_get_bezier
+  (
+    idlib_vector_2_f32 target[4],
+    idlib_curve_2_f32 const* operand,
+    idlib_u32 segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_2(operand, 0);
+  get_bezier(target->e, &c, 2, segment);
+}
+
+void
+idlib_curve_2_f32_get_arc_lengths
+  (
+    idlib_f32* target,
+    idlib_curve_2_f32 const* operand,
+    idlib_u32 samples_per_segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_2(operand, 0);
+  get_arc_lengths(target, &c, 2, samples_per_segment);
+}
+
+void
+idlib_bezier_2_f32_split
+  (
+    idlib_vector_2_f32 target1[4],
+    idlib_vector_2_f32 target2[4],
+    idlib_vector_2_f32 const operand[4],
+    idlib_f32 parameter
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target1);
+  IDLIB_DEBUG_ASSERT(NULL != target2);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  idlib_vector_2_f32 p[4] = { operand[0], operand[1], operand[2], operand[3] };
+  bezier_split(target1->e, target2->e, p->e, 2, parameter);
+}
+
+static curve
+get_curve_3
+  (
+    void const* curves,
+    size_t i
+  )
+{
+  idlib_curve_3_f32 const* c = (idlib_curve_3_f32 const*)curves + i;
+  return (curve) { .kind = c->kind, .points = c->control_points->e, .number_of_points = c->number_of_control_points };
+}
+
+void
+idlib_curve_3_f32_set
+  (
+    idlib_curve_3_f32* target,
+    idlib_u32 kind,
+    idlib_vector_3_f32 const* control_points,
+    idlib_u32 number_of_control_points
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(kind <= IDLIB_CURVE_B_SPLINE);
+  IDLIB_DEBUG_ASSERT(NULL != control_points);
+  IDLIB_DEBUG_ASSERT(0 < get_number_of_segments(kind, number_of_control_points));
+  target->kind = kind;
+  target->control_points = control_points;
+  target->number_of_control_points = number_of_control_points;
+}
+
+idlib_u32
+idlib_curve_3_f32_get_number_of_segments
+  (
+    idlib_curve_3_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  return get_number_of_segments(operand->kind, operand->number_of_control_points);
+}
+
+void
+idlib_curve_3_f32_evaluate
+  (
+    idlib_vector_3_f32* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 parameter
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_3(operand, 0);
+  evaluate(target->e, &c, 3, parameter, false);
+}
+
+void
+idlib_curve_3_f32_evaluate_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  curve c = get_curve_3(operand, 0);
+  idlib_f32* t[3] = { target->x, target->y, target->z };
+  evaluate_n(t, &c, NULL, NULL, 3, parameters, count, false);
+}
+
+void
+idlib_curve_3_f32_evaluate_derivative_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  curve c = get_curve_3(operand, 0);
+  idlib_f32* t[3] = { target->x, target->y, target->z };
+  evaluate_n(t, &c, NULL, NULL, 3, parameters, count, true);
+}
+
+void
+idlib_curve_3_f32_evaluate_curves_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  idlib_f32* t[3] = { target->x, target->y, target->z };
+  evaluate_n(t, NULL, operand, &get_curve_3, 3, parameters, count, false);
+}
+
+void
+idlib_curve_3_f32_get_bezier
+  (
+    idlib_vector_3_f32 target[4],
+    idlib_curve_3_f32 const* operand,
+    idlib_u32 segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_3(operand, 0);
+  get_bezier(target->e, &c, 3, segment);
+}
+
+void
+idlib_curve_3_f32_get_arc_lengths
+  (
+    idlib_f32* target,
+    idlib_curve_3_f32 const* operand,
+    idlib_u32 samples_per_segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_3(operand, 0);
+  get_arc_lengths(target, &c, 3, samples_per_segment);
+}
+
+void
+idlib_bezier_3_f32_split
+  (
+    idlib_vector_3_f32 target1[4],
+    idlib_vector_3_f32 target2[4],
+    idlib_vector_3_f32 const operand[4],
+    idlib_f32 parameter
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target1);
+  IDLIB_DEBUG_ASSERT(NULL != target2);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  idlib_vector_3_f32 p[4] = { operand[0], operand[1], operand[2], operand[3] };
+  bezier_split(target1->e, target2->e, p->e, 3, parameter);
+}
+
+static curve
+get_curve_4
+  (
+    void const* curves,
+    size_t i
+  )
+{
+  idlib_curve_4_f32 const* c = (idlib_curve_4_f32 const*)curves + i;
+  return (curve) { .kind = c->kind, .points = c->control_points->e, .number_of_points = c->number_of_control_points };
+}
+
+void
+idlib_curve_4_f32_set
+  (
+    idlib_curve_4_f32* target,
+    idlib_u32 kind,
+    idlib_vector_4_f32 const* control_points,
+    idlib_u32 number_of_control_points
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(kind <= IDLIB_CURVE_B_SPLINE);
+  IDLIB_DEBUG_ASSERT(NULL != control_points);
+  IDLIB_DEBUG_ASSERT(0 < get_number_of_segments(kind, number_of_control_points));
+  target->kind = kind;
+  target->control_points = control_points;
+  target->number_of_control_points = number_of_control_points;
+}
+
+idlib_u32
+idlib_curve_4_f32_get_number_of_segments
+  (
+    idlib_curve_4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  return get_number_of_segments(operand->kind, operand->number_of_control_points);
+}
+
+void
+idlib_curve_4_f32_evaluate
+  (
+    idlib_vector_4_f32* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 parameter
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_4(operand, 0);
+  evaluate(target->e, &c, 4, parameter, false);
+}
+
+void
+idlib_curve_4_f32_evaluate_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  curve c = get_curve_4(operand, 0);
+  idlib_f32* t[4] = { target->x, target->y, target->z, target->w };
+  evaluate_n(t, &c, NULL, NULL, 4, parameters, count, false);
+}
+
+void
+idlib_curve_4_f32_evaluate_derivative_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  curve c = get_curve_4(operand, 0);
+  idlib_f32* t[4] = { target->x, target->y, target->z, target->w };
+  evaluate_n(t, &c, NULL, NULL, 4, parameters, count, true);
+}
+
+void
+idlib_curve_4_f32_evaluate_curves_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_f32 const* parameters,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != parameters);
+  idlib_f32* t[4] = { target->x, target->y, target->z, target->w };
+  evaluate_n(t, NULL, operand, &get_curve_4, 4, parameters, count, false);
+}
+
+void
+idlib_curve_4_f32_get_bezier
+  (
+    idlib_vector_4_f32 target[4],
+    idlib_curve_4_f32 const* operand,
+    idlib_u32 segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_4(operand, 0);
+  get_bezier(target->e, &c, 4, segment);
+}
+
+void
+idlib_curve_4_f32_get_arc_lengths
+  (
+    idlib_f32* target,
+    idlib_curve_4_f32 const* operand,
+    idlib_u32 samples_per_segment
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  curve c = get_curve_4(operand, 0);
+  get_arc_lengths(target, &c, 4, samples_per_segment);
+}
+
+void
+idlib_bezier_4_f32_split
+  (
+    idlib_vector_4_f32 target1[4],
+    idlib_vector_4_f32 target2[4],
+    idlib_vector_4_f32 const operand[4],
+    idlib_f32 parameter
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target1);
+  IDLIB_DEBUG_ASSERT(NULL != target2);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  idlib_vector_4_f32 p[4] = { operand[0], operand[1], operand[2], operand[3] };
+  bezier_split(target1->e, target2->e, p->e, 4, parameter);
+}
+
+// Maps an arc length to a parameter given the index of the interval containing it.
+static idlib_f32
+get_parameter
+  (
+    idlib_f32 const* arc_lengths,
+    idlib_u32 samples_per_segment,
+    idlib_u32 i,
+    idlib_f32 length
+  )
+{
+  idlib_f32 d = arc_lengths[i + 1] - arc_lengths[i];
+  idlib_f32 f = d > 0.f ? (length - arc_lengths[i]) / d : 0.f;
+  return ((idlib_f32)i + f) / (idlib_f32)samples_per_segment;
+}
+
+void
+idlib_arc_lengths_f32_get_parameters_n
+  (
+    idlib_f32* target,
+    idlib_f32 const* arc_lengths,
+    idlib_u32 number_of_arc_lengths,
+    idlib_u32 samples_per_segment,
+    idlib_f32 const* operand,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != arc_lengths);
+  IDLIB_DEBUG_ASSERT(2 <= number_of_arc_lengths);
+  IDLIB_DEBUG_ASSERT(0 < samples_per_segment);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  idlib_f32 minimum = arc_lengths[0], maximum = arc_lengths[number_of_arc_lengths - 1];
+  // Binary search for the last interval i (of the number_of_arc_lengths - 1 intervals) with arc_lengths[i] <= length.
+  // The sequence of halving steps only depends on the number of intervals such that four searches proceed in lockstep.
+  size_t i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 lower = _mm_set1_ps(minimum), upper = _mm_set1_ps(maximum);
+  for (; i + 4 <= count; i += 4) {
+    __m128 l = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(operand + i), lower), upper);
+    idlib_u32 b[4] = { 0, 0, 0, 0 };
+    for (idlib_u32 n = number_of_arc_lengths - 1; n > 1; ) {
+      idlib_u32 half = n / 2;
+      __m128 probe = _mm_setr_ps(arc_lengths[b[0] + half], arc_lengths[b[1] + half], arc_lengths[b[2] + half], arc_lengths[b[3] + half]);
+      int mask = _mm_movemask_ps(_mm_cmple_ps(probe, l));
+      for (size_t k = 0; k < 4; ++k) {
+        b[k] += half & (0u - (idlib_u32)((mask >> k) & 1));
+      }
+      n -= half;
+    }
+    __m128 l0 = _mm_setr_ps(arc_lengths[b[0]], arc_lengths[b[1]], arc_lengths[b[2]], arc_lengths[b[3]]);
+    __m128 l1 = _mm_setr_ps(arc_lengths[b[0] + 1], arc_lengths[b[1] + 1], arc_lengths[b[2] + 1], arc_lengths[b[3] + 1]);
+    __m128 d = _mm_sub_ps(l1, l0);
+    __m128 f = _mm_and_ps(_mm_cmpgt_ps(d, _mm_setzero_ps()), _mm_div_ps(_mm_sub_ps(l, l0), d));
+    __m128 u = _mm_add_ps(_mm_setr_ps((idlib_f32)b[0], (idlib_f32)b[1], (idlib_f32)b[2], (idlib_f32)b[3]), f);
+    _mm_storeu_ps(target + i, _mm_div_ps(u, _mm_set1_ps((idlib_f32)samples_per_segment)));
+  }
+#endif
+  for (; i < count; ++i) {
+    idlib_f32 l = operand[i];
+    l = l > minimum ? l : minimum;
+    l = l < maximum ? l : maximum;
+    idlib_u32 b = 0;
+    for (idlib_u32 n = number_of_arc_lengths - 1; n > 1; ) {
+      idlib_u32 half = n / 2;
+      b += arc_lengths[b + half] <= l ? half : 0;
+      n -= half;
+    }
+    target[i] = get_parameter(arc_lengths, samples_per_segment, b, l);
+  }
+}
@@ -0,0 +1,887 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "idlib/math/delaunay_2.h"
+
+#include "idlib/math/predicates.h"
+
+#define NONE IDLIB_TRIANGULATION_2_NONE
+
+// The vertex at infinity shared by all ghost triangles.
+// Ghost triangles are stored as (a, b, GHOST) such that the outside of the hull edge (a, b) is to the left of a -> b.
+#define GHOST (0xFFFFFFFEu)
+
+#define NEXT(k) (((k) + 1) % 3)
+#define PREV(k) (((k) + 2) % 3)
+
+static inline size_t
+align_8
+  (
+    size_t size
+  )
+{ return (size + 7) & ~(size_t)7; }
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// The workspace of the triangulation.
+typedef struct insertion_workspace {
+  idlib_u64* keys[2];
+  idlib_u32* order[2];
+  idlib_u8* marks;
+  idlib_u32* stack;
+  idlib_u32* cavity;
+  idlib_u32* boundary;
+  idlib_u32* link;
+} insertion_workspace;
+
+// The workspace of the constraint insertion.
+typedef struct constraint_workspace {
+  idlib_u32* vertex_triangle;
+  idlib_u32* queue;
+  idlib_u32* new_edges;
+  idlib_u32 queue_capacity;
+} constraint_workspace;
+
+static size_t
+insertion_workspace_layout
+  (
+    insertion_workspace* w,
+    char* p,
+    idlib_u32 n,
+    idlib_u32 capacity
+  )
+{
+  size_t offset = 0;
+  #define CARVE(field, type, count) \
+    if (w) { w->field = (type*)(p + offset); } \
+    offset += align_8(sizeof(type) * (size_t)(count));
+  CARVE(keys[0], idlib_u64, n);
+  CARVE(keys[1], idlib_u64, n);
+  CARVE(order[0], idlib_u32, n);
+  CARVE(order[1], idlib_u32, n);
+  CARVE(marks, idlib_u8, capacity);
+  CARVE(stack, idlib_u32, capacity);
+  CARVE(cavity, idlib_u32, capacity);
+  CARVE(boundary, idlib_u32, 3 * ((size_t)capacity + 2));
+  CARVE(link, idlib_u32, (size_t)n + 1);
+  #undef CARVE
+  return offset;
+}
+
+static size_t
+constraint_workspace_layout
+  (
+    constraint_workspace* w,
+    char* p,
+    idlib_u32 n,
+    idlib_u32 capacity
+  )
+{
+  size_t offset = 0;
+  idlib_u32 queue_capacity = 3 * capacity;
+  #define CARVE(field, type, count) \
+    if (w) { w->field = (type*)(p + offset); } \
+    offset += align_8(sizeof(type) * (size_t)(count));
+  CARVE(vertex_triangle, idlib_u32, n);
+  CARVE(queue, idlib_u32, 2 * (size_t)queue_capacity);
+  CARVE(new_edges, idlib_u32, 2 * (size_t)queue_capacity);
+  #undef CARVE
+  if (w) {
+    w->queue_capacity = queue_capacity;
+  }
+  return offset;
+}
+
+idlib_u32
+idlib_delaunay_2_f32_get_capacity
+  (
+    idlib_u32 number_of_points
+  )
+{ return number_of_points < 2 ? 4 : 2 * number_of_points; }
+
+size_t
+idlib_delaunay_2_f32_get_workspace_size
+  (
+    idlib_u32 number_of_points
+  )
+{
+  idlib_u32 capacity = idlib_delaunay_2_f32_get_capacity(number_of_points);
+  size_t a = insertion_workspace_layout(NULL, NULL, number_of_points, capacity);
+  size_t b = constraint_workspace_layout(NULL, NULL, number_of_points, capacity);
+  return a > b ? a : b;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// The distance along the Hilbert curve of order 16 of the cell (x, y).
+static idlib_u32
+hilbert_index
+  (
+    idlib_u32 x,
+    idlib_u32 y
+  )
+{
+  idlib_u32 d = 0;
+  for (idlib_u32 s = 1u << 15; s > 0; s >>= 1) {
+    idlib_u32 rx = (x & s) ? 1 : 0;
+    idlib_u32 ry = (y & s) ? 1 : 0;
+    d += s * s * ((3 * rx) ^ ry);
+    if (ry == 0) {
+      if (rx == 1) {
+        x = 0xFFFF - x;
+        y = 0xFFFF - y;
+      }
+      idlib_u32 t = x; x = y; y = t;
+    }
+  }
+  return d;
+}
+
+static inline idlib_u32
+hash_32
+  (
+    idlib_u32 x
+  )
+{
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x;
+}
+
+// Compute the biased randomized insertion order.
+// The round of a point is the bit length of a hash of its index such that the last round receives about half of the points,
+// the round before about a quarter of the points, and so on.
+// The key of a point is (round << 32) | hilbert index. The keys are sorted by a least significant digit radix sort.
+// Returns a pointer to the array of point indices in insertion order.
+static idlib_u32*
+compute_insertion_order
+  (
+    insertion_workspace* w,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 n
+  )
+{
+  idlib_f32 min_x = points[0].e[0], max_x = points[0].e[0];
+  idlib_f32 min_y = points[0].e[1], max_y = points[0].e[1];
+  for (idlib_u32 i = 1; i < n; ++i) {
+    if (points[i].e[0] < min_x) min_x = points[i].e[0];
+    if (points[i].e[0] > max_x) max_x = points[i].e[0];
+    if (points[i].e[1] < min_y) min_y = points[i].e[1];
+    if (points[i].e[1] > max_y) max_y = points[i].e[1];
+  }
+  idlib_f32 extent = max_x - min_x > max_y - min_y ? max_x - min_x : max_y - min_y;
+  idlib_f32 scale = extent > 0.f ? 65535.f / extent : 0.f;
+
+  idlib_u32 number_of_rounds_bits = 0;
+  for (idlib_u32 i = n; i > 1; i >>= 1) {
+    number_of_rounds_bits++;
+  }
+  idlib_u32 round_mask = (1u << number_of_rounds_bits) - 1;
+
+  for (idlib_u32 i = 0; i < n; ++i) {
+    idlib_u32 x = (idlib_u32)((points[i].e[0] - min_x) * scale);
+    idlib_u32 y = (idlib_u32)((points[i].e[1] - min_y) * scale);
+    if (x > 0xFFFF) x = 0xFFFF;
+    if (y > 0xFFFF) y = 0xFFFF;
+    idlib_u32 r = hash_32(i) & round_mask, round = 0;
+    while (r) {
+      round++;
+      r >>= 1;
+    }
+    w->keys[0][i] = ((idlib_u64)round << 32) | hilbert_index(x, y);
+    w->order[0][i] = i;
+  }
+
+  // 40 bit keys, 5 passes of 8 bits.
+  idlib_u32 source = 0;
+  for (idlib_u32 pass = 0; pass < 5; ++pass) {
+    idlib_u32 shift = pass * 8;
+    size_t counts[256] = { 0 };
+    for (idlib_u32 i = 0; i < n; ++i) {
+      counts[(w->keys[source][i] >> shift) & 0xFF]++;
+    }
+    size_t sum = 0;
+    for (idlib_u32 j = 0; j < 256; ++j) {
+      size_t c = counts[j];
+      counts[j] = sum;
+      sum += c;
+    }
+    for (idlib_u32 i = 0; i < n; ++i) {
+      size_t j = counts[(w->keys[source][i] >> shift) & 0xFF]++;
+      w->keys[1 - source][j] = w->keys[source][i];
+      w->order[1 - source][j] = w->order[source][i];
+    }
+    source = 1 - source;
+  }
+  return w->order[source];
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+// Is c strictly in between a and b given that a, b, and c are collinear?
+static inline bool
+is_between
+  (
+    idlib_vector_2_f32 const* a,
+    idlib_vector_2_f32 const* b,
+    idlib_vector_2_f32 const* c
+  )
+{
+  size_t i = a->e[0] != b->e[0] ? 0 : 1;
+  return (a->e[i] < c->e[i] && c->e[i] < b->e[i])
+      || (b->e[i] < c->e[i] && c->e[i] < a->e[i]);
+}
+
+static inline bool
+is_in_conflict
+  (
+    idlib_triangulation_2 const* t,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 triangle,
+    idlib_vector_2_f32 const* p
+  )
+{
+  idlib_u32 const* v = t->vertices + 3 * triangle;
+  if (v[2] == GHOST) {
+    idlib_f64 o = idlib_orient_2_f32(points + v[0], points + v[1], p);
+    return o > 0.0 || (o == 0.0 && is_between(points + v[0], points + v[1], p));
+  } else {
+    return idlib_in_circle_2_f32(points + v[0], points + v[1], points + v[2], p) > 0.0;
+  }
+}
+
+// Walk from a solid triangle to the triangle containing p.
+// Returns a solid triangle containing p or a ghost triangle whose hull edge sees p.
+static idlib_u32
+locate
+  (
+    idlib_triangulation_2 const* t,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 start,
+    idlib_vector_2_f32 const* p
+  )
+{
+  idlib_u32 current = start, previous = NONE, rotation = 0;
+  while (t->vertices[3 * current + 2] != GHOST) {
+    idlib_u32 const* v = t->vertices + 3 * current;
+    idlib_u32 next = NONE;
+    // Vary the first edge tested to avoid cycling on degenerate configurations.
+    rotation = NEXT(rotation);
+    for (idlib_u32 i = 0; i < 3; ++i) {
+      idlib_u32 k = (rotation + i) % 3;
+      idlib_u32 neighbor = t->neighbors[3 * current + k];
+      if (neighbor == previous) {
+        continue;
+      }
+      if (idlib_orient_2_f32(points + v[NEXT(k)], points + v[PREV(k)], p) < 0.0) {
+        next = neighbor;
+        break;
+      }
+    }
+    if (next == NONE) {
+      // Test the edge we came from last.
+      for (idlib_u32 k = 0; k < 3; ++k) {
+        if (t->neighbors[3 * current + k] == previous &&
+            idlib_orient_2_f32(points + v[NEXT(k)], points + v[PREV(k)], p) < 0.0) {
+          next = previous;
+        }
+      }
+      if (next == NONE) {
+        return current;
+      }
+    }
+    previous = current;
+    current = next;
+  }
+  return current;
+}
+
+static inline void
+set_triangle
+  (
+    idlib_triangulation_2* t,
+    idlib_u32 triangle,
+    idlib_u32 v0,
+    idlib_u32 v1,
+    idlib_u32 v2,
+    idlib_u32 n0,
+    idlib_u32 n1,
+    idlib_u32 n2
+  )
+{
+  idlib_u32* v = t->vertices + 3 * triangle;
+  idlib_u32* n = t->neighbors + 3 * triangle;
+  v[0] = v0; v[1] = v1; v[2] = v2;
+  n[0] = n0; n[1] = n1; n[2] = n2;
+}
+
+// Insert the point p into the triangulation (Bowyer-Watson).
+// Returns the index of a new triangle or NONE if p coincides with an existing vertex.
+static idlib_u32
+insert
+  (
+    idlib_triangulation_2* t,
+    insertion_workspace* w,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 n,
+    idlib_u32 point,
+    idlib_u32 start
+  )
+{
+  idlib_vector_2_f32 const* p = points + point;
+  idlib_u32 seed = locate(t, points, start, p);
+  if (!is_in_conflict(t, points, seed, p)) {
+    return NONE;
+  }
+
+  // Collect the cavity by a depth-first search over the triangles in conflict.
+  idlib_u32 cavity_size = 0, stack_size = 0;
+  w->marks[seed] = 1;
+  w->stack[stack_size++] = seed;
+  while (stack_size) {
+    idlib_u32 c = w->stack[--stack_size];
+    w->cavity[cavity_size++] = c;
+    for (idlib_u32 k = 0; k < 3; ++k) {
+      idlib_u32 neighbor = t->neighbors[3 * c + k];
+      if (!w->marks[neighbor] && is_in_conflict(t, points, neighbor, p)) {
+        w->marks[neighbor] = 1;
+        w->stack[stack_size++] = neighbor;
+      }
+    }
+  }
+
+  // Collect the boundary edges (u, v, outer) of the cavity before any triangle is overwritten.
+  idlib_u32 boundary_size = 0;
+  for (idlib_u32 i = 0; i < cavity_size; ++i) {
+    idlib_u32 c = w->cavity[i];
+    for (idlib_u32 k = 0; k < 3; ++k) {
+      idlib_u32 neighbor = t->neighbors[3 * c + k];
+      if (!w->marks[neighbor]) {
+        w->boundary[3 * boundary_size + 0] = t->vertices[3 * c + NEXT(k)];
+        w->boundary[3 * boundary_size + 1] = t->vertices[3 * c + PREV(k)];
+        w->boundary[3 * boundary_size + 2] = neighbor;
+        boundary_size++;
+      }
+    }
+  }
+  for (idlib_u32 i = 0; i < cavity_size; ++i) {
+    w->marks[w->cavity[i]] = 0;
+  }
+  IDLIB_DEBUG_ASSERT(boundary_size == cavity_size + 2);
+
+  // Create a triangle (u, v, p) for each boundary edge, reusing the slots of the cavity triangles.
+  idlib_u32 last = NONE;
+  for (idlib_u32 i = 0; i < boundary_size; ++i) {
+    idlib_u32 u = w->boundary[3 * i + 0], v = w->boundary[3 * i + 1], outer = w->boundary[3 * i + 2];
+    idlib_u32 triangle = i < cavity_size ? w->cavity[i] : t->number_of_triangles++;
+    set_triangle(t, triangle, u, v, point, NONE, NONE, outer);
+    // Redirect the outer triangle from the cavity to the new triangle.
+    idlib_u32* ov = t->vertices + 3 * outer;
+    for (idlib_u32 k = 0; k < 3; ++k) {
+      if (ov[NEXT(k)] == v && ov[PREV(k)] == u) {
+        t->neighbors[3 * outer + k] = triangle;
+        break;
+      }
+    }
+    w->link[u == GHOST ? n : u] = triangle;
+    w->boundary[3 * i + 2] = triangle;
+  }
+  // Link the new triangles: the neighbor of (u, v, p) opposite to u is the new triangle starting at v.
+  for (idlib_u32 i = 0; i < boundary_size; ++i) {
+    idlib_u32 v = w->boundary[3 * i + 1], triangle = w->boundary[3 * i + 2];
+    idlib_u32 next = w->link[v == GHOST ? n : v];
+    t->neighbors[3 * triangle + 0] = next;
+    t->neighbors[3 * next + 1] = triangle;
+  }
+  // Rotate ghost triangles such that the ghost vertex is the last vertex.
+  for (idlib_u32 i = 0; i < boundary_size; ++i) {
+    idlib_u32 triangle = w->boundary[3 * i + 2];
+    idlib_u32* tv = t->vertices + 3 * triangle;
+    idlib_u32* tn = t->neighbors + 3 * triangle;
+    if (tv[0] == GHOST) {
+      // (G, v, p) -> (v, p, G)
+      set_triangle(t, triangle, tv[1], tv[2], tv[0], tn[1], tn[2], tn[0]);
+    } else if (tv[1] == GHOST) {
+      // (u, G, p) -> (p, u, G)
+      set_triangle(t, triangle, tv[2], tv[0], tv[1], tn[2], tn[0], tn[1]);
+    } else {
+      last = triangle;
+    }
+  }
+  return last != NONE ? last : w->boundary[2];
+}
+
+bool
+idlib_delaunay_2_f32_triangulate
+  (
+    idlib_triangulation_2* target,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 number_of_points,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+
+  idlib_u32 n = number_of_points;
+  target->number_of_triangles = 0;
+  if (n < 3 || target->capacity < idlib_delaunay_2_f32_get_capacity(n)) {
+    return false;
+  }
+  // The workspace is laid out for the minimum capacity: The triangulation never uses more triangles, even if target provides more.
+  idlib_u32 capacity = idlib_delaunay_2_f32_get_capacity(n);
+  insertion_workspace w;
+  insertion_workspace_layout(&w, (char*)workspace, n, capacity);
+  idlib_u32* order = compute_insertion_order(&w, points, n);
+
+  // Find an initial non-degenerate triangle (a, b, c).
+  idlib_u32 a = order[0], b = NONE, c = NONE;
+  idlib_u32 ib = 0, ic = 0;
+  for (idlib_u32 i = 1; i < n; ++i) {
+    if (!idlib_vector_2_f32_are_equal(points + a, points + order[i])) {
+      b = order[i];
+      ib = i;
+      break;
+    }
+  }
+  if (b == NONE) {
+    return false;
+  }
+  idlib_f64 o = 0.0;
+  for (idlib_u32 i = ib + 1; i < n; ++i) {
+    o = idlib_orient_2_f32(points + a, points + b, points + order[i]);
+    if (o != 0.0) {
+      c = order[i];
+      ic = i;
+      break;
+    }
+  }
+  if (c == NONE) {
+    return false;
+  }
+  if (o < 0.0) {
+    idlib_u32 x = b; b = c; c = x;
+  }
+  // The solid triangle 0 and the ghost triangles 1, 2, and 3 of its edges (b, c), (c, a), and (a, b).
+  set_triangle(target, 0, a, b, c, 1, 2, 3);
+  set_triangle(target, 1, c, b, GHOST, 3, 2, 0);
+  set_triangle(target, 2, a, c, GHOST, 1, 3, 0);
+  set_triangle(target, 3, b, a, GHOST, 2, 1, 0);
+  target->number_of_triangles = 4;
+  for (idlib_u32 i = 0; i < capacity; ++i) {
+    w.marks[i] = 0;
+  }
+
+  idlib_u32 start = 0;
+  for (idlib_u32 i = 1; i < n; ++i) {
+    if (i == ib || i == ic) {
+      continue;
+    }
+    idlib_u32 triangle = insert(target, &w, points, n, order[i], start);
+    if (triangle != NONE) {
+      start = triangle;
+      if (target->vertices[3 * start + 2] == GHOST) {
+        start = target->neighbors[3 * start + 2];
+      }
+    }
+  }
+
+  // Remove the ghost triangles. The stack is reused for the mapping from old to new indices.
+  idlib_u32* map = w.stack;
+  idlib_u32 m = 0;
+  for (idlib_u32 i = 0; i < target->number_of_triangles; ++i) {
+    map[i] = target->vertices[3 * i + 2] == GHOST ? NONE : m++;
+  }
+  for (idlib_u32 i = 0; i < target->number_of_triangles; ++i) {
+    idlib_u32 j = map[i];
+    if (j == NONE) {
+      continue;
+    }
+    for (idlib_u32 k = 0; k < 3; ++k) {
+      target->vertices[3 * j + k] = target->vertices[3 * i + k];
+      target->neighbors[3 * j + k] = map[target->neighbors[3 * i + k]];
+    }
+    target->constraints[j] = 0;
+  }
+  target->number_of_triangles = m;
+  return true;
+}
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+static inline idlib_u32
+index_of
+  (
+    idlib_u32 const* v,
+    idlib_u32 x
+  )
+{ return v[0] == x ? 0 : (v[1] == x ? 1 : 2); }
+
+// Find a triangle and the index k such that the edge opposite to vertex k is the edge {u, v}.
+static bool
+find_edge
+  (
+    idlib_triangulation_2 const* t,
+    constraint_workspace const* w,
+    idlib_u32 u,
+    idlib_u32 v,
+    idlib_u32* triangle,
+    idlib_u32* k
+  )
+{
+  // Rotate around u counterclockwise, then clockwise.
+  for (idlib_u32 direction = 0; direction < 2; ++direction) {
+    idlib_u32 start = w->vertex_triangle[u], current = start;
+    do {
+      idlib_u32 const* tv = t->vertices + 3 * current;
+      idlib_u32 i = index_of(tv, u);
+      if (tv[NEXT(i)] == v) {
+        *triangle = current;
+        *k = PREV(i);
+        return true;
+      }
+      if (tv[PREV(i)] == v) {
+        *triangle = current;
+        *k = NEXT(i);
+        return true;
+      }
+      current = t->neighbors[3 * current + (direction == 0 ? NEXT(i) : PREV(i))];
+    } while (current != NONE && current != start);
+    if (current == start) {
+      break;
+    }
+  }
+  return false;
+}
+
+// Flip the edge opposite to vertex k of triangle t1.
+// Returns the new edge (p0, q0) via the out parameters.
+static void
+flip
+  (
+    idlib_triangulation_2* t,
+    constraint_workspace* w,
+    idlib_u32 t1,
+    idlib_u32 k,
+    idlib_u32* new_u,
+    idlib_u32* new_v
+  )
+{
+  idlib_u32 t2 = t->neighbors[3 * t1 + k];
+  idlib_u32 j = 0;
+  while (t->neighbors[3 * t2 + j] != t1) {
+    j++;
+  }
+  idlib_u32 p0 = t->vertices[3 * t1 + k], p1 = t->vertices[3 * t1 + NEXT(k)], p2 = t->vertices[3 * t1 + PREV(k)];
+  idlib_u32 q0 = t->vertices[3 * t2 + j];
+  idlib_u32 a = t->neighbors[3 * t1 + NEXT(k)], b = t->neighbors[3 * t1 + PREV(k)];
+  idlib_u32 c = t->neighbors[3 * t2 + NEXT(j)], d = t->neighbors[3 * t2 + PREV(j)];
+  idlib_u8 ca = (t->constraints[t1] >> NEXT(k)) & 1, cb = (t->constraints[t1] >> PREV(k)) & 1;
+  idlib_u8 cc = (t->constraints[t2] >> NEXT(j)) & 1, cd = (t->constraints[t2] >> PREV(j)) & 1;
+
+  // t1 := (p0, p1, q0), t2 := (q0, p2, p0)
+  set_triangle(t, t1, p0, p1, q0, c, t2, b);
+  set_triangle(t, t2, q0, p2, p0, a, t1, d);
+  t->constraints[t1] = (idlib_u8)(cc | (cb << 2));
+  t->constraints[t2] = (idlib_u8)(ca | (cd << 2));
+  if (c != NONE) {
+    idlib_u32* cn = t->neighbors + 3 * c;
+    cn[index_of(cn, t2)] = t1;
+  }
+  if (a != NONE) {
+    idlib_u32* an = t->neighbors + 3 * a;
+    an[index_of(an, t1)] = t2;
+  }
+  w->vertex_triangle[p0] = t1;
+  w->vertex_triangle[p1] = t1;
+  w->vertex_triangle[q0] = t1;
+  w->vertex_triangle[p2] = t2;
+  *new_u = p0;
+  *new_v = q0;
+}
+
+static inline bool
+is_convex
+  (
+    idlib_triangulation_2 const* t,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 t1,
+    idlib_u32 k
+  )
+{
+  idlib_u32 t2 = t->neighbors[3 * t1 + k];
+  idlib_u32 j = index_of(t->neighbors + 3 * t2, t1);
+  idlib_vector_2_f32 const* x = points + t->vertices[3 * t1 + k];
+  idlib_vector_2_f32 const* y = points + t->vertices[3 * t2 + j];
+  idlib_f64 ou = idlib_orient_2_f32(x, y, points + t->vertices[3 * t1 + NEXT(k)]);
+  idlib_f64 ov = idlib_orient_2_f32(x, y, points + t->vertices[3 * t1 + PREV(k)]);
+  return (ou > 0.0 && ov < 0.0) || (ou < 0.0 && ov > 0.0);
+}
+
+static inline bool
+crosses
+  (
+    idlib_vector_2_f32 const* points,
+    idlib_u32 a,
+    idlib_u32 b,
+    idlib_u32 u,
+    idlib_u32 v
+  )
+{
+  if (u == a || u == b || v == a || v == b) {
+    return false;
+  }
+  idlib_f64 o1 = idlib_orient_2_f32(points + a, points + b, points + u);
+  idlib_f64 o2 = idlib_orient_2_f32(points + a, points + b, points + v);
+  idlib_f64 o3 = idlib_orient_2_f32(points + u, points + v, points + a);
+  idlib_f64 o4 = idlib_orient_2_f32(points + u, points + v, points + b);
+  return ((o1 > 0.0 && o2 < 0.0) || (o1 < 0.0 && o2 > 0.0))
+      && ((o3 > 0.0 && o4 < 0.0) || (o3 < 0.0 && o4 > 0.0));
+}
+
+// Collect the edges crossed by the segment from a towards b into the queue.
+// If the segment passes through a vertex before reaching b, then *stop is that vertex, otherwise *stop is b.
+static bool
+collect_crossed_edges
+  (
+    idlib_triangulation_2 const* t,
+    constraint_workspace* w,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 a,
+    idlib_u32 b,
+    idlib_u32* queue_size,
+    idlib_u32* stop
+  )
+{
+  idlib_vector_2_f32 const* pa = points + a;
+  idlib_vector_2_f32 const* pb = points + b;
+  // Find the triangle around a whose opposite edge is crossed by the segment, or the vertex on the segment.
+  idlib_u32 triangle = NONE, left = NONE, right = NONE;
+  for (idlib_u32 direction = 0; direction < 2 && triangle == NONE; ++direction) {
+    idlib_u32 start = w->vertex_triangle[a], current = start;
+    do {
+      idlib_u32 const* tv = t->vertices + 3 * current;
+      idlib_u32 i = index_of(tv, a);
+      idlib_u32 v1 = tv[NEXT(i)], v2 = tv[PREV(i)];
+      idlib_f64 o1 = idlib_orient_2_f32(pa, pb, points + v1);
+      idlib_f64 o2 = idlib_orient_2_f32(pa, pb, points + v2);
+      if (o1 == 0.0 && !is_between(points + v1, pb, pa)) {
+        // v1 is on the ray from a towards b.
+        *queue_size = 0;
+        *stop = v1;
+        return true;
+      }
+      if (o2 == 0.0 && !is_between(points + v2, pb, pa)) {
+        *queue_size = 0;
+        *stop = v2;
+        return true;
+      }
+      if (o1 < 0.0 && o2 > 0.0) {
+        triangle = current;
+        right = v1;
+        left = v2;
+        break;
+      }
+      current = t->neighbors[3 * current + (direction == 0 ? NEXT(i) : PREV(i))];
+    } while (current != NONE && current != start);
+    if (current == start) {
+      break;
+    }
+  }
+  if (triangle == NONE) {
+    return false;
+  }
+  // Walk along the segment.
+  idlib_u32 size = 0;
+  for (;;) {
+    idlib_u32 const* tv = t->vertices + 3 * triangle;
+    // The edge (right, left) is opposite to the third vertex of the triangle.
+    idlib_u32 k = 3 - index_of(tv, left) - index_of(tv, right);
+    if ((t->constraints[triangle] >> k) & 1) {
+      return false;
+    }
+    if (size == w->queue_capacity) {
+      return false;
+    }
+    w->queue[2 * size + 0] = right;
+    w->queue[2 * size + 1] = left;
+    size++;
+    idlib_u32 next = t->neighbors[3 * triangle + k];
+    idlib_u32 const* nv = t->vertices + 3 * next;
+    idlib_u32 x = nv[3 - index_of(nv, left) - index_of(nv, right)];
+    if (x == b) {
+      *stop = b;
+      break;
+    }
+    idlib_f64 o = idlib_orient_2_f32(pa, pb, points + x);
+    if (o == 0.0) {
+      *stop = x;
+      break;
+    } else if (o > 0.0) {
+      left = x;
+    } else {
+      right = x;
+    }
+    triangle = next;
+  }
+  *queue_size = size;
+  return true;
+}
+
+// Insert the constrained edge (a, b). The segment must not pass through a vertex.
+static bool
+insert_constraint
+  (
+    idlib_triangulation_2* t,
+    constraint_workspace* w,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 a,
+    idlib_u32 b,
+    idlib_u32 queue_size
+  )
+{
+  // Flip crossed edges until none is left (Sloan).
+  idlib_u32 head = 0, count = queue_size, number_of_new_edges = 0;
+  idlib_u32 stall = 0;
+  while (count) {
+    idlib_u32 u = w->queue[2 * head + 0], v = w->queue[2 * head + 1];
+    head = (head + 1) % w->queue_capacity;
+    count--;
+    idlib_u32 triangle, k;
+    if (!find_edge(t, w, u, v, &triangle, &k)) {
+      return false;
+    }
+    if (!is_convex(t, points, triangle, k)) {
+      // Retry later.
+      idlib_u32 tail = (head + count) % w->queue_capacity;
+      w->queue[2 * tail + 0] = u;
+      w->queue[2 * tail + 1] = v;
+      count++;
+      if (++stall > 2 * (count + 1)) {
+        return false;
+      }
+      continue;
+    }
+    stall = 0;
+    idlib_u32 x, y;
+    flip(t, w, triangle, k, &x, &y);
+    if (crosses(points, a, b, x, y)) {
+      idlib_u32 tail = (head + count) % w->queue_capacity;
+      w->queue[2 * tail + 0] = x;
+      w->queue[2 * tail + 1] = y;
+      count++;
+    } else if (!((x == a && y == b) || (x == b && y == a))) {
+      w->new_edges[2 * number_of_new_edges + 0] = x;
+      w->new_edges[2 * number_of_new_edges + 1] = y;
+      number_of_new_edges++;
+    }
+  }
+
+  // Mark the edge (a, b) as constrained.
+  idlib_u32 triangle, k;
+  if (!find_edge(t, w, a, b, &triangle, &k)) {
+    return false;
+  }
+  t->constraints[triangle] |= (idlib_u8)(1u << k);
+  idlib_u32 other = t->neighbors[3 * triangle + k];
+  if (other != NONE) {
+    t->constraints[other] |= (idlib_u8)(1u << index_of(t->neighbors + 3 * other, triangle));
+  }
+
+  // Restore the Delaunay property for the new edges.
+  bool swapped = true;
+  while (swapped) {
+    swapped = false;
+    for (idlib_u32 i = 0; i < number_of_new_edges; ++i) {
+      idlib_u32 u = w->new_edges[2 * i + 0], v = w->new_edges[2 * i + 1];
+      if (!find_edge(t, w, u, v, &triangle, &k)) {
+        return false;
+      }
+      if ((t->constraints[triangle] >> k) & 1) {
+        continue;
+      }
+      other = t->neighbors[3 * triangle + k];
+      if (other == NONE) {
+        continue;
+      }
+      idlib_u32 const* tv = t->vertices + 3 * triangle;
+      idlib_u32 const* ov = t->vertices + 3 * other;
+      idlib_u32 q = ov[index_of(t->neighbors + 3 * other, triangle)];
+      if (idlib_in_circle_2_f32(points + tv[0], points + tv[1], points + tv[2], points + q) > 0.0) {
+        flip(t, w, triangle, k, &w->new_edges[2 * i + 0], &w->new_edges[2 * i + 1]);
+        swapped = true;
+      }
+    }
+  }
+  return true;
+}
+
+bool
+idlib_delaunay_2_f32_insert_constraints
+  (
+    idlib_triangulation_2* target,
+    idlib_vector_2_f32 const* points,
+    idlib_u32 number_of_points,
+    idlib_u32 const* edges,
+    idlib_u32 number_of_edges,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  IDLIB_DEBUG_ASSERT(NULL != edges);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+
+  constraint_workspace w;
+  // See idlib_delaunay_2_f32_triangulate.
+  constraint_workspace_layout(&w, (char*)workspace, number_of_points, idlib_delaunay_2_f32_get_capacity(number_of_points));
+  for (idlib_u32 i = 0; i < number_of_points; ++i) {
+    w.vertex_triangle[i] = NONE;
+  }
+  for (idlib_u32 i = 0; i < target->number_of_triangles; ++i) {
+    for (idlib_u32 k = 0; k < 3; ++k) {
+      w.vertex_triangle[target->vertices[3 * i + k]] = i;
+    }
+  }
+  for (idlib_u32 i = 0; i < number_of_edges; ++i) {
+    idlib_u32 a = edges[2 * i + 0], b = edges[2 * i + 1];
+    if (a >= number_of_points || b >= number_of_points ||
+        w.vertex_triangle[a] == NONE || w.vertex_triangle[b] == NONE) {
+      return false;
+    }
+    // Insert the edge piecewise if it passes through vertices.
+    while (a != b) {
+      idlib_u32 queue_size, stop;
+      if (!collect_crossed_edges(target, &w, points, a, b, &queue_size, &stop)) {
+        return false;
+      }
+      if (!insert_constraint(target, &w, points, a, stop, queue_size)) {
+        return false;
+      }
+      a = stop;
+    }
+  }
+  return true;
+}
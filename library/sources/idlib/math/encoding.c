@@ -0,0 +1,791 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+// fabsf, copysignf, sqrtf
+#include <math.h>
+
+#include "idlib/math/encoding.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+  // __m128i, _mm_*_epi32, _mm_cvttps_epi32, _mm_cvtepi32_ps
+  #include <emmintrin.h>
+#endif
+
+// The scalar paths below perform the same sequence of operations as the SIMD paths
+// such that the results do not depend on the position of a vector in the stream.
+// In particular, rounding is always "round half away from zero" implemented as truncation of x + copysign(0.5, x).
+
+static inline idlib_i32
+round_f32
+  (
+    idlib_f32 x
+  )
+{ return (idlib_i32)(x + copysignf(0.5f, x)); }
+
+// The largest value of a signed normalized integer of the specified number of bits.
+static inline idlib_f32
+snorm_scale
+  (
+    idlib_u32 bits
+  )
+{ return (idlib_f32)((1u << (bits - 1)) - 1u); }
+
+// Sign-extend the lower bits of an unsigned integer.
+static inline idlib_i32
+sign_extend
+  (
+    idlib_u32 x,
+    idlib_u32 bits
+  )
+{
+  idlib_u32 m = 1u << (bits - 1);
+  x &= (m << 1) - 1u;
+  return (idlib_i32)(x ^ m) - (idlib_i32)m;
+}
+
+static inline idlib_u32
+octahedral_encode_1
+  (
+    idlib_f32 x,
+    idlib_f32 y,
+    idlib_f32 z,
+    idlib_u32 bits
+  )
+{
+  idlib_f32 l = fabsf(x) + fabsf(y) + fabsf(z);
+  idlib_f32 s = l > 0.f ? 1.f / l : 0.f;
+  idlib_f32 u = x * s, v = y * s;
+  if (z < 0.f) {
+    idlib_f32 u1 = (1.f - fabsf(v)) * copysignf(1.f, u);
+    idlib_f32 v1 = (1.f - fabsf(u)) * copysignf(1.f, v);
+    u = u1;
+    v = v1;
+  }
+  idlib_f32 scale = snorm_scale(bits);
+  idlib_u32 mask = (idlib_u32)((1ull << bits) - 1u);
+  idlib_u32 qu = (idlib_u32)round_f32(u * scale) & mask;
+  idlib_u32 qv = (idlib_u32)round_f32(v * scale) & mask;
+  return qu | (qv << bits);
+}
+
+static inline void
+octahedral_decode_1
+  (
+    idlib_f32* x,
+    idlib_f32* y,
+    idlib_f32* z,
+    idlib_u32 operand,
+    idlib_u32 bits
+  )
+{
+  idlib_f32 inverse_scale = 1.f / snorm_scale(bits);
+  idlib_f32 u = (idlib_f32)sign_extend(operand, bits) * inverse_scale;
+  idlib_f32 v = (idlib_f32)sign_extend(operand >> bits, bits) * inverse_scale;
+  u = u < -1.f ? -1.f : u;
+  v = v < -1.f ? -1.f : v;
+  idlib_f32 w = 1.f - fabsf(u) - fabsf(v);
+  idlib_f32 t = -w > 0.f ? -w : 0.f;
+  u = u - copysignf(t, u);
+  v = v - copysignf(t, v);
+  idlib_f32 s = 1.f / sqrtf(u * u + v * v + w * w);
+  *x = u * s;
+  *y = v * s;
+  *z = w * s;
+}
+
+idlib_u32
+idlib_octahedral_encode_f32
+  (
+    idlib_vector_3_f32 const* operand,
+    idlib_u32 bits
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(8 == bits || 12 == bits || 16 == bits);
+  return octahedral_encode_1(operand->e[0], operand->e[1], operand->e[2], bits);
+}
+
+void
+idlib_octahedral_decode_f32
+  (
+    idlib_vector_3_f32* target,
+    idlib_u32 operand,
+    idlib_u32 bits
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(8 == bits || 12 == bits || 16 == bits);
+  octahedral_decode_1(&target->e[0], &target->e[1], &target->e[2], operand, bits);
+}
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+static inline __m128
+abs_4
+  (
+    __m128 x
+  )
+{ return _mm_andnot_ps(_mm_set1_ps(-0.f), x); }
+
+// copysign(a, b)
+static inline __m128
+copysign_4
+  (
+    __m128 a,
+    __m128 b
+  )
+{
+  __m128 sign = _mm_set1_ps(-0.f);
+  return _mm_or_ps(_mm_andnot_ps(sign, a), _mm_and_ps(sign, b));
+}
+
+static inline __m128i
+round_4
+  (
+    __m128 x
+  )
+{ return _mm_cvttps_epi32(_mm_add_ps(x, copysign_4(_mm_set1_ps(0.5f), x))); }
+
+#endif
+
+void
+idlib_octahedral_encode_f32_n
+  (
+    idlib_u32* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 bits,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(8 == bits || 12 == bits || 16 == bits);
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f), scale = _mm_set1_ps(snorm_scale(bits));
+  __m128i mask = _mm_set1_epi32((int)((1ull << bits) - 1u));
+  for (; i + 4 <= last; i += 4) {
+    __m128 x = _mm_loadu_ps(operand->x + i), y = _mm_loadu_ps(operand->y + i), z = _mm_loadu_ps(operand->z + i);
+    __m128 l = _mm_add_ps(_mm_add_ps(abs_4(x), abs_4(y)), abs_4(z));
+    __m128 s = _mm_and_ps(_mm_cmpgt_ps(l, zero), _mm_div_ps(one, l));
+    __m128 u = _mm_mul_ps(x, s), v = _mm_mul_ps(y, s);
+    __m128 u1 = _mm_mul_ps(_mm_sub_ps(one, abs_4(v)), copysign_4(one, u));
+    __m128 v1 = _mm_mul_ps(_mm_sub_ps(one, abs_4(u)), copysign_4(one, v));
+    __m128 lower = _mm_cmplt_ps(z, zero);
+    u = _mm_or_ps(_mm_and_ps(lower, u1), _mm_andnot_ps(lower, u));
+    v = _mm_or_ps(_mm_and_ps(lower, v1), _mm_andnot_ps(lower, v));
+    __m128i qu = _mm_and_si128(round_4(_mm_mul_ps(u, scale)), mask);
+    __m128i qv = _mm_and_si128(round_4(_mm_mul_ps(v, scale)), mask);
+    _mm_storeu_si128((__m128i*)(target + i), _mm_or_si128(qu, _mm_sll_epi32(qv, _mm_cvtsi32_si128((int)bits))));
+  }
+#endif
+  for (; i < last; ++i) {
+    target[i] = octahedral_encode_1(operand->x[i], operand->y[i], operand->z[i], bits);
+  }
+}
+
+void
+idlib_octahedral_decode_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u32 const* operand,
+    idlib_u32 bits,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(8 == bits || 12 == bits || 16 == bits);
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f), minus_one = _mm_set1_ps(-1.f);
+  __m128 inverse_scale = _mm_set1_ps(1.f / snorm_scale(bits));
+  // Sign-extend by shifting the component into the upper bits and back.
+  __m128i left = _mm_cvtsi32_si128((int)(32 - bits)), right_u = _mm_cvtsi32_si128((int)(32 - 2 * bits));
+  for (; i + 4 <= last; i += 4) {
+    __m128i q = _mm_loadu_si128((__m128i const*)(operand + i));
+    __m128i qu = _mm_sra_epi32(_mm_sll_epi32(q, left), left);
+    __m128i qv = _mm_sra_epi32(_mm_sll_epi32(q, right_u), left);
+    __m128 u = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(qu), inverse_scale), minus_one);
+    __m128 v = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(qv), inverse_scale), minus_one);
+    __m128 w = _mm_sub_ps(_mm_sub_ps(one, abs_4(u)), abs_4(v));
+    __m128 t = _mm_max_ps(_mm_sub_ps(zero, w), zero);
+    u = _mm_sub_ps(u, copysign_4(t, u));
+    v = _mm_sub_ps(v, copysign_4(t, v));
+    __m128 s = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(u, u), _mm_mul_ps(v, v)), _mm_mul_ps(w, w))));
+    _mm_storeu_ps(target->x + i, _mm_mul_ps(u, s));
+    _mm_storeu_ps(target->y + i, _mm_mul_ps(v, s));
+    _mm_storeu_ps(target->z + i, _mm_mul_ps(w, s));
+  }
+#endif
+  for (; i < last; ++i) {
+    octahedral_decode_1(&target->x[i], &target->y[i], &target->z[i], operand[i], bits);
+  }
+}
+
+// The mapping of the components to normalized integers.
+// A component x is mapped to round(clamp((x - offset[k]) * scale[k], minimum, maximum))
+// and a normalized integer q is mapped back to q * inverse_scale[k] + offset[k].
+typedef struct box_mapping {
+  idlib_f32 offset[3];
+  idlib_f32 scale[3];
+  idlib_f32 inverse_scale[3];
+  idlib_f32 minimum, maximum;
+} box_mapping;
+
+static inline void
+box_mapping_initialize
+  (
+    box_mapping* target,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    idlib_u32 bits,
+    bool is_signed
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != minimum);
+  IDLIB_DEBUG_ASSERT(NULL != maximum);
+  idlib_f32 q = is_signed ? snorm_scale(bits) : (idlib_f32)((1u << bits) - 1u);
+  target->minimum = is_signed ? -q : 0.f;
+  target->maximum = q;
+  for (size_t k = 0; k < 3; ++k) {
+    idlib_f32 extent = maximum->e[k] - minimum->e[k];
+    if (is_signed) {
+      extent *= 0.5f;
+      target->offset[k] = minimum->e[k] + extent;
+    } else {
+      target->offset[k] = minimum->e[k];
+    }
+    target->scale[k] = extent > 0.f ? q / extent : 0.f;
+    target->inverse_scale[k] = extent / q;
+  }
+}
+
+static inline idlib_i32
+box_encode_1
+  (
+    box_mapping const* mapping,
+    idlib_f32 x,
+    size_t k
+  )
+{
+  idlib_f32 t = (x - mapping->offset[k]) * mapping->scale[k];
+  t = t > mapping->minimum ? t : mapping->minimum;
+  t = t < mapping->maximum ? t : mapping->maximum;
+  return round_f32(t);
+}
+
+// Encode the vectors [first, first + count) into an array of either idlib_u8 or idlib_u16 elements.
+static void
+box_encode_n
+  (
+    void* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    idlib_u32 bits,
+    bool is_signed,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, bits, is_signed);
+  idlib_u8* target8 = (idlib_u8*)target;
+  idlib_u16* target16 = (idlib_u16*)target;
+  idlib_f32 const* components[3] = { operand->x, operand->y, operand->z };
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 lower = _mm_set1_ps(mapping.minimum), upper = _mm_set1_ps(mapping.maximum);
+  __m128 offset[3], scale[3];
+  for (size_t k = 0; k < 3; ++k) {
+    offset[k] = _mm_set1_ps(mapping.offset[k]);
+    scale[k] = _mm_set1_ps(mapping.scale[k]);
+  }
+  for (; i + 4 <= last; i += 4) {
+    IDLIB_ALIGNAS(16) idlib_i32 q[3][4];
+    for (size_t k = 0; k < 3; ++k) {
+      __m128 t = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(components[k] + i), offset[k]), scale[k]);
+      t = _mm_min_ps(_mm_max_ps(t, lower), upper);
+      _mm_store_si128((__m128i*)q[k], round_4(t));
+    }
+    // Interleave the components.
+    if (8 == bits) {
+      for (size_t j = 0; j < 4; ++j) for (size_t k = 0; k < 3; ++k) target8[3 * (i + j) + k] = (idlib_u8)q[k][j];
+    } else {
+      for (size_t j = 0; j < 4; ++j) for (size_t k = 0; k < 3; ++k) target16[3 * (i + j) + k] = (idlib_u16)q[k][j];
+    }
+  }
+#endif
+  for (; i < last; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_i32 q = box_encode_1(&mapping, components[k][i], k);
+      if (8 == bits) {
+        target8[3 * i + k] = (idlib_u8)q;
+      } else {
+        target16[3 * i + k] = (idlib_u16)q;
+      }
+    }
+  }
+}
+
+static inline idlib_f32
+box_decode_1
+  (
+    box_mapping const* mapping,
+    idlib_u32 q,
+    idlib_u32 bits,
+    bool is_signed,
+    size_t k
+  )
+{
+  idlib_i32 r = is_signed ? sign_extend(q, bits) : (idlib_i32)q;
+  // The most negative value is mapped to -1 just like its successor.
+  idlib_f32 t = (idlib_f32)r;
+  t = t > mapping->minimum ? t : mapping->minimum;
+  return t * mapping->inverse_scale[k] + mapping->offset[k];
+}
+
+// Decode the vectors [first, first + count) from an array of either idlib_u8 or idlib_u16 elements.
+static void
+box_decode_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    void const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    idlib_u32 bits,
+    bool is_signed,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, bits, is_signed);
+  idlib_u8 const* operand8 = (idlib_u8 const*)operand;
+  idlib_u16 const* operand16 = (idlib_u16 const*)operand;
+  idlib_f32* components[3] = { target->x, target->y, target->z };
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 lower = _mm_set1_ps(mapping.minimum);
+  __m128 offset[3], inverse_scale[3];
+  for (size_t k = 0; k < 3; ++k) {
+    offset[k] = _mm_set1_ps(mapping.offset[k]);
+    inverse_scale[k] = _mm_set1_ps(mapping.inverse_scale[k]);
+  }
+  // Sign-extend by shifting the component into the upper bits and back.
+  __m128i shift = _mm_cvtsi32_si128((int)(32 - bits));
+  for (; i + 4 <= last; i += 4) {
+    // Deinterleave the components.
+    IDLIB_ALIGNAS(16) idlib_i32 q[3][4];
+    if (8 == bits) {
+      for (size_t j = 0; j < 4; ++j) for (size_t k = 0; k < 3; ++k) q[k][j] = operand8[3 * (i + j) + k];
+    } else {
+      for (size_t j = 0; j < 4; ++j) for (size_t k = 0; k < 3; ++k) q[k][j] = operand16[3 * (i + j) + k];
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      __m128i r = _mm_load_si128((__m128i const*)q[k]);
+      if (is_signed) {
+        r = _mm_sra_epi32(_mm_sll_epi32(r, shift), shift);
+      }
+      __m128 t = _mm_max_ps(_mm_cvtepi32_ps(r), lower);
+      _mm_storeu_ps(components[k] + i, _mm_add_ps(_mm_mul_ps(t, inverse_scale[k]), offset[k]));
+    }
+  }
+#endif
+  for (; i < last; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_u32 q = 8 == bits ? operand8[3 * i + k] : operand16[3 * i + k];
+      components[k][i] = box_decode_1(&mapping, q, bits, is_signed, k);
+    }
+  }
+}
+
+void
+idlib_vector_3_f32_encode_unorm16
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 16, false);
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] = (idlib_u16)box_encode_1(&mapping, operand->e[k], k);
+  }
+}
+
+void
+idlib_vector_3_f32_decode_unorm16
+  (
+    idlib_vector_3_f32* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 16, false);
+  for (size_t k = 0; k < 3; ++k) {
+    target->e[k] = box_decode_1(&mapping, operand[k], 16, false, k);
+  }
+}
+
+void
+idlib_vector_3_f32_encode_unorm8
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 8, false);
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] = (idlib_u8)box_encode_1(&mapping, operand->e[k], k);
+  }
+}
+
+void
+idlib_vector_3_f32_decode_unorm8
+  (
+    idlib_vector_3_f32* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 8, false);
+  for (size_t k = 0; k < 3; ++k) {
+    target->e[k] = box_decode_1(&mapping, operand[k], 8, false, k);
+  }
+}
+
+void
+idlib_vector_3_f32_encode_snorm16
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 16, true);
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] = (idlib_u16)box_encode_1(&mapping, operand->e[k], k);
+  }
+}
+
+void
+idlib_vector_3_f32_decode_snorm16
+  (
+    idlib_vector_3_f32* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 16, true);
+  for (size_t k = 0; k < 3; ++k) {
+    target->e[k] = box_decode_1(&mapping, operand[k], 16, true, k);
+  }
+}
+
+void
+idlib_vector_3_f32_encode_snorm8
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 8, true);
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] = (idlib_u8)box_encode_1(&mapping, operand->e[k], k);
+  }
+}
+
+void
+idlib_vector_3_f32_decode_snorm8
+  (
+    idlib_vector_3_f32* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  box_mapping mapping;
+  box_mapping_initialize(&mapping, minimum, maximum, 8, true);
+  for (size_t k = 0; k < 3; ++k) {
+    target->e[k] = box_decode_1(&mapping, operand[k], 8, true, k);
+  }
+}
+
+void
+idlib_vector_3_f32_encode_unorm16_n
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_encode_n(target, operand, minimum, maximum, 16, false, first, count); }
+
+void
+idlib_vector_3_f32_decode_unorm16_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_decode_n(target, operand, minimum, maximum, 16, false, first, count); }
+
+void
+idlib_vector_3_f32_encode_unorm8_n
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_encode_n(target, operand, minimum, maximum, 8, false, first, count); }
+
+void
+idlib_vector_3_f32_decode_unorm8_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_decode_n(target, operand, minimum, maximum, 8, false, first, count); }
+
+void
+idlib_vector_3_f32_encode_snorm16_n
+  (
+    idlib_u16* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_encode_n(target, operand, minimum, maximum, 16, true, first, count); }
+
+void
+idlib_vector_3_f32_decode_snorm16_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u16 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_decode_n(target, operand, minimum, maximum, 16, true, first, count); }
+
+void
+idlib_vector_3_f32_encode_snorm8_n
+  (
+    idlib_u8* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_encode_n(target, operand, minimum, maximum, 8, true, first, count); }
+
+void
+idlib_vector_3_f32_decode_snorm8_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8 const* operand,
+    idlib_vector_3_f32 const* minimum,
+    idlib_vector_3_f32 const* maximum,
+    size_t first,
+    size_t count
+  )
+{ box_decode_n(target, operand, minimum, maximum, 8, true, first, count); }
+
+// Clamp to [0,1] and map NaN to 0 like _mm_min_ps(_mm_max_ps(x, 0), 1).
+static inline idlib_f32
+saturate
+  (
+    idlib_f32 x
+  )
+{
+  x = x > 0.f ? x : 0.f;
+  return x < 1.f ? x : 1.f;
+}
+
+static inline idlib_u32
+pack_rgb10a2_1
+  (
+    idlib_f32 x,
+    idlib_f32 y,
+    idlib_f32 z,
+    idlib_f32 w
+  )
+{
+  idlib_u32 r = (idlib_u32)round_f32(saturate(x) * 1023.f);
+  idlib_u32 g = (idlib_u32)round_f32(saturate(y) * 1023.f);
+  idlib_u32 b = (idlib_u32)round_f32(saturate(z) * 1023.f);
+  idlib_u32 a = (idlib_u32)round_f32(saturate(w) * 3.f);
+  return r | (g << 10) | (b << 20) | (a << 30);
+}
+
+static inline void
+unpack_rgb10a2_1
+  (
+    idlib_f32* x,
+    idlib_f32* y,
+    idlib_f32* z,
+    idlib_f32* w,
+    idlib_u32 operand
+  )
+{
+  *x = (idlib_f32)(operand & 0x3ffu) * (1.f / 1023.f);
+  *y = (idlib_f32)((operand >> 10) & 0x3ffu) * (1.f / 1023.f);
+  *z = (idlib_f32)((operand >> 20) & 0x3ffu) * (1.f / 1023.f);
+  *w = (idlib_f32)(operand >> 30) * (1.f / 3.f);
+}
+
+idlib_u32
+idlib_vector_4_f32_pack_rgb10a2
+  (
+    idlib_vector_4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  return pack_rgb10a2_1(operand->e[0], operand->e[1], operand->e[2], operand->e[3]);
+}
+
+void
+idlib_vector_4_f32_unpack_rgb10a2
+  (
+    idlib_vector_4_f32* target,
+    idlib_u32 operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  unpack_rgb10a2_1(&target->e[0], &target->e[1], &target->e[2], &target->e[3], operand);
+}
+
+void
+idlib_vector_4_f32_pack_rgb10a2_n
+  (
+    idlib_u32* target,
+    idlib_vector_4_f32_soa const* operand,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+  __m128 scale_rgb = _mm_set1_ps(1023.f), scale_a = _mm_set1_ps(3.f);
+  for (; i + 4 <= last; i += 4) {
+    // _mm_max_ps(x, 0) returns its second operand if x is NaN, hence NaN is mapped to 0 as by saturate.
+    __m128i r = round_4(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(operand->x + i), zero), one), scale_rgb));
+    __m128i g = round_4(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(operand->y + i), zero), one), scale_rgb));
+    __m128i b = round_4(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(operand->z + i), zero), one), scale_rgb));
+    __m128i a = round_4(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(operand->w + i), zero), one), scale_a));
+    __m128i p = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 10)), _mm_or_si128(_mm_slli_epi32(b, 20), _mm_slli_epi32(a, 30)));
+    _mm_storeu_si128((__m128i*)(target + i), p);
+  }
+#endif
+  for (; i < last; ++i) {
+    target[i] = pack_rgb10a2_1(operand->x[i], operand->y[i], operand->z[i], operand->w[i]);
+  }
+}
+
+void
+idlib_vector_4_f32_unpack_rgb10a2_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_u32 const* operand,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128i mask = _mm_set1_epi32(0x3ff);
+  __m128 scale_rgb = _mm_set1_ps(1.f / 1023.f), scale_a = _mm_set1_ps(1.f / 3.f);
+  for (; i + 4 <= last; i += 4) {
+    __m128i p = _mm_loadu_si128((__m128i const*)(operand + i));
+    _mm_storeu_ps(target->x + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(p, mask)), scale_rgb));
+    _mm_storeu_ps(target->y + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(p, 10), mask)), scale_rgb));
+    _mm_storeu_ps(target->z + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(p, 20), mask)), scale_rgb));
+    _mm_storeu_ps(target->w + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(p, 30)), scale_a));
+  }
+#endif
+  for (; i < last; ++i) {
+    unpack_rgb10a2_1(&target->x[i], &target->y[i], &target->z[i], &target->w[i], operand[i]);
+  }
+}
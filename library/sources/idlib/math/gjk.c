@@ -0,0 +1,1067 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+// sqrtf, fabsf
+#include <math.h>
+
+#include "idlib/math/gjk.h"
+
+// The maximum number of GJK iterations.
+// GJK on polytopes terminates after a finite number of iterations. The bound only guards against cycling due to arithmetic errors.
+#define GJK_MAXIMUM_ITERATIONS (32)
+
+// GJK terminates if the squared length of v decreases by less than this fraction of it.
+#define GJK_RELATIVE_EPSILON (1e-5f)
+
+// The origin is considered as contained in the Minkowski difference of the core shapes
+// if the squared length of v is less than this fraction of the squared length of the longest vertex of the simplex.
+#define GJK_CONTACT_EPSILON (1e-10f)
+
+// The maximum number of vertices of the EPA polytope.
+#define EPA_MAXIMUM_VERTICES (64)
+
+// The maximum number of faces of the EPA polytope.
+#define EPA_MAXIMUM_FACES (128)
+
+// EPA terminates if a support point is less than this fraction of the scale of the polytope beyond the closest face.
+#define EPA_RELATIVE_EPSILON (1e-5f)
+
+static inline idlib_f32
+dot
+  (
+    idlib_f32 const* u,
+    idlib_f32 const* v
+  )
+{ return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; }
+
+static inline void
+cross
+  (
+    idlib_f32* target,
+    idlib_f32 const* u,
+    idlib_f32 const* v
+  )
+{
+  idlib_f32 x = u[1] * v[2] - u[2] * v[1];
+  idlib_f32 y = u[2] * v[0] - u[0] * v[2];
+  idlib_f32 z = u[0] * v[1] - u[1] * v[0];
+  target[0] = x;
+  target[1] = y;
+  target[2] = z;
+}
+
+static inline void
+subtract
+  (
+    idlib_f32* target,
+    idlib_f32 const* u,
+    idlib_f32 const* v
+  )
+{
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] = u[k] - v[k];
+  }
+}
+
+// Normalize a vector. Return false if it is (almost) the zero vector.
+static inline bool
+normalize
+  (
+    idlib_f32* target
+  )
+{
+  idlib_f32 l = dot(target, target);
+  if (!(l > 1e-30f)) {
+    return false;
+  }
+  l = 1.f / sqrtf(l);
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] *= l;
+  }
+  return true;
+}
+
+// A vertex of the simplex resp. the polytope:
+// The points a of the first and b of the second core shape in world coordinates and in local coordinates and w = a - b.
+typedef struct vertex {
+  idlib_f32 w[3];
+  idlib_f32 a[3];
+  idlib_f32 b[3];
+  idlib_f32 local_a[3];
+  idlib_f32 local_b[3];
+} vertex;
+
+// A simplex and the barycentric coordinates of its point closest to the origin.
+typedef struct simplex {
+  vertex vertices[4];
+  idlib_f32 lambda[4];
+  idlib_u32 count;
+} simplex;
+
+// A face of the EPA polytope. The vertices are in counterclockwise order when viewed from outside.
+typedef struct face {
+  idlib_u32 vertices[3];
+  idlib_f32 normal[3];
+  idlib_f32 distance;
+} face;
+
+// Evaluate the support function of the core shape for a direction in local coordinates.
+static void
+core_support_local
+  (
+    idlib_f32* target,
+    idlib_convex_shape_3_f32 const* shape,
+    idlib_f32 const* direction
+  )
+{
+  switch (shape->kind) {
+    case IDLIB_CONVEX_SHAPE_BOX: {
+      for (size_t k = 0; k < 3; ++k) {
+        target[k] = direction[k] < 0.f ? -shape->extents.e[k] : shape->extents.e[k];
+      }
+    } break;
+    case IDLIB_CONVEX_SHAPE_CAPSULE: {
+      target[0] = 0.f;
+      target[1] = direction[1] < 0.f ? -shape->extents.e[1] : shape->extents.e[1];
+      target[2] = 0.f;
+    } break;
+    case IDLIB_CONVEX_SHAPE_HULL: {
+      idlib_vector_3_f32 const* p = shape->points;
+      idlib_u32 best = 0;
+      idlib_f32 best_projection = dot(p[0].e, direction);
+      for (idlib_u32 i = 1; i < shape->number_of_points; ++i) {
+        idlib_f32 projection = dot(p[i].e, direction);
+        if (projection > best_projection) {
+          best_projection = projection;
+          best = i;
+        }
+      }
+      for (size_t k = 0; k < 3; ++k) {
+        target[k] = p[best].e[k];
+      }
+    } break;
+    case IDLIB_CONVEX_SHAPE_SPHERE:
+    default: {
+      target[0] = target[1] = target[2] = 0.f;
+    } break;
+  }
+}
+
+// Transform a direction from world coordinates into the local coordinates of a shape.
+static inline void
+to_local
+  (
+    idlib_f32* target,
+    idlib_convex_shape_3_f32 const* shape,
+    idlib_f32 const* direction
+  )
+{
+  idlib_f32 const (*r)[3] = shape->rotation.e;
+  for (size_t j = 0; j < 3; ++j) {
+    target[j] = r[0][j] * direction[0] + r[1][j] * direction[1] + r[2][j] * direction[2];
+  }
+}
+
+// Transform a point from the local coordinates of a shape into world coordinates.
+static inline void
+to_world
+  (
+    idlib_f32* target,
+    idlib_convex_shape_3_f32 const* shape,
+    idlib_f32 const* point
+  )
+{
+  idlib_f32 const (*r)[3] = shape->rotation.e;
+  for (size_t i = 0; i < 3; ++i) {
+    target[i] = r[i][0] * point[0] + r[i][1] * point[1] + r[i][2] * point[2] + shape->center.e[i];
+  }
+}
+
+// Compute the world coordinates of a vertex from its local coordinates.
+static inline void
+vertex_update
+  (
+    vertex* target,
+    idlib_convex_shape_3_f32 const* shape1,
+    idlib_convex_shape_3_f32 const* shape2
+  )
+{
+  to_world(target->a, shape1, target->local_a);
+  to_world(target->b, shape2, target->local_b);
+  subtract(target->w, target->a, target->b);
+}
+
+// Evaluate the support function of the Minkowski difference of the core shapes.
+static void
+core_support
+  (
+    vertex* target,
+    idlib_convex_shape_3_f32 const* shape1,
+    idlib_convex_shape_3_f32 const* shape2,
+    idlib_f32 const* direction
+  )
+{
+  idlib_f32 d[3], n[3] = { -direction[0], -direction[1], -direction[2] };
+  to_local(d, shape1, direction);
+  core_support_local(target->local_a, shape1, d);
+  to_local(d, shape2, n);
+  core_support_local(target->local_b, shape2, d);
+  vertex_update(target, shape1, shape2);
+}
+
+// Reduce a simplex to the segment ab resp. the endpoint closest to the origin.
+static void
+closest_segment
+  (
+    simplex* target,
+    vertex const* a,
+    vertex const* b
+  )
+{
+  idlib_f32 ab[3];
+  subtract(ab, b->w, a->w);
+  idlib_f32 t = -dot(a->w, ab), d = dot(ab, ab);
+  if (t <= 0.f || !(d > 0.f)) {
+    target->vertices[0] = *a;
+    target->lambda[0] = 1.f;
+    target->count = 1;
+  } else if (t >= d) {
+    target->vertices[0] = *b;
+    target->lambda[0] = 1.f;
+    target->count = 1;
+  } else {
+    t /= d;
+    target->vertices[0] = *a;
+    target->vertices[1] = *b;
+    target->lambda[0] = 1.f - t;
+    target->lambda[1] = t;
+    target->count = 2;
+  }
+}
+
+// Compute the squared length of the point of a simplex given by its barycentric coordinates.
+static inline idlib_f32
+closest_squared_length
+  (
+    simplex const* operand
+  )
+{
+  idlib_f32 v[3] = { 0.f, 0.f, 0.f };
+  for (idlib_u32 i = 0; i < operand->count; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      v[k] += operand->lambda[i] * operand->vertices[i].w[k];
+    }
+  }
+  return dot(v, v);
+}
+
+// Reduce a simplex to the feature of the triangle abc closest to the origin.
+// See Ericson, "Real-Time Collision Detection", Section 5.1.5.
+static void
+closest_triangle
+  (
+    simplex* target,
+    vertex const* a,
+    vertex const* b,
+    vertex const* c
+  )
+{
+  idlib_f32 ab[3], ac[3];
+  subtract(ab, b->w, a->w);
+  subtract(ac, c->w, a->w);
+  idlib_f32 d1 = -dot(ab, a->w), d2 = -dot(ac, a->w);
+  if (d1 <= 0.f && d2 <= 0.f) {
+    target->vertices[0] = *a;
+    target->lambda[0] = 1.f;
+    target->count = 1;
+    return;
+  }
+  idlib_f32 d3 = -dot(ab, b->w), d4 = -dot(ac, b->w);
+  if (d3 >= 0.f && d4 <= d3) {
+    target->vertices[0] = *b;
+    target->lambda[0] = 1.f;
+    target->count = 1;
+    return;
+  }
+  idlib_f32 vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f && d1 - d3 > 0.f) {
+    idlib_f32 t = d1 / (d1 - d3);
+    target->vertices[0] = *a;
+    target->vertices[1] = *b;
+    target->lambda[0] = 1.f - t;
+    target->lambda[1] = t;
+    target->count = 2;
+    return;
+  }
+  idlib_f32 d5 = -dot(ab, c->w), d6 = -dot(ac, c->w);
+  if (d6 >= 0.f && d5 <= d6) {
+    target->vertices[0] = *c;
+    target->lambda[0] = 1.f;
+    target->count = 1;
+    return;
+  }
+  idlib_f32 vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f && d2 - d6 > 0.f) {
+    idlib_f32 t = d2 / (d2 - d6);
+    target->vertices[0] = *a;
+    target->vertices[1] = *c;
+    target->lambda[0] = 1.f - t;
+    target->lambda[1] = t;
+    target->count = 2;
+    return;
+  }
+  idlib_f32 va = d3 * d6 - d5 * d4;
+  if (va <= 0.f && d4 - d3 >= 0.f && d5 - d6 >= 0.f && (d4 - d3) + (d5 - d6) > 0.f) {
+    idlib_f32 t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    target->vertices[0] = *b;
+    target->vertices[1] = *c;
+    target->lambda[0] = 1.f - t;
+    target->lambda[1] = t;
+    target->count = 2;
+    return;
+  }
+  idlib_f32 denominator = va + vb + vc;
+  if (!(denominator > 0.f)) {
+    // The triangle is degenerate: Select the closest of its edges.
+    simplex s;
+    closest_segment(target, a, b);
+    idlib_f32 best = closest_squared_length(target);
+    closest_segment(&s, a, c);
+    idlib_f32 l = closest_squared_length(&s);
+    if (l < best) {
+      *target = s;
+      best = l;
+    }
+    closest_segment(&s, b, c);
+    if (closest_squared_length(&s) < best) {
+      *target = s;
+    }
+    return;
+  }
+  idlib_f32 v = vb / denominator, w = vc / denominator;
+  target->vertices[0] = *a;
+  target->vertices[1] = *b;
+  target->vertices[2] = *c;
+  target->lambda[0] = 1.f - v - w;
+  target->lambda[1] = v;
+  target->lambda[2] = w;
+  target->count = 3;
+}
+
+// Get if the origin and the point d are on different sides of the plane through a, b, and c.
+// Return true if the points are (almost) coplanar such that the face is tested in any case.
+static inline bool
+origin_outside_of_plane
+  (
+    idlib_f32 const* a,
+    idlib_f32 const* b,
+    idlib_f32 const* c,
+    idlib_f32 const* d
+  )
+{
+  idlib_f32 ab[3], ac[3], ad[3], n[3];
+  subtract(ab, b, a);
+  subtract(ac, c, a);
+  subtract(ad, d, a);
+  cross(n, ab, ac);
+  idlib_f32 sign_p = -dot(a, n), sign_d = dot(ad, n);
+  if (sign_d * sign_d <= 1e-12f * dot(n, n) * dot(ad, ad)) {
+    return true;
+  }
+  return sign_p * sign_d < 0.f;
+}
+
+// Reduce a simplex to the feature of the tetrahedron abcd closest to the origin.
+// Return false if the origin is inside the tetrahedron.
+static bool
+closest_tetrahedron
+  (
+    simplex* target,
+    vertex const* a,
+    vertex const* b,
+    vertex const* c,
+    vertex const* d
+  )
+{
+  vertex const* faces[4][4] = { { a, b, c, d }, { a, c, d, b }, { a, d, b, c }, { b, d, c, a } };
+  idlib_f32 best = INFINITY;
+  bool outside = false;
+  for (size_t i = 0; i < 4; ++i) {
+    vertex const* const* f = faces[i];
+    if (origin_outside_of_plane(f[0]->w, f[1]->w, f[2]->w, f[3]->w)) {
+      simplex s;
+      closest_triangle(&s, f[0], f[1], f[2]);
+      idlib_f32 l = closest_squared_length(&s);
+      if (l < best) {
+        *target = s;
+        best = l;
+      }
+      outside = true;
+    }
+  }
+  return outside;
+}
+
+// Replace a simplex by the feature closest to the origin and compute the closest point v.
+static void
+closest
+  (
+    simplex* target,
+    idlib_f32* v
+  )
+{
+  simplex s = *target;
+  switch (s.count) {
+    case 1: {
+      target->lambda[0] = 1.f;
+    } break;
+    case 2: {
+      closest_segment(target, &s.vertices[0], &s.vertices[1]);
+    } break;
+    case 3: {
+      closest_triangle(target, &s.vertices[0], &s.vertices[1], &s.vertices[2]);
+    } break;
+    case 4: {
+      if (!closest_tetrahedron(target, &s.vertices[0], &s.vertices[1], &s.vertices[2], &s.vertices[3])) {
+        v[0] = v[1] = v[2] = 0.f;
+        return;
+      }
+    } break;
+  }
+  v[0] = v[1] = v[2] = 0.f;
+  for (idlib_u32 i = 0; i < target->count; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      v[k] += target->lambda[i] * target->vertices[i].w[k];
+    }
+  }
+}
+
+// The outcomes of gjk.
+typedef enum gjk_status {
+  // The algorithm converged. v is the closest point.
+  GJK_STATUS_CONVERGED,
+  // The origin is contained in the Minkowski difference of the core shapes.
+  GJK_STATUS_CONTACT,
+  // The core shapes are farther apart than the separation threshold.
+  GJK_STATUS_SEPARATED,
+  // The core shapes are not farther apart than the separation threshold.
+  GJK_STATUS_OVERLAP,
+} gjk_status;
+
+// Run GJK on the core shapes, starting with the simplex of the cache.
+// If threshold is not negative, then terminate as soon as the distance of the core shapes is known to be greater than threshold or not.
+// Return the number of iterations.
+static idlib_u32
+gjk
+  (
+    gjk_status* status,
+    simplex* s,
+    idlib_f32* v,
+    idlib_gjk_cache_3_f32 const* cache,
+    idlib_convex_shape_3_f32 const* shape1,
+    idlib_convex_shape_3_f32 const* shape2,
+    idlib_f32 threshold
+  )
+{
+  s->count = 0;
+  if (NULL != cache) {
+    for (idlib_u32 i = 0; i < cache->count; ++i) {
+      vertex* p = &s->vertices[i];
+      for (size_t k = 0; k < 3; ++k) {
+        p->local_a[k] = cache->points1[i].e[k];
+        p->local_b[k] = cache->points2[i].e[k];
+      }
+      vertex_update(p, shape1, shape2);
+    }
+    s->count = cache->count;
+  }
+  if (0 == s->count) {
+    idlib_f32 d[3];
+    subtract(d, shape2->center.e, shape1->center.e);
+    if (!(dot(d, d) > 0.f)) {
+      d[0] = 1.f;
+    }
+    core_support(&s->vertices[0], shape1, shape2, d);
+    s->count = 1;
+  }
+  closest(s, v);
+  idlib_f32 vv = dot(v, v);
+  idlib_u32 iterations = 0;
+  while (true) {
+    idlib_f32 scale = 0.f;
+    for (idlib_u32 i = 0; i < s->count; ++i) {
+      idlib_f32 l = dot(s->vertices[i].w, s->vertices[i].w);
+      scale = l > scale ? l : scale;
+    }
+    if (vv <= GJK_CONTACT_EPSILON * scale) {
+      *status = GJK_STATUS_CONTACT;
+      return iterations;
+    }
+    if (threshold >= 0.f && vv <= threshold * threshold) {
+      *status = GJK_STATUS_OVERLAP;
+      return iterations;
+    }
+    if (iterations == GJK_MAXIMUM_ITERATIONS) {
+      break;
+    }
+    idlib_f32 d[3] = { -v[0], -v[1], -v[2] };
+    vertex w;
+    core_support(&w, shape1, shape2, d);
+    idlib_f32 vw = dot(v, w.w);
+    if (threshold >= 0.f && vw > 0.f && vw * vw > vv * threshold * threshold) {
+      *status = GJK_STATUS_SEPARATED;
+      return iterations;
+    }
+    if (vv - vw <= GJK_RELATIVE_EPSILON * vv) {
+      break;
+    }
+    bool duplicate = false;
+    for (idlib_u32 i = 0; i < s->count; ++i) {
+      idlib_f32 const* p = s->vertices[i].w;
+      duplicate |= p[0] == w.w[0] && p[1] == w.w[1] && p[2] == w.w[2];
+    }
+    if (duplicate) {
+      break;
+    }
+    simplex t = *s;
+    idlib_f32 u[3] = { v[0], v[1], v[2] };
+    s->vertices[s->count++] = w;
+    closest(s, v);
+    ++iterations;
+    idlib_f32 uu = vv;
+    vv = dot(v, v);
+    if (vv >= uu) {
+      // No progress due to arithmetic errors: Keep the previous simplex.
+      *s = t;
+      v[0] = u[0];
+      v[1] = u[1];
+      v[2] = u[2];
+      vv = uu;
+      break;
+    }
+  }
+  if (threshold >= 0.f) {
+    *status = vv <= threshold * threshold ? GJK_STATUS_OVERLAP : GJK_STATUS_SEPARATED;
+  } else {
+    *status = GJK_STATUS_CONVERGED;
+  }
+  return iterations;
+}
+
+// Store the simplex in the cache.
+static void
+cache_store
+  (
+    idlib_gjk_cache_3_f32* cache,
+    simplex const* s
+  )
+{
+  if (NULL == cache) {
+    return;
+  }
+  for (idlib_u32 i = 0; i < s->count; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      cache->points1[i].e[k] = s->vertices[i].local_a[k];
+      cache->points2[i].e[k] = s->vertices[i].local_b[k];
+    }
+  }
+  cache->count = s->count;
+}
+
+// Compute the normal and the distance of a face. Return false if the face is degenerate.
+static bool
+face_update
+  (
+    face* target,
+    vertex const* vertices
+  )
+{
+  idlib_f32 const* a = vertices[target->vertices[0]].w;
+  idlib_f32 const* b = vertices[target->vertices[1]].w;
+  idlib_f32 const* c = vertices[target->vertices[2]].w;
+  idlib_f32 ab[3], ac[3];
+  subtract(ab, b, a);
+  subtract(ac, c, a);
+  cross(target->normal, ab, ac);
+  if (!normalize(target->normal)) {
+    return false;
+  }
+  target->distance = dot(target->normal, a);
+  return true;
+}
+
+// Extend a simplex containing the origin to a tetrahedron.
+// Return false if the Minkowski difference of the core shapes has no volume.
+// In that case, normal is a unit vector perpendicular to its affine hull.
+static bool
+epa_initialize
+  (
+    simplex* s,
+    idlib_f32* normal,
+    idlib_convex_shape_3_f32 const* shape1,
+    idlib_convex_shape_3_f32 const* shape2
+  )
+{
+  static idlib_f32 const axes[6][3] = { { 1.f, 0.f, 0.f }, { -1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, 0.f, -1.f } };
+  if (4 == s->count) {
+    idlib_f32 ab[3], ac[3], ad[3], n[3];
+    subtract(ab, s->vertices[1].w, s->vertices[0].w);
+    subtract(ac, s->vertices[2].w, s->vertices[0].w);
+    subtract(ad, s->vertices[3].w, s->vertices[0].w);
+    cross(n, ab, ac);
+    idlib_f32 volume = dot(n, ad);
+    if (volume * volume > 1e-12f * dot(n, n) * dot(ad, ad)) {
+      return true;
+    }
+    s->count = 3;
+  }
+  idlib_f32 scale = 0.f;
+  for (idlib_u32 i = 0; i < s->count; ++i) {
+    scale += dot(s->vertices[i].w, s->vertices[i].w);
+  }
+  if (1 == s->count) {
+    for (size_t i = 0; i < 6; ++i) {
+      vertex* w = &s->vertices[1];
+      core_support(w, shape1, shape2, axes[i]);
+      idlib_f32 d[3];
+      subtract(d, w->w, s->vertices[0].w);
+      if (dot(d, d) > 1e-12f * (scale + dot(w->w, w->w))) {
+        s->count = 2;
+        break;
+      }
+    }
+    if (1 == s->count) {
+      subtract(normal, shape2->center.e, shape1->center.e);
+      if (!normalize(normal)) {
+        normal[0] = 0.f;
+        normal[1] = 1.f;
+        normal[2] = 0.f;
+      }
+      return false;
+    }
+  }
+  if (2 == s->count) {
+    idlib_f32 u[3], d[4][3];
+    subtract(u, s->vertices[1].w, s->vertices[0].w);
+    normalize(u);
+    size_t j = fabsf(u[0]) < fabsf(u[1]) ? (fabsf(u[0]) < fabsf(u[2]) ? 0 : 2) : (fabsf(u[1]) < fabsf(u[2]) ? 1 : 2);
+    cross(d[0], u, axes[2 * j]);
+    cross(d[1], u, d[0]);
+    for (size_t k = 0; k < 3; ++k) {
+      d[2][k] = -d[0][k];
+      d[3][k] = -d[1][k];
+    }
+    for (size_t i = 0; i < 4; ++i) {
+      vertex* w = &s->vertices[2];
+      core_support(w, shape1, shape2, d[i]);
+      idlib_f32 e[3], f[3];
+      subtract(e, w->w, s->vertices[0].w);
+      cross(f, e, u);
+      if (dot(f, f) > 1e-12f * (scale + dot(w->w, w->w))) {
+        s->count = 3;
+        break;
+      }
+    }
+    if (2 == s->count) {
+      idlib_f32 t[3];
+      subtract(t, shape2->center.e, shape1->center.e);
+      idlib_f32 l = dot(t, u);
+      for (size_t k = 0; k < 3; ++k) {
+        normal[k] = t[k] - l * u[k];
+      }
+      if (!normalize(normal)) {
+        normal[0] = d[0][0];
+        normal[1] = d[0][1];
+        normal[2] = d[0][2];
+        normalize(normal);
+      }
+      return false;
+    }
+  }
+  idlib_f32 ab[3], ac[3], n[3];
+  subtract(ab, s->vertices[1].w, s->vertices[0].w);
+  subtract(ac, s->vertices[2].w, s->vertices[0].w);
+  cross(n, ab, ac);
+  normalize(n);
+  vertex w[2];
+  idlib_f32 m[3] = { -n[0], -n[1], -n[2] };
+  core_support(&w[0], shape1, shape2, n);
+  core_support(&w[1], shape1, shape2, m);
+  idlib_f32 e[2][3];
+  subtract(e[0], w[0].w, s->vertices[0].w);
+  subtract(e[1], w[1].w, s->vertices[0].w);
+  idlib_f32 h[2] = { fabsf(dot(e[0], n)), fabsf(dot(e[1], n)) };
+  size_t i = h[0] >= h[1] ? 0 : 1;
+  if (h[i] * h[i] > 1e-12f * (scale + dot(w[i].w, w[i].w))) {
+    s->vertices[3] = w[i];
+    s->count = 4;
+    return true;
+  }
+  idlib_f32 t[3];
+  subtract(t, shape2->center.e, shape1->center.e);
+  idlib_f32 sign = dot(t, n) < 0.f ? -1.f : 1.f;
+  for (size_t k = 0; k < 3; ++k) {
+    normal[k] = sign * n[k];
+  }
+  return false;
+}
+
+// Run EPA on the core shapes starting with a tetrahedron containing the origin.
+// Compute the penetration depth, the normal, and the witness points on the core shapes.
+// Return the number of iterations.
+static idlib_u32
+epa
+  (
+    idlib_gjk_result_3_f32* target,
+    simplex const* s,
+    idlib_convex_shape_3_f32 const* shape1,
+    idlib_convex_shape_3_f32 const* shape2
+  )
+{
+  vertex vertices[EPA_MAXIMUM_VERTICES];
+  face faces[EPA_MAXIMUM_FACES];
+  idlib_u32 edges[EPA_MAXIMUM_FACES][2];
+  idlib_u32 number_of_vertices = 4, number_of_faces = 4;
+  for (idlib_u32 i = 0; i < 4; ++i) {
+    vertices[i] = s->vertices[i];
+  }
+  // Orient the faces such that their normals point outwards.
+  {
+    idlib_f32 ab[3], ac[3], ad[3], n[3];
+    subtract(ab, vertices[1].w, vertices[0].w);
+    subtract(ac, vertices[2].w, vertices[0].w);
+    subtract(ad, vertices[3].w, vertices[0].w);
+    cross(n, ab, ac);
+    if (dot(n, ad) > 0.f) {
+      vertex t = vertices[1];
+      vertices[1] = vertices[2];
+      vertices[2] = t;
+    }
+  }
+  static idlib_u32 const initial[4][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+  idlib_f32 scale = 0.f;
+  for (idlib_u32 i = 0; i < 4; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      faces[i].vertices[k] = initial[i][k];
+    }
+    face_update(&faces[i], vertices);
+    idlib_f32 l = dot(vertices[i].w, vertices[i].w);
+    scale = l > scale ? l : scale;
+  }
+  scale = sqrtf(scale);
+  idlib_u32 iterations = 0;
+  idlib_u32 closest_face;
+  while (true) {
+    closest_face = 0;
+    for (idlib_u32 i = 1; i < number_of_faces; ++i) {
+      if (faces[i].distance < faces[closest_face].distance) {
+        closest_face = i;
+      }
+    }
+    face const* f = &faces[closest_face];
+    if (number_of_vertices == EPA_MAXIMUM_VERTICES) {
+      break;
+    }
+    vertex* w = &vertices[number_of_vertices];
+    core_support(w, shape1, shape2, f->normal);
+    if (dot(f->normal, w->w) - f->distance <= EPA_RELATIVE_EPSILON * scale) {
+      break;
+    }
+    // Determine the faces visible from the new vertex and the horizon, the boundary of the visible faces.
+    idlib_u32 number_of_edges = 0, number_of_visible_faces = 0;
+    bool overflow = false;
+    for (idlib_u32 i = 0; i < number_of_faces && !overflow; ++i) {
+      idlib_f32 d[3];
+      subtract(d, w->w, vertices[faces[i].vertices[0]].w);
+      if (dot(faces[i].normal, d) > 0.f) {
+        number_of_visible_faces++;
+        for (size_t k = 0; k < 3; ++k) {
+          idlib_u32 e0 = faces[i].vertices[k], e1 = faces[i].vertices[(k + 1) % 3];
+          idlib_u32 j = 0;
+          while (j < number_of_edges && !(edges[j][0] == e1 && edges[j][1] == e0)) {
+            j++;
+          }
+          if (j < number_of_edges) {
+            number_of_edges--;
+            edges[j][0] = edges[number_of_edges][0];
+            edges[j][1] = edges[number_of_edges][1];
+          } else if (number_of_edges == EPA_MAXIMUM_FACES) {
+            overflow = true;
+            break;
+          } else {
+            edges[number_of_edges][0] = e0;
+            edges[number_of_edges][1] = e1;
+            number_of_edges++;
+          }
+        }
+      }
+    }
+    if (overflow || 0 == number_of_visible_faces || number_of_faces - number_of_visible_faces + number_of_edges > EPA_MAXIMUM_FACES) {
+      break;
+    }
+    // Remove the visible faces and connect the horizon to the new vertex.
+    idlib_u32 n = 0;
+    for (idlib_u32 i = 0; i < number_of_faces; ++i) {
+      idlib_f32 d[3];
+      subtract(d, w->w, vertices[faces[i].vertices[0]].w);
+      if (!(dot(faces[i].normal, d) > 0.f)) {
+        faces[n++] = faces[i];
+      }
+    }
+    for (idlib_u32 i = 0; i < number_of_edges; ++i) {
+      face* g = &faces[n];
+      g->vertices[0] = edges[i][0];
+      g->vertices[1] = edges[i][1];
+      g->vertices[2] = number_of_vertices;
+      if (face_update(g, vertices)) {
+        n++;
+      }
+    }
+    number_of_faces = n;
+    idlib_f32 l = sqrtf(dot(w->w, w->w));
+    scale = l > scale ? l : scale;
+    number_of_vertices++;
+    iterations++;
+    if (0 == number_of_faces) {
+      break;
+    }
+  }
+  // Compute the barycentric coordinates of the projection of the origin onto the closest face.
+  face const* f = &faces[closest_face];
+  vertex const* a = &vertices[f->vertices[0]];
+  vertex const* b = &vertices[f->vertices[1]];
+  vertex const* c = &vertices[f->vertices[2]];
+  idlib_f32 p[3] = { f->normal[0] * f->distance, f->normal[1] * f->distance, f->normal[2] * f->distance };
+  idlib_f32 v0[3], v1[3], v2[3];
+  subtract(v0, b->w, a->w);
+  subtract(v1, c->w, a->w);
+  subtract(v2, p, a->w);
+  idlib_f32 d00 = dot(v0, v0), d01 = dot(v0, v1), d11 = dot(v1, v1), d20 = dot(v2, v0), d21 = dot(v2, v1);
+  idlib_f32 denominator = d00 * d11 - d01 * d01;
+  idlib_f32 lambda[3] = { 1.f, 0.f, 0.f };
+  if (denominator > 0.f) {
+    lambda[1] = (d11 * d20 - d01 * d21) / denominator;
+    lambda[2] = (d00 * d21 - d01 * d20) / denominator;
+    lambda[0] = 1.f - lambda[1] - lambda[2];
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    target->point1.e[k] = lambda[0] * a->a[k] + lambda[1] * b->a[k] + lambda[2] * c->a[k];
+    target->point2.e[k] = lambda[0] * a->b[k] + lambda[1] * b->b[k] + lambda[2] * c->b[k];
+    target->normal.e[k] = f->normal[k];
+  }
+  target->distance = -f->distance;
+  return iterations;
+}
+
+void
+idlib_convex_shape_3_f32_set_sphere
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_f32 radius
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != center);
+  target->kind = IDLIB_CONVEX_SHAPE_SPHERE;
+  target->center = *center;
+  idlib_matrix_3x3_f32_set_identity(&target->rotation);
+  idlib_vector_3_f32_set(&target->extents, 0.f, 0.f, 0.f);
+  target->radius = radius;
+  target->points = NULL;
+  target->number_of_points = 0;
+}
+
+void
+idlib_convex_shape_3_f32_set_box
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_matrix_3x3_f32 const* rotation,
+    idlib_vector_3_f32 const* extents
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != center);
+  IDLIB_DEBUG_ASSERT(NULL != rotation);
+  IDLIB_DEBUG_ASSERT(NULL != extents);
+  target->kind = IDLIB_CONVEX_SHAPE_BOX;
+  target->center = *center;
+  target->rotation = *rotation;
+  target->extents = *extents;
+  target->radius = 0.f;
+  target->points = NULL;
+  target->number_of_points = 0;
+}
+
+void
+idlib_convex_shape_3_f32_set_capsule
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_matrix_3x3_f32 const* rotation,
+    idlib_f32 half_height,
+    idlib_f32 radius
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != center);
+  IDLIB_DEBUG_ASSERT(NULL != rotation);
+  target->kind = IDLIB_CONVEX_SHAPE_CAPSULE;
+  target->center = *center;
+  target->rotation = *rotation;
+  idlib_vector_3_f32_set(&target->extents, 0.f, half_height, 0.f);
+  target->radius = radius;
+  target->points = NULL;
+  target->number_of_points = 0;
+}
+
+void
+idlib_convex_shape_3_f32_set_hull
+  (
+    idlib_convex_shape_3_f32* target,
+    idlib_vector_3_f32 const* center,
+    idlib_matrix_3x3_f32 const* rotation,
+    idlib_vector_3_f32 const* points,
+    idlib_u32 number_of_points
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != center);
+  IDLIB_DEBUG_ASSERT(NULL != rotation);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  IDLIB_DEBUG_ASSERT(number_of_points > 0);
+  target->kind = IDLIB_CONVEX_SHAPE_HULL;
+  target->center = *center;
+  target->rotation = *rotation;
+  idlib_vector_3_f32_set(&target->extents, 0.f, 0.f, 0.f);
+  target->radius = 0.f;
+  target->points = points;
+  target->number_of_points = number_of_points;
+}
+
+void
+idlib_convex_shape_3_f32_support
+  (
+    idlib_vector_3_f32* target,
+    idlib_convex_shape_3_f32 const* operand,
+    idlib_vector_3_f32 const* direction
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != direction);
+  idlib_f32 d[3], p[3], n[3] = { direction->e[0], direction->e[1], direction->e[2] };
+  to_local(d, operand, n);
+  core_support_local(p, operand, d);
+  to_world(target->e, operand, p);
+  if (normalize(n)) {
+    for (size_t k = 0; k < 3; ++k) {
+      target->e[k] += operand->radius * n[k];
+    }
+  }
+}
+
+void
+idlib_gjk_cache_3_f32_initialize
+  (
+    idlib_gjk_cache_3_f32* target
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  target->count = 0;
+}
+
+bool
+idlib_gjk_3_f32_intersect
+  (
+    idlib_gjk_cache_3_f32* cache,
+    idlib_convex_shape_3_f32 const* operand1,
+    idlib_convex_shape_3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  simplex s;
+  idlib_f32 v[3];
+  gjk_status status;
+  gjk(&status, &s, v, cache, operand1, operand2, operand1->radius + operand2->radius);
+  cache_store(cache, &s);
+  return GJK_STATUS_SEPARATED != status;
+}
+
+void
+idlib_gjk_3_f32_distance
+  (
+    idlib_gjk_result_3_f32* target,
+    idlib_gjk_cache_3_f32* cache,
+    idlib_convex_shape_3_f32 const* operand1,
+    idlib_convex_shape_3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  simplex s;
+  idlib_f32 v[3];
+  gjk_status status;
+  target->iterations = gjk(&status, &s, v, cache, operand1, operand2, -1.f);
+  cache_store(cache, &s);
+  idlib_f32 r1 = operand1->radius, r2 = operand2->radius;
+  if (GJK_STATUS_CONTACT != status) {
+    // The core shapes are separated: v is the vector from the closest point of the second to the closest point of the first core shape.
+    idlib_f32 l = sqrtf(dot(v, v));
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_f32 a = 0.f, b = 0.f;
+      for (idlib_u32 i = 0; i < s.count; ++i) {
+        a += s.lambda[i] * s.vertices[i].a[k];
+        b += s.lambda[i] * s.vertices[i].b[k];
+      }
+      target->normal.e[k] = -v[k] / l;
+      target->point1.e[k] = a + r1 * target->normal.e[k];
+      target->point2.e[k] = b - r2 * target->normal.e[k];
+    }
+    target->distance = l - r1 - r2;
+    return;
+  }
+  // The core shapes intersect.
+  idlib_f32 a[3] = { 0.f, 0.f, 0.f }, b[3] = { 0.f, 0.f, 0.f };
+  for (idlib_u32 i = 0; i < s.count; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      a[k] += s.lambda[i] * s.vertices[i].a[k];
+      b[k] += s.lambda[i] * s.vertices[i].b[k];
+    }
+  }
+  if (epa_initialize(&s, target->normal.e, operand1, operand2)) {
+    target->iterations += epa(target, &s, operand1, operand2);
+  } else {
+    // The Minkowski difference of the core shapes has no volume: Its penetration depth is zero.
+    idlib_vector_3_f32_set(&target->point1, a[0], a[1], a[2]);
+    idlib_vector_3_f32_set(&target->point2, b[0], b[1], b[2]);
+    target->distance = 0.f;
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    target->point1.e[k] += r1 * target->normal.e[k];
+    target->point2.e[k] -= r2 * target->normal.e[k];
+  }
+  target->distance -= r1 + r2;
+}
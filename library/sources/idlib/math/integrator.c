@@ -0,0 +1,447 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#include "idlib/math/integrator.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// INFINITY
+#include <math.h>
+
+// The number of particles advanced at once.
+#define LANES (4)
+
+// The integrators are implemented once on "lanes" of LANES values:
+// On SIMD capable architectures a lane is a SIMD register, otherwise it is an array processed element by element.
+// Both perform the same sequence of correctly rounded operations such that the results are the same.
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+typedef __m128 lane;
+
+typedef __m128 mask;
+
+static inline lane f_set(idlib_f32 x) { return _mm_set1_ps(x); }
+static inline lane f_load(idlib_f32 const* x) { return _mm_loadu_ps(x); }
+static inline void f_store(idlib_f32* target, lane x) { _mm_storeu_ps(target, x); }
+static inline lane f_add(lane x, lane y) { return _mm_add_ps(x, y); }
+static inline lane f_sub(lane x, lane y) { return _mm_sub_ps(x, y); }
+static inline lane f_mul(lane x, lane y) { return _mm_mul_ps(x, y); }
+static inline lane f_div(lane x, lane y) { return _mm_div_ps(x, y); }
+static inline lane f_min(lane x, lane y) { return _mm_min_ps(x, y); }
+static inline lane f_max(lane x, lane y) { return _mm_max_ps(x, y); }
+static inline mask f_not_equal(lane x, lane y) { return _mm_cmpneq_ps(x, y); }
+// Select x if c is true and y otherwise.
+static inline lane f_select(mask c, lane x, lane y) { return _mm_or_ps(_mm_and_ps(c, x), _mm_andnot_ps(c, y)); }
+
+#else
+
+typedef struct lane { idlib_f32 e[LANES]; } lane;
+
+typedef struct mask { bool e[LANES]; } mask;
+
+#define LANEWISE(TYPE, EXPRESSION) \
+  TYPE r; \
+  for (size_t l = 0; l < LANES; ++l) { \
+    r.e[l] = (EXPRESSION); \
+  } \
+  return r;
+
+static inline lane f_set(idlib_f32 x) { LANEWISE(lane, x) }
+static inline lane f_load(idlib_f32 const* x) { LANEWISE(lane, x[l]) }
+static inline void f_store(idlib_f32* target, lane x) { for (size_t l = 0; l < LANES; ++l) { target[l] = x.e[l]; } }
+static inline lane f_add(lane x, lane y) { LANEWISE(lane, x.e[l] + y.e[l]) }
+static inline lane f_sub(lane x, lane y) { LANEWISE(lane, x.e[l] - y.e[l]) }
+static inline lane f_mul(lane x, lane y) { LANEWISE(lane, x.e[l] * y.e[l]) }
+static inline lane f_div(lane x, lane y) { LANEWISE(lane, x.e[l] / y.e[l]) }
+// Returns y if x or y is NaN like the SIMD version.
+static inline lane f_min(lane x, lane y) { LANEWISE(lane, x.e[l] < y.e[l] ? x.e[l] : y.e[l]) }
+// Returns y if x or y is NaN like the SIMD version.
+static inline lane f_max(lane x, lane y) { LANEWISE(lane, x.e[l] > y.e[l] ? x.e[l] : y.e[l]) }
+static inline mask f_not_equal(lane x, lane y) { LANEWISE(mask, x.e[l] != y.e[l]) }
+// Select x if c is true and y otherwise.
+static inline lane f_select(mask c, lane x, lane y) { LANEWISE(lane, c.e[l] ? x.e[l] : y.e[l]) }
+
+#undef LANEWISE
+
+#endif
+
+// The constants of a step of a component.
+typedef struct constants {
+  // The time step h.
+  lane h;
+  // h / 2.
+  lane half_h;
+  // h / 6.
+  lane sixth_h;
+  // h^2.
+  lane h_h;
+  // The damping k.
+  lane k;
+  // 1 - k h.
+  lane retention;
+  // Zero.
+  lane zero;
+  // The component of the gravity.
+  lane gravity;
+  // The components of the minimum and the maximum of the bounds.
+  lane minimum, maximum;
+  // If the positions are clamped.
+  bool clamp;
+} constants;
+
+// The derivative a - k v of the velocity.
+static inline lane
+derivative
+  (
+    constants const* c,
+    lane a,
+    lane v
+  )
+{ return f_sub(a, f_mul(c->k, v)); }
+
+// Clamp the positions x1 to the bounds.
+// The velocities v1 of the clamped positions are set to zero and the previous positions p1 to the clamped positions.
+static inline void
+clamp
+  (
+    constants const* c,
+    lane* x1,
+    lane* v1,
+    lane* p1
+  )
+{
+  lane y = f_min(f_max(*x1, c->minimum), c->maximum);
+  mask clamped = f_not_equal(y, *x1);
+  *v1 = f_select(clamped, c->zero, *v1);
+  // For the Verlet method, the velocity is zero if the previous position is the position.
+  *p1 = f_select(clamped, y, *p1);
+  *x1 = y;
+}
+
+// Advance a component of the particles [i, i + LANES).
+// The streams x, v, p, and a are the positions, velocities, previous positions, and accelerations.
+// The streams v, p, and a may be null pointers if they are not required by the method.
+static inline void
+step
+  (
+    idlib_u32 method,
+    constants const* c,
+    idlib_f32* x_stream,
+    idlib_f32* v_stream,
+    idlib_f32* p_stream,
+    idlib_f32 const* a_stream,
+    size_t i
+  )
+{
+  lane x = f_load(x_stream + i), x1, v1, p1 = c->zero;
+  lane a = c->gravity;
+  if (a_stream) {
+    a = f_add(f_load(a_stream + i), a);
+  }
+  switch (method) {
+    case IDLIB_INTEGRATOR_EXPLICIT_EULER: {
+      lane v = f_load(v_stream + i);
+      x1 = f_add(x, f_mul(c->h, v));
+      v1 = f_add(v, f_mul(c->h, derivative(c, a, v)));
+    } break;
+    case IDLIB_INTEGRATOR_SYMPLECTIC_EULER:
+    default: {
+      lane v = f_load(v_stream + i);
+      v1 = f_add(v, f_mul(c->h, derivative(c, a, v)));
+      x1 = f_add(x, f_mul(c->h, v1));
+    } break;
+    case IDLIB_INTEGRATOR_VERLET: {
+      lane p = f_load(p_stream + i);
+      // x + (x - p) (1 - k h) + a h^2
+      x1 = f_add(f_add(x, f_mul(f_sub(x, p), c->retention)), f_mul(a, c->h_h));
+      v1 = f_div(f_sub(x1, x), c->h);
+      p1 = x;
+    } break;
+  };
+  if (c->clamp) {
+    clamp(c, &x1, &v1, &p1);
+  }
+  f_store(x_stream + i, x1);
+  if (v_stream) {
+    f_store(v_stream + i, v1);
+  }
+  if (IDLIB_INTEGRATOR_VERLET == method) {
+    f_store(p_stream + i, p1);
+  }
+}
+
+// Advance a component of the particles [first, first + count).
+// See step for the streams.
+static void
+advance
+  (
+    idlib_u32 method,
+    constants const* c,
+    idlib_f32* x_stream,
+    idlib_f32* v_stream,
+    idlib_f32* p_stream,
+    idlib_f32 const* a_stream,
+    size_t first,
+    size_t count
+  )
+{
+  size_t i = first, n = first + count;
+  for (; n - i >= LANES; i += LANES) {
+    step(method, c, x_stream, v_stream, p_stream, a_stream, i);
+  }
+  if (i < n) {
+    // Advance the remaining particles in streams padded to LANES particles.
+    idlib_f32 x[LANES] = { 0.f }, v[LANES] = { 0.f }, p[LANES] = { 0.f }, a[LANES] = { 0.f };
+    for (size_t l = 0; l < n - i; ++l) {
+      x[l] = x_stream[i + l];
+      v[l] = v_stream ? v_stream[i + l] : 0.f;
+      p[l] = p_stream ? p_stream[i + l] : 0.f;
+      a[l] = a_stream ? a_stream[i + l] : 0.f;
+    }
+    step(method, c, x, v_stream ? v : NULL, p_stream ? p : NULL, a, 0);
+    for (size_t l = 0; l < n - i; ++l) {
+      x_stream[i + l] = x[l];
+      if (v_stream) {
+        v_stream[i + l] = v[l];
+      }
+      if (p_stream) {
+        p_stream[i + l] = p[l];
+      }
+    }
+  }
+}
+
+// Compute the stage s of the Runge-Kutta method of a component of the particles [i, i + LANES).
+// The streams x and v are the positions and velocities at the beginning of the step, a are the accelerations at the stage or a null pointer.
+// The streams sx and sv are the positions and velocities of the stage, dx and dv are the weighted sums of the derivatives of the previous stages.
+static inline void
+compute_stage
+  (
+    idlib_u32 s,
+    constants const* c,
+    idlib_f32* x_stream,
+    idlib_f32* v_stream,
+    idlib_f32 const* a_stream,
+    idlib_f32* sx_stream,
+    idlib_f32* sv_stream,
+    idlib_f32* dx_stream,
+    idlib_f32* dv_stream,
+    size_t i
+  )
+{
+  lane x = f_load(x_stream + i), v = f_load(v_stream + i);
+  lane a = c->gravity;
+  if (a_stream) {
+    a = f_add(f_load(a_stream + i), a);
+  }
+  // The derivatives of the position and the velocity at the stage.
+  lane kx = 0 == s ? v : f_load(sv_stream + i);
+  lane kv = derivative(c, a, kx);
+  if (0 == s) {
+    f_store(dx_stream + i, kx);
+    f_store(dv_stream + i, kv);
+  } else if (s < 3) {
+    f_store(dx_stream + i, f_add(f_load(dx_stream + i), f_add(kx, kx)));
+    f_store(dv_stream + i, f_add(f_load(dv_stream + i), f_add(kv, kv)));
+  } else {
+    // x + h/6 (k1 + 2 k2 + 2 k3 + k4)
+    lane x1 = f_add(x, f_mul(c->sixth_h, f_add(f_load(dx_stream + i), kx)));
+    lane v1 = f_add(v, f_mul(c->sixth_h, f_add(f_load(dv_stream + i), kv)));
+    if (c->clamp) {
+      lane p1 = c->zero;
+      clamp(c, &x1, &v1, &p1);
+    }
+    f_store(x_stream + i, x1);
+    f_store(v_stream + i, v1);
+    return;
+  }
+  // The stages 0 and 1 advance by half a step, the stage 2 by a full step.
+  lane h = s < 2 ? c->half_h : c->h;
+  f_store(sx_stream + i, f_add(x, f_mul(h, kx)));
+  f_store(sv_stream + i, f_add(v, f_mul(h, kv)));
+}
+
+// Compute the stage s of the Runge-Kutta method of a component of the particles [first, first + count).
+// See compute_stage for the streams.
+static void
+advance_stage
+  (
+    idlib_u32 s,
+    constants const* c,
+    idlib_f32* x_stream,
+    idlib_f32* v_stream,
+    idlib_f32 const* a_stream,
+    idlib_f32* sx_stream,
+    idlib_f32* sv_stream,
+    idlib_f32* dx_stream,
+    idlib_f32* dv_stream,
+    size_t first,
+    size_t count
+  )
+{
+  size_t i = first, n = first + count;
+  for (; n - i >= LANES; i += LANES) {
+    compute_stage(s, c, x_stream, v_stream, a_stream, sx_stream, sv_stream, dx_stream, dv_stream, i);
+  }
+  if (i < n) {
+    // Compute the stage of the remaining particles in streams padded to LANES particles.
+    idlib_f32 x[LANES] = { 0.f }, v[LANES] = { 0.f }, a[LANES] = { 0.f }, sx[LANES] = { 0.f }, sv[LANES] = { 0.f }, dx[LANES] = { 0.f }, dv[LANES] = { 0.f };
+    for (size_t l = 0; l < n - i; ++l) {
+      x[l] = x_stream[i + l];
+      v[l] = v_stream[i + l];
+      a[l] = a_stream ? a_stream[i + l] : 0.f;
+      // The velocities of the stage and the sums of the derivatives are not read by the stage 0.
+      sv[l] = s > 0 ? sv_stream[i + l] : 0.f;
+      dx[l] = s > 0 ? dx_stream[i + l] : 0.f;
+      dv[l] = s > 0 ? dv_stream[i + l] : 0.f;
+    }
+    compute_stage(s, c, x, v, a, sx, sv, dx, dv, 0);
+    for (size_t l = 0; l < n - i; ++l) {
+      x_stream[i + l] = x[l];
+      v_stream[i + l] = v[l];
+      sx_stream[i + l] = sx[l];
+      sv_stream[i + l] = sv[l];
+      dx_stream[i + l] = dx[l];
+      dv_stream[i + l] = dv[l];
+    }
+  }
+}
+
+// Initialize the constants of a step which do not depend on the component.
+static void
+constants_initialize
+  (
+    constants* target,
+    idlib_integrator_f32 const* integrator,
+    idlib_f32 time_step
+  )
+{
+  target->h = f_set(time_step);
+  target->half_h = f_set(time_step * 0.5f);
+  target->sixth_h = f_set(time_step / 6.f);
+  target->h_h = f_set(time_step * time_step);
+  target->k = f_set(integrator->damping);
+  target->retention = f_set(1.f - integrator->damping * time_step);
+  target->zero = f_set(0.f);
+  target->clamp = integrator->clamp;
+}
+
+// Initialize the constants of a step which depend on the component s.
+static void
+constants_set_component
+  (
+    constants* target,
+    idlib_integrator_f32 const* integrator,
+    size_t s
+  )
+{
+  target->gravity = f_set(integrator->gravity.e[s]);
+  target->minimum = f_set(integrator->bounds.minimum.e[s]);
+  target->maximum = f_set(integrator->bounds.maximum.e[s]);
+}
+
+void
+idlib_integrator_f32_set
+  (
+    idlib_integrator_f32* target,
+    idlib_u32 method
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(method <= IDLIB_INTEGRATOR_RUNGE_KUTTA_4);
+  target->method = method;
+  target->damping = 0.f;
+  idlib_vector_3_f32_set_zero(&target->gravity);
+  target->clamp = false;
+  idlib_vector_3_f32_set(&target->bounds.minimum, -INFINITY, -INFINITY, -INFINITY);
+  idlib_vector_3_f32_set(&target->bounds.maximum, INFINITY, INFINITY, INFINITY);
+}
+
+void
+idlib_integrator_f32_step_n
+  (
+    idlib_particles_3_f32 const* target,
+    idlib_integrator_f32 const* integrator,
+    idlib_f32 time_step,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != integrator);
+  IDLIB_DEBUG_ASSERT(time_step > 0.f);
+  IDLIB_DEBUG_ASSERT(IDLIB_INTEGRATOR_RUNGE_KUTTA_4 != integrator->method);
+  IDLIB_DEBUG_ASSERT(NULL != target->positions.x);
+  IDLIB_DEBUG_ASSERT(IDLIB_INTEGRATOR_VERLET == integrator->method ? NULL != target->previous_positions.x : NULL != target->velocities.x);
+  idlib_f32* const x_streams[] = { target->positions.x, target->positions.y, target->positions.z };
+  idlib_f32* const v_streams[] = { target->velocities.x, target->velocities.y, target->velocities.z };
+  idlib_f32* const p_streams[] = { target->previous_positions.x, target->previous_positions.y, target->previous_positions.z };
+  idlib_f32 const* const a_streams[] = { target->accelerations.x, target->accelerations.y, target->accelerations.z };
+  idlib_u32 method = integrator->method;
+  constants c;
+  constants_initialize(&c, integrator, time_step);
+  // The components are independent of each other.
+  // Advancing them one after another traverses each stream once and keeps the constants of a component out of the loop.
+  for (size_t s = 0; s < 3; ++s) {
+    constants_set_component(&c, integrator, s);
+    advance(method, &c, x_streams[s], v_streams[s], IDLIB_INTEGRATOR_VERLET == method ? p_streams[s] : NULL, a_streams[s], first, count);
+  }
+}
+
+void
+idlib_integrator_f32_runge_kutta_4_stage_n
+  (
+    idlib_particles_3_f32 const* target,
+    idlib_runge_kutta_4_stages_3_f32 const* stages,
+    idlib_integrator_f32 const* integrator,
+    idlib_f32 time_step,
+    idlib_u32 stage,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != stages);
+  IDLIB_DEBUG_ASSERT(NULL != integrator);
+  IDLIB_DEBUG_ASSERT(IDLIB_INTEGRATOR_RUNGE_KUTTA_4 == integrator->method);
+  IDLIB_DEBUG_ASSERT(time_step > 0.f);
+  IDLIB_DEBUG_ASSERT(stage < IDLIB_INTEGRATOR_RUNGE_KUTTA_4_STAGES);
+  IDLIB_DEBUG_ASSERT(NULL != target->positions.x && NULL != target->velocities.x);
+  idlib_f32* const x_streams[] = { target->positions.x, target->positions.y, target->positions.z };
+  idlib_f32* const v_streams[] = { target->velocities.x, target->velocities.y, target->velocities.z };
+  idlib_f32 const* const a_streams[] = { target->accelerations.x, target->accelerations.y, target->accelerations.z };
+  idlib_f32* const sx_streams[] = { stages->positions.x, stages->positions.y, stages->positions.z };
+  idlib_f32* const sv_streams[] = { stages->velocities.x, stages->velocities.y, stages->velocities.z };
+  idlib_f32* const dx_streams[] = { stages->position_derivatives.x, stages->position_derivatives.y, stages->position_derivatives.z };
+  idlib_f32* const dv_streams[] = { stages->velocity_derivatives.x, stages->velocity_derivatives.y, stages->velocity_derivatives.z };
+  constants c;
+  constants_initialize(&c, integrator, time_step);
+  for (size_t s = 0; s < 3; ++s) {
+    constants_set_component(&c, integrator, s);
+    advance_stage(stage, &c, x_streams[s], v_streams[s], a_streams[s], sx_streams[s], sv_streams[s], dx_streams[s], dv_streams[s], first, count);
+  }
+}
@@ -0,0 +1,682 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/kd_tree.h"
+
+// INFINITY
+#include <math.h>
+// int64_t, uintptr_t
+#include <stdint.h>
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// The coordinate arrays have three elements beyond the last point such that four positions can be loaded at once from any position of a point.
+#define PADDING (3)
+
+// The maximum depth of the stack of ranges to visit.
+// A range is pushed for each level of the tree and the tree has at most 32 levels.
+#define STACK_SIZE (64)
+
+// The number of elements of a coordinate array.
+static size_t
+get_stride
+  (
+    idlib_u32 capacity
+  )
+{ return ((size_t)capacity + PADDING + 3) & ~(size_t)3; }
+
+size_t
+idlib_kd_tree_get_workspace_size
+  (
+    idlib_u32 capacity
+  )
+{ return 3 * get_stride(capacity) * sizeof(idlib_f32) + (size_t)capacity * (sizeof(idlib_u32) + sizeof(idlib_u8)); }
+
+void
+idlib_kd_tree_initialize
+  (
+    idlib_kd_tree* target,
+    idlib_u32 capacity,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  IDLIB_DEBUG_ASSERT(0 == ((uintptr_t)workspace & 15));
+  size_t stride = get_stride(capacity);
+  idlib_f32* p = (idlib_f32*)workspace;
+  for (size_t k = 0; k < 3; ++k) {
+    target->coordinates[k] = p; p += stride;
+  }
+  target->indices = (idlib_u32*)p;
+  target->dimensions = (idlib_u8*)(target->indices + capacity);
+  target->number_of_points = 0;
+  target->capacity = capacity;
+  target->number_of_dimensions = 3;
+  target->number_of_levels = 0;
+}
+
+// Swap the points at two positions.
+static inline void
+swap
+  (
+    idlib_kd_tree* target,
+    idlib_u32 number_of_dimensions,
+    idlib_u32 i,
+    idlib_u32 j
+  )
+{
+  idlib_u32 t = target->indices[i];
+  target->indices[i] = target->indices[j];
+  target->indices[j] = t;
+  for (idlib_u32 k = 0; k < number_of_dimensions; ++k) {
+    idlib_f32 u = target->coordinates[k][i];
+    target->coordinates[k][i] = target->coordinates[k][j];
+    target->coordinates[k][j] = u;
+  }
+}
+
+// Reorder the points at the positions [first, last) such that the point at the m-th position is the point which would be there if they were sorted by their coordinates in the specified dimension,
+// the coordinates of the points before it are not greater and the coordinates of the points after it are not less.
+// Hoare's FIND (quickselect) with the median of three pivot: Points equal to the pivot are swapped such that equal coordinates do not degrade it.
+static void
+select_median
+  (
+    idlib_kd_tree* target,
+    idlib_u32 number_of_dimensions,
+    idlib_u32 dimension,
+    idlib_u32 first,
+    idlib_u32 last,
+    idlib_u32 m
+  )
+{
+  idlib_f32 const* keys = target->coordinates[dimension];
+  // The positions [l, r].
+  idlib_u32 l = first, r = last - 1;
+  while (l < r) {
+    idlib_f32 a = keys[l], b = keys[l + (r - l) / 2], c = keys[r];
+    idlib_f32 pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+    // The pivot is in the range such that the scans stop. i and j are signed as j may precede l.
+    int64_t i = l, j = r;
+    do {
+      while (keys[i] < pivot) {
+        i++;
+      }
+      while (pivot < keys[j]) {
+        j--;
+      }
+      if (i <= j) {
+        swap(target, number_of_dimensions, (idlib_u32)i, (idlib_u32)j);
+        i++;
+        j--;
+      }
+    } while (i <= j);
+    // The points at [l, j] are not greater than the pivot, those at [i, r] are not less, and those in between are equal to the pivot.
+    if ((int64_t)m <= j) {
+      r = (idlib_u32)j;
+    } else if ((int64_t)m >= i) {
+      l = (idlib_u32)i;
+    } else {
+      return;
+    }
+  }
+}
+
+// Split the range [first, last) at its median position. Return the position.
+static idlib_u32
+split
+  (
+    idlib_kd_tree* target,
+    idlib_u32 first,
+    idlib_u32 last
+  )
+{
+  idlib_u32 number_of_dimensions = target->number_of_dimensions;
+  // The dimension in which the points have the largest extent.
+  idlib_u32 dimension = 0;
+  idlib_f32 extent = -1.f;
+  for (idlib_u32 k = 0; k < number_of_dimensions; ++k) {
+    idlib_f32 const* x = target->coordinates[k];
+    idlib_f32 minimum = x[first], maximum = x[first];
+    for (idlib_u32 i = first + 1; i < last; ++i) {
+      minimum = x[i] < minimum ? x[i] : minimum;
+      maximum = x[i] > maximum ? x[i] : maximum;
+    }
+    if (maximum - minimum > extent) {
+      extent = maximum - minimum;
+      dimension = k;
+    }
+  }
+  idlib_u32 m = first + (last - first) / 2;
+  select_median(target, number_of_dimensions, dimension, first, last, m);
+  target->dimensions[m] = (idlib_u8)dimension;
+  return m;
+}
+
+// Split the ranges of the subtree of the range [first, last) down to the specified number of levels.
+static void
+build_levels
+  (
+    idlib_kd_tree* target,
+    idlib_u32 first,
+    idlib_u32 last,
+    idlib_u32 number_of_levels
+  )
+{
+  while (number_of_levels && last - first > IDLIB_KD_TREE_LEAF_SIZE) {
+    idlib_u32 m = split(target, first, last);
+    number_of_levels--;
+    build_levels(target, first, m, number_of_levels);
+    first = m + 1;
+  }
+}
+
+static void
+build_top
+  (
+    idlib_kd_tree* target,
+    idlib_f32 const* const* source,
+    idlib_u32 number_of_dimensions,
+    idlib_u32 number_of_points,
+    idlib_u32 number_of_levels
+  )
+{
+  IDLIB_DEBUG_ASSERT(number_of_points <= target->capacity);
+  IDLIB_DEBUG_ASSERT(number_of_levels < 32);
+  target->number_of_points = number_of_points;
+  target->number_of_dimensions = number_of_dimensions;
+  target->number_of_levels = number_of_levels;
+  for (idlib_u32 i = 0; i < number_of_points; ++i) {
+    target->indices[i] = i;
+  }
+  for (idlib_u32 k = 0; k < 3; ++k) {
+    for (idlib_u32 i = 0; i < number_of_points; ++i) {
+      target->coordinates[k][i] = k < number_of_dimensions ? source[k][i] : 0.f;
+    }
+    for (idlib_u32 i = number_of_points; i < number_of_points + PADDING; ++i) {
+      target->coordinates[k][i] = 0.f;
+    }
+  }
+  build_levels(target, 0, number_of_points, number_of_levels);
+}
+
+void
+idlib_kd_tree_build_subtree
+  (
+    idlib_kd_tree* target,
+    idlib_u32 subtree
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  idlib_u32 number_of_levels = target->number_of_levels;
+  IDLIB_DEBUG_ASSERT(subtree < ((idlib_u32)1 << number_of_levels));
+  idlib_u32 first = 0, last = target->number_of_points;
+  for (idlib_u32 d = 0; d < number_of_levels; ++d) {
+    idlib_u32 bit = number_of_levels - 1 - d;
+    if (last - first <= IDLIB_KD_TREE_LEAF_SIZE) {
+      // The leaf belongs to the subtree with the remaining bits zero.
+      if (subtree & (((idlib_u32)1 << (bit + 1)) - 1)) {
+        return;
+      }
+      break;
+    }
+    idlib_u32 m = first + (last - first) / 2;
+    if (subtree & ((idlib_u32)1 << bit)) {
+      first = m + 1;
+    } else {
+      last = m;
+    }
+  }
+  build_levels(target, first, last, 32);
+}
+
+// The k nearest points found so far in ascending order of their squared distances.
+typedef struct nearest {
+  idlib_u32* indices;
+  idlib_f32* distances;
+  idlib_u32 k;
+  idlib_u32 count;
+} nearest;
+
+// Insert a point unless the k nearest points found so far are all nearer.
+static inline void
+insert
+  (
+    nearest* target,
+    idlib_u32 index,
+    idlib_f32 distance
+  )
+{
+  idlib_u32 i = target->count;
+  if (i == target->k) {
+    if (!(distance < target->distances[i - 1])) {
+      return;
+    }
+    i--;
+  } else {
+    target->count++;
+  }
+  for (; i > 0 && target->distances[i - 1] > distance; --i) {
+    target->indices[i] = target->indices[i - 1];
+    target->distances[i] = target->distances[i - 1];
+  }
+  target->indices[i] = index;
+  target->distances[i] = distance;
+}
+
+// Compute the squared distance of the point at the j-th position to the query point.
+static inline idlib_f32
+distance_1
+  (
+    idlib_kd_tree const* operand,
+    idlib_f32 const* q,
+    idlib_u32 number_of_dimensions,
+    idlib_u32 j
+  )
+{
+  idlib_f32 dx = operand->coordinates[0][j] - q[0], dy = operand->coordinates[1][j] - q[1];
+  idlib_f32 distance = dx * dx + dy * dy;
+  if (3 == number_of_dimensions) {
+    idlib_f32 dz = operand->coordinates[2][j] - q[2];
+    distance = distance + dz * dz;
+  }
+  return distance;
+}
+
+// Compute the squared distances of the points at the positions [j, j + 4) to the query point.
+static inline void
+distance_4
+  (
+    idlib_f32 distances[4],
+    idlib_kd_tree const* operand,
+    idlib_f32 const* q,
+    idlib_u32 number_of_dimensions,
+    idlib_u32 j
+  )
+{
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 dx = _mm_sub_ps(_mm_loadu_ps(operand->coordinates[0] + j), _mm_set1_ps(q[0]));
+  __m128 dy = _mm_sub_ps(_mm_loadu_ps(operand->coordinates[1] + j), _mm_set1_ps(q[1]));
+  __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+  if (3 == number_of_dimensions) {
+    __m128 dz = _mm_sub_ps(_mm_loadu_ps(operand->coordinates[2] + j), _mm_set1_ps(q[2]));
+    distance = _mm_add_ps(distance, _mm_mul_ps(dz, dz));
+  }
+  _mm_storeu_ps(distances, distance);
+#else
+  for (idlib_u32 l = 0; l < 4; ++l) {
+    distances[l] = distance_1(operand, q, number_of_dimensions, j + l);
+  }
+#endif
+}
+
+// A range to visit and a lower bound of the squared distance of its points to the query point.
+// The bound is the squared length of the offsets of the query point from the splitting planes bounding the range (Arya and Mount: "Algorithms for fast vector quantization").
+typedef struct range {
+  idlib_u32 first, last;
+  idlib_f32 distance;
+  idlib_f32 offsets[3];
+} range;
+
+static inline idlib_u32
+query_nearest
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_f32 const* q,
+    idlib_u32 number_of_dimensions,
+    idlib_u32 k,
+    idlib_f32 epsilon
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == k);
+  IDLIB_DEBUG_ASSERT(NULL != distances || 0 == k);
+  IDLIB_DEBUG_ASSERT(epsilon >= 0.f);
+  IDLIB_DEBUG_ASSERT(operand->number_of_dimensions == number_of_dimensions);
+  nearest result = { target, distances, k, 0 };
+  // A range is skipped if its distance times 1 + epsilon is not less than the distance of the k-th nearest point found so far.
+  idlib_f32 scale = (1.f + epsilon) * (1.f + epsilon);
+  range stack[STACK_SIZE];
+  idlib_u32 size = 0;
+  if (k && operand->number_of_points) {
+    stack[size++] = (range){ 0, operand->number_of_points, 0.f, { 0.f, 0.f, 0.f } };
+  }
+  IDLIB_ALIGNAS(16) idlib_f32 d[4];
+  while (size) {
+    range r = stack[--size];
+    if (result.count == k && r.distance * scale >= result.distances[k - 1]) {
+      continue;
+    }
+    // Descend to the leaf on the side of the query point, pushing the ranges on the other side.
+    while (r.last - r.first > IDLIB_KD_TREE_LEAF_SIZE) {
+      idlib_u32 m = r.first + (r.last - r.first) / 2;
+      idlib_u32 dimension = operand->dimensions[m];
+      idlib_f32 difference = q[dimension] - operand->coordinates[dimension][m];
+      insert(&result, operand->indices[m], distance_1(operand, q, number_of_dimensions, m));
+      IDLIB_DEBUG_ASSERT(size < STACK_SIZE);
+      range* other = &stack[size++];
+      *other = r;
+      other->distance = r.distance - r.offsets[dimension] * r.offsets[dimension] + difference * difference;
+      other->offsets[dimension] = difference;
+      if (difference < 0.f) {
+        other->first = m + 1;
+        r.last = m;
+      } else {
+        other->last = m;
+        r.first = m + 1;
+      }
+    }
+    for (idlib_u32 j = r.first; j < r.last; j += 4) {
+      distance_4(d, operand, q, number_of_dimensions, j);
+      idlib_u32 n = r.last - j < 4 ? r.last - j : 4;
+      for (idlib_u32 l = 0; l < n; ++l) {
+        insert(&result, operand->indices[j + l], d[l]);
+      }
+    }
+  }
+  for (idlib_u32 i = result.count; i < k; ++i) {
+    target[i] = IDLIB_KD_TREE_NONE;
+    distances[i] = INFINITY;
+  }
+  return result.count;
+}
+
+static inline size_t
+query_radius
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_f32 const* q,
+    idlib_u32 number_of_dimensions,
+    idlib_f32 radius
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == capacity);
+  IDLIB_DEBUG_ASSERT(radius >= 0.f);
+  IDLIB_DEBUG_ASSERT(operand->number_of_dimensions == number_of_dimensions);
+  idlib_f32 squared_radius = radius * radius;
+  size_t number_of_points = 0;
+  range stack[STACK_SIZE];
+  idlib_u32 size = 0;
+  if (operand->number_of_points) {
+    stack[size++] = (range){ 0, operand->number_of_points, 0.f, { 0.f, 0.f, 0.f } };
+  }
+  IDLIB_ALIGNAS(16) idlib_f32 d[4];
+  while (size) {
+    range r = stack[--size];
+    while (r.last - r.first > IDLIB_KD_TREE_LEAF_SIZE) {
+      idlib_u32 m = r.first + (r.last - r.first) / 2;
+      idlib_u32 dimension = operand->dimensions[m];
+      idlib_f32 difference = q[dimension] - operand->coordinates[dimension][m];
+      if (distance_1(operand, q, number_of_dimensions, m) <= squared_radius) {
+        if (number_of_points < capacity) {
+          target[number_of_points] = operand->indices[m];
+        }
+        number_of_points++;
+      }
+      // The range on the other side is visited only if the splitting plane is within the radius.
+      bool other = difference * difference <= squared_radius;
+      IDLIB_DEBUG_ASSERT(size < STACK_SIZE);
+      if (difference < 0.f) {
+        if (other) {
+          stack[size++] = (range){ m + 1, r.last, 0.f, { 0.f, 0.f, 0.f } };
+        }
+        r.last = m;
+      } else {
+        if (other) {
+          stack[size++] = (range){ r.first, m, 0.f, { 0.f, 0.f, 0.f } };
+        }
+        r.first = m + 1;
+      }
+    }
+    for (idlib_u32 j = r.first; j < r.last; j += 4) {
+      distance_4(d, operand, q, number_of_dimensions, j);
+      idlib_u32 n = r.last - j < 4 ? r.last - j : 4;
+      for (idlib_u32 l = 0; l < n; ++l) {
+        if (d[l] <= squared_radius) {
+          if (number_of_points < capacity) {
+            target[number_of_points] = operand->indices[j + l];
+          }
+          number_of_points++;
+        }
+      }
+    }
+  }
+  return number_of_points;
+}
+
+void
+idlib_kd_tree_3_f32_build
+  (
+    idlib_kd_tree* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points
+  )
+{
+  idlib_kd_tree_3_f32_build_top(target, operand, number_of_points, 0);
+  idlib_kd_tree_build_subtree(target, 0);
+}
+
+void
+idlib_kd_tree_3_f32_build_top
+  (
+    idlib_kd_tree* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_u32 number_of_levels
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  idlib_f32 const* source[3] = { operand->x, operand->y, operand->z };
+  build_top(target, source, 3, number_of_points, number_of_levels);
+}
+
+idlib_u32
+idlib_kd_tree_3_f32_query_nearest
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_u32 k,
+    idlib_f32 epsilon
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  return query_nearest(target, distances, operand, point->e, 3, k, epsilon);
+}
+
+void
+idlib_kd_tree_3_f32_query_nearest_n
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_u32 k,
+    idlib_f32 epsilon,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  for (size_t i = 0; i < count; ++i) {
+    idlib_f32 q[3] = { points->x[first + i], points->y[first + i], points->z[first + i] };
+    query_nearest(target + i * k, distances + i * k, operand, q, 3, k, epsilon);
+  }
+}
+
+size_t
+idlib_kd_tree_3_f32_query_radius
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_f32 radius
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  return query_radius(target, capacity, operand, point->e, 3, radius);
+}
+
+size_t
+idlib_kd_tree_3_f32_query_radius_n
+  (
+    size_t* offsets,
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_f32 radius,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != offsets);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  size_t number_of_points = 0;
+  for (size_t i = 0; i < count; ++i) {
+    idlib_f32 q[3] = { points->x[first + i], points->y[first + i], points->z[first + i] };
+    offsets[i] = number_of_points;
+    size_t remaining = number_of_points < capacity ? capacity - number_of_points : 0;
+    number_of_points += query_radius(remaining ? target + number_of_points : NULL, remaining, operand, q, 3, radius);
+  }
+  offsets[count] = number_of_points;
+  return number_of_points;
+}
+
+void
+idlib_kd_tree_2_f32_build
+  (
+    idlib_kd_tree* target,
+    idlib_vector_2_f32_soa const* operand,
+    idlib_u32 number_of_points
+  )
+{
+  idlib_kd_tree_2_f32_build_top(target, operand, number_of_points, 0);
+  idlib_kd_tree_build_subtree(target, 0);
+}
+
+void
+idlib_kd_tree_2_f32_build_top
+  (
+    idlib_kd_tree* target,
+    idlib_vector_2_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_u32 number_of_levels
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  idlib_f32 const* source[3] = { operand->x, operand->y, NULL };
+  build_top(target, source, 2, number_of_points, number_of_levels);
+}
+
+idlib_u32
+idlib_kd_tree_2_f32_query_nearest
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32 const* point,
+    idlib_u32 k,
+    idlib_f32 epsilon
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  return query_nearest(target, distances, operand, point->e, 2, k, epsilon);
+}
+
+void
+idlib_kd_tree_2_f32_query_nearest_n
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32_soa const* points,
+    idlib_u32 k,
+    idlib_f32 epsilon,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  for (size_t i = 0; i < count; ++i) {
+    idlib_f32 q[2] = { points->x[first + i], points->y[first + i] };
+    query_nearest(target + i * k, distances + i * k, operand, q, 2, k, epsilon);
+  }
+}
+
+size_t
+idlib_kd_tree_2_f32_query_radius
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32 const* point,
+    idlib_f32 radius
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  return query_radius(target, capacity, operand, point->e, 2, radius);
+}
+
+size_t
+idlib_kd_tree_2_f32_query_radius_n
+  (
+    size_t* offsets,
+    idlib_u32* target,
+    size_t capacity,
+    idlib_kd_tree const* operand,
+    idlib_vector_2_f32_soa const* points,
+    idlib_f32 radius,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != offsets);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  size_t number_of_points = 0;
+  for (size_t i = 0; i < count; ++i) {
+    idlib_f32 q[2] = { points->x[first + i], points->y[first + i] };
+    offsets[i] = number_of_points;
+    size_t remaining = number_of_points < capacity ? capacity - number_of_points : 0;
+    number_of_points += query_radius(remaining ? target + number_of_points : NULL, remaining, operand, q, 2, radius);
+  }
+  offsets[count] = number_of_points;
+  return number_of_points;
+}
@@ -0,0 +1,660 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/matrix_3x3.h"
+
+// sqrtf, fabsf, copysignf
+#include <math.h>
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// The decompositions are written once in terms of "lanes" and "masks".
+// On SIMD capable architectures, a lane holds eight values and eight matrices are decomposed at once.
+// Otherwise, a lane holds one value.
+// Each lane performs the same sequence of IEEE operations, hence the results do not depend on the position of a matrix in a stream.
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+#define LANES (8)
+
+// Two SSE registers per lane to hide the latencies of the long dependency chains of the rotations.
+typedef struct lanes { __m128 e[2]; } lanes;
+typedef lanes mask;
+
+// An approximation of 1 / sqrt(x) refined by one Newton step (about 22 bits).
+static inline __m128
+rsqrt_4
+  (
+    __m128 x
+  )
+{
+  __m128 y = _mm_rsqrt_ps(x);
+  return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_mul_ps(y, y))));
+}
+
+#define UNARY(NAME, EXPRESSION) \
+  static inline lanes NAME(lanes x) { lanes t; for (size_t i = 0; i < 2; ++i) { __m128 a = x.e[i]; t.e[i] = (EXPRESSION); } return t; }
+
+#define BINARY(NAME, EXPRESSION) \
+  static inline lanes NAME(lanes x, lanes y) { lanes t; for (size_t i = 0; i < 2; ++i) { __m128 a = x.e[i], b = y.e[i]; t.e[i] = (EXPRESSION); } return t; }
+
+static inline lanes lanes_splat(idlib_f32 x) { lanes t = { { _mm_set1_ps(x), _mm_set1_ps(x) } }; return t; }
+static inline lanes lanes_load(idlib_f32 const* p) { lanes t = { { _mm_loadu_ps(p), _mm_loadu_ps(p + 4) } }; return t; }
+static inline void lanes_store(idlib_f32* p, lanes x) { _mm_storeu_ps(p, x.e[0]); _mm_storeu_ps(p + 4, x.e[1]); }
+static inline idlib_f32 lanes_first(lanes x) { return _mm_cvtss_f32(x.e[0]); }
+BINARY(lanes_add, _mm_add_ps(a, b))
+BINARY(lanes_sub, _mm_sub_ps(a, b))
+BINARY(lanes_mul, _mm_mul_ps(a, b))
+BINARY(lanes_div, _mm_div_ps(a, b))
+UNARY(lanes_sqrt, _mm_sqrt_ps(a))
+UNARY(lanes_rsqrt, rsqrt_4(a))
+BINARY(lanes_max, _mm_max_ps(a, b))
+UNARY(lanes_abs, _mm_andnot_ps(_mm_set1_ps(-0.f), a))
+UNARY(lanes_neg, _mm_xor_ps(_mm_set1_ps(-0.f), a))
+// The magnitude of x with the sign of y.
+BINARY(lanes_copysign, _mm_or_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), a), _mm_and_ps(_mm_set1_ps(-0.f), b)))
+BINARY(lanes_less, _mm_cmplt_ps(a, b))
+BINARY(lanes_greater, _mm_cmpgt_ps(a, b))
+// x if m is set, y otherwise.
+static inline lanes lanes_select(mask m, lanes x, lanes y) { lanes t; for (size_t i = 0; i < 2; ++i) { t.e[i] = _mm_or_ps(_mm_and_ps(m.e[i], x.e[i]), _mm_andnot_ps(m.e[i], y.e[i])); } return t; }
+
+#undef BINARY
+#undef UNARY
+
+#else
+
+#define LANES (1)
+
+typedef idlib_f32 lanes;
+typedef bool mask;
+
+static inline lanes lanes_splat(idlib_f32 x) { return x; }
+static inline lanes lanes_load(idlib_f32 const* p) { return *p; }
+static inline void lanes_store(idlib_f32* p, lanes x) { *p = x; }
+static inline idlib_f32 lanes_first(lanes x) { return x; }
+static inline lanes lanes_add(lanes x, lanes y) { return x + y; }
+static inline lanes lanes_sub(lanes x, lanes y) { return x - y; }
+static inline lanes lanes_mul(lanes x, lanes y) { return x * y; }
+static inline lanes lanes_div(lanes x, lanes y) { return x / y; }
+static inline lanes lanes_sqrt(lanes x) { return sqrtf(x); }
+static inline lanes lanes_rsqrt(lanes x) { return 1.f / sqrtf(x); }
+// Like _mm_max_ps: y if either is NaN.
+static inline lanes lanes_max(lanes x, lanes y) { return x > y ? x : y; }
+static inline lanes lanes_abs(lanes x) { return fabsf(x); }
+static inline lanes lanes_neg(lanes x) { return -x; }
+static inline lanes lanes_copysign(lanes x, lanes y) { return copysignf(x, y); }
+static inline mask lanes_less(lanes x, lanes y) { return x < y; }
+static inline mask lanes_greater(lanes x, lanes y) { return x > y; }
+static inline lanes lanes_select(mask m, lanes x, lanes y) { return m ? x : y; }
+
+#endif
+
+// The number of cyclic Jacobi sweeps of the eigensolver.
+#define EIGEN_SWEEPS (4)
+
+// The number of cyclic Jacobi sweeps of the singular value decomposition.
+#define SVD_SWEEPS (6)
+
+// Off-diagonal elements of the normalized matrices of smaller magnitude are treated as zero.
+// This keeps the operands of the rotations away from subnormal numbers which are very slow on some architectures.
+#define NEGLIGIBLE (1e-12f)
+
+// Scale a matrix by the reciprocal of its element of greatest magnitude. Return that magnitude.
+static inline lanes
+normalize
+  (
+    lanes a[3][3]
+  )
+{
+  lanes m = lanes_splat(0.f);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      m = lanes_max(lanes_abs(a[i][j]), m);
+    }
+  }
+  lanes s = lanes_select(lanes_greater(m, lanes_splat(0.f)), lanes_div(lanes_splat(1.f), m), lanes_splat(0.f));
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      a[i][j] = lanes_mul(a[i][j], s);
+    }
+  }
+  return m;
+}
+
+static inline void
+set_identity
+  (
+    lanes a[3][3]
+  )
+{
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      a[i][j] = lanes_splat(i == j ? 1.f : 0.f);
+    }
+  }
+}
+
+// Replace the columns p and q of a by c * a_p - s * a_q and s * a_p + c * a_q.
+static inline void
+rotate_columns
+  (
+    lanes a[3][3],
+    size_t p,
+    size_t q,
+    lanes c,
+    lanes s
+  )
+{
+  for (size_t k = 0; k < 3; ++k) {
+    lanes x = a[k][p], y = a[k][q];
+    a[k][p] = lanes_sub(lanes_mul(c, x), lanes_mul(s, y));
+    a[k][q] = lanes_add(lanes_mul(s, x), lanes_mul(c, y));
+  }
+}
+
+// Replace the rows p and q of a by c * a_p - s * a_q and s * a_p + c * a_q.
+static inline void
+rotate_rows
+  (
+    lanes a[3][3],
+    size_t p,
+    size_t q,
+    lanes c,
+    lanes s
+  )
+{
+  for (size_t k = 0; k < 3; ++k) {
+    lanes x = a[p][k], y = a[q][k];
+    a[p][k] = lanes_sub(lanes_mul(c, x), lanes_mul(s, y));
+    a[q][k] = lanes_add(lanes_mul(s, x), lanes_mul(c, y));
+  }
+}
+
+// Replace a symmetric matrix a by P^T a P where P is the rotation of the columns p and q by rotate_columns.
+static inline void
+rotate_symmetric
+  (
+    lanes a[3][3],
+    size_t p,
+    size_t q,
+    lanes c,
+    lanes s
+  )
+{
+  size_t k = 3 - p - q;
+  lanes app = a[p][p], aqq = a[q][q], apq = a[p][q], akp = a[k][p], akq = a[k][q];
+  lanes cc = lanes_mul(c, c), ss = lanes_mul(s, s), cs = lanes_mul(c, s);
+  lanes cs_apq = lanes_mul(lanes_add(cs, cs), apq);
+  a[p][p] = lanes_add(lanes_sub(lanes_mul(cc, app), cs_apq), lanes_mul(ss, aqq));
+  a[q][q] = lanes_add(lanes_add(lanes_mul(ss, app), cs_apq), lanes_mul(cc, aqq));
+  a[p][q] = a[q][p] = lanes_add(lanes_mul(cs, lanes_sub(app, aqq)), lanes_mul(lanes_sub(cc, ss), apq));
+  a[k][p] = a[p][k] = lanes_sub(lanes_mul(c, akp), lanes_mul(s, akq));
+  a[k][q] = a[q][k] = lanes_add(lanes_mul(s, akp), lanes_mul(c, akq));
+}
+
+// If m is set, swap the columns p and q of a and negate the new column q (such that the determinant is preserved).
+static inline void
+swap_columns
+  (
+    lanes a[3][3],
+    size_t p,
+    size_t q,
+    mask m
+  )
+{
+  for (size_t k = 0; k < 3; ++k) {
+    lanes x = a[k][p], y = a[k][q];
+    a[k][p] = lanes_select(m, y, x);
+    a[k][q] = lanes_select(m, lanes_neg(x), y);
+  }
+}
+
+// If m is set, swap x and y.
+static inline void
+swap_lanes
+  (
+    lanes* x,
+    lanes* y,
+    mask m
+  )
+{
+  lanes t = *x;
+  *x = lanes_select(m, *y, t);
+  *y = lanes_select(m, t, *y);
+}
+
+// Annihilate the elements (p, q) and (q, p) of a symmetric matrix a by an exact Jacobi rotation. Accumulate the rotation in v.
+static inline void
+eigen_rotation
+  (
+    lanes a[3][3],
+    lanes v[3][3],
+    size_t p,
+    size_t q
+  )
+{
+  lanes zero = lanes_splat(0.f), one = lanes_splat(1.f), two = lanes_splat(2.f), four = lanes_splat(4.f);
+  // t = tan(theta) is the smaller root of t^2 + 2 t (a_qq - a_pp) / (2 a_pq) - 1 = 0.
+  lanes apq = lanes_select(lanes_greater(lanes_abs(a[p][q]), lanes_splat(NEGLIGIBLE)), a[p][q], zero), e = lanes_sub(a[q][q], a[p][p]);
+  lanes denominator = lanes_add(lanes_abs(e), lanes_sqrt(lanes_add(lanes_mul(e, e), lanes_mul(four, lanes_mul(apq, apq)))));
+  lanes t = lanes_select(lanes_greater(denominator, zero),
+                         lanes_div(lanes_mul(lanes_mul(two, apq), lanes_copysign(one, e)), denominator),
+                         zero);
+  lanes c = lanes_div(one, lanes_sqrt(lanes_add(lanes_mul(t, t), one)));
+  lanes s = lanes_mul(t, c);
+  rotate_symmetric(a, p, q, c, s);
+  a[p][q] = zero;
+  a[q][p] = zero;
+  rotate_columns(v, p, q, c, s);
+}
+
+// If d[q] is greater than d[p], swap d[p] and d[q] and the columns p and q of v.
+static inline void
+eigen_sort
+  (
+    lanes d[3],
+    lanes v[3][3],
+    size_t p,
+    size_t q
+  )
+{
+  mask swap = lanes_less(d[p], d[q]);
+  swap_lanes(&d[p], &d[q], swap);
+  swap_columns(v, p, q, swap);
+}
+
+static void
+eigen_symmetric
+  (
+    lanes v[3][3],
+    lanes d[3],
+    lanes a[3][3]
+  )
+{
+  // Mirror the upper triangle.
+  a[1][0] = a[0][1];
+  a[2][0] = a[0][2];
+  a[2][1] = a[1][2];
+  lanes m = normalize(a);
+  set_identity(v);
+  for (size_t sweep = 0; sweep < EIGEN_SWEEPS; ++sweep) {
+    eigen_rotation(a, v, 0, 1);
+    eigen_rotation(a, v, 0, 2);
+    eigen_rotation(a, v, 1, 2);
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    d[k] = lanes_mul(a[k][k], m);
+  }
+  // Sort in descending order.
+  eigen_sort(d, v, 0, 1);
+  eigen_sort(d, v, 1, 2);
+  eigen_sort(d, v, 0, 1);
+}
+
+// Reduce the elements (p, q) and (q, p) of a symmetric matrix s by an approximate Jacobi rotation. Accumulate the rotation in v.
+// The approximate rotation is the exact rotation for small angles and a rotation by pi/4 if the exact angle is large.
+static inline void
+svd_jacobi_rotation
+  (
+    lanes s[3][3],
+    lanes v[3][3],
+    size_t p,
+    size_t q
+  )
+{
+  lanes zero = lanes_splat(0.f), two = lanes_splat(2.f);
+  lanes gamma = lanes_splat(5.828427124f); // 3 + 2 sqrt(2)
+  lanes c_star = lanes_splat(0.923879532f); // cos(pi/8)
+  lanes s_star = lanes_splat(0.382683432f); // sin(pi/8)
+  // (ch, sh) is the cosine and the sine of the half angle.
+  // Both are flushed: Otherwise ch^2 + sh^2 might be subnormal and the refinement of the reciprocal square root would compute inf * 0.
+  lanes ch = lanes_mul(two, lanes_sub(s[p][p], s[q][q]));
+  ch = lanes_select(lanes_greater(lanes_abs(ch), lanes_splat(NEGLIGIBLE)), ch, zero);
+  lanes sh = lanes_select(lanes_greater(lanes_abs(s[p][q]), lanes_splat(NEGLIGIBLE)), s[p][q], zero);
+  mask exact = lanes_less(lanes_mul(gamma, lanes_mul(sh, sh)), lanes_mul(ch, ch));
+  lanes w = lanes_rsqrt(lanes_add(lanes_mul(ch, ch), lanes_mul(sh, sh)));
+  ch = lanes_select(exact, lanes_mul(w, ch), c_star);
+  sh = lanes_select(exact, lanes_mul(w, sh), s_star);
+  lanes c = lanes_sub(lanes_mul(ch, ch), lanes_mul(sh, sh));
+  lanes ns = lanes_neg(lanes_mul(two, lanes_mul(ch, sh)));
+  rotate_symmetric(s, p, q, c, ns);
+  rotate_columns(v, p, q, c, ns);
+}
+
+// If column q of b has a greater norm than column p, swap the columns p and q of b and v.
+static inline void
+svd_sort_columns
+  (
+    lanes n[3],
+    lanes b[3][3],
+    lanes v[3][3],
+    size_t p,
+    size_t q
+  )
+{
+  mask swap = lanes_less(n[p], n[q]);
+  swap_lanes(&n[p], &n[q], swap);
+  swap_columns(b, p, q, swap);
+  swap_columns(v, p, q, swap);
+}
+
+// If |sigma[q]| is greater than |sigma[p]|, swap sigma[p] and sigma[q] and the columns p and q of u and v.
+// The new columns q of u and v are both negated, hence U diag(sigma) V^T is preserved.
+static inline void
+svd_sort_values
+  (
+    lanes sigma[3],
+    lanes u[3][3],
+    lanes v[3][3],
+    size_t p,
+    size_t q
+  )
+{
+  mask swap = lanes_less(lanes_abs(sigma[p]), lanes_abs(sigma[q]));
+  swap_lanes(&sigma[p], &sigma[q], swap);
+  swap_columns(u, p, q, swap);
+  swap_columns(v, p, q, swap);
+}
+
+// If sigma[p] is negative, negate sigma[p] and sigma[2] and the columns p and 2 of u.
+// U diag(sigma) V^T and the determinant of u are preserved.
+static inline void
+svd_make_positive
+  (
+    lanes sigma[3],
+    lanes u[3][3],
+    size_t p
+  )
+{
+  mask negative = lanes_less(sigma[p], lanes_splat(0.f));
+  sigma[p] = lanes_select(negative, lanes_neg(sigma[p]), sigma[p]);
+  sigma[2] = lanes_select(negative, lanes_neg(sigma[2]), sigma[2]);
+  for (size_t k = 0; k < 3; ++k) {
+    u[k][p] = lanes_select(negative, lanes_neg(u[k][p]), u[k][p]);
+    u[k][2] = lanes_select(negative, lanes_neg(u[k][2]), u[k][2]);
+  }
+}
+
+// Annihilate the element (q, p) of b by a Givens rotation applied to the rows p and q. Accumulate the rotation in u.
+static inline void
+qr_rotation
+  (
+    lanes b[3][3],
+    lanes u[3][3],
+    size_t p,
+    size_t q
+  )
+{
+  lanes zero = lanes_splat(0.f), two = lanes_splat(2.f), epsilon = lanes_splat(1e-6f);
+  lanes a1 = b[p][p], a2 = b[q][p];
+  lanes rho = lanes_sqrt(lanes_add(lanes_mul(a1, a1), lanes_mul(a2, a2)));
+  lanes sh = lanes_select(lanes_greater(rho, epsilon), a2, zero);
+  sh = lanes_select(lanes_greater(lanes_abs(sh), lanes_splat(NEGLIGIBLE)), sh, zero);
+  lanes ch = lanes_add(lanes_abs(a1), lanes_max(rho, epsilon));
+  swap_lanes(&ch, &sh, lanes_less(a1, zero));
+  lanes w = lanes_rsqrt(lanes_add(lanes_mul(ch, ch), lanes_mul(sh, sh)));
+  ch = lanes_mul(ch, w);
+  sh = lanes_mul(sh, w);
+  lanes c = lanes_sub(lanes_mul(ch, ch), lanes_mul(sh, sh));
+  lanes ns = lanes_neg(lanes_mul(two, lanes_mul(ch, sh)));
+  rotate_rows(b, p, q, c, ns);
+  rotate_columns(u, p, q, c, ns);
+}
+
+static void
+svd
+  (
+    lanes u[3][3],
+    lanes sigma[3],
+    lanes v[3][3],
+    lanes a[3][3]
+  )
+{
+  lanes m = normalize(a);
+  // Symmetric eigenanalysis of A^T A.
+  lanes s[3][3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      s[i][j] = lanes_add(lanes_add(lanes_mul(a[0][i], a[0][j]), lanes_mul(a[1][i], a[1][j])), lanes_mul(a[2][i], a[2][j]));
+    }
+  }
+  set_identity(v);
+  for (size_t sweep = 0; sweep < SVD_SWEEPS; ++sweep) {
+    svd_jacobi_rotation(s, v, 0, 1);
+    svd_jacobi_rotation(s, v, 0, 2);
+    svd_jacobi_rotation(s, v, 1, 2);
+  }
+  // B = A V.
+  lanes b[3][3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      b[i][j] = lanes_add(lanes_add(lanes_mul(a[i][0], v[0][j]), lanes_mul(a[i][1], v[1][j])), lanes_mul(a[i][2], v[2][j]));
+    }
+  }
+  // Sort the columns of B by decreasing norm.
+  lanes n[3];
+  for (size_t j = 0; j < 3; ++j) {
+    n[j] = lanes_add(lanes_add(lanes_mul(b[0][j], b[0][j]), lanes_mul(b[1][j], b[1][j])), lanes_mul(b[2][j], b[2][j]));
+  }
+  svd_sort_columns(n, b, v, 0, 1);
+  svd_sort_columns(n, b, v, 0, 2);
+  svd_sort_columns(n, b, v, 1, 2);
+  // QR decomposition of B by Givens rotations: U^T B = R.
+  set_identity(u);
+  qr_rotation(b, u, 0, 1);
+  qr_rotation(b, u, 0, 2);
+  qr_rotation(b, u, 1, 2);
+  for (size_t k = 0; k < 3; ++k) {
+    sigma[k] = lanes_mul(b[k][k], m);
+  }
+  // The diagonal of R is ordered by magnitude only up to rounding errors, its first two elements might be negative.
+  // This is significant for matrices of (almost) rank one where the second and the third singular values are of the size of the rounding errors.
+  svd_sort_values(sigma, u, v, 0, 1);
+  svd_sort_values(sigma, u, v, 1, 2);
+  svd_sort_values(sigma, u, v, 0, 1);
+  svd_make_positive(sigma, u, 0);
+  svd_make_positive(sigma, u, 1);
+}
+
+void
+idlib_matrix_3x3_f32_eigen_symmetric
+  (
+    idlib_matrix_3x3_f32* target_vectors,
+    idlib_vector_3_f32* target_values,
+    idlib_matrix_3x3_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target_vectors);
+  IDLIB_DEBUG_ASSERT(NULL != target_values);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  lanes a[3][3], v[3][3], d[3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      a[i][j] = lanes_splat(operand->e[i][j]);
+    }
+  }
+  eigen_symmetric(v, d, a);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      target_vectors->e[i][j] = lanes_first(v[i][j]);
+    }
+    target_values->e[i] = lanes_first(d[i]);
+  }
+}
+
+// Load the matrices [i, i + LANES) of a stream.
+// If fewer than LANES matrices remain, the remaining lanes are padded with zeroes.
+static inline void
+load_3x3
+  (
+    lanes a[3][3],
+    idlib_matrix_3x3_f32_soa const* operand,
+    size_t i,
+    size_t n
+  )
+{
+  for (size_t r = 0; r < 3; ++r) {
+    for (size_t c = 0; c < 3; ++c) {
+      if (LANES == n) {
+        a[r][c] = lanes_load(operand->e[r][c] + i);
+      } else {
+        idlib_f32 t[LANES] = { 0.f };
+        for (size_t j = 0; j < n; ++j) {
+          t[j] = operand->e[r][c][i + j];
+        }
+        a[r][c] = lanes_load(t);
+      }
+    }
+  }
+}
+
+// Store n <= LANES lanes at index i of a stream.
+static inline void
+store_1
+  (
+    idlib_f32* target,
+    lanes x,
+    size_t i,
+    size_t n
+  )
+{
+  if (LANES == n) {
+    lanes_store(target + i, x);
+  } else {
+    idlib_f32 t[LANES];
+    lanes_store(t, x);
+    for (size_t j = 0; j < n; ++j) {
+      target[i + j] = t[j];
+    }
+  }
+}
+
+static inline void
+store_3x3
+  (
+    idlib_matrix_3x3_f32_soa const* target,
+    lanes a[3][3],
+    size_t i,
+    size_t n
+  )
+{
+  for (size_t r = 0; r < 3; ++r) {
+    for (size_t c = 0; c < 3; ++c) {
+      store_1(target->e[r][c], a[r][c], i, n);
+    }
+  }
+}
+
+static inline void
+store_3
+  (
+    idlib_vector_3_f32_soa const* target,
+    lanes a[3],
+    size_t i,
+    size_t n
+  )
+{
+  store_1(target->x, a[0], i, n);
+  store_1(target->y, a[1], i, n);
+  store_1(target->z, a[2], i, n);
+}
+
+void
+idlib_matrix_3x3_f32_eigen_symmetric_n
+  (
+    idlib_matrix_3x3_f32_soa const* target_vectors,
+    idlib_vector_3_f32_soa const* target_values,
+    idlib_matrix_3x3_f32_soa const* operand,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target_vectors);
+  IDLIB_DEBUG_ASSERT(NULL != target_values);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t i = first, last = first + count; i < last; i += LANES) {
+    size_t n = last - i < LANES ? last - i : LANES;
+    lanes a[3][3], v[3][3], d[3];
+    load_3x3(a, operand, i, n);
+    eigen_symmetric(v, d, a);
+    store_3x3(target_vectors, v, i, n);
+    store_3(target_values, d, i, n);
+  }
+}
+
+void
+idlib_matrix_3x3_f32_svd
+  (
+    idlib_matrix_3x3_f32* target_u,
+    idlib_vector_3_f32* target_sigma,
+    idlib_matrix_3x3_f32* target_v,
+    idlib_matrix_3x3_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target_u);
+  IDLIB_DEBUG_ASSERT(NULL != target_sigma);
+  IDLIB_DEBUG_ASSERT(NULL != target_v);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  lanes a[3][3], u[3][3], v[3][3], sigma[3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      a[i][j] = lanes_splat(operand->e[i][j]);
+    }
+  }
+  svd(u, sigma, v, a);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      target_u->e[i][j] = lanes_first(u[i][j]);
+      target_v->e[i][j] = lanes_first(v[i][j]);
+    }
+    target_sigma->e[i] = lanes_first(sigma[i]);
+  }
+}
+
+void
+idlib_matrix_3x3_f32_svd_n
+  (
+    idlib_matrix_3x3_f32_soa const* target_u,
+    idlib_vector_3_f32_soa const* target_sigma,
+    idlib_matrix_3x3_f32_soa const* target_v,
+    idlib_matrix_3x3_f32_soa const* operand,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target_u);
+  IDLIB_DEBUG_ASSERT(NULL != target_sigma);
+  IDLIB_DEBUG_ASSERT(NULL != target_v);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t i = first, last = first + count; i < last; i += LANES) {
+    size_t n = last - i < LANES ? last - i : LANES;
+    lanes a[3][3], u[3][3], v[3][3], sigma[3];
+    load_3x3(a, operand, i, n);
+    svd(u, sigma, v, a);
+    store_3x3(target_u, u, i, n);
+    store_3x3(target_v, v, i, n);
+    store_3(target_sigma, sigma, i, n);
+  }
+}
@@ -20,3 +20,70 @@
 */
 
 #include "idlib/math/matrix_4x4.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps, _mm_sfence
+  #include <xmmintrin.h>
+#endif
+
+static void
+transform_n
+  (
+    idlib_vector_4a_f32* target,
+    idlib_matrix_4x4a_f32 const* operand1,
+    idlib_vector_3a_f32 const* operand2,
+    size_t count,
+    idlib_f32 w
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2 || 0 == count);
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // Load the rows with aligned loads and transpose them into columns.
+  // The result is then the sum of the columns scaled by the components of the operand.
+  __m128 c0 = _mm_load_ps(operand1->e[0]);
+  __m128 c1 = _mm_load_ps(operand1->e[1]);
+  __m128 c2 = _mm_load_ps(operand1->e[2]);
+  __m128 c3 = _mm_load_ps(operand1->e[3]);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  c3 = _mm_mul_ps(c3, _mm_set1_ps(w));
+  for (size_t i = 0; i < count; ++i) {
+    __m128 v = _mm_load_ps(operand2[i].e);
+    __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))),
+                          _mm_mul_ps(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+    r = _mm_add_ps(r, c3);
+    _mm_stream_ps(target[i].e, r);
+  }
+  // Make the non-temporal stores globally visible before returning.
+  _mm_sfence();
+#else
+  for (size_t i = 0; i < count; ++i) {
+    idlib_f32 x = operand2[i].e[0], y = operand2[i].e[1], z = operand2[i].e[2];
+    for (size_t j = 0; j < 4; ++j) {
+      target[i].e[j] = operand1->e[j][0] * x + operand1->e[j][1] * y + operand1->e[j][2] * z + operand1->e[j][3] * w;
+    }
+  }
+#endif
+}
+
+void
+idlib_matrix_4x4a_f32_transform_points_n
+  (
+    idlib_vector_4a_f32* target,
+    idlib_matrix_4x4a_f32 const* operand1,
+    idlib_vector_3a_f32 const* operand2,
+    size_t count
+  )
+{ transform_n(target, operand1, operand2, count, 1.f); }
+
+void
+idlib_matrix_4x4a_f32_transform_directions_n
+  (
+    idlib_vector_4a_f32* target,
+    idlib_matrix_4x4a_f32 const* operand1,
+    idlib_vector_3a_f32 const* operand2,
+    size_t count
+  )
+{ transform_n(target, operand1, operand2, count, 0.f); }
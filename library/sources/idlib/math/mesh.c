@@ -0,0 +1,368 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/mesh.h"
+
+// acosf, fabsf
+#include <math.h>
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// The frame of a triangle: normal, tangent, and bitangent, each padded to four components.
+typedef struct triangle_frame {
+  idlib_f32 normal[4];
+  idlib_f32 tangent[4];
+  idlib_f32 bitangent[4];
+} triangle_frame;
+
+// The layout of the workspace.
+typedef struct workspace_layout {
+  // number_of_triangles triangle frames.
+  triangle_frame* frames;
+  // 3 * number_of_triangles weights, one per corner.
+  idlib_f32* weights;
+  // number_of_vertices + 1 offsets into corners: The corners of vertex v are corners[offsets[v]], ..., corners[offsets[v + 1] - 1].
+  idlib_u32* offsets;
+  // 3 * number_of_triangles corners. Corner c is the corner c % 3 of triangle c / 3.
+  idlib_u32* corners;
+} workspace_layout;
+
+static void
+workspace_layout_initialize
+  (
+    workspace_layout* target,
+    idlib_u32 number_of_vertices,
+    idlib_u32 number_of_triangles,
+    void* workspace
+  )
+{
+  idlib_u8* p = (idlib_u8*)workspace;
+  target->frames = (triangle_frame*)p;
+  p += sizeof(triangle_frame) * (size_t)number_of_triangles;
+  target->weights = (idlib_f32*)p;
+  p += sizeof(idlib_f32) * 3 * (size_t)number_of_triangles;
+  target->offsets = (idlib_u32*)p;
+  p += sizeof(idlib_u32) * ((size_t)number_of_vertices + 1);
+  target->corners = (idlib_u32*)p;
+}
+
+size_t
+idlib_mesh_f32_get_workspace_size
+  (
+    idlib_u32 number_of_vertices,
+    idlib_u32 number_of_triangles
+  )
+{
+  return sizeof(triangle_frame) * (size_t)number_of_triangles
+       + sizeof(idlib_f32) * 3 * (size_t)number_of_triangles
+       + sizeof(idlib_u32) * ((size_t)number_of_vertices + 1)
+       + sizeof(idlib_u32) * 3 * (size_t)number_of_triangles;
+}
+
+void
+idlib_mesh_f32_prepare
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  workspace_layout w;
+  workspace_layout_initialize(&w, job->number_of_vertices, job->number_of_triangles, workspace);
+
+  idlib_u32 n = job->number_of_vertices, m = 3 * job->number_of_triangles;
+  for (idlib_u32 v = 0; v <= n; ++v) {
+    w.offsets[v] = 0;
+  }
+  // Count the corners of each vertex into offsets[v + 1] ...
+  for (idlib_u32 c = 0; c < m; ++c) {
+    IDLIB_DEBUG_ASSERT(job->indices[c] < n);
+    w.offsets[job->indices[c] + 1]++;
+  }
+  // ... compute the prefix sums such that offsets[v] is the start of the corners of vertex v ...
+  for (idlib_u32 v = 0; v < n; ++v) {
+    w.offsets[v + 1] += w.offsets[v];
+  }
+  // ... place the corners, advancing offsets[v] to the start of the corners of vertex v + 1 ...
+  for (idlib_u32 c = 0; c < m; ++c) {
+    w.corners[w.offsets[job->indices[c]]++] = c;
+  }
+  // ... and shift the offsets back.
+  for (idlib_u32 v = n; v > 0; --v) {
+    w.offsets[v] = w.offsets[v - 1];
+  }
+  w.offsets[0] = 0;
+}
+
+static inline void
+subtract
+  (
+    idlib_f32 target[3],
+    idlib_vector_3_f32_soa const* positions,
+    idlib_u32 i,
+    idlib_u32 j
+  )
+{
+  target[0] = positions->x[i] - positions->x[j];
+  target[1] = positions->y[i] - positions->y[j];
+  target[2] = positions->z[i] - positions->z[j];
+}
+
+static inline idlib_f32
+dot
+  (
+    idlib_f32 const a[3],
+    idlib_f32 const b[3]
+  )
+{ return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+// Normalize a vector. Return its length before normalization. Vectors of length zero remain zero vectors.
+static inline idlib_f32
+normalize
+  (
+    idlib_f32 a[3]
+  )
+{
+  idlib_f32 l = idlib_sqrt_f32(dot(a, a));
+  if (l > 0.f) {
+    idlib_f32 s = 1.f / l;
+    a[0] *= s;
+    a[1] *= s;
+    a[2] *= s;
+  }
+  return l;
+}
+
+// Compute the angle between two vectors.
+static inline idlib_f32
+angle
+  (
+    idlib_f32 const a[3],
+    idlib_f32 const b[3]
+  )
+{
+  idlib_f32 l = idlib_sqrt_f32(dot(a, a) * dot(b, b));
+  if (l <= 0.f) {
+    return 0.f;
+  }
+  idlib_f32 c = dot(a, b) / l;
+  return acosf(c < -1.f ? -1.f : (c > 1.f ? 1.f : c));
+}
+
+void
+idlib_mesh_f32_compute_triangle_frames
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  workspace_layout w;
+  workspace_layout_initialize(&w, job->number_of_vertices, job->number_of_triangles, workspace);
+  bool tangents = NULL != job->texture_coordinates.x;
+
+  for (idlib_u32 t = first, n = first + count; t < n; ++t) {
+    idlib_u32 const* v = job->indices + 3 * (size_t)t;
+    triangle_frame* f = w.frames + t;
+    idlib_f32* weights = w.weights + 3 * (size_t)t;
+
+    idlib_f32 e1[3], e2[3];
+    subtract(e1, &job->positions, v[1], v[0]);
+    subtract(e2, &job->positions, v[2], v[0]);
+
+    // The length of the cross product is twice the area.
+    idlib_f32 normal[3] = { e1[1] * e2[2] - e1[2] * e2[1],
+                            e1[2] * e2[0] - e1[0] * e2[2],
+                            e1[0] * e2[1] - e1[1] * e2[0] };
+    idlib_f32 area = 0.5f * normalize(normal);
+    if (IDLIB_MESH_WEIGHTING_ANGLE == job->weighting && area > 0.f) {
+      // The angles at the corners 0 and 1. The angle at corner 2 is their supplement.
+      idlib_f32 e3[3], e4[3];
+      subtract(e3, &job->positions, v[2], v[1]);
+      subtract(e4, &job->positions, v[0], v[1]);
+      weights[0] = angle(e1, e2);
+      weights[1] = angle(e3, e4);
+      weights[2] = IDLIB_PI_F32 - weights[0] - weights[1];
+      if (weights[2] < 0.f) {
+        weights[2] = 0.f;
+      }
+    } else {
+      weights[0] = area;
+      weights[1] = area;
+      weights[2] = area;
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      f->normal[k] = normal[k];
+      f->tangent[k] = 0.f;
+      f->bitangent[k] = 0.f;
+    }
+    f->normal[3] = f->tangent[3] = f->bitangent[3] = 0.f;
+
+    if (tangents && area > 0.f) {
+      idlib_f32 du1 = job->texture_coordinates.x[v[1]] - job->texture_coordinates.x[v[0]],
+                dv1 = job->texture_coordinates.y[v[1]] - job->texture_coordinates.y[v[0]],
+                du2 = job->texture_coordinates.x[v[2]] - job->texture_coordinates.x[v[0]],
+                dv2 = job->texture_coordinates.y[v[2]] - job->texture_coordinates.y[v[0]];
+      idlib_f32 r = du1 * dv2 - du2 * dv1;
+      // Only the direction is required, hence multiply by the sign of r rather than dividing by r.
+      if (0.f != r) {
+        idlib_f32 s = r < 0.f ? -1.f : 1.f;
+        for (size_t k = 0; k < 3; ++k) {
+          f->tangent[k] = s * (e1[k] * dv2 - e2[k] * dv1);
+          f->bitangent[k] = s * (e2[k] * du1 - e1[k] * du2);
+        }
+        normalize(f->tangent);
+        normalize(f->bitangent);
+      }
+    }
+  }
+}
+
+// Assign a tangent an arbitrary unit vector orthogonal to a unit normal.
+static inline void
+any_tangent
+  (
+    idlib_f32 t[3],
+    idlib_f32 const n[3]
+  )
+{
+  // Cross the normal with the coordinate axis it is least aligned with.
+  if (fabsf(n[0]) < 0.5f) {
+    t[0] = 0.f; t[1] = n[2]; t[2] = -n[1];
+  } else {
+    t[0] = -n[2]; t[1] = 0.f; t[2] = n[0];
+  }
+  normalize(t);
+}
+
+static inline void
+store_vertex_frame
+  (
+    idlib_mesh_f32_job const* job,
+    idlib_u32 v,
+    idlib_f32 n[3],
+    idlib_f32 t[3],
+    idlib_f32 const b[3],
+    bool tangents
+  )
+{
+  normalize(n);
+  job->normals.x[v] = n[0];
+  job->normals.y[v] = n[1];
+  job->normals.z[v] = n[2];
+  if (!tangents) {
+    return;
+  }
+  // Gram-Schmidt: Remove the component of the tangent along the normal.
+  idlib_f32 d = dot(n, t);
+  for (size_t k = 0; k < 3; ++k) {
+    t[k] -= d * n[k];
+  }
+  idlib_f32 h = 1.f;
+  if (normalize(t) <= 1e-6f) {
+    if (0.f == dot(n, n)) {
+      t[0] = t[1] = t[2] = 0.f;
+    } else {
+      any_tangent(t, n);
+    }
+  } else {
+    // The handedness is negative if the summed bitangent points against cross(n, t).
+    idlib_f32 c[3] = { n[1] * t[2] - n[2] * t[1],
+                       n[2] * t[0] - n[0] * t[2],
+                       n[0] * t[1] - n[1] * t[0] };
+    h = dot(c, b) < 0.f ? -1.f : 1.f;
+  }
+  job->tangents.x[v] = t[0];
+  job->tangents.y[v] = t[1];
+  job->tangents.z[v] = t[2];
+  job->tangents.w[v] = h;
+}
+
+void
+idlib_mesh_f32_compute_vertex_frames
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  workspace_layout w;
+  workspace_layout_initialize(&w, job->number_of_vertices, job->number_of_triangles, workspace);
+  bool tangents = NULL != job->texture_coordinates.x;
+
+  for (idlib_u32 v = first, n = first + count; v < n; ++v) {
+    idlib_u32 const* c = w.corners + w.offsets[v];
+    idlib_u32 const* e = w.corners + w.offsets[v + 1];
+    idlib_f32 sn[4], st[4], sb[4];
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+    __m128 an = _mm_setzero_ps(), at = _mm_setzero_ps(), ab = _mm_setzero_ps();
+    for (; c < e; ++c) {
+      triangle_frame const* f = w.frames + *c / 3;
+      __m128 weight = _mm_set1_ps(w.weights[*c]);
+      an = _mm_add_ps(an, _mm_mul_ps(weight, _mm_load_ps(f->normal)));
+      at = _mm_add_ps(at, _mm_mul_ps(weight, _mm_load_ps(f->tangent)));
+      ab = _mm_add_ps(ab, _mm_mul_ps(weight, _mm_load_ps(f->bitangent)));
+    }
+    _mm_storeu_ps(sn, an);
+    _mm_storeu_ps(st, at);
+    _mm_storeu_ps(sb, ab);
+#else
+    for (size_t k = 0; k < 4; ++k) {
+      sn[k] = st[k] = sb[k] = 0.f;
+    }
+    for (; c < e; ++c) {
+      triangle_frame const* f = w.frames + *c / 3;
+      idlib_f32 weight = w.weights[*c];
+      for (size_t k = 0; k < 4; ++k) {
+        sn[k] += weight * f->normal[k];
+        st[k] += weight * f->tangent[k];
+        sb[k] += weight * f->bitangent[k];
+      }
+    }
+#endif
+    store_vertex_frame(job, v, sn, st, sb, tangents);
+  }
+}
+
+void
+idlib_mesh_f32_compute_normals_and_tangents
+  (
+    idlib_mesh_f32_job const* job,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  idlib_mesh_f32_prepare(job, workspace);
+  idlib_mesh_f32_compute_triangle_frames(job, workspace, 0, job->number_of_triangles);
+  idlib_mesh_f32_compute_vertex_frames(job, workspace, 0, job->number_of_vertices);
+}
@@ -0,0 +1,604 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#include "idlib/math/noise.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+  // __m128i, _mm_*_epi32, _mm_cvttps_epi32, _mm_cvtepi32_ps
+  #include <emmintrin.h>
+#endif
+
+// The noise is computed by a single implementation on "lanes":
+// On SIMD capable architectures a lane is a SIMD register of four values and all points (including single points) are processed by the SIMD code.
+// Otherwise a lane is a single value. Both perform the same sequence of correctly rounded operations such that the results are the same.
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+#define LANES (4)
+
+typedef __m128 lane_f32;
+
+// A lane of integers. Conditions are represented by all bits set (true) or no bits set (false).
+typedef __m128i lane_i32;
+
+static inline lane_f32 f_set(idlib_f32 x) { return _mm_set1_ps(x); }
+static inline lane_f32 f_load(idlib_f32 const* x) { return _mm_loadu_ps(x); }
+static inline void f_store(idlib_f32* target, lane_f32 x) { _mm_storeu_ps(target, x); }
+static inline lane_f32 f_add(lane_f32 x, lane_f32 y) { return _mm_add_ps(x, y); }
+static inline lane_f32 f_sub(lane_f32 x, lane_f32 y) { return _mm_sub_ps(x, y); }
+static inline lane_f32 f_mul(lane_f32 x, lane_f32 y) { return _mm_mul_ps(x, y); }
+static inline lane_f32 f_max(lane_f32 x, lane_f32 y) { return _mm_max_ps(x, y); }
+static inline lane_f32 f_abs(lane_f32 x) { return _mm_andnot_ps(_mm_set1_ps(-0.f), x); }
+static inline lane_i32 f_greater(lane_f32 x, lane_f32 y) { return _mm_castps_si128(_mm_cmpgt_ps(x, y)); }
+// Negate x if c is true.
+static inline lane_f32 f_negate_if(lane_i32 c, lane_f32 x) { return _mm_xor_ps(x, _mm_and_ps(_mm_castsi128_ps(c), _mm_set1_ps(-0.f))); }
+// Select x if c is true and y otherwise.
+static inline lane_f32 f_select(lane_i32 c, lane_f32 x, lane_f32 y) { return _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(c), x), _mm_andnot_ps(_mm_castsi128_ps(c), y)); }
+// The largest integer not greater than x. x must be in the range of idlib_i32.
+static inline lane_i32
+f_floor
+  (
+    lane_f32 x
+  )
+{
+  lane_i32 i = _mm_cvttps_epi32(x);
+  // Truncation rounds negative non-integral values up, subtract one (add -1) in that case.
+  return _mm_add_epi32(i, _mm_castps_si128(_mm_cmplt_ps(x, _mm_cvtepi32_ps(i))));
+}
+static inline lane_f32 i_to_f(lane_i32 x) { return _mm_cvtepi32_ps(x); }
+
+static inline lane_i32 i_set(idlib_i32 x) { return _mm_set1_epi32(x); }
+static inline lane_i32 i_add(lane_i32 x, lane_i32 y) { return _mm_add_epi32(x, y); }
+static inline lane_i32 i_sub(lane_i32 x, lane_i32 y) { return _mm_sub_epi32(x, y); }
+static inline lane_i32 i_and(lane_i32 x, lane_i32 y) { return _mm_and_si128(x, y); }
+static inline lane_i32 i_or(lane_i32 x, lane_i32 y) { return _mm_or_si128(x, y); }
+static inline lane_i32 i_xor(lane_i32 x, lane_i32 y) { return _mm_xor_si128(x, y); }
+static inline lane_i32 i_shift_right(lane_i32 x, int n) { return _mm_srli_epi32(x, n); }
+static inline lane_i32 i_less(lane_i32 x, lane_i32 y) { return _mm_cmplt_epi32(x, y); }
+static inline lane_i32 i_equal(lane_i32 x, lane_i32 y) { return _mm_cmpeq_epi32(x, y); }
+// The lower 32 bits of the products (SSE2 only provides the 64 bit products of the even elements).
+static inline lane_i32
+i_mul
+  (
+    lane_i32 x,
+    lane_i32 y
+  )
+{
+  lane_i32 even = _mm_mul_epu32(x, y);
+  lane_i32 odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+#else
+
+#define LANES (1)
+
+typedef idlib_f32 lane_f32;
+
+// A lane of integers. Conditions are represented by all bits set (true) or no bits set (false).
+typedef idlib_i32 lane_i32;
+
+static inline lane_f32 f_set(idlib_f32 x) { return x; }
+static inline lane_f32 f_load(idlib_f32 const* x) { return *x; }
+static inline void f_store(idlib_f32* target, lane_f32 x) { *target = x; }
+static inline lane_f32 f_add(lane_f32 x, lane_f32 y) { return x + y; }
+static inline lane_f32 f_sub(lane_f32 x, lane_f32 y) { return x - y; }
+static inline lane_f32 f_mul(lane_f32 x, lane_f32 y) { return x * y; }
+// Returns y if x and y are zeroes or x is NaN like the SIMD version.
+static inline lane_f32 f_max(lane_f32 x, lane_f32 y) { return x > y ? x : y; }
+static inline lane_f32 f_abs(lane_f32 x) { return x < 0.f ? -x : (x == 0.f ? 0.f : x); }
+static inline lane_i32 f_greater(lane_f32 x, lane_f32 y) { return x > y ? -1 : 0; }
+// Negate x if c is true.
+static inline lane_f32 f_negate_if(lane_i32 c, lane_f32 x) { return c ? -x : x; }
+// Select x if c is true and y otherwise.
+static inline lane_f32 f_select(lane_i32 c, lane_f32 x, lane_f32 y) { return c ? x : y; }
+// The largest integer not greater than x. x must be in the range of idlib_i32.
+static inline lane_i32
+f_floor
+  (
+    lane_f32 x
+  )
+{
+  lane_i32 i = (lane_i32)x;
+  return x < (idlib_f32)i ? i - 1 : i;
+}
+static inline lane_f32 i_to_f(lane_i32 x) { return (idlib_f32)x; }
+
+static inline lane_i32 i_set(idlib_i32 x) { return x; }
+static inline lane_i32 i_add(lane_i32 x, lane_i32 y) { return (lane_i32)((idlib_u32)x + (idlib_u32)y); }
+static inline lane_i32 i_sub(lane_i32 x, lane_i32 y) { return (lane_i32)((idlib_u32)x - (idlib_u32)y); }
+static inline lane_i32 i_and(lane_i32 x, lane_i32 y) { return x & y; }
+static inline lane_i32 i_or(lane_i32 x, lane_i32 y) { return x | y; }
+static inline lane_i32 i_xor(lane_i32 x, lane_i32 y) { return x ^ y; }
+static inline lane_i32 i_shift_right(lane_i32 x, int n) { return (lane_i32)((idlib_u32)x >> n); }
+static inline lane_i32 i_less(lane_i32 x, lane_i32 y) { return x < y ? -1 : 0; }
+static inline lane_i32 i_equal(lane_i32 x, lane_i32 y) { return x == y ? -1 : 0; }
+static inline lane_i32 i_mul(lane_i32 x, lane_i32 y) { return (lane_i32)((idlib_u32)x * (idlib_u32)y); }
+
+#endif
+
+// The largest number of dimensions.
+#define MAXIMUM_DIMENSIONS (4)
+
+// Factors by which the lattice coordinates are multiplied before they are hashed.
+static idlib_i32 const HASH_PRIMES[MAXIMUM_DIMENSIONS] = {
+  (idlib_i32)0x8da6b343u,
+  (idlib_i32)0xd8163841u,
+  (idlib_i32)0xcb1ab31fu,
+  (idlib_i32)0x9e3779b1u,
+};
+
+// The factors scaling the noise of the kinds of noise for 2, 3, and 4 dimensions into the range [-1, 1].
+static idlib_f32 const SCALE[3][3] = {
+  // IDLIB_NOISE_PERLIN
+  { 0.65f, 0.936f, 0.84f },
+  // IDLIB_NOISE_SIMPLEX
+  { 45.f, 32.f, 27.f },
+  // IDLIB_NOISE_VALUE
+  { 1.f, 1.f, 1.f },
+};
+
+// Mix the bits of the hash of a lattice point.
+static inline lane_i32
+finalize_hash
+  (
+    lane_i32 h
+  )
+{
+  h = i_xor(h, i_shift_right(h, 15));
+  h = i_mul(h, i_set((idlib_i32)0x2c1b3c6du));
+  h = i_xor(h, i_shift_right(h, 12));
+  h = i_mul(h, i_set((idlib_i32)0x297a2d39u));
+  return i_xor(h, i_shift_right(h, 15));
+}
+
+// The dot product of a pseudo-random gradient selected by h with the vector x.
+// The gradients are those of Ken Perlin's improved noise: The vectors from the center to the midpoints of the edges of the square/cube/hypercube
+// (with the two-dimensional gradients scaled by (1, 2) to obtain eight directions).
+static inline lane_f32
+gradient
+  (
+    lane_i32 h,
+    lane_f32 const* x,
+    size_t number_of_dimensions
+  )
+{
+  lane_i32 b1 = i_equal(i_and(h, i_set(1)), i_set(1)),
+           b2 = i_equal(i_and(h, i_set(2)), i_set(2));
+  switch (number_of_dimensions) {
+    case 2: {
+      lane_i32 c = i_less(i_and(h, i_set(7)), i_set(4));
+      lane_f32 u = f_select(c, x[0], x[1]), v = f_select(c, x[1], x[0]);
+      return f_add(f_negate_if(b1, u), f_negate_if(b2, f_mul(f_set(2.f), v)));
+    }
+    case 3: {
+      lane_i32 g = i_and(h, i_set(15));
+      lane_f32 u = f_select(i_less(g, i_set(8)), x[0], x[1]);
+      lane_f32 v = f_select(i_less(g, i_set(4)), x[1], f_select(i_or(i_equal(g, i_set(12)), i_equal(g, i_set(14))), x[0], x[2]));
+      return f_add(f_negate_if(b1, u), f_negate_if(b2, v));
+    }
+    default: {
+      lane_i32 g = i_and(h, i_set(31));
+      lane_i32 b4 = i_equal(i_and(h, i_set(4)), i_set(4));
+      lane_f32 u = f_select(i_less(g, i_set(24)), x[0], x[1]);
+      lane_f32 v = f_select(i_less(g, i_set(16)), x[1], x[2]);
+      lane_f32 w = f_select(i_less(g, i_set(8)), x[2], x[3]);
+      return f_add(f_add(f_negate_if(b1, u), f_negate_if(b2, v)), f_negate_if(b4, w));
+    }
+  }
+}
+
+// The quintic fade function 6 t^5 - 15 t^4 + 10 t^3.
+static inline lane_f32
+fade
+  (
+    lane_f32 t
+  )
+{ return f_mul(f_mul(f_mul(t, t), t), f_add(f_mul(t, f_sub(f_mul(t, f_set(6.f)), f_set(15.f))), f_set(10.f))); }
+
+// Perlin noise (gradient is true) or value noise (gradient is false).
+static inline lane_f32
+lattice_noise
+  (
+    lane_f32 const* p,
+    size_t number_of_dimensions,
+    lane_i32 seed,
+    bool gradient_noise
+  )
+{
+  size_t d = number_of_dimensions;
+  lane_f32 f[MAXIMUM_DIMENSIONS], u[MAXIMUM_DIMENSIONS];
+  // The hashes of the lower and upper coordinates of the cell along each axis.
+  lane_i32 h[MAXIMUM_DIMENSIONS][2];
+  for (size_t k = 0; k < d; ++k) {
+    lane_i32 i = f_floor(p[k]);
+    f[k] = f_sub(p[k], i_to_f(i));
+    u[k] = fade(f[k]);
+    h[k][0] = i_mul(i, i_set(HASH_PRIMES[k]));
+    h[k][1] = i_add(h[k][0], i_set(HASH_PRIMES[k]));
+  }
+  lane_f32 v[1 << MAXIMUM_DIMENSIONS];
+  for (size_t c = 0; c < ((size_t)1 << d); ++c) {
+    lane_i32 hash = seed;
+    lane_f32 x[MAXIMUM_DIMENSIONS];
+    for (size_t k = 0; k < d; ++k) {
+      size_t b = (c >> k) & 1;
+      hash = i_xor(hash, h[k][b]);
+      x[k] = b ? f_sub(f[k], f_set(1.f)) : f[k];
+    }
+    hash = finalize_hash(hash);
+    if (gradient_noise) {
+      v[c] = gradient(hash, x, d);
+    } else {
+      v[c] = f_sub(f_mul(i_to_f(i_shift_right(hash, 8)), f_set(2.f / 16777215.f)), f_set(1.f));
+    }
+  }
+  // Interpolate along the axes in turn: Bit k of the index of a corner is its offset along the k-th axis.
+  for (size_t k = 0; k < d; ++k) {
+    for (size_t c = 0; c < ((size_t)1 << (d - k - 1)); ++c) {
+      v[c] = f_add(v[2 * c], f_mul(u[k], f_sub(v[2 * c + 1], v[2 * c])));
+    }
+  }
+  return v[0];
+}
+
+// Simplex noise.
+static inline lane_f32
+simplex_noise
+  (
+    lane_f32 const* p,
+    size_t number_of_dimensions,
+    lane_i32 seed
+  )
+{
+  // The factors skewing the lattice of simplices to the lattice of hypercubes and back: (sqrt(d + 1) - 1) / d and (d + 1 - sqrt(d + 1)) / (d (d + 1)).
+  static idlib_f32 const F[MAXIMUM_DIMENSIONS + 1] = { 0.f, 0.f, 0.366025403784f, 1.f / 3.f, 0.309016994375f };
+  static idlib_f32 const G[MAXIMUM_DIMENSIONS + 1] = { 0.f, 0.f, 0.211324865405f, 1.f / 6.f, 0.138196601125f };
+  // The squared radius of the support of the contribution of a corner.
+  static idlib_f32 const R[MAXIMUM_DIMENSIONS + 1] = { 0.f, 0.f, 0.5f, 0.6f, 0.6f };
+  size_t d = number_of_dimensions;
+  // Determine the hypercube containing the point and the offset of the point from its first corner in the unskewed space.
+  lane_f32 s = p[0];
+  for (size_t k = 1; k < d; ++k) {
+    s = f_add(s, p[k]);
+  }
+  s = f_mul(s, f_set(F[d]));
+  lane_i32 i[MAXIMUM_DIMENSIONS];
+  lane_f32 t = f_set(0.f);
+  for (size_t k = 0; k < d; ++k) {
+    i[k] = f_floor(f_add(p[k], s));
+    t = f_add(t, i_to_f(i[k]));
+  }
+  t = f_mul(t, f_set(G[d]));
+  lane_f32 x0[MAXIMUM_DIMENSIONS];
+  for (size_t k = 0; k < d; ++k) {
+    x0[k] = f_sub(p[k], f_sub(i_to_f(i[k]), t));
+  }
+  // The simplex containing the point is determined by the order of the coordinates of the offset:
+  // The j-th corner is offset by 1 along the axes of the j largest coordinates. The rank of an axis is the number of axes with smaller coordinates.
+  lane_i32 rank[MAXIMUM_DIMENSIONS];
+  for (size_t k = 0; k < d; ++k) {
+    rank[k] = i_set(0);
+  }
+  for (size_t a = 0; a < d; ++a) {
+    for (size_t b = a + 1; b < d; ++b) {
+      lane_i32 g = f_greater(x0[a], x0[b]);
+      rank[a] = i_sub(rank[a], g);
+      rank[b] = i_add(rank[b], i_add(g, i_set(1)));
+    }
+  }
+  lane_f32 n = f_set(0.f);
+  for (size_t j = 0; j <= d; ++j) {
+    lane_i32 hash = seed;
+    lane_f32 x[MAXIMUM_DIMENSIONS];
+    lane_f32 r = f_set(R[d]);
+    for (size_t k = 0; k < d; ++k) {
+      // The offset is 1 if rank >= d - j, that is rank > d - j - 1.
+      lane_i32 o = i_less(i_set((idlib_i32)(d - j) - 1), rank[k]);
+      lane_i32 c = i_sub(i[k], o);
+      hash = i_xor(hash, i_mul(c, i_set(HASH_PRIMES[k])));
+      x[k] = f_add(f_sub(x0[k], i_to_f(i_sub(i_set(0), o))), f_set((idlib_f32)j * G[d]));
+      r = f_sub(r, f_mul(x[k], x[k]));
+    }
+    hash = finalize_hash(hash);
+    r = f_max(r, f_set(0.f));
+    r = f_mul(r, r);
+    n = f_add(n, f_mul(f_mul(r, r), gradient(hash, x, d)));
+  }
+  return n;
+}
+
+// Evaluate the noise at points.
+static inline lane_f32
+evaluate
+  (
+    idlib_noise_f32 const* operand,
+    lane_f32 const* p,
+    size_t number_of_dimensions
+  )
+{
+  idlib_u32 octaves = IDLIB_NOISE_FRACTAL_NONE == operand->fractal ? 1 : operand->octaves;
+  idlib_f32 frequency = operand->frequency, amplitude = 1.f, sum = 0.f;
+  idlib_f32 scale = SCALE[operand->kind][number_of_dimensions - 2];
+  lane_f32 result = f_set(0.f);
+  for (idlib_u32 o = 0; o < octaves; ++o) {
+    lane_f32 q[MAXIMUM_DIMENSIONS];
+    for (size_t k = 0; k < number_of_dimensions; ++k) {
+      q[k] = f_mul(p[k], f_set(frequency));
+    }
+    // Each octave has its own seed.
+    lane_i32 seed = i_set((idlib_i32)(operand->seed + o * 0x9e3779b9u));
+    lane_f32 n;
+    switch (operand->kind) {
+      case IDLIB_NOISE_PERLIN: {
+        n = lattice_noise(q, number_of_dimensions, seed, true);
+      } break;
+      case IDLIB_NOISE_SIMPLEX: {
+        n = simplex_noise(q, number_of_dimensions, seed);
+      } break;
+      default: {
+        n = lattice_noise(q, number_of_dimensions, seed, false);
+      } break;
+    }
+    n = f_mul(n, f_set(scale));
+    if (IDLIB_NOISE_FRACTAL_RIDGED == operand->fractal) {
+      n = f_sub(f_set(1.f), f_abs(n));
+      n = f_mul(n, n);
+    }
+    result = f_add(result, f_mul(n, f_set(amplitude)));
+    sum += amplitude;
+    amplitude *= operand->gain;
+    frequency *= operand->lacunarity;
+  }
+  return octaves > 1 ? f_mul(result, f_set(1.f / sum)) : result;
+}
+
+// Evaluate the noise at count points whose coordinates are given by the arrays coordinates[k].
+// The results of a partial lane are the same as those of a full lane as the lanes do not interact.
+static void
+evaluate_n
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_f32 const* const* coordinates,
+    size_t number_of_dimensions,
+    size_t count
+  )
+{
+  size_t i = 0;
+  for (; i + LANES <= count; i += LANES) {
+    lane_f32 p[MAXIMUM_DIMENSIONS];
+    for (size_t k = 0; k < number_of_dimensions; ++k) {
+      p[k] = f_load(coordinates[k] + i);
+    }
+    f_store(target + i, evaluate(operand, p, number_of_dimensions));
+  }
+  if (i < count) {
+    idlib_f32 q[MAXIMUM_DIMENSIONS][LANES] = { { 0.f } }, r[LANES];
+    lane_f32 p[MAXIMUM_DIMENSIONS];
+    for (size_t k = 0; k < number_of_dimensions; ++k) {
+      for (size_t j = i; j < count; ++j) {
+        q[k][j - i] = coordinates[k][j];
+      }
+      p[k] = f_load(q[k]);
+    }
+    f_store(r, evaluate(operand, p, number_of_dimensions));
+    for (size_t j = i; j < count; ++j) {
+      target[j] = r[j - i];
+    }
+  }
+}
+
+void
+idlib_noise_f32_set
+  (
+    idlib_noise_f32* target,
+    idlib_u32 kind,
+    idlib_u32 seed
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(kind <= IDLIB_NOISE_VALUE);
+  target->kind = kind;
+  target->fractal = IDLIB_NOISE_FRACTAL_NONE;
+  target->seed = seed;
+  target->octaves = 1;
+  target->frequency = 1.f;
+  target->lacunarity = 2.f;
+  target->gain = 0.5f;
+}
+
+idlib_f32
+idlib_noise_2_f32_evaluate
+  (
+    idlib_noise_f32 const* operand,
+    idlib_vector_2_f32 const* point
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  idlib_f32 const* c[2] = { &point->e[0], &point->e[1] };
+  idlib_f32 r;
+  evaluate_n(&r, operand, c, 2, 1);
+  return r;
+}
+
+void
+idlib_noise_2_f32_evaluate_n
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_2_f32_soa const* points,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  idlib_f32 const* c[2] = { points->x + first, points->y + first };
+  evaluate_n(target + first, operand, c, 2, count);
+}
+
+// Evaluate the noise at a row of a grid. The coordinates of the i-th point are origin + i * spacing along the first axis and row along the other axes.
+static void
+evaluate_row
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_f32 origin,
+    idlib_f32 spacing,
+    idlib_f32 const* row,
+    size_t number_of_dimensions,
+    idlib_u32 count
+  )
+{
+  lane_f32 p[MAXIMUM_DIMENSIONS];
+  for (size_t k = 1; k < number_of_dimensions; ++k) {
+    p[k] = f_set(row[k - 1]);
+  }
+  idlib_f32 x[LANES], r[LANES];
+  for (idlib_u32 i = 0; i < count; i += LANES) {
+    for (idlib_u32 j = 0; j < LANES; ++j) {
+      x[j] = origin + (idlib_f32)(i + j) * spacing;
+    }
+    p[0] = f_load(x);
+    f_store(r, evaluate(operand, p, number_of_dimensions));
+    for (idlib_u32 j = 0; j < LANES && i + j < count; ++j) {
+      target[i + j] = r[j];
+    }
+  }
+}
+
+void
+idlib_noise_2_f32_evaluate_grid
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_2_f32 const* origin,
+    idlib_vector_2_f32 const* spacing,
+    idlib_u32 size_x,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != origin);
+  IDLIB_DEBUG_ASSERT(NULL != spacing);
+  for (idlib_u32 y = first; y < first + count; ++y) {
+    idlib_f32 row[1] = { origin->e[1] + (idlib_f32)y * spacing->e[1] };
+    evaluate_row(target + (size_t)size_x * y, operand, origin->e[0], spacing->e[0], row, 2, size_x);
+  }
+}
+
+idlib_f32
+idlib_noise_3_f32_evaluate
+  (
+    idlib_noise_f32 const* operand,
+    idlib_vector_3_f32 const* point
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  idlib_f32 const* c[3] = { &point->e[0], &point->e[1], &point->e[2] };
+  idlib_f32 r;
+  evaluate_n(&r, operand, c, 3, 1);
+  return r;
+}
+
+void
+idlib_noise_3_f32_evaluate_n
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_3_f32_soa const* points,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  idlib_f32 const* c[3] = { points->x + first, points->y + first, points->z + first };
+  evaluate_n(target + first, operand, c, 3, count);
+}
+
+void
+idlib_noise_3_f32_evaluate_grid
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_3_f32 const* origin,
+    idlib_vector_3_f32 const* spacing,
+    idlib_u32 size_x,
+    idlib_u32 size_y,
+    idlib_u32 first,
+    idlib_u32 count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != origin);
+  IDLIB_DEBUG_ASSERT(NULL != spacing);
+  IDLIB_DEBUG_ASSERT(0 < size_y);
+  for (idlib_u32 r = first; r < first + count; ++r) {
+    idlib_u32 y = r % size_y, z = r / size_y;
+    idlib_f32 row[2] = { origin->e[1] + (idlib_f32)y * spacing->e[1], origin->e[2] + (idlib_f32)z * spacing->e[2] };
+    evaluate_row(target + (size_t)size_x * r, operand, origin->e[0], spacing->e[0], row, 3, size_x);
+  }
+}
+
+idlib_f32
+idlib_noise_4_f32_evaluate
+  (
+    idlib_noise_f32 const* operand,
+    idlib_vector_4_f32 const* point
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  idlib_f32 const* c[4] = { &point->e[0], &point->e[1], &point->e[2], &point->e[3] };
+  idlib_f32 r;
+  evaluate_n(&r, operand, c, 4, 1);
+  return r;
+}
+
+void
+idlib_noise_4_f32_evaluate_n
+  (
+    idlib_f32* target,
+    idlib_noise_f32 const* operand,
+    idlib_vector_4_f32_soa const* points,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  idlib_f32 const* c[4] = { points->x + first, points->y + first, points->z + first, points->w + first };
+  evaluate_n(target + first, operand, c, 4, count);
+}
@@ -0,0 +1,813 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+// fabsf, sqrtf
+#include <math.h>
+
+#include "idlib/math/obb.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+  // __m128i, _mm_*_epi32
+  #include <emmintrin.h>
+#endif
+
+// An epsilon added to the absolute values of the rotation from one box to the other.
+// Counteracts arithmetic errors when two edges are (almost) parallel and their cross product is (almost) the zero vector.
+#define SAT_EPSILON (1e-6f)
+
+// The number of directions of DiTO-14.
+#define DITO_DIRECTIONS (7)
+
+static inline idlib_f32
+dot
+  (
+    idlib_f32 const* u,
+    idlib_f32 const* v
+  )
+{ return u[0] * v[0] + u[1] * v[1] + u[2] * v[2]; }
+
+static inline void
+cross
+  (
+    idlib_f32* target,
+    idlib_f32 const* u,
+    idlib_f32 const* v
+  )
+{
+  idlib_f32 x = u[1] * v[2] - u[2] * v[1];
+  idlib_f32 y = u[2] * v[0] - u[0] * v[2];
+  idlib_f32 z = u[0] * v[1] - u[1] * v[0];
+  target[0] = x;
+  target[1] = y;
+  target[2] = z;
+}
+
+static inline void
+subtract
+  (
+    idlib_f32* target,
+    idlib_f32 const* u,
+    idlib_f32 const* v
+  )
+{
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] = u[k] - v[k];
+  }
+}
+
+// Normalize a vector. Return false if it is (almost) the zero vector.
+static inline bool
+normalize
+  (
+    idlib_f32* target
+  )
+{
+  idlib_f32 l = dot(target, target);
+  if (!(l > 1e-30f)) {
+    return false;
+  }
+  l = 1.f / sqrtf(l);
+  for (size_t k = 0; k < 3; ++k) {
+    target[k] *= l;
+  }
+  return true;
+}
+
+// Compute the minimum and the maximum of the projections of the points onto three axes.
+static void
+project_points
+  (
+    idlib_f32 minimum[3],
+    idlib_f32 maximum[3],
+    idlib_vector_3_f32_soa const* operand,
+    size_t count,
+    idlib_f32 const axes[3][3]
+  )
+{
+  for (size_t k = 0; k < 3; ++k) {
+    minimum[k] = maximum[k] = operand->x[0] * axes[k][0] + operand->y[0] * axes[k][1] + operand->z[0] * axes[k][2];
+  }
+  size_t i = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 minimum4[3], maximum4[3], a[3][3];
+  for (size_t k = 0; k < 3; ++k) {
+    minimum4[k] = _mm_set1_ps(minimum[k]);
+    maximum4[k] = _mm_set1_ps(maximum[k]);
+    for (size_t l = 0; l < 3; ++l) {
+      a[k][l] = _mm_set1_ps(axes[k][l]);
+    }
+  }
+  for (; i + 4 <= count; i += 4) {
+    __m128 x = _mm_loadu_ps(operand->x + i), y = _mm_loadu_ps(operand->y + i), z = _mm_loadu_ps(operand->z + i);
+    for (size_t k = 0; k < 3; ++k) {
+      __m128 p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, a[k][0]), _mm_mul_ps(y, a[k][1])), _mm_mul_ps(z, a[k][2]));
+      minimum4[k] = _mm_min_ps(minimum4[k], p);
+      maximum4[k] = _mm_max_ps(maximum4[k], p);
+    }
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    IDLIB_ALIGNAS(16) idlib_f32 t[2][4];
+    _mm_store_ps(t[0], minimum4[k]);
+    _mm_store_ps(t[1], maximum4[k]);
+    for (size_t j = 0; j < 4; ++j) {
+      minimum[k] = t[0][j] < minimum[k] ? t[0][j] : minimum[k];
+      maximum[k] = t[1][j] > maximum[k] ? t[1][j] : maximum[k];
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_f32 p = operand->x[i] * axes[k][0] + operand->y[i] * axes[k][1] + operand->z[i] * axes[k][2];
+      minimum[k] = p < minimum[k] ? p : minimum[k];
+      maximum[k] = p > maximum[k] ? p : maximum[k];
+    }
+  }
+}
+
+// Assign the box with the specified axes and the specified minimum and maximum projections onto these axes.
+static void
+set_box
+  (
+    idlib_obb_3_f32* target,
+    idlib_f32 const axes[3][3],
+    idlib_f32 const minimum[3],
+    idlib_f32 const maximum[3]
+  )
+{
+  for (size_t k = 0; k < 3; ++k) {
+    target->center.e[k] = 0.f;
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    idlib_f32 m = 0.5f * (minimum[k] + maximum[k]);
+    for (size_t l = 0; l < 3; ++l) {
+      target->rotation.e[l][k] = axes[k][l];
+      target->center.e[l] += axes[k][l] * m;
+    }
+    target->extents.e[k] = 0.5f * (maximum[k] - minimum[k]);
+  }
+}
+
+static void
+set_empty
+  (
+    idlib_obb_3_f32* target
+  )
+{
+  idlib_vector_3_f32_set_zero(&target->center);
+  idlib_matrix_3x3_f32_set_identity(&target->rotation);
+  idlib_vector_3_f32_set_zero(&target->extents);
+}
+
+void
+idlib_obb_3_f32_set_aabb
+  (
+    idlib_obb_3_f32* target,
+    idlib_aabb_3_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t k = 0; k < 3; ++k) {
+    target->center.e[k] = 0.5f * (operand->minimum.e[k] + operand->maximum.e[k]);
+    target->extents.e[k] = 0.5f * (operand->maximum.e[k] - operand->minimum.e[k]);
+  }
+  idlib_matrix_3x3_f32_set_identity(&target->rotation);
+}
+
+void
+idlib_obb_3_f32_fit_covariance
+  (
+    idlib_obb_3_f32* target,
+    idlib_vector_3_f32_soa const* operand,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  if (!count) {
+    set_empty(target);
+    return;
+  }
+  // The sums are accumulated in idlib_f64 arithmetic as the sets of points are large.
+  idlib_f64 mean[3] = { 0., 0., 0. };
+  for (size_t i = 0; i < count; ++i) {
+    mean[0] += operand->x[i];
+    mean[1] += operand->y[i];
+    mean[2] += operand->z[i];
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    mean[k] /= (idlib_f64)count;
+  }
+  idlib_f64 c[6] = { 0., 0., 0., 0., 0., 0. };
+  for (size_t i = 0; i < count; ++i) {
+    idlib_f64 x = operand->x[i] - mean[0], y = operand->y[i] - mean[1], z = operand->z[i] - mean[2];
+    c[0] += x * x;
+    c[1] += x * y;
+    c[2] += x * z;
+    c[3] += y * y;
+    c[4] += y * z;
+    c[5] += z * z;
+  }
+  idlib_matrix_3x3_f32 covariance;
+  covariance.e[0][0] = (idlib_f32)c[0];
+  covariance.e[0][1] = covariance.e[1][0] = (idlib_f32)c[1];
+  covariance.e[0][2] = covariance.e[2][0] = (idlib_f32)c[2];
+  covariance.e[1][1] = (idlib_f32)c[3];
+  covariance.e[1][2] = covariance.e[2][1] = (idlib_f32)c[4];
+  covariance.e[2][2] = (idlib_f32)c[5];
+  idlib_matrix_3x3_f32 vectors;
+  idlib_vector_3_f32 values;
+  idlib_matrix_3x3_f32_eigen_symmetric(&vectors, &values, &covariance);
+  idlib_f32 axes[3][3];
+  for (size_t k = 0; k < 3; ++k) {
+    for (size_t l = 0; l < 3; ++l) {
+      axes[k][l] = vectors.e[l][k];
+    }
+  }
+  idlib_f32 minimum[3], maximum[3];
+  project_points(minimum, maximum, operand, count, axes);
+  set_box(target, axes, minimum, maximum);
+}
+
+// The directions of DiTO-14.
+static const idlib_f32 DITO_NORMALS[DITO_DIRECTIONS][3] = {
+  { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f, 1.f },
+  { 1.f, 1.f, 1.f }, { 1.f, 1.f, -1.f }, { 1.f, -1.f, 1.f }, { 1.f, -1.f, -1.f },
+};
+
+// Find the indices of the points with the minimal and the maximal projection onto each of the DiTO-14 directions.
+// The first of several points with the same projection is selected.
+static void
+find_extremal_points
+  (
+    size_t minimum_index[DITO_DIRECTIONS],
+    size_t maximum_index[DITO_DIRECTIONS],
+    idlib_f32 minimum[DITO_DIRECTIONS],
+    idlib_f32 maximum[DITO_DIRECTIONS],
+    idlib_vector_3_f32_soa const* operand,
+    size_t count
+  )
+{
+  for (size_t k = 0; k < DITO_DIRECTIONS; ++k) {
+    minimum[k] = maximum[k] = operand->x[0] * DITO_NORMALS[k][0] + operand->y[0] * DITO_NORMALS[k][1] + operand->z[0] * DITO_NORMALS[k][2];
+    minimum_index[k] = maximum_index[k] = 0;
+  }
+  size_t i = 1;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  if (count >= 4 && count <= 0x7fffffff) {
+    __m128 minimum4[DITO_DIRECTIONS], maximum4[DITO_DIRECTIONS];
+    __m128i minimum_index4[DITO_DIRECTIONS], maximum_index4[DITO_DIRECTIONS];
+    __m128 x = _mm_loadu_ps(operand->x), y = _mm_loadu_ps(operand->y), z = _mm_loadu_ps(operand->z);
+    __m128i index = _mm_setr_epi32(0, 1, 2, 3), four = _mm_set1_epi32(4);
+    __m128 p[DITO_DIRECTIONS];
+    #define PROJECT() \
+      p[0] = x; \
+      p[1] = y; \
+      p[2] = z; \
+      p[3] = _mm_add_ps(_mm_add_ps(x, y), z); \
+      p[4] = _mm_sub_ps(_mm_add_ps(x, y), z); \
+      p[5] = _mm_add_ps(_mm_sub_ps(x, y), z); \
+      p[6] = _mm_sub_ps(_mm_sub_ps(x, y), z);
+    PROJECT();
+    for (size_t k = 0; k < DITO_DIRECTIONS; ++k) {
+      minimum4[k] = maximum4[k] = p[k];
+      minimum_index4[k] = maximum_index4[k] = index;
+    }
+    for (i = 4; i + 4 <= count; i += 4) {
+      x = _mm_loadu_ps(operand->x + i);
+      y = _mm_loadu_ps(operand->y + i);
+      z = _mm_loadu_ps(operand->z + i);
+      index = _mm_add_epi32(index, four);
+      PROJECT();
+      for (size_t k = 0; k < DITO_DIRECTIONS; ++k) {
+        __m128i less = _mm_castps_si128(_mm_cmplt_ps(p[k], minimum4[k]));
+        __m128i greater = _mm_castps_si128(_mm_cmpgt_ps(p[k], maximum4[k]));
+        minimum4[k] = _mm_min_ps(p[k], minimum4[k]);
+        maximum4[k] = _mm_max_ps(p[k], maximum4[k]);
+        minimum_index4[k] = _mm_or_si128(_mm_and_si128(less, index), _mm_andnot_si128(less, minimum_index4[k]));
+        maximum_index4[k] = _mm_or_si128(_mm_and_si128(greater, index), _mm_andnot_si128(greater, maximum_index4[k]));
+      }
+    }
+    #undef PROJECT
+    // Reduce the lanes. Among points with the same projection, the point of least index is selected.
+    for (size_t k = 0; k < DITO_DIRECTIONS; ++k) {
+      IDLIB_ALIGNAS(16) idlib_f32 value[2][4];
+      IDLIB_ALIGNAS(16) idlib_u32 j[2][4];
+      _mm_store_ps(value[0], minimum4[k]);
+      _mm_store_ps(value[1], maximum4[k]);
+      _mm_store_si128((__m128i*)j[0], minimum_index4[k]);
+      _mm_store_si128((__m128i*)j[1], maximum_index4[k]);
+      for (size_t l = 0; l < 4; ++l) {
+        if (value[0][l] < minimum[k] || (value[0][l] == minimum[k] && j[0][l] < minimum_index[k])) {
+          minimum[k] = value[0][l];
+          minimum_index[k] = j[0][l];
+        }
+        if (value[1][l] > maximum[k] || (value[1][l] == maximum[k] && j[1][l] < maximum_index[k])) {
+          maximum[k] = value[1][l];
+          maximum_index[k] = j[1][l];
+        }
+      }
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    for (size_t k = 0; k < DITO_DIRECTIONS; ++k) {
+      idlib_f32 p = operand->x[i] * DITO_NORMALS[k][0] + operand->y[i] * DITO_NORMALS[k][1] + operand->z[i] * DITO_NORMALS[k][2];
+      if (p < minimum[k]) {
+        minimum[k] = p;
+        minimum_index[k] = i;
+      }
+      if (p > maximum[k]) {
+        maximum[k] = p;
+        maximum_index[k] = i;
+      }
+    }
+  }
+}
+
+// The state of the DiTO-14 candidate search.
+typedef struct dito_state {
+  // The extremal points.
+  idlib_f32 points[2 * DITO_DIRECTIONS][3];
+  // The best axes so far and their quality (the half surface area of the box of the extremal points).
+  idlib_f32 axes[3][3];
+  idlib_f32 quality;
+} dito_state;
+
+// Evaluate the axes (u, v, u x v) where u and v are orthonormal.
+static void
+dito_evaluate
+  (
+    dito_state* state,
+    idlib_f32 const* u,
+    idlib_f32 const* v
+  )
+{
+  idlib_f32 axes[3][3];
+  for (size_t k = 0; k < 3; ++k) {
+    axes[0][k] = u[k];
+    axes[1][k] = v[k];
+  }
+  cross(axes[2], u, v);
+  idlib_f32 l[3];
+  for (size_t k = 0; k < 3; ++k) {
+    idlib_f32 minimum = dot(state->points[0], axes[k]), maximum = minimum;
+    for (size_t i = 1; i < 2 * DITO_DIRECTIONS; ++i) {
+      idlib_f32 p = dot(state->points[i], axes[k]);
+      minimum = p < minimum ? p : minimum;
+      maximum = p > maximum ? p : maximum;
+    }
+    l[k] = maximum - minimum;
+  }
+  idlib_f32 quality = l[0] * l[1] + l[1] * l[2] + l[2] * l[0];
+  if (quality < state->quality) {
+    state->quality = quality;
+    for (size_t k = 0; k < 3; ++k) {
+      for (size_t j = 0; j < 3; ++j) {
+        state->axes[k][j] = axes[k][j];
+      }
+    }
+  }
+}
+
+// Evaluate the axes derived from the triangle (a, b, c): For each edge e, the axes (e, n, e x n) where n is the normal of the triangle.
+static void
+dito_evaluate_triangle
+  (
+    dito_state* state,
+    idlib_f32 const* a,
+    idlib_f32 const* b,
+    idlib_f32 const* c
+  )
+{
+  idlib_f32 e[3][3], n[3];
+  subtract(e[0], b, a);
+  subtract(e[1], c, b);
+  subtract(e[2], a, c);
+  cross(n, e[0], e[1]);
+  if (!normalize(n)) {
+    return;
+  }
+  for (size_t k = 0; k < 3; ++k) {
+    if (normalize(e[k])) {
+      dito_evaluate(state, e[k], n);
+    }
+  }
+}
+
+void
+idlib_obb_3_f32_fit_dito
+  (
+    idlib_obb_3_f32* target,
+    idlib_vector_3_f32_soa const* operand,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  if (!count) {
+    set_empty(target);
+    return;
+  }
+  size_t minimum_index[DITO_DIRECTIONS], maximum_index[DITO_DIRECTIONS];
+  idlib_f32 minimum[DITO_DIRECTIONS], maximum[DITO_DIRECTIONS];
+  find_extremal_points(minimum_index, maximum_index, minimum, maximum, operand, count);
+
+  dito_state state;
+  for (size_t k = 0; k < DITO_DIRECTIONS; ++k) {
+    size_t i = minimum_index[k], j = maximum_index[k];
+    state.points[2 * k + 0][0] = operand->x[i];
+    state.points[2 * k + 0][1] = operand->y[i];
+    state.points[2 * k + 0][2] = operand->z[i];
+    state.points[2 * k + 1][0] = operand->x[j];
+    state.points[2 * k + 1][1] = operand->y[j];
+    state.points[2 * k + 1][2] = operand->z[j];
+  }
+  // The axis-aligned box is the first candidate. Its extents are known from the first pass.
+  idlib_f32 l[3] = { maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2] };
+  idlib_f32 aabb_quality = l[0] * l[1] + l[1] * l[2] + l[2] * l[0];
+  for (size_t k = 0; k < 3; ++k) {
+    for (size_t j = 0; j < 3; ++j) {
+      state.axes[k][j] = k == j ? 1.f : 0.f;
+    }
+  }
+  state.quality = aabb_quality;
+
+  // The first vertex pair of the large base triangle is the pair of extremal points farthest apart.
+  size_t p0 = 0, p1 = 1;
+  idlib_f32 d[3];
+  subtract(d, state.points[1], state.points[0]);
+  idlib_f32 best = dot(d, d);
+  for (size_t k = 1; k < DITO_DIRECTIONS; ++k) {
+    subtract(d, state.points[2 * k + 1], state.points[2 * k]);
+    idlib_f32 t = dot(d, d);
+    if (t > best) {
+      best = t;
+      p0 = 2 * k;
+      p1 = 2 * k + 1;
+    }
+  }
+  idlib_f32 e0[3];
+  subtract(e0, state.points[p1], state.points[p0]);
+  if (normalize(e0)) {
+    // The third vertex of the base triangle is the extremal point farthest from the line through the first two vertices.
+    size_t p2 = p0;
+    best = 0.f;
+    for (size_t i = 0; i < 2 * DITO_DIRECTIONS; ++i) {
+      subtract(d, state.points[i], state.points[p0]);
+      idlib_f32 s = dot(d, e0);
+      idlib_f32 t = dot(d, d) - s * s;
+      if (t > best) {
+        best = t;
+        p2 = i;
+      }
+    }
+    if (p2 != p0) {
+      idlib_f32 const* a = state.points[p0], * b = state.points[p1], * c = state.points[p2];
+      dito_evaluate_triangle(&state, a, b, c);
+      // The apexes of the ditetrahedron are the extremal points farthest below and above the plane of the base triangle.
+      idlib_f32 e1[3], n[3];
+      subtract(e1, c, b);
+      cross(n, e0, e1);
+      if (normalize(n)) {
+        idlib_f32 h = dot(a, n), lowest = h, highest = h;
+        size_t q0 = p0, q1 = p0;
+        for (size_t i = 0; i < 2 * DITO_DIRECTIONS; ++i) {
+          idlib_f32 t = dot(state.points[i], n);
+          if (t < lowest) {
+            lowest = t;
+            q0 = i;
+          }
+          if (t > highest) {
+            highest = t;
+            q1 = i;
+          }
+        }
+        size_t apexes[2] = { q0, q1 };
+        for (size_t k = 0; k < 2; ++k) {
+          if (apexes[k] != p0) {
+            idlib_f32 const* q = state.points[apexes[k]];
+            dito_evaluate_triangle(&state, a, b, q);
+            dito_evaluate_triangle(&state, b, c, q);
+            dito_evaluate_triangle(&state, c, a, q);
+          }
+        }
+      }
+    } else {
+      // The points are collinear. Complete e0 to an orthonormal basis.
+      idlib_f32 u[3] = { 0.f, 0.f, 0.f };
+      u[fabsf(e0[0]) < 0.5f ? 0 : 1] = 1.f;
+      idlib_f32 v[3];
+      cross(v, e0, u);
+      normalize(v);
+      dito_evaluate(&state, e0, v);
+    }
+  }
+  if (state.quality < aabb_quality) {
+    idlib_f32 minimum_[3], maximum_[3];
+    project_points(minimum_, maximum_, operand, count, state.axes);
+    // The projections onto the selected axes of all points can yield a box larger than the axis-aligned box.
+    idlib_f32 m[3] = { maximum_[0] - minimum_[0], maximum_[1] - minimum_[1], maximum_[2] - minimum_[2] };
+    if (m[0] * m[1] + m[1] * m[2] + m[2] * m[0] < aabb_quality) {
+      set_box(target, state.axes, minimum_, maximum_);
+      return;
+    }
+  }
+  idlib_f32 const identity[3][3] = { { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f, 1.f } };
+  set_box(target, identity, minimum, maximum);
+}
+
+// The separating axis test.
+// r[i][j] is the dot product of the i-th axis of the first box and the j-th axis of the second box,
+// t[i] is the dot product of the i-th axis of the first box and the vector from the center of the first box to the center of the second box,
+// a and b are the extents of the first and the second box.
+// Return true if the boxes are separated.
+static inline bool
+separated_1
+  (
+    idlib_f32 const r[3][3],
+    idlib_f32 const t[3],
+    idlib_f32 const a[3],
+    idlib_f32 const b[3]
+  )
+{
+  idlib_f32 s[3][3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      s[i][j] = fabsf(r[i][j]) + SAT_EPSILON;
+    }
+  }
+  bool separated = false;
+  // The axes of the first box.
+  for (size_t i = 0; i < 3; ++i) {
+    idlib_f32 rb = b[0] * s[i][0] + b[1] * s[i][1] + b[2] * s[i][2];
+    separated |= fabsf(t[i]) > a[i] + rb;
+  }
+  // The axes of the second box.
+  for (size_t j = 0; j < 3; ++j) {
+    idlib_f32 ra = a[0] * s[0][j] + a[1] * s[1][j] + a[2] * s[2][j];
+    idlib_f32 d = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+    separated |= fabsf(d) > ra + b[j];
+  }
+  // The cross products of the i-th axis of the first box and the j-th axis of the second box.
+  for (size_t i = 0; i < 3; ++i) {
+    size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+    for (size_t j = 0; j < 3; ++j) {
+      size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      idlib_f32 ra = a[i1] * s[i2][j] + a[i2] * s[i1][j];
+      idlib_f32 rb = b[j1] * s[i][j2] + b[j2] * s[i][j1];
+      idlib_f32 d = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+      separated |= fabsf(d) > ra + rb;
+    }
+  }
+  return separated;
+}
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+static inline __m128
+abs_4
+  (
+    __m128 x
+  )
+{ return _mm_andnot_ps(_mm_set1_ps(-0.f), x); }
+
+// See separated_1. Return the mask of the separated boxes.
+static inline __m128
+separated_4
+  (
+    __m128 const r[3][3],
+    __m128 const t[3],
+    __m128 const a[3],
+    __m128 const b[3]
+  )
+{
+  __m128 epsilon = _mm_set1_ps(SAT_EPSILON);
+  __m128 s[3][3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      s[i][j] = _mm_add_ps(abs_4(r[i][j]), epsilon);
+    }
+  }
+  __m128 separated = _mm_setzero_ps();
+  for (size_t i = 0; i < 3; ++i) {
+    __m128 rb = _mm_add_ps(_mm_add_ps(_mm_mul_ps(b[0], s[i][0]), _mm_mul_ps(b[1], s[i][1])), _mm_mul_ps(b[2], s[i][2]));
+    separated = _mm_or_ps(separated, _mm_cmpgt_ps(abs_4(t[i]), _mm_add_ps(a[i], rb)));
+  }
+  for (size_t j = 0; j < 3; ++j) {
+    __m128 ra = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], s[0][j]), _mm_mul_ps(a[1], s[1][j])), _mm_mul_ps(a[2], s[2][j]));
+    __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(t[0], r[0][j]), _mm_mul_ps(t[1], r[1][j])), _mm_mul_ps(t[2], r[2][j]));
+    separated = _mm_or_ps(separated, _mm_cmpgt_ps(abs_4(d), _mm_add_ps(ra, b[j])));
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+    for (size_t j = 0; j < 3; ++j) {
+      size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+      __m128 ra = _mm_add_ps(_mm_mul_ps(a[i1], s[i2][j]), _mm_mul_ps(a[i2], s[i1][j]));
+      __m128 rb = _mm_add_ps(_mm_mul_ps(b[j1], s[i][j2]), _mm_mul_ps(b[j2], s[i][j1]));
+      __m128 d = _mm_sub_ps(_mm_mul_ps(t[i2], r[i1][j]), _mm_mul_ps(t[i1], r[i2][j]));
+      separated = _mm_or_ps(separated, _mm_cmpgt_ps(abs_4(d), _mm_add_ps(ra, rb)));
+    }
+  }
+  return separated;
+}
+
+// Store the negated separation masks as 0 or 1.
+static inline void
+store_overlap_4
+  (
+    idlib_u8* target,
+    __m128 separated
+  )
+{
+  int m = _mm_movemask_ps(separated);
+  for (size_t j = 0; j < 4; ++j) {
+    target[j] = (m >> j) & 1 ? 0 : 1;
+  }
+}
+
+#endif
+
+// Compute the inputs of the separating axis test for the boxes a and b.
+static inline void
+prepare_1
+  (
+    idlib_f32 r[3][3],
+    idlib_f32 t[3],
+    idlib_obb_3_f32 const* a,
+    idlib_f32 const b_center[3],
+    idlib_f32 const b_rotation[3][3]
+  )
+{
+  idlib_f32 d[3] = { b_center[0] - a->center.e[0], b_center[1] - a->center.e[1], b_center[2] - a->center.e[2] };
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      r[i][j] = a->rotation.e[0][i] * b_rotation[0][j] + a->rotation.e[1][i] * b_rotation[1][j] + a->rotation.e[2][i] * b_rotation[2][j];
+    }
+    t[i] = a->rotation.e[0][i] * d[0] + a->rotation.e[1][i] * d[1] + a->rotation.e[2][i] * d[2];
+  }
+}
+
+bool
+idlib_obb_3_f32_overlap
+  (
+    idlib_obb_3_f32 const* operand1,
+    idlib_obb_3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  idlib_f32 r[3][3], t[3];
+  prepare_1(r, t, operand1, operand2->center.e, operand2->rotation.e);
+  return !separated_1(r, t, operand1->extents.e, operand2->extents.e);
+}
+
+bool
+idlib_obb_3_f32_overlap_aabb
+  (
+    idlib_obb_3_f32 const* operand1,
+    idlib_aabb_3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  idlib_obb_3_f32 b;
+  idlib_obb_3_f32_set_aabb(&b, operand2);
+  return idlib_obb_3_f32_overlap(operand1, &b);
+}
+
+void
+idlib_obb_3_f32_overlap_n
+  (
+    idlib_u8* target,
+    idlib_obb_3_f32 const* operand1,
+    idlib_obb_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  idlib_f32 const* center[3] = { operand2->center.x, operand2->center.y, operand2->center.z };
+  idlib_f32 const* extents[3] = { operand2->extents.x, operand2->extents.y, operand2->extents.z };
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 u[3][3], a_center[3], a[3];
+  for (size_t k = 0; k < 3; ++k) {
+    for (size_t l = 0; l < 3; ++l) {
+      u[k][l] = _mm_set1_ps(operand1->rotation.e[k][l]);
+    }
+    a_center[k] = _mm_set1_ps(operand1->center.e[k]);
+    a[k] = _mm_set1_ps(operand1->extents.e[k]);
+  }
+  for (; i + 4 <= last; i += 4) {
+    __m128 r[3][3], t[3], b[3], d[3], v[3][3];
+    for (size_t k = 0; k < 3; ++k) {
+      d[k] = _mm_sub_ps(_mm_loadu_ps(center[k] + i), a_center[k]);
+      b[k] = _mm_loadu_ps(extents[k] + i);
+      for (size_t l = 0; l < 3; ++l) {
+        v[k][l] = _mm_loadu_ps(operand2->rotation.e[k][l] + i);
+      }
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      for (size_t l = 0; l < 3; ++l) {
+        r[k][l] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u[0][k], v[0][l]), _mm_mul_ps(u[1][k], v[1][l])), _mm_mul_ps(u[2][k], v[2][l]));
+      }
+      t[k] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u[0][k], d[0]), _mm_mul_ps(u[1][k], d[1])), _mm_mul_ps(u[2][k], d[2]));
+    }
+    store_overlap_4(target + i, separated_4(r, t, a, b));
+  }
+#endif
+  for (; i < last; ++i) {
+    idlib_f32 b_center[3], b_rotation[3][3], b[3], r[3][3], t[3];
+    for (size_t k = 0; k < 3; ++k) {
+      b_center[k] = center[k][i];
+      b[k] = extents[k][i];
+      for (size_t l = 0; l < 3; ++l) {
+        b_rotation[k][l] = operand2->rotation.e[k][l][i];
+      }
+    }
+    prepare_1(r, t, operand1, b_center, b_rotation);
+    target[i] = separated_1(r, t, operand1->extents.e, b) ? 0 : 1;
+  }
+}
+
+void
+idlib_obb_3_f32_overlap_aabb_n
+  (
+    idlib_u8* target,
+    idlib_obb_3_f32 const* operand1,
+    idlib_aabb_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  idlib_f32 const* minimum[3] = { operand2->minimum.x, operand2->minimum.y, operand2->minimum.z };
+  idlib_f32 const* maximum[3] = { operand2->maximum.x, operand2->maximum.y, operand2->maximum.z };
+  // The axes of the second box are the standard basis, hence r is the transpose of the rotation of the first box.
+  static const idlib_f32 identity[3][3] = { { 1.f, 0.f, 0.f }, { 0.f, 1.f, 0.f }, { 0.f, 0.f, 1.f } };
+  size_t i = first, last = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 u[3][3], r[3][3], a_center[3], a[3], half = _mm_set1_ps(0.5f);
+  for (size_t k = 0; k < 3; ++k) {
+    for (size_t l = 0; l < 3; ++l) {
+      u[k][l] = _mm_set1_ps(operand1->rotation.e[k][l]);
+    }
+    a_center[k] = _mm_set1_ps(operand1->center.e[k]);
+    a[k] = _mm_set1_ps(operand1->extents.e[k]);
+  }
+  // The same operations as in prepare_1 such that the results are the same.
+  for (size_t k = 0; k < 3; ++k) {
+    for (size_t l = 0; l < 3; ++l) {
+      r[k][l] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u[0][k], _mm_set1_ps(identity[0][l])), _mm_mul_ps(u[1][k], _mm_set1_ps(identity[1][l]))),
+                           _mm_mul_ps(u[2][k], _mm_set1_ps(identity[2][l])));
+    }
+  }
+  for (; i + 4 <= last; i += 4) {
+    __m128 t[3], b[3], d[3];
+    for (size_t k = 0; k < 3; ++k) {
+      __m128 lo = _mm_loadu_ps(minimum[k] + i), hi = _mm_loadu_ps(maximum[k] + i);
+      d[k] = _mm_sub_ps(_mm_mul_ps(half, _mm_add_ps(lo, hi)), a_center[k]);
+      b[k] = _mm_mul_ps(half, _mm_sub_ps(hi, lo));
+    }
+    for (size_t k = 0; k < 3; ++k) {
+      t[k] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(u[0][k], d[0]), _mm_mul_ps(u[1][k], d[1])), _mm_mul_ps(u[2][k], d[2]));
+    }
+    store_overlap_4(target + i, separated_4(r, t, a, b));
+  }
+#endif
+  for (; i < last; ++i) {
+    idlib_f32 b_center[3], b[3], r[3][3], t[3];
+    for (size_t k = 0; k < 3; ++k) {
+      b_center[k] = 0.5f * (minimum[k][i] + maximum[k][i]);
+      b[k] = 0.5f * (maximum[k][i] - minimum[k][i]);
+    }
+    prepare_1(r, t, operand1, b_center, identity);
+    target[i] = separated_1(r, t, operand1->extents.e, b) ? 0 : 1;
+  }
+}
@@ -0,0 +1,554 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "idlib/math/predicates.h"
+
+// fabs, NAN
+#include <math.h>
+
+// The arithmetic below follows
+// Jonathan Richard Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates", 1997.
+// A floating-point expansion is a sum of non-overlapping idlib_f64 values stored in increasing order of magnitude.
+// The sign of an expansion is the sign of its last (largest) component.
+
+// epsilon = 2^-53
+#define EPSILON (1.1102230246251565e-16)
+
+// 2^ceil(53 / 2) + 1
+#define SPLITTER (134217729.0)
+
+// Forward error bounds of the filtered determinants.
+#define ORIENT_2_BOUND ((3.0 + 16.0 * EPSILON) * EPSILON)
+#define ORIENT_3_BOUND ((7.0 + 56.0 * EPSILON) * EPSILON)
+#define IN_CIRCLE_2_BOUND ((10.0 + 96.0 * EPSILON) * EPSILON)
+
+static inline void
+two_sum
+  (
+    idlib_f64 a,
+    idlib_f64 b,
+    idlib_f64* x,
+    idlib_f64* y
+  )
+{
+  idlib_f64 s = a + b;
+  idlib_f64 bv = s - a;
+  idlib_f64 av = s - bv;
+  *x = s;
+  *y = (a - av) + (b - bv);
+}
+
+static inline void
+fast_two_sum
+  (
+    idlib_f64 a,
+    idlib_f64 b,
+    idlib_f64* x,
+    idlib_f64* y
+  )
+{
+  idlib_f64 s = a + b;
+  *x = s;
+  *y = b - (s - a);
+}
+
+static inline void
+two_diff
+  (
+    idlib_f64 a,
+    idlib_f64 b,
+    idlib_f64* x,
+    idlib_f64* y
+  )
+{
+  idlib_f64 d = a - b;
+  idlib_f64 bv = a - d;
+  idlib_f64 av = d + bv;
+  *x = d;
+  *y = (a - av) + (bv - b);
+}
+
+static inline void
+split
+  (
+    idlib_f64 a,
+    idlib_f64* hi,
+    idlib_f64* lo
+  )
+{
+  idlib_f64 c = SPLITTER * a;
+  idlib_f64 abig = c - a;
+  *hi = c - abig;
+  *lo = a - *hi;
+}
+
+static inline void
+two_product
+  (
+    idlib_f64 a,
+    idlib_f64 b,
+    idlib_f64* x,
+    idlib_f64* y
+  )
+{
+  idlib_f64 p = a * b;
+  idlib_f64 ahi, alo, bhi, blo;
+  split(a, &ahi, &alo);
+  split(b, &bhi, &blo);
+  idlib_f64 err1 = p - (ahi * bhi);
+  idlib_f64 err2 = err1 - (alo * bhi);
+  idlib_f64 err3 = err2 - (ahi * blo);
+  *x = p;
+  *y = (alo * blo) - err3;
+}
+
+// The exact value of a * b - c * d as a four component expansion.
+static inline void
+two_two_product_diff
+  (
+    idlib_f64 a,
+    idlib_f64 b,
+    idlib_f64 c,
+    idlib_f64 d,
+    idlib_f64 h[4]
+  )
+{
+  idlib_f64 a1, a0, b1, b0, i, j, k;
+  two_product(a, b, &a1, &a0);
+  two_product(c, d, &b1, &b0);
+  // (a1, a0) - b0
+  two_diff(a0, b0, &i, &h[0]);
+  two_sum(a1, i, &j, &k);
+  // (j, k) - b1
+  two_diff(k, b1, &i, &h[1]);
+  two_sum(j, i, &h[3], &h[2]);
+}
+
+// h := e + f, zero components are eliminated. Returns the number of components of h.
+// h must not alias e or f and must provide space for elen + flen components.
+static int
+expansion_sum
+  (
+    int elen,
+    idlib_f64 const* e,
+    int flen,
+    idlib_f64 const* f,
+    idlib_f64* h
+  )
+{
+  int i = 0, j = 0, k = 0;
+  idlib_f64 q, hh;
+  // Merge the components of e and f in increasing order of magnitude, accumulating with two_sum.
+  if (fabs(e[0]) <= fabs(f[0])) {
+    q = e[i++];
+  } else {
+    q = f[j++];
+  }
+  while (i < elen || j < flen) {
+    idlib_f64 next;
+    if (j == flen || (i < elen && fabs(e[i]) <= fabs(f[j]))) {
+      next = e[i++];
+    } else {
+      next = f[j++];
+    }
+    two_sum(q, next, &q, &hh);
+    if (hh != 0.0) {
+      h[k++] = hh;
+    }
+  }
+  if (q != 0.0 || k == 0) {
+    h[k++] = q;
+  }
+  return k;
+}
+
+// h := b * e, zero components are eliminated. Returns the number of components of h.
+// h must not alias e and must provide space for 2 * elen components.
+static int
+expansion_scale
+  (
+    int elen,
+    idlib_f64 const* e,
+    idlib_f64 b,
+    idlib_f64* h
+  )
+{
+  int k = 0;
+  idlib_f64 q, hh, p1, p0, s;
+  two_product(e[0], b, &q, &hh);
+  if (hh != 0.0) {
+    h[k++] = hh;
+  }
+  for (int i = 1; i < elen; ++i) {
+    two_product(e[i], b, &p1, &p0);
+    two_sum(q, p0, &s, &hh);
+    if (hh != 0.0) {
+      h[k++] = hh;
+    }
+    fast_two_sum(p1, s, &q, &hh);
+    if (hh != 0.0) {
+      h[k++] = hh;
+    }
+  }
+  if (q != 0.0 || k == 0) {
+    h[k++] = q;
+  }
+  return k;
+}
+
+static idlib_f64
+orient_2_exact
+  (
+    idlib_f64 ax,
+    idlib_f64 ay,
+    idlib_f64 bx,
+    idlib_f64 by,
+    idlib_f64 cx,
+    idlib_f64 cy
+  )
+{
+  idlib_f64 aterms[4], bterms[4], cterms[4], v[8], w[12];
+  two_two_product_diff(ax, by, ax, cy, aterms);
+  two_two_product_diff(bx, cy, bx, ay, bterms);
+  two_two_product_diff(cx, ay, cx, by, cterms);
+  int vlen = expansion_sum(4, aterms, 4, bterms, v);
+  int wlen = expansion_sum(vlen, v, 4, cterms, w);
+  return w[wlen - 1];
+}
+
+// The 2x2 minors of four points and the 3x3 minors built from them, shared by orient_3_exact and in_circle_2_exact.
+typedef struct minors {
+  idlib_f64 abc[12], bcd[12], cda[12], dab[12];
+  int abclen, bcdlen, cdalen, dablen;
+} minors;
+
+static void
+minors_compute
+  (
+    minors* m,
+    idlib_f64 ax,
+    idlib_f64 ay,
+    idlib_f64 bx,
+    idlib_f64 by,
+    idlib_f64 cx,
+    idlib_f64 cy,
+    idlib_f64 dx,
+    idlib_f64 dy
+  )
+{
+  idlib_f64 ab[4], bc[4], cd[4], da[4], ac[4], bd[4], t[8];
+  two_two_product_diff(ax, by, bx, ay, ab);
+  two_two_product_diff(bx, cy, cx, by, bc);
+  two_two_product_diff(cx, dy, dx, cy, cd);
+  two_two_product_diff(dx, ay, ax, dy, da);
+  two_two_product_diff(ax, cy, cx, ay, ac);
+  two_two_product_diff(bx, dy, dx, by, bd);
+
+  int tlen;
+  tlen = expansion_sum(4, cd, 4, da, t);
+  m->cdalen = expansion_sum(tlen, t, 4, ac, m->cda);
+  tlen = expansion_sum(4, da, 4, ab, t);
+  m->dablen = expansion_sum(tlen, t, 4, bd, m->dab);
+  for (int i = 0; i < 4; ++i) {
+    bd[i] = -bd[i];
+    ac[i] = -ac[i];
+  }
+  tlen = expansion_sum(4, ab, 4, bc, t);
+  m->abclen = expansion_sum(tlen, t, 4, ac, m->abc);
+  tlen = expansion_sum(4, bc, 4, cd, t);
+  m->bcdlen = expansion_sum(tlen, t, 4, bd, m->bcd);
+}
+
+static idlib_f64
+orient_3_exact
+  (
+    idlib_vector_3_f32 const* a,
+    idlib_vector_3_f32 const* b,
+    idlib_vector_3_f32 const* c,
+    idlib_vector_3_f32 const* d
+  )
+{
+  minors m;
+  minors_compute(&m, a->e[0], a->e[1], b->e[0], b->e[1], c->e[0], c->e[1], d->e[0], d->e[1]);
+
+  idlib_f64 adet[24], bdet[24], cdet[24], ddet[24], abdet[48], cddet[48], deter[96];
+  int alen = expansion_scale(m.bcdlen, m.bcd, a->e[2], adet);
+  int blen = expansion_scale(m.cdalen, m.cda, -(idlib_f64)b->e[2], bdet);
+  int clen = expansion_scale(m.dablen, m.dab, c->e[2], cdet);
+  int dlen = expansion_scale(m.abclen, m.abc, -(idlib_f64)d->e[2], ddet);
+
+  int ablen = expansion_sum(alen, adet, blen, bdet, abdet);
+  int cdlen = expansion_sum(clen, cdet, dlen, ddet, cddet);
+  int len = expansion_sum(ablen, abdet, cdlen, cddet, deter);
+  return deter[len - 1];
+}
+
+// The contribution (x^2 + y^2) * sign * minor of one point to the in-circle determinant.
+static int
+in_circle_2_term
+  (
+    int mlen,
+    idlib_f64 const* minor,
+    idlib_f64 x,
+    idlib_f64 y,
+    idlib_f64 sign,
+    idlib_f64* h
+  )
+{
+  idlib_f64 t24x[24], t48x[48], t24y[24], t48y[48];
+  int xlen = expansion_scale(mlen, minor, x, t24x);
+  int xxlen = expansion_scale(xlen, t24x, sign * x, t48x);
+  int ylen = expansion_scale(mlen, minor, y, t24y);
+  int yylen = expansion_scale(ylen, t24y, sign * y, t48y);
+  return expansion_sum(xxlen, t48x, yylen, t48y, h);
+}
+
+static idlib_f64
+in_circle_2_exact
+  (
+    idlib_vector_2_f32 const* a,
+    idlib_vector_2_f32 const* b,
+    idlib_vector_2_f32 const* c,
+    idlib_vector_2_f32 const* d
+  )
+{
+  minors m;
+  minors_compute(&m, a->e[0], a->e[1], b->e[0], b->e[1], c->e[0], c->e[1], d->e[0], d->e[1]);
+
+  idlib_f64 adet[96], bdet[96], cdet[96], ddet[96], abdet[192], cddet[192], deter[384];
+  int alen = in_circle_2_term(m.bcdlen, m.bcd, a->e[0], a->e[1], +1.0, adet);
+  int blen = in_circle_2_term(m.cdalen, m.cda, b->e[0], b->e[1], -1.0, bdet);
+  int clen = in_circle_2_term(m.dablen, m.dab, c->e[0], c->e[1], +1.0, cdet);
+  int dlen = in_circle_2_term(m.abclen, m.abc, d->e[0], d->e[1], -1.0, ddet);
+
+  int ablen = expansion_sum(alen, adet, blen, bdet, abdet);
+  int cdlen = expansion_sum(clen, cdet, dlen, ddet, cddet);
+  int len = expansion_sum(ablen, abdet, cdlen, cddet, deter);
+  return deter[len - 1];
+}
+
+// The filtered determinants. If the filter is inconclusive, then NAN is returned.
+
+static inline idlib_f64
+orient_2_filtered
+  (
+    idlib_vector_2_f32 const* a,
+    idlib_vector_2_f32 const* b,
+    idlib_vector_2_f32 const* c
+  )
+{
+  idlib_f64 detleft = ((idlib_f64)a->e[0] - (idlib_f64)c->e[0]) * ((idlib_f64)b->e[1] - (idlib_f64)c->e[1]);
+  idlib_f64 detright = ((idlib_f64)a->e[1] - (idlib_f64)c->e[1]) * ((idlib_f64)b->e[0] - (idlib_f64)c->e[0]);
+  idlib_f64 det = detleft - detright;
+  idlib_f64 errbound = ORIENT_2_BOUND * (fabs(detleft) + fabs(detright));
+  return fabs(det) > errbound || (detleft == 0.0 && detright == 0.0) ? det : NAN;
+}
+
+static inline idlib_f64
+orient_3_filtered
+  (
+    idlib_vector_3_f32 const* a,
+    idlib_vector_3_f32 const* b,
+    idlib_vector_3_f32 const* c,
+    idlib_vector_3_f32 const* d
+  )
+{
+  idlib_f64 adx = (idlib_f64)a->e[0] - d->e[0], bdx = (idlib_f64)b->e[0] - d->e[0], cdx = (idlib_f64)c->e[0] - d->e[0];
+  idlib_f64 ady = (idlib_f64)a->e[1] - d->e[1], bdy = (idlib_f64)b->e[1] - d->e[1], cdy = (idlib_f64)c->e[1] - d->e[1];
+  idlib_f64 adz = (idlib_f64)a->e[2] - d->e[2], bdz = (idlib_f64)b->e[2] - d->e[2], cdz = (idlib_f64)c->e[2] - d->e[2];
+
+  idlib_f64 bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  idlib_f64 cdxady = cdx * ady, adxcdy = adx * cdy;
+  idlib_f64 adxbdy = adx * bdy, bdxady = bdx * ady;
+
+  idlib_f64 det = adz * (bdxcdy - cdxbdy)
+                + bdz * (cdxady - adxcdy)
+                + cdz * (adxbdy - bdxady);
+  idlib_f64 permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * fabs(adz)
+                      + (fabs(cdxady) + fabs(adxcdy)) * fabs(bdz)
+                      + (fabs(adxbdy) + fabs(bdxady)) * fabs(cdz);
+  idlib_f64 errbound = ORIENT_3_BOUND * permanent;
+  return fabs(det) > errbound || permanent == 0.0 ? det : NAN;
+}
+
+static inline idlib_f64
+in_circle_2_filtered
+  (
+    idlib_vector_2_f32 const* a,
+    idlib_vector_2_f32 const* b,
+    idlib_vector_2_f32 const* c,
+    idlib_vector_2_f32 const* d
+  )
+{
+  idlib_f64 adx = (idlib_f64)a->e[0] - d->e[0], bdx = (idlib_f64)b->e[0] - d->e[0], cdx = (idlib_f64)c->e[0] - d->e[0];
+  idlib_f64 ady = (idlib_f64)a->e[1] - d->e[1], bdy = (idlib_f64)b->e[1] - d->e[1], cdy = (idlib_f64)c->e[1] - d->e[1];
+
+  idlib_f64 bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  idlib_f64 cdxady = cdx * ady, adxcdy = adx * cdy;
+  idlib_f64 adxbdy = adx * bdy, bdxady = bdx * ady;
+
+  idlib_f64 alift = adx * adx + ady * ady;
+  idlib_f64 blift = bdx * bdx + bdy * bdy;
+  idlib_f64 clift = cdx * cdx + cdy * cdy;
+
+  idlib_f64 det = alift * (bdxcdy - cdxbdy)
+                + blift * (cdxady - adxcdy)
+                + clift * (adxbdy - bdxady);
+  idlib_f64 permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * alift
+                      + (fabs(cdxady) + fabs(adxcdy)) * blift
+                      + (fabs(adxbdy) + fabs(bdxady)) * clift;
+  idlib_f64 errbound = IN_CIRCLE_2_BOUND * permanent;
+  return fabs(det) > errbound || permanent == 0.0 ? det : NAN;
+}
+
+idlib_f64
+idlib_orient_2_f32
+  (
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  IDLIB_DEBUG_ASSERT(NULL != operand3);
+  idlib_f64 det = orient_2_filtered(operand1, operand2, operand3);
+  if (det == det) {
+    return det;
+  }
+  return orient_2_exact(operand1->e[0], operand1->e[1], operand2->e[0], operand2->e[1], operand3->e[0], operand3->e[1]);
+}
+
+idlib_f64
+idlib_orient_3_f32
+  (
+    idlib_vector_3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2,
+    idlib_vector_3_f32 const* operand3,
+    idlib_vector_3_f32 const* operand4
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  IDLIB_DEBUG_ASSERT(NULL != operand3);
+  IDLIB_DEBUG_ASSERT(NULL != operand4);
+  idlib_f64 det = orient_3_filtered(operand1, operand2, operand3, operand4);
+  if (det == det) {
+    return det;
+  }
+  return orient_3_exact(operand1, operand2, operand3, operand4);
+}
+
+idlib_f64
+idlib_in_circle_2_f32
+  (
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3,
+    idlib_vector_2_f32 const* operand4
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  IDLIB_DEBUG_ASSERT(NULL != operand3);
+  IDLIB_DEBUG_ASSERT(NULL != operand4);
+  idlib_f64 det = in_circle_2_filtered(operand1, operand2, operand3, operand4);
+  if (det == det) {
+    return det;
+  }
+  return in_circle_2_exact(operand1, operand2, operand3, operand4);
+}
+
+void
+idlib_orient_2_f32_n
+  (
+    idlib_f64* target,
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  IDLIB_DEBUG_ASSERT(NULL != operand3);
+  for (size_t i = 0; i < count; ++i) {
+    target[i] = orient_2_filtered(operand1 + i, operand2 + i, operand3 + i);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (target[i] != target[i]) {
+      target[i] = orient_2_exact(operand1[i].e[0], operand1[i].e[1], operand2[i].e[0], operand2[i].e[1], operand3[i].e[0], operand3[i].e[1]);
+    }
+  }
+}
+
+void
+idlib_orient_3_f32_n
+  (
+    idlib_f64* target,
+    idlib_vector_3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2,
+    idlib_vector_3_f32 const* operand3,
+    idlib_vector_3_f32 const* operand4,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  IDLIB_DEBUG_ASSERT(NULL != operand3);
+  IDLIB_DEBUG_ASSERT(NULL != operand4);
+  for (size_t i = 0; i < count; ++i) {
+    target[i] = orient_3_filtered(operand1 + i, operand2 + i, operand3 + i, operand4 + i);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (target[i] != target[i]) {
+      target[i] = orient_3_exact(operand1 + i, operand2 + i, operand3 + i, operand4 + i);
+    }
+  }
+}
+
+void
+idlib_in_circle_2_f32_n
+  (
+    idlib_f64* target,
+    idlib_vector_2_f32 const* operand1,
+    idlib_vector_2_f32 const* operand2,
+    idlib_vector_2_f32 const* operand3,
+    idlib_vector_2_f32 const* operand4,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  IDLIB_DEBUG_ASSERT(NULL != operand3);
+  IDLIB_DEBUG_ASSERT(NULL != operand4);
+  for (size_t i = 0; i < count; ++i) {
+    target[i] = in_circle_2_filtered(operand1 + i, operand2 + i, operand3 + i, operand4 + i);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (target[i] != target[i]) {
+      target[i] = in_circle_2_exact(operand1 + i, operand2 + i, operand3 + i, operand4 + i);
+    }
+  }
+}
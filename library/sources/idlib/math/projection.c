@@ -0,0 +1,253 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/projection.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// What the projection kernel computes.
+#define PROJECT_TO_CLIP (0)
+#define PROJECT_TO_NDC (1)
+#define PROJECT_TO_SCREEN (2)
+
+// The coefficients of the mapping from normalized device coordinates to screen coordinates:
+// (x, y, z) is mapped to (a[0] * x + b[0], a[1] * y + b[1], a[2] * z + b[2]).
+typedef struct screen_mapping {
+  idlib_f32 a[3];
+  idlib_f32 b[3];
+} screen_mapping;
+
+static inline void
+screen_mapping_initialize
+  (
+    screen_mapping* target,
+    idlib_viewport_f32 const* viewport
+  )
+{
+  if (viewport) {
+    target->a[0] = 0.5f * viewport->width;
+    target->b[0] = viewport->left + 0.5f * viewport->width;
+    target->a[1] = -0.5f * viewport->height;
+    target->b[1] = viewport->top + 0.5f * viewport->height;
+    target->a[2] = 0.5f;
+    target->b[2] = 0.5f;
+  } else {
+    for (size_t k = 0; k < 3; ++k) {
+      target->a[k] = 1.f;
+      target->b[k] = 0.f;
+    }
+  }
+}
+
+// Project the i-th vector.
+// The operation sequence is the same as in the SIMD path such that the results do not depend on the position of a vector in the stream.
+static inline void
+project_1
+  (
+    idlib_vector_4_f32_soa const* clip_target,
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8* visible,
+    idlib_matrix_4x4_f32 const* m,
+    screen_mapping const* mapping,
+    idlib_vector_3_f32_soa const* operand,
+    size_t i,
+    int mode
+  )
+{
+  idlib_f32 x = operand->x[i], y = operand->y[i], z = operand->z[i];
+  idlib_f32 c[4];
+  for (size_t k = 0; k < 4; ++k) {
+    c[k] = ((m->e[k][0] * x + m->e[k][1] * y) + m->e[k][2] * z) + m->e[k][3];
+  }
+  if (PROJECT_TO_CLIP == mode) {
+    clip_target->x[i] = c[0];
+    clip_target->y[i] = c[1];
+    clip_target->z[i] = c[2];
+    clip_target->w[i] = c[3];
+    return;
+  }
+  idlib_f32 r[3] = { 0.f, 0.f, 0.f };
+  bool v = c[3] > 0.f;
+  if (v) {
+    idlib_f32 inverse = 1.f / c[3];
+    for (size_t k = 0; k < 3; ++k) {
+      r[k] = c[k] * inverse;
+      if (PROJECT_TO_SCREEN == mode) {
+        r[k] = r[k] * mapping->a[k] + mapping->b[k];
+      }
+    }
+  }
+  target->x[i] = r[0];
+  target->y[i] = r[1];
+  target->z[i] = r[2];
+  visible[i] = v ? 1 : 0;
+}
+
+static void
+project_n
+  (
+    idlib_vector_4_f32_soa const* clip_target,
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8* visible,
+    idlib_matrix_4x4_f32 const* m,
+    idlib_viewport_f32 const* viewport,
+    idlib_vector_3_f32_soa const* operand,
+    size_t first,
+    size_t count,
+    int mode
+  )
+{
+  screen_mapping mapping;
+  screen_mapping_initialize(&mapping, viewport);
+  size_t i = first, n = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 e[4][4];
+  for (size_t u = 0; u < 4; ++u) {
+    for (size_t v = 0; v < 4; ++v) {
+      e[u][v] = _mm_set1_ps(m->e[u][v]);
+    }
+  }
+  __m128 a[3], b[3];
+  for (size_t k = 0; k < 3; ++k) {
+    a[k] = _mm_set1_ps(mapping.a[k]);
+    b[k] = _mm_set1_ps(mapping.b[k]);
+  }
+  __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.f);
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(operand->x + i);
+    __m128 y = _mm_loadu_ps(operand->y + i);
+    __m128 z = _mm_loadu_ps(operand->z + i);
+    __m128 c[4];
+    for (size_t k = 0; k < 4; ++k) {
+      c[k] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e[k][0], x), _mm_mul_ps(e[k][1], y)), _mm_mul_ps(e[k][2], z)), e[k][3]);
+    }
+    if (PROJECT_TO_CLIP == mode) {
+      _mm_storeu_ps(clip_target->x + i, c[0]);
+      _mm_storeu_ps(clip_target->y + i, c[1]);
+      _mm_storeu_ps(clip_target->z + i, c[2]);
+      _mm_storeu_ps(clip_target->w + i, c[3]);
+      continue;
+    }
+    // Points behind the camera yield an infinity or a NaN which is masked to zero.
+    __m128 mask = _mm_cmpgt_ps(c[3], zero);
+    __m128 inverse = _mm_div_ps(one, c[3]);
+    for (size_t k = 0; k < 3; ++k) {
+      c[k] = _mm_mul_ps(c[k], inverse);
+      if (PROJECT_TO_SCREEN == mode) {
+        c[k] = _mm_add_ps(_mm_mul_ps(c[k], a[k]), b[k]);
+      }
+      c[k] = _mm_and_ps(c[k], mask);
+    }
+    _mm_storeu_ps(target->x + i, c[0]);
+    _mm_storeu_ps(target->y + i, c[1]);
+    _mm_storeu_ps(target->z + i, c[2]);
+    int bits = _mm_movemask_ps(mask);
+    visible[i + 0] = (bits >> 0) & 1;
+    visible[i + 1] = (bits >> 1) & 1;
+    visible[i + 2] = (bits >> 2) & 1;
+    visible[i + 3] = (bits >> 3) & 1;
+  }
+#endif
+  for (; i < n; ++i) {
+    project_1(clip_target, target, visible, m, &mapping, operand, i, mode);
+  }
+}
+
+bool
+idlib_matrix_4x4_3f_project_point
+  (
+    idlib_vector_3_f32* target,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  idlib_f32 x = operand2->e[0], y = operand2->e[1], z = operand2->e[2];
+  idlib_vector_3_f32 result;
+  idlib_u8 visible;
+  idlib_vector_3_f32_soa target_stream = { &result.e[0], &result.e[1], &result.e[2] };
+  idlib_vector_3_f32_soa operand_stream = { &x, &y, &z };
+  screen_mapping mapping;
+  screen_mapping_initialize(&mapping, NULL);
+  project_1(NULL, &target_stream, &visible, operand1, &mapping, &operand_stream, 0, PROJECT_TO_NDC);
+  *target = result;
+  return 0 != visible;
+}
+
+void
+idlib_matrix_4x4_f32_project_to_clip_n
+  (
+    idlib_vector_4_f32_soa const* target,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_vector_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  project_n(target, NULL, NULL, operand1, NULL, operand2, first, count, PROJECT_TO_CLIP);
+}
+
+void
+idlib_matrix_4x4_f32_project_to_ndc_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8* visible,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_vector_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != visible);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  project_n(NULL, target, visible, operand1, NULL, operand2, first, count, PROJECT_TO_NDC);
+}
+
+void
+idlib_matrix_4x4_f32_project_to_screen_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_u8* visible,
+    idlib_matrix_4x4_f32 const* operand1,
+    idlib_viewport_f32 const* viewport,
+    idlib_vector_3_f32_soa const* operand2,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != visible);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != viewport);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  project_n(NULL, target, visible, operand1, viewport, operand2, first, count, PROJECT_TO_SCREEN);
+}
@@ -0,0 +1,449 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#include "idlib/math/random.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+  // __m128i, _mm_*_epi32, _mm_cvtepi32_ps
+  #include <emmintrin.h>
+#endif
+
+// sqrtf
+#include <math.h>
+
+// The generators and samplers are implemented once on "lanes" of IDLIB_RANDOM_LANES values:
+// On SIMD capable architectures a lane is a SIMD register, otherwise it is an array processed element by element.
+// Both perform the same sequence of correctly rounded operations such that the results are the same.
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+typedef __m128 lane_f32;
+
+typedef __m128i lane_u32;
+
+static inline lane_u32 u_load(idlib_u32 const* x) { return _mm_loadu_si128((__m128i const*)x); }
+static inline void u_store(idlib_u32* target, lane_u32 x) { _mm_storeu_si128((__m128i*)target, x); }
+static inline lane_u32 u_add(lane_u32 x, lane_u32 y) { return _mm_add_epi32(x, y); }
+static inline lane_u32 u_xor(lane_u32 x, lane_u32 y) { return _mm_xor_si128(x, y); }
+static inline lane_u32 u_shift_left(lane_u32 x, int n) { return _mm_slli_epi32(x, n); }
+static inline lane_u32 u_shift_right(lane_u32 x, int n) { return _mm_srli_epi32(x, n); }
+static inline lane_u32 u_rotate_left(lane_u32 x, int n) { return _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - n)); }
+static inline lane_u32 u_set(idlib_u32 x) { return _mm_set1_epi32((int)x); }
+// The bits of the mask i are set in x.
+static inline lane_u32 u_bit(lane_u32 x, idlib_u32 i) { return _mm_cmpeq_epi32(_mm_and_si128(x, _mm_set1_epi32((int)i)), _mm_set1_epi32((int)i)); }
+// Convert integers smaller than 2^31.
+static inline lane_f32 u_to_f(lane_u32 x) { return _mm_cvtepi32_ps(x); }
+
+static inline lane_f32 f_set(idlib_f32 x) { return _mm_set1_ps(x); }
+static inline void f_store(idlib_f32* target, lane_f32 x) { _mm_storeu_ps(target, x); }
+static inline lane_f32 f_add(lane_f32 x, lane_f32 y) { return _mm_add_ps(x, y); }
+static inline lane_f32 f_sub(lane_f32 x, lane_f32 y) { return _mm_sub_ps(x, y); }
+static inline lane_f32 f_mul(lane_f32 x, lane_f32 y) { return _mm_mul_ps(x, y); }
+static inline lane_f32 f_max(lane_f32 x, lane_f32 y) { return _mm_max_ps(x, y); }
+static inline lane_f32 f_sqrt(lane_f32 x) { return _mm_sqrt_ps(x); }
+// Truncate non-negative values.
+static inline lane_u32 f_truncate(lane_f32 x) { return _mm_cvttps_epi32(x); }
+// Select x if c is true and y otherwise.
+static inline lane_f32 f_select(lane_u32 c, lane_f32 x, lane_f32 y) { return _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(c), x), _mm_andnot_ps(_mm_castsi128_ps(c), y)); }
+// Negate x if c is true.
+static inline lane_f32 f_negate_if(lane_u32 c, lane_f32 x) { return _mm_xor_ps(x, _mm_and_ps(_mm_castsi128_ps(c), _mm_set1_ps(-0.f))); }
+
+#else
+
+typedef struct lane_f32 { idlib_f32 e[IDLIB_RANDOM_LANES]; } lane_f32;
+
+typedef struct lane_u32 { idlib_u32 e[IDLIB_RANDOM_LANES]; } lane_u32;
+
+#define LANEWISE(TYPE, EXPRESSION) \
+  TYPE r; \
+  for (size_t l = 0; l < IDLIB_RANDOM_LANES; ++l) { \
+    r.e[l] = (EXPRESSION); \
+  } \
+  return r;
+
+static inline lane_u32 u_load(idlib_u32 const* x) { LANEWISE(lane_u32, x[l]) }
+static inline void u_store(idlib_u32* target, lane_u32 x) { for (size_t l = 0; l < IDLIB_RANDOM_LANES; ++l) { target[l] = x.e[l]; } }
+static inline lane_u32 u_add(lane_u32 x, lane_u32 y) { LANEWISE(lane_u32, x.e[l] + y.e[l]) }
+static inline lane_u32 u_xor(lane_u32 x, lane_u32 y) { LANEWISE(lane_u32, x.e[l] ^ y.e[l]) }
+static inline lane_u32 u_shift_left(lane_u32 x, int n) { LANEWISE(lane_u32, x.e[l] << n) }
+static inline lane_u32 u_shift_right(lane_u32 x, int n) { LANEWISE(lane_u32, x.e[l] >> n) }
+static inline lane_u32 u_rotate_left(lane_u32 x, int n) { LANEWISE(lane_u32, (x.e[l] << n) | (x.e[l] >> (32 - n))) }
+static inline lane_u32 u_set(idlib_u32 x) { LANEWISE(lane_u32, x) }
+// The bits of the mask i are set in x.
+static inline lane_u32 u_bit(lane_u32 x, idlib_u32 i) { LANEWISE(lane_u32, (x.e[l] & i) == i ? 0xffffffffu : 0u) }
+// Convert integers smaller than 2^31.
+static inline lane_f32 u_to_f(lane_u32 x) { LANEWISE(lane_f32, (idlib_f32)x.e[l]) }
+
+static inline lane_f32 f_set(idlib_f32 x) { LANEWISE(lane_f32, x) }
+static inline void f_store(idlib_f32* target, lane_f32 x) { for (size_t l = 0; l < IDLIB_RANDOM_LANES; ++l) { target[l] = x.e[l]; } }
+static inline lane_f32 f_add(lane_f32 x, lane_f32 y) { LANEWISE(lane_f32, x.e[l] + y.e[l]) }
+static inline lane_f32 f_sub(lane_f32 x, lane_f32 y) { LANEWISE(lane_f32, x.e[l] - y.e[l]) }
+static inline lane_f32 f_mul(lane_f32 x, lane_f32 y) { LANEWISE(lane_f32, x.e[l] * y.e[l]) }
+// Returns y if x and y are zeroes or x is NaN like the SIMD version.
+static inline lane_f32 f_max(lane_f32 x, lane_f32 y) { LANEWISE(lane_f32, x.e[l] > y.e[l] ? x.e[l] : y.e[l]) }
+static inline lane_f32 f_sqrt(lane_f32 x) { LANEWISE(lane_f32, sqrtf(x.e[l])) }
+// Truncate non-negative values.
+static inline lane_u32 f_truncate(lane_f32 x) { LANEWISE(lane_u32, (idlib_u32)x.e[l]) }
+// Select x if c is true and y otherwise.
+static inline lane_f32 f_select(lane_u32 c, lane_f32 x, lane_f32 y) { LANEWISE(lane_f32, c.e[l] ? x.e[l] : y.e[l]) }
+// Negate x if c is true.
+static inline lane_f32 f_negate_if(lane_u32 c, lane_f32 x) { LANEWISE(lane_f32, c.e[l] ? -x.e[l] : x.e[l]) }
+
+#undef LANEWISE
+
+#endif
+
+// Advance the lanes of a generator and return the next numbers (xoshiro128**).
+static inline lane_u32
+next_u32
+  (
+    idlib_random* generator
+  )
+{
+  lane_u32 s0 = u_load(generator->state[0]), s1 = u_load(generator->state[1]),
+           s2 = u_load(generator->state[2]), s3 = u_load(generator->state[3]);
+  // (s1 * 5 <<< 7) * 9
+  lane_u32 r = u_rotate_left(u_add(u_shift_left(s1, 2), s1), 7);
+  r = u_add(u_shift_left(r, 3), r);
+  lane_u32 t = u_shift_left(s1, 9);
+  s2 = u_xor(s2, s0);
+  s3 = u_xor(s3, s1);
+  s1 = u_xor(s1, s2);
+  s0 = u_xor(s0, s3);
+  s2 = u_xor(s2, t);
+  s3 = u_rotate_left(s3, 11);
+  u_store(generator->state[0], s0);
+  u_store(generator->state[1], s1);
+  u_store(generator->state[2], s2);
+  u_store(generator->state[3], s3);
+  return r;
+}
+
+// The next numbers in [0, 1).
+static inline lane_f32
+next_f32
+  (
+    idlib_random* generator
+  )
+{ return f_mul(u_to_f(u_shift_right(next_u32(generator), 8)), f_set(1.f / 16777216.f)); }
+
+// The cosine and the sine of 2 pi u for u in [0, 1).
+static inline void
+cosine_sine
+  (
+    lane_f32* cosine,
+    lane_f32* sine,
+    lane_f32 u
+  )
+{
+  // The quadrant q and the angle a in [0, pi / 2) within the quadrant.
+  lane_f32 t = f_mul(u, f_set(4.f));
+  lane_u32 q = f_truncate(t);
+  lane_f32 a = f_mul(f_sub(t, u_to_f(q)), f_set(IDLIB_PI_F32 * 0.5f));
+  lane_f32 a2 = f_mul(a, a);
+  // The Taylor polynomials of the sine (to degree 11) and the cosine (to degree 12) are accurate to 1e-7 in [0, pi / 2).
+  lane_f32 s = f_set(-1.f / 39916800.f);
+  s = f_add(f_mul(s, a2), f_set(1.f / 362880.f));
+  s = f_add(f_mul(s, a2), f_set(-1.f / 5040.f));
+  s = f_add(f_mul(s, a2), f_set(1.f / 120.f));
+  s = f_add(f_mul(s, a2), f_set(-1.f / 6.f));
+  s = f_add(f_mul(f_mul(s, a2), a), a);
+  lane_f32 c = f_set(1.f / 479001600.f);
+  c = f_add(f_mul(c, a2), f_set(-1.f / 3628800.f));
+  c = f_add(f_mul(c, a2), f_set(1.f / 40320.f));
+  c = f_add(f_mul(c, a2), f_set(-1.f / 720.f));
+  c = f_add(f_mul(c, a2), f_set(1.f / 24.f));
+  c = f_add(f_mul(c, a2), f_set(-0.5f));
+  c = f_add(f_mul(c, a2), f_set(1.f));
+  // Rotate by q quarter turns: (c, s), (-s, c), (-c, -s), (s, -c).
+  lane_u32 odd = u_bit(q, 1);
+  *cosine = f_negate_if(u_bit(u_add(q, u_set(1)), 2), f_select(odd, s, c));
+  *sine = f_negate_if(u_bit(q, 2), f_select(odd, c, s));
+}
+
+// Store the values of a lane to target[0], ..., target[count - 1] where count <= IDLIB_RANDOM_LANES.
+static inline void
+store
+  (
+    idlib_f32* target,
+    lane_f32 x,
+    size_t count
+  )
+{
+  if (IDLIB_RANDOM_LANES == count) {
+    f_store(target, x);
+  } else {
+    idlib_f32 r[IDLIB_RANDOM_LANES];
+    f_store(r, x);
+    for (size_t l = 0; l < count; ++l) {
+      target[l] = r[l];
+    }
+  }
+}
+
+// SplitMix64.
+static idlib_u64
+split_mix_64
+  (
+    idlib_u64* state
+  )
+{
+  idlib_u64 z = (*state += UINT64_C(0x9e3779b97f4a7c15));
+  z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+  return z ^ (z >> 31);
+}
+
+void
+idlib_random_initialize
+  (
+    idlib_random* target,
+    idlib_u64 seed,
+    idlib_u64 stream
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  idlib_u64 state = seed ^ split_mix_64(&stream);
+  idlib_u32 s[4];
+  do {
+    idlib_u64 a = split_mix_64(&state), b = split_mix_64(&state);
+    s[0] = (idlib_u32)a; s[1] = (idlib_u32)(a >> 32); s[2] = (idlib_u32)b; s[3] = (idlib_u32)(b >> 32);
+  } while (0 == (s[0] | s[1] | s[2] | s[3]));
+  // The polynomial advancing a xoshiro128 generator by 2^64 numbers.
+  static idlib_u32 const JUMP[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+  for (size_t l = 0; l < IDLIB_RANDOM_LANES; ++l) {
+    for (size_t k = 0; k < 4; ++k) {
+      target->state[k][l] = s[k];
+    }
+    idlib_u32 j[4] = { 0, 0, 0, 0 };
+    for (size_t i = 0; i < 4; ++i) {
+      for (idlib_u32 b = 0; b < 32; ++b) {
+        if (JUMP[i] & (1u << b)) {
+          for (size_t k = 0; k < 4; ++k) {
+            j[k] ^= s[k];
+          }
+        }
+        idlib_u32 t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = (s[3] << 11) | (s[3] >> 21);
+      }
+    }
+    for (size_t k = 0; k < 4; ++k) {
+      s[k] = j[k];
+    }
+  }
+}
+
+void
+idlib_random_u32_n
+  (
+    idlib_u32* target,
+    idlib_random* generator,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  for (size_t i = 0; i < count; i += IDLIB_RANDOM_LANES) {
+    lane_u32 x = next_u32(generator);
+    if (i + IDLIB_RANDOM_LANES <= count) {
+      u_store(target + i, x);
+    } else {
+      idlib_u32 r[IDLIB_RANDOM_LANES];
+      u_store(r, x);
+      for (size_t l = 0; i + l < count; ++l) {
+        target[i + l] = r[l];
+      }
+    }
+  }
+}
+
+void
+idlib_random_f32_n
+  (
+    idlib_f32* target,
+    idlib_random* generator,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  for (size_t i = 0; i < count; i += IDLIB_RANDOM_LANES) {
+    size_t n = count - i < IDLIB_RANDOM_LANES ? count - i : IDLIB_RANDOM_LANES;
+    store(target + i, next_f32(generator), n);
+  }
+}
+
+void
+idlib_random_sample_box_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    idlib_aabb_3_f32 const* box,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  IDLIB_DEBUG_ASSERT(NULL != box);
+  idlib_f32* t[3] = { target->x + first, target->y + first, target->z + first };
+  for (size_t i = 0; i < count; i += IDLIB_RANDOM_LANES) {
+    size_t n = count - i < IDLIB_RANDOM_LANES ? count - i : IDLIB_RANDOM_LANES;
+    for (size_t k = 0; k < 3; ++k) {
+      lane_f32 u = next_f32(generator);
+      lane_f32 minimum = f_set(box->minimum.e[k]), extent = f_set(box->maximum.e[k] - box->minimum.e[k]);
+      store(t[k] + i, f_add(minimum, f_mul(u, extent)), n);
+    }
+  }
+}
+
+// Sample points on the unit sphere with z coordinates in [1 - 2 * extent, 1] or,
+// if disk is true, in the unit disk (with z coordinates of zero) or projected from the unit disk onto the unit hemisphere.
+static void
+sample_sphere
+  (
+    idlib_f32* const* target,
+    idlib_random* generator,
+    idlib_f32 extent,
+    bool disk,
+    size_t count
+  )
+{
+  for (size_t i = 0; i < count; i += IDLIB_RANDOM_LANES) {
+    size_t n = count - i < IDLIB_RANDOM_LANES ? count - i : IDLIB_RANDOM_LANES;
+    lane_f32 u = next_f32(generator), v = next_f32(generator);
+    lane_f32 r, z;
+    if (disk) {
+      r = f_sqrt(u);
+      z = f_sqrt(f_max(f_sub(f_set(1.f), u), f_set(0.f)));
+    } else {
+      z = f_sub(f_set(1.f), f_mul(u, f_set(2.f * extent)));
+      r = f_sqrt(f_max(f_sub(f_set(1.f), f_mul(z, z)), f_set(0.f)));
+    }
+    lane_f32 c, s;
+    cosine_sine(&c, &s, v);
+    store(target[0] + i, f_mul(r, c), n);
+    store(target[1] + i, f_mul(r, s), n);
+    if (target[2]) {
+      store(target[2] + i, z, n);
+    }
+  }
+}
+
+void
+idlib_random_sample_sphere_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  idlib_f32* t[3] = { target->x + first, target->y + first, target->z + first };
+  sample_sphere(t, generator, 1.f, false, count);
+}
+
+void
+idlib_random_sample_hemisphere_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  idlib_f32* t[3] = { target->x + first, target->y + first, target->z + first };
+  sample_sphere(t, generator, 0.5f, false, count);
+}
+
+void
+idlib_random_sample_cosine_hemisphere_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  idlib_f32* t[3] = { target->x + first, target->y + first, target->z + first };
+  sample_sphere(t, generator, 0.f, true, count);
+}
+
+void
+idlib_random_sample_disk_2_f32_n
+  (
+    idlib_vector_2_f32_soa const* target,
+    idlib_random* generator,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  idlib_f32* t[3] = { target->x + first, target->y + first, NULL };
+  sample_sphere(t, generator, 0.f, true, count);
+}
+
+void
+idlib_random_sample_triangle_3_f32_n
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_random* generator,
+    idlib_vector_3_f32 const* operand1,
+    idlib_vector_3_f32 const* operand2,
+    idlib_vector_3_f32 const* operand3,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != generator);
+  IDLIB_DEBUG_ASSERT(NULL != operand1);
+  IDLIB_DEBUG_ASSERT(NULL != operand2);
+  IDLIB_DEBUG_ASSERT(NULL != operand3);
+  idlib_f32* t[3] = { target->x + first, target->y + first, target->z + first };
+  for (size_t i = 0; i < count; i += IDLIB_RANDOM_LANES) {
+    size_t n = count - i < IDLIB_RANDOM_LANES ? count - i : IDLIB_RANDOM_LANES;
+    lane_f32 u = f_sqrt(next_f32(generator)), v = next_f32(generator);
+    lane_f32 b = f_mul(u, f_sub(f_set(1.f), v)), c = f_mul(u, v);
+    // a + b (B - A) + c (C - A) with a = 1 - b - c.
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_f32 a = operand1->e[k];
+      lane_f32 p = f_add(f_add(f_set(a), f_mul(b, f_set(operand2->e[k] - a))), f_mul(c, f_set(operand3->e[k] - a)));
+      store(t[k] + i, p, n);
+    }
+  }
+}
@@ -0,0 +1,320 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#include "idlib/math/shadow.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// floorf, powf, INFINITY
+#include <math.h>
+
+// The number of lights processed at once.
+#define LANES (4)
+
+// The cube map matrices are computed on "lanes" of LANES values:
+// On SIMD capable architectures a lane is a SIMD register, otherwise it is an array processed element by element.
+// Both perform the same sequence of correctly rounded operations such that the results are the same.
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+typedef __m128 lane;
+
+static inline lane f_set(idlib_f32 x) { return _mm_set1_ps(x); }
+static inline lane f_load(idlib_f32 const* x) { return _mm_loadu_ps(x); }
+static inline void f_store(idlib_f32* target, lane x) { _mm_storeu_ps(target, x); }
+static inline lane f_add(lane x, lane y) { return _mm_add_ps(x, y); }
+static inline lane f_sub(lane x, lane y) { return _mm_sub_ps(x, y); }
+static inline lane f_mul(lane x, lane y) { return _mm_mul_ps(x, y); }
+static inline lane f_div(lane x, lane y) { return _mm_div_ps(x, y); }
+
+#else
+
+typedef struct lane { idlib_f32 e[LANES]; } lane;
+
+#define LANEWISE(TYPE, EXPRESSION) \
+  TYPE r; \
+  for (size_t l = 0; l < LANES; ++l) { \
+    r.e[l] = (EXPRESSION); \
+  } \
+  return r;
+
+static inline lane f_set(idlib_f32 x) { LANEWISE(lane, x) }
+static inline lane f_load(idlib_f32 const* x) { LANEWISE(lane, x[l]) }
+static inline void f_store(idlib_f32* target, lane x) { for (size_t l = 0; l < LANES; ++l) { target[l] = x.e[l]; } }
+static inline lane f_add(lane x, lane y) { LANEWISE(lane, x.e[l] + y.e[l]) }
+static inline lane f_sub(lane x, lane y) { LANEWISE(lane, x.e[l] - y.e[l]) }
+static inline lane f_mul(lane x, lane y) { LANEWISE(lane, x.e[l] * y.e[l]) }
+static inline lane f_div(lane x, lane y) { LANEWISE(lane, x.e[l] / y.e[l]) }
+
+#undef LANEWISE
+
+#endif
+
+void
+idlib_shadow_cascades_f32_get_splits
+  (
+    idlib_f32* target,
+    idlib_f32 near_distance,
+    idlib_f32 far_distance,
+    idlib_f32 weight,
+    idlib_u32 number_of_cascades
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(0.f < near_distance && near_distance < far_distance);
+  IDLIB_DEBUG_ASSERT(0.f <= weight && weight <= 1.f);
+  IDLIB_DEBUG_ASSERT(0 < number_of_cascades);
+  target[0] = near_distance;
+  for (idlib_u32 i = 1; i < number_of_cascades; ++i) {
+    idlib_f32 t = (idlib_f32)i / (idlib_f32)number_of_cascades;
+    idlib_f32 logarithmic = near_distance * powf(far_distance / near_distance, t);
+    idlib_f32 uniform = near_distance + (far_distance - near_distance) * t;
+    target[i] = weight * logarithmic + (1.f - weight) * uniform;
+  }
+  target[number_of_cascades] = far_distance;
+}
+
+// Assign target the inverse of the affine transformation operand.
+static void
+invert_affine
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  )
+{
+  idlib_f32 const (*m)[4] = operand->e;
+  // The cofactors of the upper left 3x3 matrix.
+  idlib_f32 c[3][3] = {
+    { m[1][1] * m[2][2] - m[1][2] * m[2][1], m[1][2] * m[2][0] - m[1][0] * m[2][2], m[1][0] * m[2][1] - m[1][1] * m[2][0] },
+    { m[0][2] * m[2][1] - m[0][1] * m[2][2], m[0][0] * m[2][2] - m[0][2] * m[2][0], m[0][1] * m[2][0] - m[0][0] * m[2][1] },
+    { m[0][1] * m[1][2] - m[0][2] * m[1][1], m[0][2] * m[1][0] - m[0][0] * m[1][2], m[0][0] * m[1][1] - m[0][1] * m[1][0] },
+  };
+  idlib_f32 inverse_determinant = 1.f / (m[0][0] * c[0][0] + m[0][1] * c[0][1] + m[0][2] * c[0][2]);
+  for (size_t i = 0; i < 3; ++i) {
+    // The inverse is the transposed matrix of cofactors divided by the determinant.
+    for (size_t j = 0; j < 3; ++j) {
+      target->e[i][j] = c[j][i] * inverse_determinant;
+    }
+    target->e[i][3] = -(target->e[i][0] * m[0][3] + target->e[i][1] * m[1][3] + target->e[i][2] * m[2][3]);
+    target->e[3][i] = 0.f;
+  }
+  target->e[3][3] = 1.f;
+}
+
+// Assign target the rotation into the light space of a light shining into the direction direction.
+// The light shines along the negative z-axis of the light space.
+static void
+set_light_rotation
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_vector_3_f32 const* direction
+  )
+{
+  idlib_vector_3_f32 forward, up, right;
+  idlib_vector_3_f32_normalize(&forward, direction);
+  // The up vector is the y-axis unless the light shines (almost) along it.
+  if (forward.e[1] < 0.99f && forward.e[1] > -0.99f) {
+    idlib_vector_3_f32_set(&up, 0.f, 1.f, 0.f);
+  } else {
+    idlib_vector_3_f32_set(&up, 0.f, 0.f, 1.f);
+  }
+  idlib_vector_3_f32_cross(&right, &forward, &up);
+  idlib_vector_3_f32_normalize(&right, &right);
+  idlib_vector_3_f32_cross(&up, &right, &forward);
+  for (size_t j = 0; j < 3; ++j) {
+    target->e[0][j] = right.e[j];
+    target->e[1][j] = up.e[j];
+    target->e[2][j] = -forward.e[j];
+    target->e[3][j] = 0.f;
+  }
+  target->e[0][3] = 0.f;
+  target->e[1][3] = 0.f;
+  target->e[2][3] = 0.f;
+  target->e[3][3] = 1.f;
+}
+
+// Snap the interval [*minimum, *maximum] of a view volume to a shadow map of the specified resolution:
+// The interval is enlarged such that its bounds are multiples of the size of a texel.
+static void
+snap
+  (
+    idlib_f32* minimum,
+    idlib_f32* maximum,
+    idlib_u32 resolution
+  )
+{
+  // Choosing the size of a texel as the extent divided by resolution - 1 leaves room for moving the minimum by up to one texel.
+  idlib_f32 texel = (*maximum - *minimum) / (idlib_f32)(resolution - 1);
+  if (texel > 0.f) {
+    *minimum = floorf(*minimum / texel) * texel;
+    *maximum = *minimum + texel * (idlib_f32)resolution;
+  }
+}
+
+void
+idlib_shadow_cascades_f32_set_view_projections
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_matrix_4x4_f32 const* view,
+    idlib_f32 field_of_view_y,
+    idlib_f32 aspect_ratio,
+    idlib_f32 const* splits,
+    idlib_u32 number_of_cascades,
+    idlib_vector_3_f32 const* direction,
+    idlib_u32 resolution,
+    idlib_f32 extension
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != view);
+  IDLIB_DEBUG_ASSERT(NULL != splits);
+  IDLIB_DEBUG_ASSERT(NULL != direction);
+  IDLIB_DEBUG_ASSERT(1 < resolution);
+  idlib_matrix_4x4_f32 camera, light, to_light;
+  // The camera space to world space transformation.
+  invert_affine(&camera, view);
+  set_light_rotation(&light, direction);
+  // The camera space to light space transformation.
+  idlib_matrix_4x4_f32_multiply(&to_light, &light, &camera);
+  // The half extents of the frustum at distance one.
+  idlib_f32 y = idlib_tan_f32(idlib_deg_to_rad_f32(field_of_view_y) / 2.f);
+  idlib_f32 x = y * aspect_ratio;
+  for (idlib_u32 i = 0; i < number_of_cascades; ++i) {
+    idlib_vector_3_f32 minimum, maximum;
+    idlib_vector_3_f32_set(&minimum, INFINITY, INFINITY, INFINITY);
+    idlib_vector_3_f32_set(&maximum, -INFINITY, -INFINITY, -INFINITY);
+    for (size_t k = 0; k < 8; ++k) {
+      idlib_f32 d = splits[i + (k >> 2)];
+      idlib_vector_3_f32 corner;
+      idlib_vector_3_f32_set(&corner, (k & 1) ? d * x : -d * x, (k & 2) ? d * y : -d * y, -d);
+      idlib_matrix_4x4_3f_transform_point(&corner, &to_light, &corner);
+      for (size_t j = 0; j < 3; ++j) {
+        minimum.e[j] = corner.e[j] < minimum.e[j] ? corner.e[j] : minimum.e[j];
+        maximum.e[j] = corner.e[j] > maximum.e[j] ? corner.e[j] : maximum.e[j];
+      }
+    }
+    snap(&minimum.e[0], &maximum.e[0], resolution);
+    snap(&minimum.e[1], &maximum.e[1], resolution);
+    // The light looks along the negative z-axis, hence the distances are the negated z coordinates.
+    idlib_matrix_4x4_f32 projection;
+    idlib_matrix_4x4_f32_set_orthographic(&projection, minimum.e[0], maximum.e[0], minimum.e[1], maximum.e[1], -maximum.e[2] - extension, -minimum.e[2]);
+    idlib_matrix_4x4_f32_multiply(&target[i], &projection, &light);
+  }
+}
+
+// The rows of the rotations of the look-at transformations of the faces of a cube map.
+static idlib_f32 const CUBE_ROTATIONS[IDLIB_SHADOW_CUBE_FACES][3][3] = {
+  { { 0.f, 0.f, -1.f }, { 0.f, -1.f, 0.f }, { -1.f, 0.f, 0.f } },
+  { { 0.f, 0.f, 1.f }, { 0.f, -1.f, 0.f }, { 1.f, 0.f, 0.f } },
+  { { 1.f, 0.f, 0.f }, { 0.f, 0.f, 1.f }, { 0.f, -1.f, 0.f } },
+  { { 1.f, 0.f, 0.f }, { 0.f, 0.f, -1.f }, { 0.f, 1.f, 0.f } },
+  { { 1.f, 0.f, 0.f }, { 0.f, -1.f, 0.f }, { 0.f, 0.f, -1.f } },
+  { { -1.f, 0.f, 0.f }, { 0.f, -1.f, 0.f }, { 0.f, 0.f, 1.f } },
+};
+
+// Compute the view projection matrices of the cube maps of the lights [i, i + count) where count <= LANES.
+// The positions and far distances of the lights are px, py, pz, and far_distances.
+// f is the cotangent of the half of the field of view.
+static inline void
+set_cube
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_f32 const* px,
+    idlib_f32 const* py,
+    idlib_f32 const* pz,
+    idlib_f32 const* far_distances,
+    idlib_f32 near_distance,
+    idlib_f32 f,
+    size_t count
+  )
+{
+  lane x = f_load(px), y = f_load(py), z = f_load(pz), n = f_set(near_distance), r = f_load(far_distances);
+  // The projection maps the z coordinate z' of the view space to (a z' + b) / -z'.
+  lane d = f_sub(n, r);
+  idlib_f32 a[LANES], b[LANES];
+  f_store(a, f_div(f_add(r, n), d));
+  f_store(b, f_div(f_mul(f_mul(f_set(2.f), r), n), d));
+  // The translations -R p of the view matrices.
+  idlib_f32 t[IDLIB_SHADOW_CUBE_FACES][3][LANES];
+  for (size_t j = 0; j < IDLIB_SHADOW_CUBE_FACES; ++j) {
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_f32 const* row = CUBE_ROTATIONS[j][k];
+      lane p = f_add(f_add(f_mul(f_set(row[0]), x), f_mul(f_set(row[1]), y)), f_mul(f_set(row[2]), z));
+      f_store(t[j][k], f_sub(f_set(0.f), p));
+    }
+  }
+  for (size_t l = 0; l < count; ++l) {
+    for (size_t j = 0; j < IDLIB_SHADOW_CUBE_FACES; ++j) {
+      idlib_matrix_4x4_f32* m = &target[IDLIB_SHADOW_CUBE_FACES * l + j];
+      idlib_f32 const (*rotation)[3] = CUBE_ROTATIONS[j];
+      // The matrix product adds terms of the zero elements of the factors, hence its zero elements are +0.
+      // Adding +0 maps -0 to +0 and leaves the other values unchanged such that the results are bit-identical.
+      for (size_t k = 0; k < 3; ++k) {
+        m->e[0][k] = f * rotation[0][k] + 0.f;
+        m->e[1][k] = f * rotation[1][k] + 0.f;
+        m->e[2][k] = a[l] * rotation[2][k] + 0.f;
+        m->e[3][k] = -rotation[2][k] + 0.f;
+      }
+      m->e[0][3] = f * t[j][0][l] + 0.f;
+      m->e[1][3] = f * t[j][1][l] + 0.f;
+      m->e[2][3] = a[l] * t[j][2][l] + b[l];
+      m->e[3][3] = -t[j][2][l] + 0.f;
+    }
+  }
+}
+
+void
+idlib_shadow_cube_f32_set_view_projections_n
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_vector_3_f32_soa const* positions,
+    idlib_f32 near_distance,
+    idlib_f32 const* far_distances,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != positions);
+  IDLIB_DEBUG_ASSERT(NULL != far_distances);
+  // The field of view is 90 degrees and the aspect ratio is 1.
+  idlib_f32 f = 1.f / idlib_tan_f32(idlib_deg_to_rad_f32(90.f) / 2.f);
+  size_t i = first, n = first + count;
+  for (; n - i >= LANES; i += LANES) {
+    set_cube(target + IDLIB_SHADOW_CUBE_FACES * i, positions->x + i, positions->y + i, positions->z + i, far_distances + i, near_distance, f, LANES);
+  }
+  if (i < n) {
+    // The remaining lights are padded to LANES lights.
+    idlib_f32 x[LANES], y[LANES], z[LANES], r[LANES];
+    for (size_t l = 0; l < LANES; ++l) {
+      x[l] = i + l < n ? positions->x[i + l] : 0.f;
+      y[l] = i + l < n ? positions->y[i + l] : 0.f;
+      z[l] = i + l < n ? positions->z[i + l] : 0.f;
+      r[l] = i + l < n ? far_distances[i + l] : 2.f * near_distance;
+    }
+    set_cube(target + IDLIB_SHADOW_CUBE_FACES * i, x, y, z, r, near_distance, f, n - i);
+  }
+}
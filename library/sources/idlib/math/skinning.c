@@ -0,0 +1,390 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "idlib/math/skinning.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+void
+idlib_dual_quaternion_f32_set_matrix_4x4
+  (
+    idlib_dual_quaternion_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+
+  #define e(i,j) operand->e[i][j]
+
+  // Rotation part (Shepperd's method: pivot on the largest diagonal term for numerical stability).
+  idlib_f32 x, y, z, w;
+  idlib_f32 trace = e(0,0) + e(1,1) + e(2,2);
+  if (trace > 0.f) {
+    idlib_f32 s = idlib_sqrt_f32(trace + 1.f) * 2.f;
+    w = 0.25f * s;
+    x = (e(2,1) - e(1,2)) / s;
+    y = (e(0,2) - e(2,0)) / s;
+    z = (e(1,0) - e(0,1)) / s;
+  } else if (e(0,0) > e(1,1) && e(0,0) > e(2,2)) {
+    idlib_f32 s = idlib_sqrt_f32(1.f + e(0,0) - e(1,1) - e(2,2)) * 2.f;
+    w = (e(2,1) - e(1,2)) / s;
+    x = 0.25f * s;
+    y = (e(0,1) + e(1,0)) / s;
+    z = (e(0,2) + e(2,0)) / s;
+  } else if (e(1,1) > e(2,2)) {
+    idlib_f32 s = idlib_sqrt_f32(1.f + e(1,1) - e(0,0) - e(2,2)) * 2.f;
+    w = (e(0,2) - e(2,0)) / s;
+    x = (e(0,1) + e(1,0)) / s;
+    y = 0.25f * s;
+    z = (e(1,2) + e(2,1)) / s;
+  } else {
+    idlib_f32 s = idlib_sqrt_f32(1.f + e(2,2) - e(0,0) - e(1,1)) * 2.f;
+    w = (e(1,0) - e(0,1)) / s;
+    x = (e(0,2) + e(2,0)) / s;
+    y = (e(1,2) + e(2,1)) / s;
+    z = 0.25f * s;
+  }
+
+  // Translation part: dual = 1/2 (t, 0) * real.
+  idlib_f32 tx = e(0,3), ty = e(1,3), tz = e(2,3);
+
+  #undef e
+
+  target->real[0] = x;
+  target->real[1] = y;
+  target->real[2] = z;
+  target->real[3] = w;
+
+  target->dual[0] = 0.5f * ( tx * w + ty * z - tz * y);
+  target->dual[1] = 0.5f * (-tx * z + ty * w + tz * x);
+  target->dual[2] = 0.5f * ( tx * y - ty * x + tz * w);
+  target->dual[3] = -0.5f * (tx * x + ty * y + tz * z);
+}
+
+void
+idlib_dual_quaternion_f32_set_matrix_4x4_n
+  (
+    idlib_dual_quaternion_f32* target,
+    idlib_matrix_4x4_f32 const* operand,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t i = 0; i < count; ++i) {
+    idlib_dual_quaternion_f32_set_matrix_4x4(target + i, operand + i);
+  }
+}
+
+static inline void
+store_normalized
+  (
+    idlib_vector_3_f32_soa const* target,
+    size_t i,
+    idlib_f32 x,
+    idlib_f32 y,
+    idlib_f32 z
+  )
+{
+  idlib_f32 l = x * x + y * y + z * z;
+  if (l > 0.f) {
+    l = 1.f / idlib_sqrt_f32(l);
+    x *= l;
+    y *= l;
+    z *= l;
+  }
+  target->x[i] = x;
+  target->y[i] = y;
+  target->z[i] = z;
+}
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+void
+idlib_skinning_f32_linear_blend
+  (
+    idlib_skinning_f32_job const* job,
+    idlib_matrix_4x4_f32 const* palette,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != palette);
+
+  bool normals = NULL != job->source_normals.x;
+  for (size_t i = first, n = first + count; i < n; ++i) {
+    idlib_u16 const* indices = job->bone_indices + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+    idlib_f32 const* weights = job->bone_weights + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+    // Blend the first three rows of the bone matrices.
+    __m128 r0 = _mm_setzero_ps(), r1 = _mm_setzero_ps(), r2 = _mm_setzero_ps(), r3 = _mm_setzero_ps();
+    for (size_t k = 0; k < IDLIB_SKINNING_NUMBER_OF_INFLUENCES; ++k) {
+      idlib_matrix_4x4_f32 const* m = palette + indices[k];
+      __m128 w = _mm_set1_ps(weights[k]);
+      r0 = _mm_add_ps(r0, _mm_mul_ps(w, _mm_loadu_ps(m->e[0])));
+      r1 = _mm_add_ps(r1, _mm_mul_ps(w, _mm_loadu_ps(m->e[1])));
+      r2 = _mm_add_ps(r2, _mm_mul_ps(w, _mm_loadu_ps(m->e[2])));
+    }
+    // The columns of the blended matrix.
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    idlib_f32 t[4];
+
+    __m128 p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_set1_ps(job->source_positions.x[i])),
+                                     _mm_mul_ps(r1, _mm_set1_ps(job->source_positions.y[i]))),
+                          _mm_add_ps(_mm_mul_ps(r2, _mm_set1_ps(job->source_positions.z[i])), r3));
+    _mm_storeu_ps(t, p);
+    job->target_positions.x[i] = t[0];
+    job->target_positions.y[i] = t[1];
+    job->target_positions.z[i] = t[2];
+
+    if (normals) {
+      __m128 q = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_set1_ps(job->source_normals.x[i])),
+                                       _mm_mul_ps(r1, _mm_set1_ps(job->source_normals.y[i]))),
+                            _mm_mul_ps(r2, _mm_set1_ps(job->source_normals.z[i])));
+      _mm_storeu_ps(t, q);
+      store_normalized(&job->target_normals, i, t[0], t[1], t[2]);
+    }
+  }
+}
+
+#else
+
+void
+idlib_skinning_f32_linear_blend
+  (
+    idlib_skinning_f32_job const* job,
+    idlib_matrix_4x4_f32 const* palette,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != palette);
+
+  bool normals = NULL != job->source_normals.x;
+  for (size_t i = first, n = first + count; i < n; ++i) {
+    idlib_u16 const* indices = job->bone_indices + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+    idlib_f32 const* weights = job->bone_weights + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+    // Blend the first three rows of the bone matrices.
+    idlib_f32 r[3][4] = { { 0.f } };
+    for (size_t k = 0; k < IDLIB_SKINNING_NUMBER_OF_INFLUENCES; ++k) {
+      idlib_matrix_4x4_f32 const* m = palette + indices[k];
+      idlib_f32 w = weights[k];
+      for (size_t u = 0; u < 3; ++u) {
+        for (size_t v = 0; v < 4; ++v) {
+          r[u][v] += w * m->e[u][v];
+        }
+      }
+    }
+    idlib_f32 x = job->source_positions.x[i],
+              y = job->source_positions.y[i],
+              z = job->source_positions.z[i];
+    job->target_positions.x[i] = r[0][0] * x + r[0][1] * y + r[0][2] * z + r[0][3];
+    job->target_positions.y[i] = r[1][0] * x + r[1][1] * y + r[1][2] * z + r[1][3];
+    job->target_positions.z[i] = r[2][0] * x + r[2][1] * y + r[2][2] * z + r[2][3];
+    if (normals) {
+      x = job->source_normals.x[i];
+      y = job->source_normals.y[i];
+      z = job->source_normals.z[i];
+      store_normalized(&job->target_normals, i,
+                       r[0][0] * x + r[0][1] * y + r[0][2] * z,
+                       r[1][0] * x + r[1][1] * y + r[1][2] * z,
+                       r[2][0] * x + r[2][1] * y + r[2][2] * z);
+    }
+  }
+}
+
+#endif
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+// The dot product of x and y in all elements.
+static inline __m128
+dot_4
+  (
+    __m128 x,
+    __m128 y
+  )
+{
+  __m128 p = _mm_mul_ps(x, y);
+  p = _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_add_ps(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+// The cross product of the first three elements of x and y.
+static inline __m128
+cross_3
+  (
+    __m128 x,
+    __m128 y
+  )
+{
+  __m128 x_yzx = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 0, 2, 1)), y_yzx = _mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 0, 2, 1));
+  __m128 c = _mm_sub_ps(_mm_mul_ps(x, y_yzx), _mm_mul_ps(x_yzx, y));
+  return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+void
+idlib_skinning_f32_dual_quaternion_blend
+  (
+    idlib_skinning_f32_job const* job,
+    idlib_dual_quaternion_f32 const* palette,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != palette);
+
+  bool normals = NULL != job->source_normals.x;
+  __m128 sign = _mm_set1_ps(-0.f), two = _mm_set1_ps(2.f);
+  for (size_t i = first, n = first + count; i < n; ++i) {
+    idlib_u16 const* indices = job->bone_indices + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+    idlib_f32 const* weights = job->bone_weights + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+
+    // Blend. Flip dual quaternions into the hemisphere of the first influence.
+    __m128 q0 = _mm_loadu_ps(palette[indices[0]].real);
+    __m128 r = _mm_setzero_ps(), d = _mm_setzero_ps();
+    for (size_t k = 0; k < IDLIB_SKINNING_NUMBER_OF_INFLUENCES; ++k) {
+      idlib_dual_quaternion_f32 const* q = palette + indices[k];
+      __m128 qr = _mm_loadu_ps(q->real);
+      __m128 w = _mm_set1_ps(weights[k]);
+      w = _mm_xor_ps(w, _mm_and_ps(_mm_cmplt_ps(dot_4(q0, qr), _mm_setzero_ps()), sign));
+      r = _mm_add_ps(r, _mm_mul_ps(w, qr));
+      d = _mm_add_ps(d, _mm_mul_ps(w, _mm_loadu_ps(q->dual)));
+    }
+
+    // Normalize.
+    __m128 l = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(dot_4(r, r)));
+    r = _mm_mul_ps(r, l);
+    d = _mm_mul_ps(d, l);
+    __m128 rw = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+    __m128 dw = _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3));
+
+    // Translation t = 2 (rw d - dw r + r x d).
+    __m128 t = _mm_mul_ps(two, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(rw, d), _mm_mul_ps(dw, r)), cross_3(r, d)));
+
+    // Rotate v' = v + 2 r x (r x v + rw v).
+    #define ROTATE(v) _mm_add_ps(v, _mm_mul_ps(two, cross_3(r, _mm_add_ps(cross_3(r, v), _mm_mul_ps(rw, v)))))
+
+    idlib_f32 o[4];
+    __m128 p = _mm_setr_ps(job->source_positions.x[i], job->source_positions.y[i], job->source_positions.z[i], 0.f);
+    _mm_storeu_ps(o, _mm_add_ps(ROTATE(p), t));
+    job->target_positions.x[i] = o[0];
+    job->target_positions.y[i] = o[1];
+    job->target_positions.z[i] = o[2];
+    if (normals) {
+      __m128 v = _mm_setr_ps(job->source_normals.x[i], job->source_normals.y[i], job->source_normals.z[i], 0.f);
+      _mm_storeu_ps(o, ROTATE(v));
+      job->target_normals.x[i] = o[0];
+      job->target_normals.y[i] = o[1];
+      job->target_normals.z[i] = o[2];
+    }
+
+    #undef ROTATE
+  }
+}
+
+#else
+
+void
+idlib_skinning_f32_dual_quaternion_blend
+  (
+    idlib_skinning_f32_job const* job,
+    idlib_dual_quaternion_f32 const* palette,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != palette);
+
+  bool normals = NULL != job->source_normals.x;
+  for (size_t i = first, n = first + count; i < n; ++i) {
+    idlib_u16 const* indices = job->bone_indices + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+    idlib_f32 const* weights = job->bone_weights + i * IDLIB_SKINNING_NUMBER_OF_INFLUENCES;
+
+    // Blend. Flip dual quaternions into the hemisphere of the first influence.
+    idlib_dual_quaternion_f32 const* q0 = palette + indices[0];
+    idlib_f32 b[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+    for (size_t k = 0; k < IDLIB_SKINNING_NUMBER_OF_INFLUENCES; ++k) {
+      idlib_dual_quaternion_f32 const* q = palette + indices[k];
+      idlib_f32 d = q0->real[0] * q->real[0] + q0->real[1] * q->real[1]
+                  + q0->real[2] * q->real[2] + q0->real[3] * q->real[3];
+      idlib_f32 w = d < 0.f ? -weights[k] : weights[k];
+      for (size_t j = 0; j < 4; ++j) {
+        b[j] += w * q->real[j];
+        b[4 + j] += w * q->dual[j];
+      }
+    }
+
+    // Normalize.
+    idlib_f32 l = b[0] * b[0] + b[1] * b[1] + b[2] * b[2] + b[3] * b[3];
+    l = 1.f / idlib_sqrt_f32(l);
+    for (size_t j = 0; j < 8; ++j) {
+      b[j] *= l;
+    }
+    idlib_f32 rx = b[0], ry = b[1], rz = b[2], rw = b[3];
+    idlib_f32 dx = b[4], dy = b[5], dz = b[6], dw = b[7];
+
+    // Translation t = 2 (rw d - dw r + r x d).
+    idlib_f32 tx = 2.f * (rw * dx - dw * rx + (ry * dz - rz * dy));
+    idlib_f32 ty = 2.f * (rw * dy - dw * ry + (rz * dx - rx * dz));
+    idlib_f32 tz = 2.f * (rw * dz - dw * rz + (rx * dy - ry * dx));
+
+    // Rotate v' = v + 2 r x (r x v + rw v).
+    #define ROTATE(vx, vy, vz, ox, oy, oz) \
+      { \
+        idlib_f32 cx = (ry * vz - rz * vy) + rw * vx; \
+        idlib_f32 cy = (rz * vx - rx * vz) + rw * vy; \
+        idlib_f32 cz = (rx * vy - ry * vx) + rw * vz; \
+        ox = vx + 2.f * (ry * cz - rz * cy); \
+        oy = vy + 2.f * (rz * cx - rx * cz); \
+        oz = vz + 2.f * (rx * cy - ry * cx); \
+      }
+
+    idlib_f32 px = job->source_positions.x[i],
+              py = job->source_positions.y[i],
+              pz = job->source_positions.z[i];
+    idlib_f32 ox, oy, oz;
+    ROTATE(px, py, pz, ox, oy, oz);
+    job->target_positions.x[i] = ox + tx;
+    job->target_positions.y[i] = oy + ty;
+    job->target_positions.z[i] = oz + tz;
+    if (normals) {
+      idlib_f32 nx = job->source_normals.x[i],
+                ny = job->source_normals.y[i],
+                nz = job->source_normals.z[i];
+      ROTATE(nx, ny, nz, ox, oy, oz);
+      job->target_normals.x[i] = ox;
+      job->target_normals.y[i] = oy;
+      job->target_normals.z[i] = oz;
+    }
+
+    #undef ROTATE
+  }
+}
+
+#endif
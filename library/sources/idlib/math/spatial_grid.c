@@ -0,0 +1,878 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/spatial_grid.h"
+
+// fabsf, floorf, INFINITY
+#include <math.h>
+// int64_t, uintptr_t
+#include <stdint.h>
+// abs
+#include <stdlib.h>
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+  // __m128i, _mm_*_epi32, _mm_cvttps_epi32, _mm_cvtepi32_ps
+  #include <emmintrin.h>
+#endif
+
+// The coordinate arrays have three elements beyond the last point such that four positions can be loaded at once from any position of a point.
+#define PADDING (3)
+
+// The relative margin by which the bounds of cells are widened for pruning.
+#define MARGIN (0x1.0p-20f)
+
+// The number of elements of a coordinate array.
+static size_t
+get_stride
+  (
+    idlib_u32 capacity
+  )
+{ return ((size_t)capacity + PADDING + 3) & ~(size_t)3; }
+
+// The smallest power of two not less than the specified number of points (and not less than one).
+static idlib_u32
+get_number_of_buckets
+  (
+    idlib_u32 number_of_points
+  )
+{
+  idlib_u32 n = 1;
+  while (n < number_of_points) {
+    n <<= 1;
+  }
+  return n;
+}
+
+// The finalizer of MurmurHash3.
+static inline idlib_u32
+mix
+  (
+    idlib_u32 h
+  )
+{
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+// The bucket of a cell.
+// The cells of a row along the x-axis are hashed into consecutive buckets (modulo the number of buckets) such that a row can be visited at once.
+static inline idlib_u32
+hash
+  (
+    idlib_i32 x,
+    idlib_i32 y,
+    idlib_i32 z,
+    idlib_u32 number_of_buckets
+  )
+{ return (mix(((idlib_u32)y * 19349663u) ^ ((idlib_u32)z * 83492791u)) + (idlib_u32)x) & (number_of_buckets - 1); }
+
+// The coordinate of the cell of a coordinate of a point.
+static inline idlib_i32
+cell_of
+  (
+    idlib_f32 x,
+    idlib_f32 inverse_cell_size
+  )
+{ return (idlib_i32)floorf(x * inverse_cell_size); }
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+// The coordinates of the cells of four coordinates of points. Same as cell_of.
+static inline __m128i
+cell_of_4
+  (
+    __m128 x,
+    __m128 inverse_cell_size
+  )
+{
+  __m128 t = _mm_mul_ps(x, inverse_cell_size);
+  __m128i i = _mm_cvttps_epi32(t);
+  // Truncation rounds towards zero. Subtract one where it rounded up.
+  return _mm_add_epi32(i, _mm_castps_si128(_mm_cmplt_ps(t, _mm_cvtepi32_ps(i))));
+}
+
+#endif
+
+size_t
+idlib_spatial_grid_get_workspace_size
+  (
+    idlib_u32 capacity
+  )
+{
+  return 3 * get_stride(capacity) * sizeof(idlib_f32)
+       + 2 * (size_t)get_number_of_buckets(capacity) * sizeof(idlib_u32)
+       + (size_t)capacity * sizeof(idlib_u32);
+}
+
+void
+idlib_spatial_grid_initialize
+  (
+    idlib_spatial_grid* target,
+    idlib_u32 capacity,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  IDLIB_DEBUG_ASSERT(0 == ((uintptr_t)workspace & 15));
+  size_t stride = get_stride(capacity);
+  idlib_f32* p = (idlib_f32*)workspace;
+  target->x = p; p += stride;
+  target->y = p; p += stride;
+  target->z = p; p += stride;
+  idlib_u32* q = (idlib_u32*)p;
+  target->cell_start = q; q += get_number_of_buckets(capacity);
+  target->cell_count = q; q += get_number_of_buckets(capacity);
+  target->indices = q;
+  target->number_of_points = 0;
+  target->capacity = capacity;
+  target->number_of_buckets = 1;
+  target->cell_start[0] = 0;
+  target->cell_count[0] = 0;
+  target->cell_size = 1.f;
+  for (size_t k = 0; k < 3; ++k) {
+    target->minimum[k] = 0;
+    target->maximum[k] = -1;
+  }
+}
+
+// Compute the exclusive prefix sum of the counts.
+static void
+prefix_sum
+  (
+    idlib_u32* target,
+    idlib_u32 const* operand,
+    idlib_u32 count
+  )
+{
+  idlib_u32 i = 0, sum = 0;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128i carry = _mm_setzero_si128();
+  for (; i + 4 <= count; i += 4) {
+    __m128i c = _mm_loadu_si128((__m128i const*)(operand + i));
+    // The inclusive prefix sum of the four counts in two steps.
+    __m128i s = _mm_add_epi32(c, _mm_slli_si128(c, 4));
+    s = _mm_add_epi32(s, _mm_slli_si128(s, 8));
+    _mm_storeu_si128((__m128i*)(target + i), _mm_add_epi32(carry, _mm_sub_epi32(s, c)));
+    carry = _mm_add_epi32(carry, _mm_shuffle_epi32(s, _MM_SHUFFLE(3, 3, 3, 3)));
+  }
+  sum = (idlib_u32)_mm_cvtsi128_si32(carry);
+#endif
+  for (; i < count; ++i) {
+    target[i] = sum;
+    sum += operand[i];
+  }
+}
+
+void
+idlib_spatial_grid_build
+  (
+    idlib_spatial_grid* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_f32 cell_size
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(number_of_points <= target->capacity);
+  IDLIB_DEBUG_ASSERT(cell_size > 0.f);
+  idlib_u32 n = number_of_points;
+  idlib_u32 number_of_buckets = get_number_of_buckets(n);
+  idlib_f32 inverse_cell_size = 1.f / cell_size;
+  idlib_u32* cell_start = target->cell_start;
+  idlib_u32* cell_count = target->cell_count;
+  target->number_of_points = n;
+  target->number_of_buckets = number_of_buckets;
+  target->cell_size = cell_size;
+  for (size_t k = 0; k < 3; ++k) {
+    target->minimum[k] = 0;
+    target->maximum[k] = -1;
+  }
+  // Count the points of the buckets.
+  for (idlib_u32 i = 0; i < number_of_buckets; ++i) {
+    cell_count[i] = 0;
+  }
+  idlib_f32 const* x = operand->x, * y = operand->y, * z = operand->z;
+  for (idlib_u32 i = 0; i < n; ++i) {
+    idlib_i32 c[3] = { cell_of(x[i], inverse_cell_size), cell_of(y[i], inverse_cell_size), cell_of(z[i], inverse_cell_size) };
+    cell_count[hash(c[0], c[1], c[2], number_of_buckets)]++;
+    for (size_t k = 0; k < 3; ++k) {
+      if (0 == i || c[k] < target->minimum[k]) {
+        target->minimum[k] = c[k];
+      }
+      if (0 == i || c[k] > target->maximum[k]) {
+        target->maximum[k] = c[k];
+      }
+    }
+  }
+  prefix_sum(cell_start, cell_count, number_of_buckets);
+  // Scatter the points to their positions. The start positions are advanced and restored afterwards.
+  for (idlib_u32 i = 0; i < n; ++i) {
+    idlib_u32 h = hash(cell_of(x[i], inverse_cell_size), cell_of(y[i], inverse_cell_size), cell_of(z[i], inverse_cell_size), number_of_buckets);
+    idlib_u32 j = cell_start[h]++;
+    target->indices[j] = i;
+    target->x[j] = x[i];
+    target->y[j] = y[i];
+    target->z[j] = z[i];
+  }
+  for (idlib_u32 i = 0; i < number_of_buckets; ++i) {
+    cell_start[i] -= cell_count[i];
+  }
+  for (idlib_u32 j = n; j < n + PADDING; ++j) {
+    target->x[j] = 0.f;
+    target->y[j] = 0.f;
+    target->z[j] = 0.f;
+  }
+}
+
+// The range [*first, *first + *count) of the points of the i-th range of a build job.
+static inline void
+get_points_of_range
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i,
+    idlib_u32* first,
+    idlib_u32* count
+  )
+{
+  idlib_u64 n = job->number_of_points, m = job->number_of_ranges;
+  idlib_u32 a = (idlib_u32)(n * i / m), b = (idlib_u32)(n * (i + 1) / m);
+  *first = a;
+  *count = b - a;
+}
+
+// The range [*first, *first + *count) of the buckets of the i-th block of a build job.
+static inline void
+get_buckets_of_block
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i,
+    idlib_u32* first,
+    idlib_u32* count
+  )
+{
+  idlib_u64 a = (idlib_u64)i << job->block_shift, b = (idlib_u64)(i + 1) << job->block_shift;
+  idlib_u64 n = job->target->number_of_buckets;
+  a = a < n ? a : n;
+  b = b < n ? b : n;
+  *first = (idlib_u32)a;
+  *count = (idlib_u32)(b - a);
+}
+
+size_t
+idlib_spatial_grid_build_job_get_workspace_size
+  (
+    idlib_u32 capacity,
+    idlib_u32 number_of_ranges
+  )
+{
+  size_t m = number_of_ranges;
+  // The counts (m rows of buckets), the bases (m rows of m blocks), the totals of the blocks, and the bounds of the cells of the ranges.
+  return m * get_number_of_buckets(capacity) * sizeof(idlib_u32)
+       + m * m * sizeof(idlib_u32)
+       + m * sizeof(idlib_u32)
+       + 6 * m * sizeof(idlib_i32);
+}
+
+void
+idlib_spatial_grid_build_job_initialize
+  (
+    idlib_spatial_grid_build_job* job,
+    idlib_spatial_grid* target,
+    idlib_vector_3_f32_soa const* operand,
+    idlib_u32 number_of_points,
+    idlib_f32 cell_size,
+    idlib_u32 number_of_ranges,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(number_of_points <= target->capacity);
+  IDLIB_DEBUG_ASSERT(cell_size > 0.f);
+  IDLIB_DEBUG_ASSERT(0 < number_of_ranges);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  idlib_u32 number_of_buckets = get_number_of_buckets(number_of_points);
+  target->number_of_points = number_of_points;
+  target->number_of_buckets = number_of_buckets;
+  target->cell_size = cell_size;
+  job->target = target;
+  job->operand = *operand;
+  job->number_of_points = number_of_points;
+  job->inverse_cell_size = 1.f / cell_size;
+  job->number_of_ranges = number_of_ranges;
+  // The blocks are of a size of a power of two such that the block of a bucket is computed by a shift.
+  // There are at most number_of_ranges blocks.
+  job->block_shift = 0;
+  while (((idlib_u64)number_of_ranges << job->block_shift) < number_of_buckets) {
+    job->block_shift++;
+  }
+  size_t m = number_of_ranges;
+  idlib_u32* p = (idlib_u32*)workspace;
+  job->counts = p; p += m * number_of_buckets;
+  job->bases = p; p += m * m;
+  job->totals = p; p += m;
+  job->bounds = (idlib_i32*)p;
+}
+
+void
+idlib_spatial_grid_build_job_count
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_ranges);
+  idlib_u32 number_of_buckets = job->target->number_of_buckets;
+  idlib_f32 inverse_cell_size = job->inverse_cell_size;
+  idlib_u32* counts = job->counts + (size_t)i * number_of_buckets;
+  for (idlib_u32 j = 0; j < number_of_buckets; ++j) {
+    counts[j] = 0;
+  }
+  idlib_i32* minimum = job->bounds + 6 * (size_t)i, * maximum = minimum + 3;
+  idlib_u32 first, count;
+  get_points_of_range(job, i, &first, &count);
+  idlib_f32 const* x = job->operand.x, * y = job->operand.y, * z = job->operand.z;
+  for (idlib_u32 j = first, n = first + count; j < n; ++j) {
+    idlib_i32 c[3] = { cell_of(x[j], inverse_cell_size), cell_of(y[j], inverse_cell_size), cell_of(z[j], inverse_cell_size) };
+    counts[hash(c[0], c[1], c[2], number_of_buckets)]++;
+    for (size_t k = 0; k < 3; ++k) {
+      if (j == first || c[k] < minimum[k]) {
+        minimum[k] = c[k];
+      }
+      if (j == first || c[k] > maximum[k]) {
+        maximum[k] = c[k];
+      }
+    }
+  }
+}
+
+void
+idlib_spatial_grid_build_job_scan
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_ranges);
+  idlib_spatial_grid* target = job->target;
+  idlib_u32 number_of_buckets = target->number_of_buckets;
+  idlib_u32 m = job->number_of_ranges;
+  idlib_u32 first, count;
+  get_buckets_of_block(job, i, &first, &count);
+  // The count of a bucket is the sum of its counts in the ranges.
+  // The count of a bucket in a range is replaced by the sum of its counts in the preceding ranges.
+  for (idlib_u32 h = first, n = first + count; h < n; ++h) {
+    idlib_u32 sum = 0;
+    for (size_t r = 0; r < m; ++r) {
+      idlib_u32* c = job->counts + r * number_of_buckets + h;
+      idlib_u32 t = *c;
+      *c = sum;
+      sum += t;
+    }
+    target->cell_count[h] = sum;
+  }
+  // The start positions of the buckets relative to the start of the block.
+  prefix_sum(target->cell_start + first, target->cell_count + first, count);
+  job->totals[i] = 0 < count ? target->cell_start[first + count - 1] + target->cell_count[first + count - 1] : 0;
+  for (idlib_u32 h = first, n = first + count; h < n; ++h) {
+    for (size_t r = 0; r < m; ++r) {
+      job->counts[r * number_of_buckets + h] += target->cell_start[h];
+    }
+  }
+  if (0 == i) {
+    // The bounds of the cells are the bounds over the non-empty ranges.
+    for (size_t k = 0; k < 3; ++k) {
+      target->minimum[k] = 0;
+      target->maximum[k] = -1;
+    }
+    bool empty = true;
+    for (idlib_u32 r = 0; r < m; ++r) {
+      idlib_u32 a, b;
+      get_points_of_range(job, r, &a, &b);
+      if (0 == b) {
+        continue;
+      }
+      idlib_i32 const* minimum = job->bounds + 6 * (size_t)r, * maximum = minimum + 3;
+      for (size_t k = 0; k < 3; ++k) {
+        if (empty || minimum[k] < target->minimum[k]) {
+          target->minimum[k] = minimum[k];
+        }
+        if (empty || maximum[k] > target->maximum[k]) {
+          target->maximum[k] = maximum[k];
+        }
+      }
+      empty = false;
+    }
+  }
+}
+
+void
+idlib_spatial_grid_build_job_scatter
+  (
+    idlib_spatial_grid_build_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_ranges);
+  idlib_spatial_grid* target = job->target;
+  idlib_u32 number_of_buckets = target->number_of_buckets;
+  idlib_f32 inverse_cell_size = job->inverse_cell_size;
+  idlib_u32 m = job->number_of_ranges;
+  // The start positions of the blocks: The exclusive prefix sum of the totals of the blocks.
+  idlib_u32* bases = job->bases + (size_t)i * m;
+  prefix_sum(bases, job->totals, m);
+  idlib_u32* counts = job->counts + (size_t)i * number_of_buckets;
+  idlib_u32 first, count;
+  get_points_of_range(job, i, &first, &count);
+  idlib_f32 const* x = job->operand.x, * y = job->operand.y, * z = job->operand.z;
+  for (idlib_u32 j = first, n = first + count; j < n; ++j) {
+    idlib_u32 h = hash(cell_of(x[j], inverse_cell_size), cell_of(y[j], inverse_cell_size), cell_of(z[j], inverse_cell_size), number_of_buckets);
+    idlib_u32 k = bases[h >> job->block_shift] + counts[h]++;
+    target->indices[k] = j;
+    target->x[k] = x[j];
+    target->y[k] = y[j];
+    target->z[k] = z[j];
+  }
+  // The start positions of the buckets of the i-th block are not read by the other invocations of this phase.
+  get_buckets_of_block(job, i, &first, &count);
+  for (idlib_u32 h = first, n = first + count; h < n; ++h) {
+    target->cell_start[h] += bases[i];
+  }
+  if (0 == i) {
+    for (idlib_u32 j = job->number_of_points; j < job->number_of_points + PADDING; ++j) {
+      target->x[j] = 0.f;
+      target->y[j] = 0.f;
+      target->z[j] = 0.f;
+    }
+  }
+}
+
+// A query point and the cells being visited.
+typedef struct query {
+  idlib_f32 p[3];
+  idlib_f32 inverse_cell_size;
+  // The cells being visited are the cells (x, y, z) with first[0] <= x <= last[0], y = first[1], and z = first[2].
+  idlib_i32 first[3];
+  idlib_i32 last[3];
+  // If false, then the points are not tested for being in the cells being visited.
+  bool check_cell;
+} query;
+
+// Compute the squared distances of the points at the positions [j, j + 4) to the query point
+// and the mask of the points among the positions [j, end) in the cells being visited.
+static inline int
+test_4
+  (
+    idlib_f32 distances[4],
+    idlib_spatial_grid const* operand,
+    query const* q,
+    idlib_u32 j,
+    idlib_u32 end
+  )
+{
+  int mask = end - j >= 4 ? 15 : (1 << (end - j)) - 1;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 x = _mm_loadu_ps(operand->x + j), y = _mm_loadu_ps(operand->y + j), z = _mm_loadu_ps(operand->z + j);
+  __m128 dx = _mm_sub_ps(x, _mm_set1_ps(q->p[0])), dy = _mm_sub_ps(y, _mm_set1_ps(q->p[1])), dz = _mm_sub_ps(z, _mm_set1_ps(q->p[2]));
+  _mm_storeu_ps(distances, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+  if (q->check_cell) {
+    __m128 inverse_cell_size = _mm_set1_ps(q->inverse_cell_size);
+    __m128i cx = cell_of_4(x, inverse_cell_size);
+    __m128i out = _mm_or_si128(_mm_cmplt_epi32(cx, _mm_set1_epi32(q->first[0])), _mm_cmpgt_epi32(cx, _mm_set1_epi32(q->last[0])));
+    __m128i in = _mm_and_si128(_mm_cmpeq_epi32(cell_of_4(y, inverse_cell_size), _mm_set1_epi32(q->first[1])),
+                               _mm_cmpeq_epi32(cell_of_4(z, inverse_cell_size), _mm_set1_epi32(q->first[2])));
+    mask &= _mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(out, in)));
+  }
+#else
+  for (idlib_u32 l = 0; l < 4; ++l) {
+    idlib_f32 dx = operand->x[j + l] - q->p[0], dy = operand->y[j + l] - q->p[1], dz = operand->z[j + l] - q->p[2];
+    distances[l] = (dx * dx + dy * dy) + dz * dz;
+    if (q->check_cell) {
+      idlib_i32 cx = cell_of(operand->x[j + l], q->inverse_cell_size);
+      if (cx < q->first[0] || cx > q->last[0]
+       || cell_of(operand->y[j + l], q->inverse_cell_size) != q->first[1]
+       || cell_of(operand->z[j + l], q->inverse_cell_size) != q->first[2]) {
+        mask &= ~(1 << l);
+      }
+    }
+  }
+#endif
+  return mask;
+}
+
+// Get the ranges of positions of the points of the buckets of the cells being visited.
+// Return the number of ranges (one or two if the buckets wrap around).
+static idlib_u32
+get_ranges
+  (
+    idlib_u32 ranges[4],
+    idlib_spatial_grid const* operand,
+    query const* q
+  )
+{
+  idlib_u32 number_of_buckets = operand->number_of_buckets;
+  idlib_u32 a = hash(q->first[0], q->first[1], q->first[2], number_of_buckets);
+  idlib_u32 b = (a + (idlib_u32)(q->last[0] - q->first[0])) & (number_of_buckets - 1);
+  if (a <= b) {
+    ranges[0] = operand->cell_start[a];
+    ranges[1] = operand->cell_start[b] + operand->cell_count[b];
+    return 1;
+  } else {
+    ranges[0] = operand->cell_start[a];
+    ranges[1] = operand->number_of_points;
+    ranges[2] = 0;
+    ranges[3] = operand->cell_start[b] + operand->cell_count[b];
+    return 2;
+  }
+}
+
+// Append the points at the positions [start, end) within the radius of the query point.
+static size_t
+find_in_range
+  (
+    idlib_u32* target,
+    size_t capacity,
+    size_t number_of_points,
+    idlib_spatial_grid const* operand,
+    query const* q,
+    idlib_f32 squared_radius,
+    idlib_u32 start,
+    idlib_u32 end
+  )
+{
+  IDLIB_ALIGNAS(16) idlib_f32 distances[4];
+  for (idlib_u32 j = start; j < end; j += 4) {
+    int mask = test_4(distances, operand, q, j, end);
+    for (idlib_u32 l = 0; l < 4; ++l) {
+      if ((mask & (1 << l)) && distances[l] <= squared_radius) {
+        if (number_of_points < capacity) {
+          target[number_of_points] = operand->indices[j + l];
+        }
+        number_of_points++;
+      }
+    }
+  }
+  return number_of_points;
+}
+
+// Get the range of the coordinates of the cells (clipped to the cells containing points) overlapping an interval.
+// Return false if the range is empty.
+static bool
+get_range
+  (
+    idlib_i32* first,
+    idlib_i32* last,
+    idlib_f32 minimum,
+    idlib_f32 maximum,
+    idlib_f32 inverse_cell_size,
+    idlib_i32 lower,
+    idlib_i32 upper
+  )
+{
+  idlib_f32 a = floorf(minimum * inverse_cell_size), b = floorf(maximum * inverse_cell_size);
+  if (!(a <= (idlib_f32)upper && b >= (idlib_f32)lower)) {
+    return false;
+  }
+  *first = a < (idlib_f32)lower ? lower : (idlib_i32)a;
+  *last = b > (idlib_f32)upper ? upper : (idlib_i32)b;
+  return *first <= *last;
+}
+
+size_t
+idlib_spatial_grid_query_radius
+  (
+    idlib_u32* target,
+    size_t capacity,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_f32 radius
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == capacity);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  IDLIB_DEBUG_ASSERT(radius >= 0.f);
+  query q;
+  q.inverse_cell_size = 1.f / operand->cell_size;
+  idlib_i32 first[3], last[3];
+  for (size_t k = 0; k < 3; ++k) {
+    q.p[k] = point->e[k];
+    if (!get_range(&first[k], &last[k], point->e[k] - radius, point->e[k] + radius, q.inverse_cell_size, operand->minimum[k], operand->maximum[k])) {
+      return 0;
+    }
+  }
+  idlib_f32 squared_radius = radius * radius;
+  idlib_u64 number_of_cells = (idlib_u64)(last[0] - first[0] + 1) * (idlib_u64)(last[1] - first[1] + 1) * (idlib_u64)(last[2] - first[2] + 1);
+  if (number_of_cells > operand->number_of_buckets) {
+    // Visiting more cells than there are buckets is more expensive than testing all points.
+    q.check_cell = false;
+    return find_in_range(target, capacity, 0, operand, &q, squared_radius, 0, operand->number_of_points);
+  }
+  // A bucket may contain the points of several cells. Only the points in the cells being visited are tested such that no point is found twice.
+  // The number of cells of a row does not exceed the number of buckets such that no bucket is visited twice for a row.
+  q.check_cell = true;
+  q.first[0] = first[0];
+  q.last[0] = last[0];
+  size_t number_of_points = 0;
+  for (idlib_i32 z = first[2]; z <= last[2]; ++z) {
+    for (idlib_i32 y = first[1]; y <= last[1]; ++y) {
+      q.first[1] = q.last[1] = y;
+      q.first[2] = q.last[2] = z;
+      idlib_u32 ranges[4];
+      idlib_u32 number_of_ranges = get_ranges(ranges, operand, &q);
+      for (idlib_u32 i = 0; i < number_of_ranges; ++i) {
+        number_of_points = find_in_range(target, capacity, number_of_points, operand, &q, squared_radius, ranges[2 * i + 0], ranges[2 * i + 1]);
+      }
+    }
+  }
+  return number_of_points;
+}
+
+size_t
+idlib_spatial_grid_query_radius_n
+  (
+    size_t* offsets,
+    idlib_u32* target,
+    size_t capacity,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_f32 radius,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != offsets);
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == capacity);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  size_t number_of_points = 0;
+  for (size_t i = 0; i < count; ++i) {
+    idlib_vector_3_f32 point = { { points->x[first + i], points->y[first + i], points->z[first + i] } };
+    offsets[i] = number_of_points;
+    size_t remaining = number_of_points < capacity ? capacity - number_of_points : 0;
+    number_of_points += idlib_spatial_grid_query_radius(remaining ? target + number_of_points : NULL, remaining, operand, &point, radius);
+  }
+  offsets[count] = number_of_points;
+  return number_of_points;
+}
+
+// The k nearest points found so far in ascending order of their squared distances.
+typedef struct nearest {
+  idlib_u32* indices;
+  idlib_f32* distances;
+  idlib_u32 k;
+  idlib_u32 count;
+} nearest;
+
+// Insert a point unless the k nearest points found so far are all nearer.
+static inline void
+insert
+  (
+    nearest* target,
+    idlib_u32 index,
+    idlib_f32 distance
+  )
+{
+  idlib_u32 i = target->count;
+  if (i == target->k) {
+    if (!(distance < target->distances[i - 1])) {
+      return;
+    }
+    i--;
+  } else {
+    target->count++;
+  }
+  for (; i > 0 && target->distances[i - 1] > distance; --i) {
+    target->indices[i] = target->indices[i - 1];
+    target->distances[i] = target->distances[i - 1];
+  }
+  target->indices[i] = index;
+  target->distances[i] = distance;
+}
+
+// Visit the cells (x, y, z), x = first..last, of the grid.
+static void
+visit
+  (
+    nearest* target,
+    idlib_spatial_grid const* operand,
+    query* q,
+    idlib_i32 first,
+    idlib_i32 last,
+    idlib_i32 y,
+    idlib_i32 z
+  )
+{
+  if (target->count == target->k) {
+    // Skip the cells if they are farther away than the k-th nearest point found so far.
+    // The bounds of the cells are widened by a margin covering the rounding errors of the computation of the cells of the points.
+    idlib_i32 lower[3] = { first, y, z }, upper[3] = { last, y, z };
+    idlib_f32 distance = 0.f;
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_f32 a = ((idlib_f32)lower[k] - ((idlib_f32)abs(lower[k]) + 1.f) * MARGIN) * operand->cell_size;
+      idlib_f32 b = ((idlib_f32)upper[k] + 1.f + ((idlib_f32)abs(upper[k]) + 1.f) * MARGIN) * operand->cell_size;
+      idlib_f32 d = q->p[k] < a ? a - q->p[k] : (q->p[k] > b ? q->p[k] - b : 0.f);
+      distance += d * d;
+    }
+    if (distance > target->distances[target->k - 1]) {
+      return;
+    }
+  }
+  q->first[0] = first; q->last[0] = last;
+  q->first[1] = q->last[1] = y;
+  q->first[2] = q->last[2] = z;
+  idlib_u32 ranges[4];
+  idlib_u32 number_of_ranges = get_ranges(ranges, operand, q);
+  IDLIB_ALIGNAS(16) idlib_f32 distances[4];
+  for (idlib_u32 i = 0; i < number_of_ranges; ++i) {
+    idlib_u32 end = ranges[2 * i + 1];
+    for (idlib_u32 j = ranges[2 * i + 0]; j < end; j += 4) {
+      int mask = test_4(distances, operand, q, j, end);
+      for (idlib_u32 l = 0; l < 4; ++l) {
+        if (mask & (1 << l)) {
+          insert(target, operand->indices[j + l], distances[l]);
+        }
+      }
+    }
+  }
+}
+
+static inline int64_t
+maximum_of
+  (
+    int64_t a,
+    int64_t b
+  )
+{ return a > b ? a : b; }
+
+static inline int64_t
+minimum_of
+  (
+    int64_t a,
+    int64_t b
+  )
+{ return a < b ? a : b; }
+
+idlib_u32
+idlib_spatial_grid_query_nearest
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32 const* point,
+    idlib_u32 k
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == k);
+  IDLIB_DEBUG_ASSERT(NULL != distances || 0 == k);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != point);
+  nearest result = { target, distances, k, 0 };
+  if (k && operand->number_of_points) {
+    query q;
+    q.inverse_cell_size = 1.f / operand->cell_size;
+    q.check_cell = true;
+    // The cell of the query point (which need not contain points) and the shells of cells around it intersecting the cells containing points.
+    int64_t c[3], lower[3], upper[3];
+    int64_t first_shell = 0, last_shell = 0;
+    idlib_f32 magnitude = 0.f;
+    for (size_t i = 0; i < 3; ++i) {
+      q.p[i] = point->e[i];
+      idlib_f32 t = floorf(point->e[i] * q.inverse_cell_size);
+      lower[i] = operand->minimum[i];
+      upper[i] = operand->maximum[i];
+      c[i] = t < (idlib_f32)lower[i] ? lower[i] - 1 : (t > (idlib_f32)upper[i] ? upper[i] + 1 : (int64_t)t);
+      first_shell = maximum_of(first_shell, maximum_of(lower[i] - c[i], c[i] - upper[i]));
+      last_shell = maximum_of(last_shell, maximum_of(c[i] - lower[i], upper[i] - c[i]));
+      magnitude = fabsf(t) > magnitude ? fabsf(t) : magnitude;
+    }
+    for (int64_t r = first_shell; r <= last_shell; ++r) {
+      // The cells at the Chebyshev distance r from the cell of the query point.
+      for (int64_t z = maximum_of(c[2] - r, lower[2]); z <= minimum_of(c[2] + r, upper[2]); ++z) {
+        for (int64_t y = maximum_of(c[1] - r, lower[1]); y <= minimum_of(c[1] + r, upper[1]); ++y) {
+          if (z == c[2] - r || z == c[2] + r || y == c[1] - r || y == c[1] + r) {
+            idlib_i32 first = (idlib_i32)maximum_of(c[0] - r, lower[0]), last = (idlib_i32)minimum_of(c[0] + r, upper[0]);
+            // Rows with more cells than buckets are visited in parts such that no bucket is visited twice.
+            for (; first <= last; first += (idlib_i32)operand->number_of_buckets) {
+              idlib_i32 end = (int64_t)last - first >= (int64_t)operand->number_of_buckets ? first + (idlib_i32)operand->number_of_buckets - 1 : last;
+              visit(&result, operand, &q, first, end, (idlib_i32)y, (idlib_i32)z);
+              if (end == last) {
+                break;
+              }
+            }
+          } else {
+            if (c[0] - r >= lower[0]) {
+              visit(&result, operand, &q, (idlib_i32)(c[0] - r), (idlib_i32)(c[0] - r), (idlib_i32)y, (idlib_i32)z);
+            }
+            if (r > 0 && c[0] + r <= upper[0]) {
+              visit(&result, operand, &q, (idlib_i32)(c[0] + r), (idlib_i32)(c[0] + r), (idlib_i32)y, (idlib_i32)z);
+            }
+          }
+        }
+      }
+      // The points in the shells beyond r are at least r cells away from the query point (up to the margin).
+      if (result.count == k) {
+        idlib_f32 d = ((idlib_f32)r - ((idlib_f32)r + magnitude + 1.f) * MARGIN) * operand->cell_size;
+        if (result.distances[k - 1] <= d * d) {
+          break;
+        }
+      }
+    }
+  }
+  for (idlib_u32 i = result.count; i < k; ++i) {
+    target[i] = IDLIB_SPATIAL_GRID_NONE;
+    distances[i] = INFINITY;
+  }
+  return result.count;
+}
+
+void
+idlib_spatial_grid_query_nearest_n
+  (
+    idlib_u32* target,
+    idlib_f32* distances,
+    idlib_spatial_grid const* operand,
+    idlib_vector_3_f32_soa const* points,
+    idlib_u32 k,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != points);
+  for (size_t i = 0; i < count; ++i) {
+    idlib_vector_3_f32 point = { { points->x[first + i], points->y[first + i], points->z[first + i] } };
+    idlib_spatial_grid_query_nearest(target + i * k, distances + i * k, operand, &point, k);
+  }
+}
@@ -0,0 +1,459 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/transform.h"
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  // __m128, _mm_*_ps
+  #include <xmmintrin.h>
+#endif
+
+// fabs, sqrt
+#include <math.h>
+
+// The maximum number of iterations of the polar decomposition.
+// The scaled Newton iteration converges quadratically, usually in less than ten iterations.
+#define POLAR_DECOMPOSITION_MAXIMUM_ITERATIONS (32)
+
+void
+idlib_matrix_4x4_f32_set_transform
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_transform_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+
+  idlib_f32 x = operand->rotation.e[0],
+            y = operand->rotation.e[1],
+            z = operand->rotation.e[2],
+            w = operand->rotation.e[3];
+  // Dividing by the squared norm makes this robust against quaternions that drifted slightly off unit length.
+  idlib_f32 n = x * x + y * y + z * z + w * w;
+  idlib_f32 s = n > 0.f ? 2.f / n : 0.f;
+  idlib_f32 xs = x * s, ys = y * s, zs = z * s;
+  idlib_f32 wx = w * xs, wy = w * ys, wz = w * zs,
+            xx = x * xs, xy = x * ys, xz = x * zs,
+            yy = y * ys, yz = y * zs, zz = z * zs;
+
+  idlib_f32 sx = operand->scale.e[0], sy = operand->scale.e[1], sz = operand->scale.e[2];
+
+  target->e[0][0] = (1.f - (yy + zz)) * sx;
+  target->e[1][0] = (xy + wz) * sx;
+  target->e[2][0] = (xz - wy) * sx;
+  target->e[3][0] = 0.f;
+
+  target->e[0][1] = (xy - wz) * sy;
+  target->e[1][1] = (1.f - (xx + zz)) * sy;
+  target->e[2][1] = (yz + wx) * sy;
+  target->e[3][1] = 0.f;
+
+  target->e[0][2] = (xz + wy) * sz;
+  target->e[1][2] = (yz - wx) * sz;
+  target->e[2][2] = (1.f - (xx + yy)) * sz;
+  target->e[3][2] = 0.f;
+
+  target->e[0][3] = operand->translation.e[0];
+  target->e[1][3] = operand->translation.e[1];
+  target->e[2][3] = operand->translation.e[2];
+  target->e[3][3] = 1.f;
+}
+
+void
+idlib_matrix_4x4_f32_set_transform_n
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_transform_f32 const* operand,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  for (size_t i = 0; i < count; ++i) {
+    idlib_matrix_4x4_f32_set_transform(target + i, operand + i);
+  }
+}
+
+// Compute the transposed inverse of a 3x3 matrix, that is, its cofactor matrix divided by its determinant.
+// Return the determinant.
+static idlib_f64
+inverse_transpose
+  (
+    idlib_f64 target[3][3],
+    idlib_f64 const a[3][3]
+  )
+{
+  idlib_f64 c[3][3];
+  c[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+  c[0][1] = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+  c[0][2] = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+  c[1][0] = a[2][1] * a[0][2] - a[2][2] * a[0][1];
+  c[1][1] = a[2][2] * a[0][0] - a[2][0] * a[0][2];
+  c[1][2] = a[2][0] * a[0][1] - a[2][1] * a[0][0];
+  c[2][0] = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+  c[2][1] = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+  c[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+  idlib_f64 d = a[0][0] * c[0][0] + a[0][1] * c[0][1] + a[0][2] * c[0][2];
+  if (0. != d) {
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        target[i][j] = c[i][j] / d;
+      }
+    }
+  }
+  return d;
+}
+
+static idlib_f64
+frobenius_norm
+  (
+    idlib_f64 const a[3][3]
+  )
+{
+  idlib_f64 s = 0.;
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      s += a[i][j] * a[i][j];
+    }
+  }
+  return sqrt(s);
+}
+
+// Compute the orthogonal factor Q of the polar decomposition A = Q P.
+// Return false if A is singular.
+static bool
+polar_decomposition
+  (
+    idlib_f64 q[3][3],
+    idlib_f64 const a[3][3]
+  )
+{
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      q[i][j] = a[i][j];
+    }
+  }
+  idlib_f64 scale = frobenius_norm(a);
+  if (0. == scale) {
+    return false;
+  }
+  // Fast path: If the columns are orthogonal (there is no shear), then P is diagonal and Q consists of the normalized columns.
+  idlib_f64 l[3];
+  for (size_t j = 0; j < 3; ++j) {
+    l[j] = sqrt(a[0][j] * a[0][j] + a[1][j] * a[1][j] + a[2][j] * a[2][j]);
+  }
+  if (l[0] > 1e-6 * scale && l[1] > 1e-6 * scale && l[2] > 1e-6 * scale) {
+    bool orthogonal = true;
+    for (size_t j = 0; j < 3; ++j) {
+      size_t k = (j + 1) % 3;
+      idlib_f64 d = a[0][j] * a[0][k] + a[1][j] * a[1][k] + a[2][j] * a[2][k];
+      orthogonal = orthogonal && fabs(d) <= 1e-7 * l[j] * l[k];
+    }
+    if (orthogonal) {
+      for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+          q[i][j] = a[i][j] / l[j];
+        }
+      }
+      return true;
+    }
+  }
+  for (size_t k = 0; k < POLAR_DECOMPOSITION_MAXIMUM_ITERATIONS; ++k) {
+    idlib_f64 r[3][3];
+    idlib_f64 d = inverse_transpose(r, q);
+    // Singular relative to the magnitude of the matrix.
+    if (fabs(d) <= 1e-12 * scale * scale * scale) {
+      return false;
+    }
+    idlib_f64 g = sqrt(frobenius_norm(r) / frobenius_norm(q));
+    idlib_f64 change = 0.;
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        idlib_f64 v = 0.5 * (g * q[i][j] + r[i][j] / g);
+        change += fabs(v - q[i][j]);
+        q[i][j] = v;
+      }
+    }
+    if (change <= 1e-12) {
+      break;
+    }
+  }
+  return true;
+}
+
+// Assign a quaternion the rotation of a rotation matrix.
+// Shepperd's method: pivot on the largest diagonal term for numerical stability.
+static void
+quaternion_set_rotation
+  (
+    idlib_vector_4_f32* target,
+    idlib_f64 const e[3][3]
+  )
+{
+  idlib_f64 x, y, z, w;
+  idlib_f64 trace = e[0][0] + e[1][1] + e[2][2];
+  if (trace > 0.) {
+    idlib_f64 s = sqrt(trace + 1.) * 2.;
+    w = 0.25 * s;
+    x = (e[2][1] - e[1][2]) / s;
+    y = (e[0][2] - e[2][0]) / s;
+    z = (e[1][0] - e[0][1]) / s;
+  } else if (e[0][0] > e[1][1] && e[0][0] > e[2][2]) {
+    idlib_f64 s = sqrt(1. + e[0][0] - e[1][1] - e[2][2]) * 2.;
+    w = (e[2][1] - e[1][2]) / s;
+    x = 0.25 * s;
+    y = (e[0][1] + e[1][0]) / s;
+    z = (e[0][2] + e[2][0]) / s;
+  } else if (e[1][1] > e[2][2]) {
+    idlib_f64 s = sqrt(1. + e[1][1] - e[0][0] - e[2][2]) * 2.;
+    w = (e[0][2] - e[2][0]) / s;
+    x = (e[0][1] + e[1][0]) / s;
+    y = 0.25 * s;
+    z = (e[1][2] + e[2][1]) / s;
+  } else {
+    idlib_f64 s = sqrt(1. + e[2][2] - e[0][0] - e[1][1]) * 2.;
+    w = (e[1][0] - e[0][1]) / s;
+    x = (e[0][2] + e[2][0]) / s;
+    y = (e[1][2] + e[2][1]) / s;
+    z = 0.25 * s;
+  }
+  // Canonical sign: q and -q represent the same rotation.
+  idlib_f64 n = sqrt(x * x + y * y + z * z + w * w);
+  if (w < 0.) {
+    n = -n;
+  }
+  target->e[0] = (idlib_f32)(x / n);
+  target->e[1] = (idlib_f32)(y / n);
+  target->e[2] = (idlib_f32)(z / n);
+  target->e[3] = (idlib_f32)(w / n);
+}
+
+bool
+idlib_transform_f32_set_matrix_4x4
+  (
+    idlib_transform_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+
+  target->translation.e[0] = operand->e[0][3];
+  target->translation.e[1] = operand->e[1][3];
+  target->translation.e[2] = operand->e[2][3];
+
+  idlib_f64 a[3][3];
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      a[i][j] = operand->e[i][j];
+    }
+  }
+
+  idlib_f64 q[3][3];
+  if (!polar_decomposition(q, a)) {
+    target->rotation.e[0] = 0.f;
+    target->rotation.e[1] = 0.f;
+    target->rotation.e[2] = 0.f;
+    target->rotation.e[3] = 1.f;
+    for (size_t j = 0; j < 3; ++j) {
+      target->scale.e[j] = (idlib_f32)sqrt(a[0][j] * a[0][j] + a[1][j] * a[1][j] + a[2][j] * a[2][j]);
+    }
+    return false;
+  }
+
+  // If Q is a reflection, then negate its first column to obtain a rotation.
+  // The reflection is thereby moved into the x component of the scale.
+  idlib_f64 d = q[0][0] * (q[1][1] * q[2][2] - q[1][2] * q[2][1])
+              - q[0][1] * (q[1][0] * q[2][2] - q[1][2] * q[2][0])
+              + q[0][2] * (q[1][0] * q[2][1] - q[1][1] * q[2][0]);
+  if (d < 0.) {
+    q[0][0] = -q[0][0];
+    q[1][0] = -q[1][0];
+    q[2][0] = -q[2][0];
+  }
+
+  // The diagonal of P = Q^T A.
+  for (size_t j = 0; j < 3; ++j) {
+    idlib_f64 p = q[0][j] * a[0][j] + q[1][j] * a[1][j] + q[2][j] * a[2][j];
+    target->scale.e[j] = (idlib_f32)p;
+  }
+
+  quaternion_set_rotation(&target->rotation, q);
+  return true;
+}
+
+bool
+idlib_transform_f32_set_matrix_4x4_n
+  (
+    idlib_transform_f32* target,
+    idlib_matrix_4x4_f32 const* operand,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  bool result = true;
+  for (size_t i = 0; i < count; ++i) {
+    result &= idlib_transform_f32_set_matrix_4x4(target + i, operand + i);
+  }
+  return result;
+}
+
+void
+idlib_matrix_4x4_f32_set_normal_matrix
+  (
+    idlib_matrix_4x4_f32* target,
+    idlib_matrix_4x4_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+
+  #define a(i,j) operand->e[i][j]
+  idlib_f32 c[3][3];
+  c[0][0] = a(1,1) * a(2,2) - a(1,2) * a(2,1);
+  c[0][1] = a(1,2) * a(2,0) - a(1,0) * a(2,2);
+  c[0][2] = a(1,0) * a(2,1) - a(1,1) * a(2,0);
+  c[1][0] = a(2,1) * a(0,2) - a(2,2) * a(0,1);
+  c[1][1] = a(2,2) * a(0,0) - a(2,0) * a(0,2);
+  c[1][2] = a(2,0) * a(0,1) - a(2,1) * a(0,0);
+  c[2][0] = a(0,1) * a(1,2) - a(0,2) * a(1,1);
+  c[2][1] = a(0,2) * a(1,0) - a(0,0) * a(1,2);
+  c[2][2] = a(0,0) * a(1,1) - a(0,1) * a(1,0);
+  idlib_f32 d = a(0,0) * c[0][0] + a(0,1) * c[0][1] + a(0,2) * c[0][2];
+  #undef a
+
+  idlib_f32 s = d < 0.f ? -1.f : 1.f;
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      target->e[i][j] = s * c[i][j];
+    }
+    target->e[i][3] = 0.f;
+    target->e[3][i] = 0.f;
+  }
+  target->e[3][3] = 1.f;
+}
+
+// Transform the i-th vector of a stream by the upper left 3x3 matrix of m and normalize it.
+static inline void
+transform_normalize_1
+  (
+    idlib_vector_3_f32_soa const* target,
+    idlib_matrix_4x4_f32 const* m,
+    idlib_vector_3_f32_soa const* operand,
+    size_t i
+  )
+{
+  idlib_f32 x = operand->x[i], y = operand->y[i], z = operand->z[i];
+  idlib_f32 r[3];
+  for (size_t k = 0; k < 3; ++k) {
+    r[k] = (m->e[k][0] * x + m->e[k][1] * y) + m->e[k][2] * z;
+  }
+  idlib_f32 l = (r[0] * r[0] + r[1] * r[1]) + r[2] * r[2];
+  if (l > 0.f) {
+    l = 1.f / idlib_sqrt_f32(l);
+    r[0] *= l;
+    r[1] *= l;
+    r[2] *= l;
+  }
+  target->x[i] = r[0];
+  target->y[i] = r[1];
+  target->z[i] = r[2];
+}
+
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+
+// Transform the vectors [i, i + 4) of a stream by the upper left 3x3 matrix (broadcast in m) and normalize them.
+static inline void
+transform_normalize_4
+  (
+    idlib_vector_3_f32_soa const* target,
+    __m128 const m[3][3],
+    idlib_vector_3_f32_soa const* operand,
+    size_t i
+  )
+{
+  __m128 x = _mm_loadu_ps(operand->x + i);
+  __m128 y = _mm_loadu_ps(operand->y + i);
+  __m128 z = _mm_loadu_ps(operand->z + i);
+  __m128 r[3];
+  for (size_t k = 0; k < 3; ++k) {
+    r[k] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[k][0], x), _mm_mul_ps(m[k][1], y)), _mm_mul_ps(m[k][2], z));
+  }
+  __m128 l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], r[0]), _mm_mul_ps(r[1], r[1])), _mm_mul_ps(r[2], r[2]));
+  // Zero vectors yield an infinity which is masked out.
+  __m128 mask = _mm_cmpgt_ps(l, _mm_setzero_ps());
+  l = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(l));
+  l = _mm_or_ps(_mm_and_ps(mask, l), _mm_andnot_ps(mask, _mm_set1_ps(1.f)));
+  _mm_storeu_ps(target->x + i, _mm_mul_ps(r[0], l));
+  _mm_storeu_ps(target->y + i, _mm_mul_ps(r[1], l));
+  _mm_storeu_ps(target->z + i, _mm_mul_ps(r[2], l));
+}
+
+#endif
+
+void
+idlib_matrix_4x4_f32_transform_normals_n
+  (
+    idlib_vector_3_f32_soa const* target_normals,
+    idlib_vector_3_f32_soa const* target_tangents,
+    idlib_matrix_4x4_f32 const* operand,
+    idlib_vector_3_f32_soa const* source_normals,
+    idlib_vector_3_f32_soa const* source_tangents,
+    size_t first,
+    size_t count
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target_normals);
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(NULL != source_normals);
+  IDLIB_DEBUG_ASSERT(NULL != source_tangents);
+
+  bool tangents = NULL != source_tangents->x;
+  IDLIB_DEBUG_ASSERT(!tangents || NULL != target_tangents);
+  idlib_matrix_4x4_f32 normal_matrix;
+  idlib_matrix_4x4_f32_set_normal_matrix(&normal_matrix, operand);
+
+  size_t i = first, n = first + count;
+#if IDLIB_INSTRUCTION_SET_ARCHITECTURE == IDLIB_INSTRUCTION_SET_ARCHITECTURE_X64
+  __m128 nm[3][3], tm[3][3];
+  for (size_t u = 0; u < 3; ++u) {
+    for (size_t v = 0; v < 3; ++v) {
+      nm[u][v] = _mm_set1_ps(normal_matrix.e[u][v]);
+      tm[u][v] = _mm_set1_ps(operand->e[u][v]);
+    }
+  }
+  for (; i + 4 <= n; i += 4) {
+    transform_normalize_4(target_normals, nm, source_normals, i);
+    if (tangents) {
+      transform_normalize_4(target_tangents, tm, source_tangents, i);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    transform_normalize_1(target_normals, &normal_matrix, source_normals, i);
+    if (tangents) {
+      transform_normalize_1(target_tangents, operand, source_tangents, i);
+    }
+  }
+}
@@ -0,0 +1,614 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/vertex_cache.h"
+
+// powf, sqrt, sqrtf
+#include <math.h>
+
+// The parameters of the scoring function as proposed by Tom Forsyth.
+#define CACHE_DECAY_POWER (1.5f)
+#define LAST_TRIANGLE_SCORE (0.75f)
+#define VALENCE_BOOST_SCALE (2.0f)
+#define VALENCE_BOOST_POWER (0.5f)
+
+// The number of entries of the table of valence scores.
+#define MAXIMUM_TABULATED_VALENCE (32)
+
+// Marks a vertex not in the cache.
+#define NOT_IN_CACHE (0xFF)
+
+// Marks "no triangle".
+#define NONE (0xFFFFFFFFu)
+
+typedef struct workspace_layout {
+  // The triangles of vertex v are adjacency[offsets[v]], ..., adjacency[offsets[v] + valence[v] - 1].
+  // Emitted triangles are moved behind the triangles not yet emitted.
+  idlib_u32* offsets;
+  idlib_u32* adjacency;
+  idlib_u32* valence;
+  idlib_f32* vertex_scores;
+  idlib_f32* triangle_scores;
+  idlib_u8* emitted;
+  idlib_u8* cache_positions;
+} workspace_layout;
+
+static void
+workspace_layout_initialize
+  (
+    workspace_layout* target,
+    size_t number_of_triangles,
+    idlib_u32 number_of_vertices,
+    void* workspace
+  )
+{
+  idlib_u8* p = (idlib_u8*)workspace;
+  target->offsets = (idlib_u32*)p;
+  p += sizeof(idlib_u32) * ((size_t)number_of_vertices + 1);
+  target->adjacency = (idlib_u32*)p;
+  p += sizeof(idlib_u32) * 3 * number_of_triangles;
+  target->valence = (idlib_u32*)p;
+  p += sizeof(idlib_u32) * number_of_vertices;
+  target->vertex_scores = (idlib_f32*)p;
+  p += sizeof(idlib_f32) * number_of_vertices;
+  target->triangle_scores = (idlib_f32*)p;
+  p += sizeof(idlib_f32) * number_of_triangles;
+  target->emitted = p;
+  p += number_of_triangles;
+  target->cache_positions = p;
+}
+
+size_t
+idlib_vertex_cache_get_workspace_size
+  (
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices
+  )
+{
+  size_t number_of_triangles = number_of_indices / 3;
+  return sizeof(idlib_u32) * ((size_t)number_of_vertices + 1)
+       + sizeof(idlib_u32) * 3 * number_of_triangles
+       + sizeof(idlib_u32) * number_of_vertices
+       + sizeof(idlib_f32) * number_of_vertices
+       + sizeof(idlib_f32) * number_of_triangles
+       + number_of_triangles
+       + number_of_vertices;
+}
+
+typedef struct score_tables {
+  // The score of a vertex by its position in the cache.
+  idlib_f32 cache[IDLIB_VERTEX_CACHE_SIZE + 3];
+  // The score of a vertex by its number of triangles not yet emitted.
+  idlib_f32 valence[MAXIMUM_TABULATED_VALENCE + 1];
+} score_tables;
+
+static void
+score_tables_initialize
+  (
+    score_tables* target
+  )
+{
+  for (size_t i = 0; i < IDLIB_VERTEX_CACHE_SIZE + 3; ++i) {
+    if (i < 3) {
+      // The vertices of the last triangle get a fixed score such that the next triangle does not
+      // use them preferentially (that would produce strips rather than a compact fan-like order).
+      target->cache[i] = LAST_TRIANGLE_SCORE;
+    } else if (i < IDLIB_VERTEX_CACHE_SIZE) {
+      idlib_f32 scaler = 1.f / (IDLIB_VERTEX_CACHE_SIZE - 3);
+      target->cache[i] = powf(1.f - (idlib_f32)(i - 3) * scaler, CACHE_DECAY_POWER);
+    } else {
+      target->cache[i] = 0.f;
+    }
+  }
+  target->valence[0] = 0.f;
+  for (size_t i = 1; i <= MAXIMUM_TABULATED_VALENCE; ++i) {
+    target->valence[i] = VALENCE_BOOST_SCALE * powf((idlib_f32)i, -VALENCE_BOOST_POWER);
+  }
+}
+
+static inline idlib_f32
+vertex_score
+  (
+    score_tables const* tables,
+    idlib_u8 cache_position,
+    idlib_u32 valence
+  )
+{
+  if (0 == valence) {
+    // No triangles left, this vertex is irrelevant.
+    return -1.f;
+  }
+  idlib_f32 score = NOT_IN_CACHE == cache_position ? 0.f : tables->cache[cache_position];
+  score += valence <= MAXIMUM_TABULATED_VALENCE ? tables->valence[valence]
+                                                : VALENCE_BOOST_SCALE * powf((idlib_f32)valence, -VALENCE_BOOST_POWER);
+  return score;
+}
+
+void
+idlib_vertex_cache_optimize
+  (
+    idlib_u32* target,
+    idlib_u32 const* indices,
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == number_of_indices);
+  IDLIB_DEBUG_ASSERT(NULL != indices || 0 == number_of_indices);
+  IDLIB_DEBUG_ASSERT(0 == number_of_indices % 3);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+
+  size_t number_of_triangles = number_of_indices / 3;
+  workspace_layout w;
+  workspace_layout_initialize(&w, number_of_triangles, number_of_vertices, workspace);
+  score_tables tables;
+  score_tables_initialize(&tables);
+
+  // Compute the triangles of each vertex by a counting sort.
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    w.valence[v] = 0;
+    w.cache_positions[v] = NOT_IN_CACHE;
+  }
+  for (size_t i = 0; i < number_of_indices; ++i) {
+    IDLIB_DEBUG_ASSERT(indices[i] < number_of_vertices);
+    w.valence[indices[i]]++;
+  }
+  idlib_u32 offset = 0;
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    w.offsets[v] = offset;
+    offset += w.valence[v];
+    w.valence[v] = 0;
+  }
+  w.offsets[number_of_vertices] = offset;
+  for (size_t t = 0; t < number_of_triangles; ++t) {
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_u32 v = indices[3 * t + k];
+      w.adjacency[w.offsets[v] + w.valence[v]++] = (idlib_u32)t;
+    }
+  }
+
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    w.vertex_scores[v] = vertex_score(&tables, NOT_IN_CACHE, w.valence[v]);
+  }
+  idlib_u32 best = NONE;
+  idlib_f32 best_score = -1.f;
+  for (size_t t = 0; t < number_of_triangles; ++t) {
+    w.emitted[t] = 0;
+    w.triangle_scores[t] = w.vertex_scores[indices[3 * t + 0]]
+                         + w.vertex_scores[indices[3 * t + 1]]
+                         + w.vertex_scores[indices[3 * t + 2]];
+    if (w.triangle_scores[t] > best_score) {
+      best_score = w.triangle_scores[t];
+      best = (idlib_u32)t;
+    }
+  }
+
+  // The simulated cache, most recently used vertex first.
+  idlib_u32 cache[IDLIB_VERTEX_CACHE_SIZE];
+  size_t cache_count = 0;
+  // Triangles before this one have been emitted. Used to find a triangle if the cache has no candidates.
+  size_t scan = 0;
+
+  for (size_t e = 0; e < number_of_triangles; ++e) {
+    if (NONE == best) {
+      while (w.emitted[scan]) {
+        scan++;
+      }
+      best = (idlib_u32)scan;
+    }
+    idlib_u32 const* tri = indices + 3 * (size_t)best;
+    target[3 * e + 0] = tri[0];
+    target[3 * e + 1] = tri[1];
+    target[3 * e + 2] = tri[2];
+    w.emitted[best] = 1;
+
+    // Remove the triangle from the triangles of its vertices.
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_u32 v = tri[k];
+      idlib_u32* a = w.adjacency + w.offsets[v];
+      idlib_u32 n = w.valence[v];
+      for (idlib_u32 i = 0; i < n; ++i) {
+        if (a[i] == best) {
+          a[i] = a[n - 1];
+          a[n - 1] = best;
+          break;
+        }
+      }
+      w.valence[v] = n - 1;
+    }
+
+    // Move the vertices of the triangle to the front of the cache.
+    // The new cache temporarily holds up to three more vertices than the capacity of the cache.
+    idlib_u32 new_cache[IDLIB_VERTEX_CACHE_SIZE + 3];
+    size_t new_count = 0;
+    for (size_t k = 0; k < 3; ++k) {
+      new_cache[new_count++] = tri[k];
+    }
+    for (size_t i = 0; i < cache_count; ++i) {
+      idlib_u32 v = cache[i];
+      if (v != tri[0] && v != tri[1] && v != tri[2]) {
+        new_cache[new_count++] = v;
+      }
+    }
+    // Vertices pushed out of the cache.
+    for (size_t i = IDLIB_VERTEX_CACHE_SIZE; i < new_count; ++i) {
+      w.cache_positions[new_cache[i]] = NOT_IN_CACHE;
+    }
+    if (new_count > IDLIB_VERTEX_CACHE_SIZE) {
+      // Their scores changed by leaving the cache.
+      for (size_t i = IDLIB_VERTEX_CACHE_SIZE; i < new_count; ++i) {
+        idlib_u32 v = new_cache[i];
+        idlib_f32 s = vertex_score(&tables, NOT_IN_CACHE, w.valence[v]);
+        idlib_f32 d = s - w.vertex_scores[v];
+        w.vertex_scores[v] = s;
+        idlib_u32 const* a = w.adjacency + w.offsets[v];
+        for (idlib_u32 j = 0, n = w.valence[v]; j < n; ++j) {
+          w.triangle_scores[a[j]] += d;
+        }
+      }
+      new_count = IDLIB_VERTEX_CACHE_SIZE;
+    }
+
+    // Update the scores of the vertices in the cache and of their triangles and find the best candidate.
+    best = NONE;
+    best_score = -1.f;
+    for (size_t i = 0; i < new_count; ++i) {
+      idlib_u32 v = new_cache[i];
+      cache[i] = v;
+      w.cache_positions[v] = (idlib_u8)i;
+      idlib_f32 s = vertex_score(&tables, (idlib_u8)i, w.valence[v]);
+      idlib_f32 d = s - w.vertex_scores[v];
+      w.vertex_scores[v] = s;
+      idlib_u32 const* a = w.adjacency + w.offsets[v];
+      for (idlib_u32 j = 0, n = w.valence[v]; j < n; ++j) {
+        w.triangle_scores[a[j]] += d;
+      }
+    }
+    cache_count = new_count;
+    for (size_t i = 0; i < cache_count; ++i) {
+      idlib_u32 v = cache[i];
+      idlib_u32 const* a = w.adjacency + w.offsets[v];
+      for (idlib_u32 j = 0, n = w.valence[v]; j < n; ++j) {
+        if (w.triangle_scores[a[j]] > best_score) {
+          best_score = w.triangle_scores[a[j]];
+          best = a[j];
+        }
+      }
+    }
+  }
+}
+
+idlib_f32
+idlib_vertex_cache_get_acmr
+  (
+    idlib_u32 const* indices,
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices,
+    idlib_u32 cache_size,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != indices || 0 == number_of_indices);
+  IDLIB_DEBUG_ASSERT(NULL != workspace || 0 == number_of_vertices);
+  if (0 == number_of_indices) {
+    return 0.f;
+  }
+  // A vertex is in the cache if fewer than cache_size misses occurred since it was loaded.
+  idlib_u32* timestamps = (idlib_u32*)workspace;
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    timestamps[v] = 0;
+  }
+  idlib_u32 misses = 0;
+  for (size_t i = 0; i < number_of_indices; ++i) {
+    idlib_u32 v = indices[i];
+    if (0 == timestamps[v] || misses + 1 - timestamps[v] > cache_size) {
+      misses++;
+      timestamps[v] = misses;
+    }
+  }
+  return (idlib_f32)misses / (idlib_f32)(number_of_indices / 3);
+}
+
+// Map an idlib_f32 value to an idlib_u32 value such that the order of the values is reversed.
+static inline idlib_u32
+descending
+  (
+    idlib_f32 x
+  )
+{
+  union {
+    idlib_f32 f;
+    idlib_u32 u;
+  } v;
+  v.f = x + 0.f;
+  return ~(v.u ^ ((v.u >> 31) ? 0xFFFFFFFFu : 0x80000000u));
+}
+
+// Split the triangles [first, last) into clusters and append the indices of their first triangles to clusters.
+// timestamps and misses simulate a first-in first-out cache as in idlib_vertex_cache_get_acmr.
+static void
+split
+  (
+    idlib_u32 const* indices,
+    size_t first,
+    size_t last,
+    idlib_f32 threshold,
+    idlib_u32* timestamps,
+    idlib_u32* misses,
+    idlib_u32* clusters,
+    size_t* number_of_clusters
+  )
+{
+  // Count the cache misses of the run from an empty cache.
+  *misses += IDLIB_VERTEX_CACHE_SIZE + 1;
+  idlib_u32 start = *misses;
+  for (size_t i = 3 * first; i < 3 * last; ++i) {
+    idlib_u32 v = indices[i];
+    if (timestamps[v] <= *misses - IDLIB_VERTEX_CACHE_SIZE) {
+      (*misses)++;
+      timestamps[v] = *misses;
+    }
+  }
+  idlib_f32 limit = threshold * (idlib_f32)(*misses - start) / (idlib_f32)(last - first);
+  // Split where the cache miss ratio since the last split falls to the limit. The cache is empty after a split.
+  clusters[(*number_of_clusters)++] = (idlib_u32)first;
+  *misses += IDLIB_VERTEX_CACHE_SIZE + 1;
+  start = *misses;
+  size_t begin = first;
+  for (size_t t = first; t < last; ++t) {
+    for (size_t k = 0; k < 3; ++k) {
+      idlib_u32 v = indices[3 * t + k];
+      if (timestamps[v] <= *misses - IDLIB_VERTEX_CACHE_SIZE) {
+        (*misses)++;
+        timestamps[v] = *misses;
+      }
+    }
+    if (t + 1 < last && (idlib_f32)(*misses - start) <= limit * (idlib_f32)(t + 1 - begin)) {
+      clusters[(*number_of_clusters)++] = (idlib_u32)(t + 1);
+      *misses += IDLIB_VERTEX_CACHE_SIZE + 1;
+      start = *misses;
+      begin = t + 1;
+    }
+  }
+}
+
+// Add the area-weighted centroid, the area-weighted normal, and the area of a triangle.
+// The area is not halved, the factor cancels out.
+static inline void
+accumulate
+  (
+    idlib_vector_3_f32_soa const* positions,
+    idlib_u32 const* triangle,
+    idlib_f64 centroid[3],
+    idlib_f64 normal[3],
+    idlib_f64* area
+  )
+{
+  idlib_f32 const* p[3] = { positions->x, positions->y, positions->z };
+  idlib_u32 a = triangle[0], b = triangle[1], c = triangle[2];
+  idlib_f32 u[3], w[3];
+  for (size_t j = 0; j < 3; ++j) {
+    u[j] = p[j][b] - p[j][a];
+    w[j] = p[j][c] - p[j][a];
+  }
+  idlib_f32 n[3] = { u[1] * w[2] - u[2] * w[1], u[2] * w[0] - u[0] * w[2], u[0] * w[1] - u[1] * w[0] };
+  idlib_f32 l = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+  for (size_t j = 0; j < 3; ++j) {
+    centroid[j] += l * (p[j][a] + p[j][b] + p[j][c]) / 3.f;
+    normal[j] += n[j];
+  }
+  *area += l;
+}
+
+size_t
+idlib_overdraw_get_workspace_size
+  (
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices
+  )
+{
+  size_t number_of_triangles = number_of_indices / 3;
+  // The timestamps, the clusters, and two arrays of keys and of the order of the clusters.
+  return sizeof(idlib_u32) * number_of_vertices
+       + sizeof(idlib_u32) * (number_of_triangles + 1)
+       + sizeof(idlib_u32) * 4 * number_of_triangles;
+}
+
+void
+idlib_overdraw_optimize
+  (
+    idlib_u32* target,
+    idlib_u32 const* indices,
+    size_t number_of_indices,
+    idlib_vector_3_f32_soa const* positions,
+    idlib_u32 number_of_vertices,
+    idlib_f32 threshold,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == number_of_indices);
+  IDLIB_DEBUG_ASSERT(NULL != indices || 0 == number_of_indices);
+  IDLIB_DEBUG_ASSERT(0 == number_of_indices % 3);
+  IDLIB_DEBUG_ASSERT(NULL != positions);
+  IDLIB_DEBUG_ASSERT(threshold >= 1.f);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+
+  size_t number_of_triangles = number_of_indices / 3;
+  if (0 == number_of_triangles) {
+    return;
+  }
+  idlib_u32* timestamps = (idlib_u32*)workspace;
+  idlib_u32* clusters = timestamps + number_of_vertices;
+  idlib_u32* k[2] = { clusters + number_of_triangles + 1, clusters + 2 * number_of_triangles + 1 };
+  idlib_u32* o[2] = { clusters + 3 * number_of_triangles + 1, clusters + 4 * number_of_triangles + 1 };
+
+  // Find the runs: A run ends where the cache misses all vertices of a triangle, that is, where the order restarted.
+  // The first triangles of the runs are stored in the keys until the keys are computed.
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    timestamps[v] = 0;
+  }
+  idlib_u32 misses = IDLIB_VERTEX_CACHE_SIZE;
+  idlib_u32* runs = k[0];
+  size_t number_of_runs = 0;
+  for (size_t t = 0; t < number_of_triangles; ++t) {
+    idlib_u32 m = 0;
+    for (size_t j = 0; j < 3; ++j) {
+      idlib_u32 v = indices[3 * t + j];
+      IDLIB_DEBUG_ASSERT(v < number_of_vertices);
+      if (timestamps[v] <= misses - IDLIB_VERTEX_CACHE_SIZE) {
+        misses++;
+        timestamps[v] = misses;
+        m++;
+      }
+    }
+    if (0 == t || 3 == m) {
+      runs[number_of_runs++] = (idlib_u32)t;
+    }
+  }
+  runs[number_of_runs] = (idlib_u32)number_of_triangles;
+  // Split the runs into clusters.
+  size_t number_of_clusters = 0;
+  for (size_t i = 0; i < number_of_runs; ++i) {
+    split(indices, runs[i], runs[i + 1], threshold, timestamps, &misses, clusters, &number_of_clusters);
+  }
+  clusters[number_of_clusters] = (idlib_u32)number_of_triangles;
+
+  // The area-weighted centroid of the mesh.
+  idlib_f64 mesh_centroid[3] = { 0., 0., 0. };
+  idlib_f64 mesh_normal[3] = { 0., 0., 0. };
+  idlib_f64 mesh_area = 0.;
+  for (size_t t = 0; t < number_of_triangles; ++t) {
+    accumulate(positions, indices + 3 * t, mesh_centroid, mesh_normal, &mesh_area);
+  }
+  for (size_t j = 0; j < 3; ++j) {
+    mesh_centroid[j] = mesh_area > 0. ? mesh_centroid[j] / mesh_area : 0.;
+  }
+
+  // The key of a cluster is the dot product of its normal and the vector from the centroid of the mesh to its centroid.
+  for (size_t i = 0; i < number_of_clusters; ++i) {
+    idlib_f64 centroid[3] = { 0., 0., 0. };
+    idlib_f64 normal[3] = { 0., 0., 0. };
+    idlib_f64 area = 0.;
+    for (size_t t = clusters[i]; t < clusters[i + 1]; ++t) {
+      accumulate(positions, indices + 3 * t, centroid, normal, &area);
+    }
+    idlib_f64 l = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    idlib_f64 d = 0.;
+    if (area > 0. && l > 0.) {
+      for (size_t j = 0; j < 3; ++j) {
+        d += (centroid[j] / area - mesh_centroid[j]) * normal[j];
+      }
+      d /= l;
+    }
+    k[0][i] = descending((idlib_f32)d);
+    o[0][i] = (idlib_u32)i;
+  }
+
+  // Sort the clusters by their keys by a least significant digit radix sort.
+  idlib_u32 source = 0;
+  for (idlib_u32 pass = 0; pass < 4; ++pass) {
+    idlib_u32 shift = pass * 8;
+    size_t counts[256] = { 0 };
+    for (size_t i = 0; i < number_of_clusters; ++i) {
+      counts[(k[source][i] >> shift) & 0xFF]++;
+    }
+    if (counts[(k[source][0] >> shift) & 0xFF] == number_of_clusters) {
+      // All keys have the same digit.
+      continue;
+    }
+    size_t sum = 0;
+    for (idlib_u32 j = 0; j < 256; ++j) {
+      size_t c = counts[j];
+      counts[j] = sum;
+      sum += c;
+    }
+    for (size_t i = 0; i < number_of_clusters; ++i) {
+      size_t j = counts[(k[source][i] >> shift) & 0xFF]++;
+      k[1 - source][j] = k[source][i];
+      o[1 - source][j] = o[source][i];
+    }
+    source = 1 - source;
+  }
+
+  size_t n = 0;
+  for (size_t i = 0; i < number_of_clusters; ++i) {
+    idlib_u32 c = o[source][i];
+    for (size_t j = 3 * (size_t)clusters[c], l = 3 * (size_t)clusters[c + 1]; j < l; ++j) {
+      target[n++] = indices[j];
+    }
+  }
+}
+
+idlib_u32
+idlib_vertex_fetch_optimize
+  (
+    idlib_u32* remap,
+    idlib_u32* indices,
+    size_t number_of_indices,
+    idlib_u32 number_of_vertices
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != remap || 0 == number_of_vertices);
+  IDLIB_DEBUG_ASSERT(NULL != indices || 0 == number_of_indices);
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    remap[v] = NONE;
+  }
+  idlib_u32 n = 0;
+  for (size_t i = 0; i < number_of_indices; ++i) {
+    idlib_u32 v = indices[i];
+    IDLIB_DEBUG_ASSERT(v < number_of_vertices);
+    if (NONE == remap[v]) {
+      remap[v] = n++;
+    }
+    indices[i] = remap[v];
+  }
+  idlib_u32 referenced = n;
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    if (NONE == remap[v]) {
+      remap[v] = n++;
+    }
+  }
+  return referenced;
+}
+
+void
+idlib_vertex_remap_f32
+  (
+    idlib_f32* target,
+    idlib_f32 const* source,
+    idlib_u32 const* remap,
+    idlib_u32 number_of_vertices,
+    idlib_u32 number_of_components
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == number_of_vertices);
+  IDLIB_DEBUG_ASSERT(NULL != source || 0 == number_of_vertices);
+  IDLIB_DEBUG_ASSERT(NULL != remap || 0 == number_of_vertices);
+  for (idlib_u32 v = 0; v < number_of_vertices; ++v) {
+    idlib_f32* t = target + (size_t)remap[v] * number_of_components;
+    idlib_f32 const* s = source + (size_t)v * number_of_components;
+    for (idlib_u32 k = 0; k < number_of_components; ++k) {
+      t[k] = s[k];
+    }
+  }
+}
@@ -0,0 +1,531 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "idlib/math/weld.h"
+
+// floor, NAN
+#include <math.h>
+
+// memcpy
+#include <string.h>
+
+// Marks an empty slot of the hash table.
+#define EMPTY (0xFFFFFFFFu)
+
+// The finalizer of MurmurHash3.
+static inline idlib_u32
+mix
+  (
+    idlib_u32 h
+  )
+{
+  h ^= h >> 16;
+  h *= 0x85EBCA6Bu;
+  h ^= h >> 13;
+  h *= 0xC2B2AE35u;
+  h ^= h >> 16;
+  return h;
+}
+
+static inline idlib_u32
+combine
+  (
+    idlib_u32 a,
+    idlib_u32 b,
+    idlib_u32 c
+  )
+{ return mix(mix(mix(a) ^ b) ^ c); }
+
+// Get the bits of a component. Negative zero is mapped to positive zero.
+static inline idlib_u32
+bits
+  (
+    idlib_f32 x
+  )
+{
+  idlib_u32 u;
+  x = (0.f == x) ? 0.f : x;
+  memcpy(&u, &x, sizeof(u));
+  return u;
+}
+
+// The bits of the grid point floor(x / cell_size + 1/2) of a component as an idlib_f64 value.
+// The grid point is not converted to an integer such that huge and non-finite values are quantized without undefined behavior.
+// Negative zero is mapped to positive zero and NaNs are mapped to the same NaN.
+static inline idlib_u64
+quantize
+  (
+    idlib_f32 x,
+    idlib_f64 inverse_cell_size
+  )
+{
+  idlib_f64 q = floor((idlib_f64)x * inverse_cell_size + 0.5);
+  if (0. == q) {
+    q = 0.;
+  } else if (q != q) {
+    q = NAN;
+  }
+  idlib_u64 u;
+  memcpy(&u, &q, sizeof(u));
+  return u;
+}
+
+// Fold the bits of a quantized component into 32 bits.
+static inline idlib_u32
+fold
+  (
+    idlib_u64 x
+  )
+{ return (idlib_u32)(x ^ (x >> 32)); }
+
+// The key of a vertex: The bits of its components or of its quantized components.
+typedef struct key {
+  idlib_u64 e[3];
+} key;
+
+static inline key
+get_key
+  (
+    idlib_f32 x,
+    idlib_f32 y,
+    idlib_f32 z,
+    bool quantized,
+    idlib_f64 inverse_cell_size
+  )
+{
+  key k;
+  if (quantized) {
+    k.e[0] = quantize(x, inverse_cell_size);
+    k.e[1] = quantize(y, inverse_cell_size);
+    k.e[2] = quantize(z, inverse_cell_size);
+  } else {
+    k.e[0] = bits(x);
+    k.e[1] = bits(y);
+    k.e[2] = bits(z);
+  }
+  return k;
+}
+
+static inline bool
+are_keys_equal
+  (
+    key const* a,
+    key const* b
+  )
+{ return a->e[0] == b->e[0] && a->e[1] == b->e[1] && a->e[2] == b->e[2]; }
+
+static inline idlib_u32
+hash_key
+  (
+    key const* k
+  )
+{ return combine(fold(k->e[0]), fold(k->e[1]), fold(k->e[2])); }
+
+idlib_u32
+idlib_vector_3_f32_hash
+  (
+    idlib_vector_3_f32 const* operand
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  key k = get_key(operand->e[0], operand->e[1], operand->e[2], false, 0.);
+  return hash_key(&k);
+}
+
+idlib_u32
+idlib_vector_3_f32_hash_quantized
+  (
+    idlib_vector_3_f32 const* operand,
+    idlib_f32 cell_size
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != operand);
+  IDLIB_DEBUG_ASSERT(cell_size > 0.f);
+  key k = get_key(operand->e[0], operand->e[1], operand->e[2], true, 1. / (idlib_f64)cell_size);
+  return hash_key(&k);
+}
+
+// The capacity of the hash table: the smallest power of two greater than or equal to twice the number of vertices.
+static size_t
+get_capacity
+  (
+    size_t number_of_vertices
+  )
+{
+  size_t capacity = 16;
+  while (capacity < 2 * number_of_vertices) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+size_t
+idlib_weld_f32_get_workspace_size
+  (
+    size_t number_of_vertices
+  )
+{ return get_capacity(number_of_vertices) * sizeof(idlib_u32); }
+
+size_t
+idlib_weld_f32
+  (
+    idlib_u32* remap,
+    idlib_vector_3_f32_soa const* target,
+    idlib_vector_3_f32_soa const* source,
+    size_t number_of_vertices,
+    idlib_f32 cell_size,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != remap || 0 == number_of_vertices);
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != source);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  IDLIB_DEBUG_ASSERT(cell_size >= 0.f);
+  IDLIB_DEBUG_ASSERT(number_of_vertices < EMPTY);
+
+  size_t capacity = get_capacity(number_of_vertices);
+  size_t mask = capacity - 1;
+  // The slots store indices into target.
+  idlib_u32* table = (idlib_u32*)workspace;
+  for (size_t i = 0; i < capacity; ++i) {
+    table[i] = EMPTY;
+  }
+
+  bool quantized = cell_size > 0.f;
+  idlib_f64 inverse_cell_size = quantized ? 1. / (idlib_f64)cell_size : 0.;
+  size_t n = 0;
+  for (size_t i = 0; i < number_of_vertices; ++i) {
+    idlib_f32 x = source->x[i], y = source->y[i], z = source->z[i];
+    key k = get_key(x, y, z, quantized, inverse_cell_size);
+    size_t slot = hash_key(&k) & mask;
+    while (true) {
+      idlib_u32 j = table[slot];
+      if (EMPTY == j) {
+        table[slot] = (idlib_u32)n;
+        target->x[n] = x;
+        target->y[n] = y;
+        target->z[n] = z;
+        remap[i] = (idlib_u32)n;
+        n++;
+        break;
+      }
+      key l = get_key(target->x[j], target->y[j], target->z[j], quantized, inverse_cell_size);
+      if (are_keys_equal(&k, &l)) {
+        remap[i] = j;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+  return n;
+}
+
+// The range [*first, *first + *count) of the vertices of the i-th chunk of a job.
+static inline void
+get_chunk
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i,
+    size_t* first,
+    size_t* count
+  )
+{
+  idlib_u64 n = job->number_of_vertices, m = job->number_of_partitions;
+  size_t a = (size_t)(n * i / m), b = (size_t)(n * (i + 1) / m);
+  *first = a;
+  *count = b - a;
+}
+
+// The partition of a vertex with the specified hash value.
+static inline idlib_u32
+get_partition
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 hash
+  )
+{ return (idlib_u32)(((idlib_u64)hash * job->number_of_partitions) >> 32); }
+
+// The number of vertices of the i-th chunk in the j-th partition.
+static inline idlib_u32*
+get_count
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i,
+    idlib_u32 j
+  )
+{ return job->counts + (size_t)i * job->number_of_partitions + j; }
+
+// The number of distinct vertices of the i-th chunk found in the j-th partition.
+static inline idlib_u32*
+get_unique_count
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i,
+    idlib_u32 j
+  )
+{ return job->unique_counts + (size_t)i * job->number_of_partitions + j; }
+
+size_t
+idlib_weld_f32_job_get_workspace_size
+  (
+    size_t number_of_vertices,
+    idlib_u32 number_of_partitions
+  )
+{
+  size_t p = number_of_partitions;
+  // hashes, order, and representatives (3 n), counts and unique counts (2 p^2), and
+  // the hash tables of the partitions: get_capacity(m) <= 4 m + 16 for a partition of m vertices.
+  return (3 * number_of_vertices + 2 * p * p + 4 * number_of_vertices + 16 * p) * sizeof(idlib_u32);
+}
+
+void
+idlib_weld_f32_job_initialize
+  (
+    idlib_weld_f32_job* job,
+    idlib_u32* remap,
+    idlib_vector_3_f32_soa const* target,
+    idlib_vector_3_f32_soa const* source,
+    size_t number_of_vertices,
+    idlib_f32 cell_size,
+    idlib_u32 number_of_partitions,
+    void* workspace
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(NULL != remap || 0 == number_of_vertices);
+  IDLIB_DEBUG_ASSERT(NULL != target);
+  IDLIB_DEBUG_ASSERT(NULL != source);
+  IDLIB_DEBUG_ASSERT(cell_size >= 0.f);
+  IDLIB_DEBUG_ASSERT(number_of_vertices < EMPTY);
+  IDLIB_DEBUG_ASSERT(0 < number_of_partitions);
+  IDLIB_DEBUG_ASSERT(NULL != workspace);
+  job->remap = remap;
+  job->target = *target;
+  job->source = *source;
+  job->number_of_vertices = number_of_vertices;
+  job->cell_size = cell_size;
+  job->number_of_partitions = number_of_partitions;
+  size_t p = number_of_partitions;
+  idlib_u32* w = (idlib_u32*)workspace;
+  job->hashes = w;
+  w += number_of_vertices;
+  job->order = w;
+  w += number_of_vertices;
+  job->representatives = w;
+  w += number_of_vertices;
+  job->counts = w;
+  w += p * p;
+  job->unique_counts = w;
+  w += p * p;
+  job->tables = w;
+}
+
+void
+idlib_weld_f32_job_partition
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_partitions);
+  bool quantized = job->cell_size > 0.f;
+  idlib_f64 inverse_cell_size = quantized ? 1. / (idlib_f64)job->cell_size : 0.;
+  for (idlib_u32 j = 0; j < job->number_of_partitions; ++j) {
+    *get_count(job, i, j) = 0;
+  }
+  size_t first, count;
+  get_chunk(job, i, &first, &count);
+  for (size_t k = first, n = first + count; k < n; ++k) {
+    key l = get_key(job->source.x[k], job->source.y[k], job->source.z[k], quantized, inverse_cell_size);
+    idlib_u32 h = hash_key(&l);
+    job->hashes[k] = h;
+    (*get_count(job, i, get_partition(job, h)))++;
+  }
+}
+
+void
+idlib_weld_f32_job_scatter
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_partitions);
+  // The partitions are stored one after another, each in the order of the chunks.
+  // The offset of the vertices of the i-th chunk in the j-th partition is hence
+  // the number of vertices in the partitions 0, ..., j - 1 plus the number of vertices of the chunks 0, ..., i - 1 in the j-th partition.
+  // The offsets are computed from the counts, an exclusive scan over the chunks.
+  // The offsets are stored in the i-th row of the unique counts which are not used before idlib_weld_f32_job_weld.
+  idlib_u32 m = job->number_of_partitions;
+  idlib_u32* offsets = get_unique_count(job, i, 0);
+  size_t offset = 0;
+  for (idlib_u32 j = 0; j < m; ++j) {
+    for (idlib_u32 k = 0; k < m; ++k) {
+      if (k == i) {
+        offsets[j] = (idlib_u32)offset;
+      }
+      offset += *get_count(job, k, j);
+    }
+  }
+  size_t first, count;
+  get_chunk(job, i, &first, &count);
+  for (size_t k = first, n = first + count; k < n; ++k) {
+    job->order[offsets[get_partition(job, job->hashes[k])]++] = (idlib_u32)k;
+  }
+}
+
+void
+idlib_weld_f32_job_weld
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_partitions);
+  bool quantized = job->cell_size > 0.f;
+  idlib_f64 inverse_cell_size = quantized ? 1. / (idlib_f64)job->cell_size : 0.;
+  idlib_u32 m = job->number_of_partitions;
+  // The range [first, first + count) of the i-th partition in the order and the offset of its hash table.
+  size_t first = 0, count = 0, table_offset = 0;
+  for (idlib_u32 j = 0; j <= i; ++j) {
+    first += count;
+    table_offset += j > 0 ? get_capacity(count) : 0;
+    count = 0;
+    for (idlib_u32 k = 0; k < m; ++k) {
+      count += *get_count(job, k, j);
+    }
+  }
+  size_t capacity = get_capacity(count);
+  size_t mask = capacity - 1;
+  // The slots store the indices of the first occurrences in the source.
+  idlib_u32* table = job->tables + table_offset;
+  for (size_t k = 0; k < capacity; ++k) {
+    table[k] = EMPTY;
+  }
+  // The vertices of the partition are ordered by chunk and, within a chunk, ascending.
+  // Hence the first vertex inserted into a slot is the first occurrence.
+  size_t l = first;
+  for (idlib_u32 c = 0; c < m; ++c) {
+    idlib_u32 unique_count = 0;
+    for (size_t n = l + *get_count(job, c, i); l < n; ++l) {
+      idlib_u32 v = job->order[l];
+      key k = get_key(job->source.x[v], job->source.y[v], job->source.z[v], quantized, inverse_cell_size);
+      size_t slot = job->hashes[v] & mask;
+      while (true) {
+        idlib_u32 u = table[slot];
+        if (EMPTY == u) {
+          table[slot] = v;
+          job->representatives[v] = v;
+          unique_count++;
+          break;
+        }
+        key o = get_key(job->source.x[u], job->source.y[u], job->source.z[u], quantized, inverse_cell_size);
+        if (are_keys_equal(&k, &o)) {
+          job->representatives[v] = u;
+          break;
+        }
+        slot = (slot + 1) & mask;
+      }
+    }
+    *get_unique_count(job, c, i) = unique_count;
+  }
+}
+
+void
+idlib_weld_f32_job_compact
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_partitions);
+  idlib_u32 m = job->number_of_partitions;
+  // The index of the first distinct vertex of the i-th chunk in the target: An exclusive scan over the chunks.
+  size_t n = 0;
+  for (idlib_u32 k = 0; k < i; ++k) {
+    for (idlib_u32 j = 0; j < m; ++j) {
+      n += *get_unique_count(job, k, j);
+    }
+  }
+  size_t first, count;
+  get_chunk(job, i, &first, &count);
+  // The hash values are not used anymore: They are replaced by the indices of the distinct vertices in the target.
+  for (size_t k = first, l = first + count; k < l; ++k) {
+    if (job->representatives[k] == k) {
+      job->target.x[n] = job->source.x[k];
+      job->target.y[n] = job->source.y[k];
+      job->target.z[n] = job->source.z[k];
+      job->hashes[k] = (idlib_u32)n;
+      n++;
+    }
+  }
+}
+
+void
+idlib_weld_f32_job_remap
+  (
+    idlib_weld_f32_job const* job,
+    idlib_u32 i
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  IDLIB_DEBUG_ASSERT(i < job->number_of_partitions);
+  size_t first, count;
+  get_chunk(job, i, &first, &count);
+  for (size_t k = first, n = first + count; k < n; ++k) {
+    job->remap[k] = job->hashes[job->representatives[k]];
+  }
+}
+
+size_t
+idlib_weld_f32_job_get_number_of_vertices
+  (
+    idlib_weld_f32_job const* job
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != job);
+  size_t n = 0;
+  for (size_t k = 0, m = (size_t)job->number_of_partitions * job->number_of_partitions; k < m; ++k) {
+    n += job->unique_counts[k];
+  }
+  return n;
+}
+
+void
+idlib_weld_remap_indices
+  (
+    idlib_u32* target,
+    size_t count,
+    idlib_u32 const* remap
+  )
+{
+  IDLIB_DEBUG_ASSERT(NULL != target || 0 == count);
+  IDLIB_DEBUG_ASSERT(NULL != remap || 0 == count);
+  for (size_t i = 0; i < count; ++i) {
+    target[i] = remap[target[i]];
+  }
+}
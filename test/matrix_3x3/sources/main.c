@@ -0,0 +1,157 @@
+/*
+  IdLib Math
+  Copyright (C) 2023-2024 Michael Heilmann. All rights reserved.
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+
+#include "idlib/math.h"
+#include <stdlib.h>
+#include <math.h>
+
+// Check that U diag(s) V^T reproduces the matrix, that U and V are rotations, and that s[0] >= s[1] >= |s[2]|.
+static bool
+check_svd
+  (
+    idlib_matrix_3x3_f32 const* a
+  )
+{
+  idlib_matrix_3x3_f32 u, v;
+  idlib_vector_3_f32 s;
+  idlib_matrix_3x3_f32_svd(&u, &s, &v, a);
+  if (!(s.e[0] >= s.e[1] && s.e[1] >= fabsf(s.e[2]))) {
+    return false;
+  }
+  idlib_f32 m = 0.f;
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      m = fmaxf(m, fabsf(a->e[i][j]));
+    }
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      idlib_f32 x = 0.f, uu = 0.f, vv = 0.f;
+      for (size_t k = 0; k < 3; ++k) {
+        x += u.e[i][k] * s.e[k] * v.e[j][k];
+        uu += u.e[k][i] * u.e[k][j];
+        vv += v.e[k][i] * v.e[k][j];
+      }
+      idlib_f32 d = i == j ? 1.f : 0.f;
+      if (!(fabsf(x - a->e[i][j]) <= 1e-4f * m) || !(fabsf(uu - d) <= 1e-4f) || !(fabsf(vv - d) <= 1e-4f)) {
+        return false;
+      }
+    }
+  }
+  for (size_t k = 0; k < 2; ++k) {
+    idlib_matrix_3x3_f32 const* r = 0 == k ? &u : &v;
+    idlib_f32 det = r->e[0][0] * (r->e[1][1] * r->e[2][2] - r->e[1][2] * r->e[2][1])
+                  - r->e[0][1] * (r->e[1][0] * r->e[2][2] - r->e[1][2] * r->e[2][0])
+                  + r->e[0][2] * (r->e[1][0] * r->e[2][1] - r->e[1][1] * r->e[2][0]);
+    if (!(det > 0.f)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Assign a the matrix R diag(x, y, z) Q^T where R and Q are rotations about the z-axis by alpha and about the x-axis by beta.
+static void
+set_rotated_diagonal
+  (
+    idlib_matrix_3x3_f32* a,
+    idlib_f32 x,
+    idlib_f32 y,
+    idlib_f32 z,
+    idlib_f32 alpha,
+    idlib_f32 beta
+  )
+{
+  idlib_f32 ca = cosf(alpha), sa = sinf(alpha), cb = cosf(beta), sb = sinf(beta);
+  idlib_f32 r[3][3] = { { ca, -sa, 0.f }, { sa, ca, 0.f }, { 0.f, 0.f, 1.f } };
+  idlib_f32 q[3][3] = { { 1.f, 0.f, 0.f }, { 0.f, cb, -sb }, { 0.f, sb, cb } };
+  idlib_f32 d[3] = { x, y, z };
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      idlib_f32 t = 0.f;
+      for (size_t k = 0; k < 3; ++k) {
+        t += r[i][k] * d[k] * q[j][k];
+      }
+      a->e[i][j] = t;
+    }
+  }
+}
+
+// Nearly rank one matrices produced NaN on x64 and unordered singular values.
+static bool
+test_svd_rank_one
+  (
+  )
+{
+  idlib_matrix_3x3_f32 a;
+  set_rotated_diagonal(&a, 1e4f, 1e-4f, 1e-4f, 0.f, 0.f);
+  if (!check_svd(&a)) {
+    return false;
+  }
+  for (idlib_f32 x = 1e-8f; x < 1e-6f; x *= 1.3f) {
+    set_rotated_diagonal(&a, 1.f, x, x, 0.f, 0.f);
+    if (!check_svd(&a)) {
+      return false;
+    }
+  }
+  set_rotated_diagonal(&a, 1.f, 1e-7f, 1e-7f, 0.7f, 1.1f);
+  if (!check_svd(&a)) {
+    return false;
+  }
+  // Outer products x y^T.
+  idlib_u32 state = 1;
+  for (size_t n = 0; n < 2000; ++n) {
+    idlib_f32 x[3], y[3];
+    for (size_t k = 0; k < 6; ++k) {
+      state = state * 1103515245u + 12345u;
+      idlib_f32 t = (idlib_f32)((state >> 8) & 0xFFFF) / 65535.f * 2.f - 1.f;
+      if (k < 3) {
+        x[k] = 5.f * t;
+      } else {
+        y[k - 3] = t;
+      }
+    }
+    for (size_t i = 0; i < 3; ++i) {
+      for (size_t j = 0; j < 3; ++j) {
+        a.e[i][j] = x[i] * y[j];
+      }
+    }
+    if (!check_svd(&a)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int
+main
+  (
+    int argc,
+    char** argv
+  )
+{
+  if (!test_svd_rank_one()) {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}